@@ -35,6 +35,11 @@ void ObjectTrack::Serialize(Serializer& stream)
       // from the tracks name
       stream.SerializeField("Name", track.Name);
       stream.SerializeField("TypeName", track.TypeName);
+      if (track.IsCompressed())
+      {
+        bool compressed = true;
+        stream.SerializeField("Compressed", compressed);
+      }
 
       track.Serialize(stream);
       stream.EndPolymorphic();
@@ -97,8 +102,16 @@ void ObjectTrack::Serialize(Serializer& stream)
         }
       }
 
+      bool compressed;
+      stream.SerializeFieldDefault("Compressed", compressed, false);
+
       // Create the property track
-      PropertyTrack* newPropertyTrack = MakePropertyTrack(componentName, propertyName, typeName);
+      PropertyTrack* newPropertyTrack = nullptr;
+      if (compressed)
+        newPropertyTrack = MakeCompressedPropertyTrack(
+            componentName, propertyName, MetaDatabase::GetInstance()->FindType(typeName));
+      else
+        newPropertyTrack = MakePropertyTrack(componentName, propertyName, typeName);
       if (newPropertyTrack)
       {
         AddPropertyTrack(newPropertyTrack);
@@ -137,6 +150,26 @@ void ObjectTrack::UpdateFrame(PlayData& playData, TrackParams& params, Animation
   }
 }
 
+void ObjectTrack::UpdatePose(PlayData& playData, float time, AnimationPose& pose)
+{
+  ObjectTrackPlayData& thisData = playData[ObjectTrackId];
+
+  // The object isn't looked up here since it can't be done from other threads,
+  // tracks whose object was destroyed are skipped when the pose is applied.
+  // Tracks whose object was never found have no play data.
+  PropertyTrackList::range r = PropertyTracks.All();
+  for (; !r.Empty(); r.PopFront())
+  {
+    PropertyTrack& track = r.Front();
+    if (track.TrackIndex >= thisData.mSubTrackPlayData.Size())
+      continue;
+
+    PropertyTrackPlayData& instanceData = thisData.mSubTrackPlayData[track.TrackIndex];
+    if (instanceData.mComponent)
+      track.UpdatePose(instanceData, time, pose);
+  }
+}
+
 PropertyTrack* ObjectTrack::GetPropertyTrack(StringParam name)
 {
   forRange (PropertyTrack& propertyTrack, PropertyTracks.All())
@@ -246,6 +279,15 @@ void Animation::UpdateFrame(PlayData& playData, TrackParams& params, AnimationFr
   }
 }
 
+void Animation::UpdatePose(PlayData& playData, float time, AnimationPose& pose)
+{
+  ObjectTrackList::range r = ObjectTracks.All();
+  for (; !r.Empty(); r.PopFront())
+  {
+    r.Front().UpdatePose(playData, time, pose);
+  }
+}
+
 class AnimationLoaderData : public ResourceLoader
 {
   HandleOf<Resource> LoadFromFile(ResourceEntry& entry) override
@@ -317,6 +359,43 @@ struct AnimationLoadPattern
     animation.ObjectTracks.PushBack(track);
   }
 
+  template <typename readerType>
+  static void LoadCompressedObjectTrack(Animation& animation, uint trackId, readerType& reader)
+  {
+    ObjectTrack* track = new ObjectTrack();
+    String fullPath;
+    reader.ReadString(fullPath);
+    track->SetFullPath(fullPath);
+
+    u32 channels = 0;
+    reader.Read(channels);
+
+    // The curves are stored in channel order
+    if (channels & AnimationPoseChannels::Translation)
+    {
+      CompressedPropertyTrack<Vec3>* translationTrack = new CompressedPropertyTrack<Vec3>("Transform", "Translation");
+      translationTrack->mCurve.Read(reader);
+      track->AddPropertyTrack(translationTrack);
+    }
+
+    if (channels & AnimationPoseChannels::Rotation)
+    {
+      CompressedPropertyTrack<Quat>* rotationTrack = new CompressedPropertyTrack<Quat>("Transform", "Rotation");
+      rotationTrack->mCurve.Read(reader);
+      track->AddPropertyTrack(rotationTrack);
+    }
+
+    if (channels & AnimationPoseChannels::Scale)
+    {
+      CompressedPropertyTrack<Vec3>* scaleTrack = new CompressedPropertyTrack<Vec3>("Transform", "Scale");
+      scaleTrack->mCurve.Read(reader);
+      track->AddPropertyTrack(scaleTrack);
+    }
+
+    track->ObjectTrackId = trackId;
+    animation.ObjectTracks.PushBack(track);
+  }
+
   template <typename readerType>
   static void Load(Animation* animation, readerType& reader)
   {
@@ -337,6 +416,9 @@ struct AnimationLoadPattern
       case ObjectTrackChunk:
         LoadObjectTrack(*animation, trackId, reader);
         break;
+      case CompressedObjectTrackChunk:
+        LoadCompressedObjectTrack(*animation, trackId, reader);
+        break;
       default:
         ErrorIf(true, "Incorrect animation data format\n");
         break;
@@ -59,6 +59,7 @@ public:
   void Serialize(Serializer& stream);
 
   void UpdateFrame(PlayData& playData, TrackParams& params, AnimationFrame& frame);
+  void UpdatePose(PlayData& playData, float time, AnimationPose& pose);
 
   /// Name will be "Transform.Translation" or "Light.Color"
   PropertyTrack* GetPropertyTrack(StringParam name);
@@ -116,6 +117,9 @@ public:
 
   ObjectTrackList ObjectTracks;
   void UpdateFrame(PlayData& playData, TrackParams& params, AnimationFrame& frame);
+  /// Samples the tracks that animate Transforms. Safe to call from any thread
+  /// as long as the animation and play data aren't being modified.
+  void UpdatePose(PlayData& playData, float time, AnimationPose& pose);
   ObjectTrack* GetObjectTrack(StringParam fullPath);
   float mDuration;
   uint mNumberOfTracks;
@@ -41,10 +41,12 @@ ZilchDefineType(AnimationGraph, builder, type)
 AnimationGraph::AnimationGraph()
 {
   mFrameId = 0;
+  mUpdatePending = false;
 }
 
 AnimationGraph::~AnimationGraph()
 {
+  DeleteObjectsInContainer(mEventsToSend);
   DeleteObjectsInContainer(mBlendTracks);
 }
 
@@ -83,7 +85,7 @@ void AnimationGraph::OnAllObjectsCreated(CogInitializer& initializer)
 
 void AnimationGraph::Initialize(CogInitializer& initializer)
 {
-  ConnectThisTo(initializer.mSpace, Events::LogicUpdate, OnUpdate);
+  ConnectThisTo(initializer.mSpace, Events::AnimationLogicUpdate, OnUpdate);
 
   if (mOnGraphCreated && !GetSpace()->IsEditorMode())
     mOnGraphCreated(this);
@@ -103,45 +105,101 @@ void AnimationGraph::Update(float dt)
 {
   if (mActiveNode)
   {
-    // Static so we can re-use memory and avoid extra allocations
-    static Array<AnimationGraphEvent*> eventsToSend;
-    eventsToSend.Clear();
+    UpdateNodes(dt);
+    FinishUpdate();
+  }
+}
 
-    // Update the root node
-    mActiveNode = mActiveNode->Update(this, dt, mFrameId++, eventsToSend);
+void AnimationGraph::UpdateNodes(float dt)
+{
+  // Finish a queued frame first so that its events are sent in order
+  FinishUpdate();
+  if (!mActiveNode)
+    return;
 
-    // Apply the frame if we're given anything back
-    if (mActiveNode)
-      ApplyFrame(mActiveNode->mFrameData);
+  // Update the root node
+  mActiveNode = mActiveNode->Update(this, dt, mFrameId++, mEventsToSend);
+  mUpdatePending = true;
+}
 
-    // Dispatch all events from the animation graph
+void AnimationGraph::FinishUpdate()
+{
+  if (!mUpdatePending)
+    return;
+  mUpdatePending = false;
+
+  EvaluatePoses();
+
+  // Apply the frame if we're given anything back
+  if (mActiveNode)
+    ApplyFrame(mActiveNode->mFrameData);
+  mPoseReferences.Clear();
+
+  // Dispatch all events from the animation graph. The handlers can update the
+  // graph again, which sends its own events.
+  if (!mEventsToSend.Empty())
+  {
+    Array<AnimationGraphEvent*> eventsToSend;
+    eventsToSend.Swap(mEventsToSend);
     forRange (AnimationGraphEvent* eventToSend, eventsToSend.All())
     {
       GetOwner()->DispatchEvent(eventToSend->EventId, eventToSend);
       delete eventToSend;
     }
-
-    // Send the post animation event
-    Event eventToSend;
-    GetOwner()->DispatchEvent(Events::AnimationPostUpdate, &eventToSend);
-
-    return;
   }
+
+  // Send the post animation event
+  Event eventToSend;
+  GetOwner()->DispatchEvent(Events::AnimationPostUpdate, &eventToSend);
 }
 
 void AnimationGraph::OnUpdate(UpdateEvent* e)
 {
   // Do nothing if we aren't active
-  if (!mActive)
+  if (!mActive || !mActiveNode)
     return;
 
-  Update(e->Dt);
+  UpdateNodes(e->Dt);
+  GetSpace()->mAnimationPoseUpdater.AddGraph(this);
+}
+
+void AnimationGraph::OnPreviewUpdate(UpdateEvent* e)
+{
+  // Preview updates aren't followed by the space's pose update
+  if (mActive)
+    Update(e->Dt);
+}
+
+uint AnimationGraph::GetPoseSize()
+{
+  return mPoseTransforms.Size();
+}
+
+void AnimationGraph::QueuePose(AnimationNode* node, AnimationNode* inputA, AnimationNode* inputB)
+{
+  mPoseQueue.PushBack(node);
+  mPoseReferences.PushBack(node);
+  if (inputA)
+    mPoseReferences.PushBack(inputA);
+  if (inputB)
+    mPoseReferences.PushBack(inputB);
+}
+
+void AnimationGraph::EvaluatePoses()
+{
+  forRange (AnimationNode* node, mPoseQueue.All())
+    node->EvaluatePose();
+  mPoseQueue.Clear();
 }
 
 void AnimationGraph::ApplyFrame(AnimationFrame& frame)
 {
   forRange (BlendTrack* blendTrack, mBlendTracks.Values())
   {
+    // Transforms are applied from the pose
+    if (blendTrack->PoseIndex != -1)
+      continue;
+
     ErrorIf(blendTrack->Index >= frame.Tracks.Size(), "Frame error");
     if (blendTrack->Index < frame.Tracks.Size())
     {
@@ -157,12 +215,64 @@ void AnimationGraph::ApplyFrame(AnimationFrame& frame)
     {
     }
   }
+
+  ApplyPose(frame.Pose);
+}
+
+void AnimationGraph::ApplyPose(AnimationPose& pose)
+{
+  uint count = Math::Min(pose.Size(), (uint)mPoseTransforms.Size());
+  for (uint i = 0; i < count; ++i)
+  {
+    uint channels = pose.mChannels[i];
+    if (channels == AnimationPoseChannels::None)
+      continue;
+
+    Transform* transform = mPoseTransforms[i];
+    if (transform == nullptr)
+      continue;
+
+    // Setting everything at once only sends one transform update
+    const uint allChannels =
+        AnimationPoseChannels::Translation | AnimationPoseChannels::Rotation | AnimationPoseChannels::Scale;
+    if (channels == allChannels)
+    {
+      transform->SetLocalTransform(pose.mTranslations[i], pose.mRotations[i], pose.mScales[i]);
+      continue;
+    }
+
+    if (channels & AnimationPoseChannels::Scale)
+      transform->SetLocalScale(pose.mScales[i]);
+    if (channels & AnimationPoseChannels::Rotation)
+      transform->SetLocalRotation(pose.mRotations[i]);
+    if (channels & AnimationPoseChannels::Translation)
+      transform->SetLocalTranslation(pose.mTranslations[i]);
+  }
+}
+
+void AnimationGraph::UpdatePoseTransforms()
+{
+  mPoseTransforms.Clear();
+  forRange (BlendTrack* blendTrack, mBlendTracks.Values())
+  {
+    if (blendTrack->PoseIndex == -1)
+      continue;
+
+    uint index = (uint)blendTrack->PoseIndex;
+    if (index >= mPoseTransforms.Size())
+      mPoseTransforms.Resize(index + 1);
+    mPoseTransforms[index] = blendTrack->Object.Get<Transform*>();
+  }
 }
 
 void AnimationGraph::OnMetaModified(MetaLibraryEvent* e)
 {
+  // Queued poses still read the blend tracks
+  EvaluatePoses();
+
   // The blend tracks store pointers to MetaProperties, and must be deleted
   DeleteObjectsInContainer(mBlendTracks);
+  mPoseTransforms.Clear();
 
   // Re-link all active animations
   if (AnimationNode* root = mActiveNode)
@@ -178,15 +288,15 @@ void AnimationGraph::ForceUpdate()
 {
   if (mActiveNode)
   {
-    AnimationFrame frame;
-
-    // Static so we can re-use memory and avoid extra allocations
-    static Array<AnimationGraphEvent*> eventsToSend;
-    eventsToSend.Clear();
+    UpdateNodes(0.0f);
+    mUpdatePending = false;
 
-    mActiveNode = mActiveNode->Update(this, 0.0f, mFrameId++, eventsToSend);
+    // Forced updates don't send any events
+    EvaluatePoses();
     if (mActiveNode)
       ApplyFrame(mActiveNode->mFrameData);
+    mPoseReferences.Clear();
+    DeleteObjectsInContainer(mEventsToSend);
   }
 }
 
@@ -267,6 +377,8 @@ void AnimationGraph::SetUpPlayData(Animation* animation, PlayData& playData)
       DebugPrint("Failed to find object in animation track. %s\n", track.GetFullPath().c_str());
     }
   }
+
+  UpdatePoseTransforms();
 }
 
 void AnimationGraph::PreviewGraph()
@@ -277,7 +389,7 @@ void AnimationGraph::PreviewGraph()
 
 void AnimationGraph::SetPreviewMode()
 {
-  ConnectThisTo(GetSpace(), Events::PreviewUpdate, OnUpdate);
+  ConnectThisTo(GetSpace(), Events::PreviewUpdate, OnPreviewUpdate);
 }
 
 bool AnimationGraph::IsPlayingInGraph(Animation* animation)
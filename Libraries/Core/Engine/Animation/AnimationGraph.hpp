@@ -56,6 +56,20 @@ public:
   /// The master List.
   BlendTracks mBlendTracks;
 
+  /// How many Transforms the graph's poses hold.
+  uint GetPoseSize();
+  /// Adds a node whose pose is evaluated once every node has updated. The
+  /// nodes it reads poses from are kept alive until then.
+  void QueuePose(AnimationNode* node, AnimationNode* inputA = nullptr, AnimationNode* inputB = nullptr);
+  /// Evaluates the poses of the queued nodes in order. Only reads the
+  /// animations and the nodes' poses, so it can be called from another thread.
+  void EvaluatePoses();
+  /// Applies the frame from the last update of the nodes and sends its events.
+  void FinishUpdate();
+
+  /// Whether the nodes have updated but the frame hasn't been applied yet.
+  bool mUpdatePending;
+
   /// Editor preview functionality.
   void PreviewGraph();
   typedef void (*DebugPreviewFunction)(AnimationGraph*);
@@ -71,8 +85,17 @@ private:
 
   /// Updates the root node on each from and applies it to the object tree.
   void Update(float dt);
+  /// Updates the root node, leaving the frame to be applied by FinishUpdate.
+  void UpdateNodes(float dt);
+  /// Queues the frame on the space so that the poses of every graph are
+  /// evaluated together.
   void OnUpdate(UpdateEvent* e);
+  void OnPreviewUpdate(UpdateEvent* e);
   void ApplyFrame(AnimationFrame& frame);
+  /// Writes each animated Transform once.
+  void ApplyPose(AnimationPose& pose);
+  /// Finds the Transform of each index in the pose.
+  void UpdatePoseTransforms();
 
   /// We need to re-link all objects whenever the meta database has been
   /// modified. This should only ever happen if this object is in the editor.
@@ -90,6 +113,16 @@ private:
   /// The current root animation node.
   HandleOf<AnimationNode> mActiveNode;
 
+  /// Sent when the frame is applied.
+  Array<AnimationGraphEvent*> mEventsToSend;
+
+  /// Nodes waiting for their poses to be evaluated.
+  Array<AnimationNode*> mPoseQueue;
+  /// Keeps the queued nodes alive until the frame is applied.
+  Array<HandleOf<AnimationNode>> mPoseReferences;
+  /// The Transform at each index in the pose.
+  Array<HandleOf<Transform>> mPoseTransforms;
+
   /// Still around for updater's.
   AnimationPlayMode::Enum mPlayMode;
   HandleOf<Animation> mAnimation;
@@ -81,6 +81,13 @@ void AnimationNode::CollapseToPose()
   mCollapseToPose = true;
 }
 
+AnimationNode* AnimationNode::CreatePoseNode(AnimationGraph* animGraph)
+{
+  // The pose node copies the frame, so it has to be up to date
+  animGraph->EvaluatePoses();
+  return new PoseNode(mFrameData);
+}
+
 void AnimationNode::SetDuration(float duration)
 {
   mDuration = duration;
@@ -131,6 +138,7 @@ ZilchDefineType(PoseNode, builder, type)
 PoseNode::PoseNode(AnimationFrame& pose)
 {
   mFrameData.Tracks.Assign(pose.Tracks.All());
+  mFrameData.Pose = pose.Pose;
 }
 
 AnimationNode* PoseNode::Update(AnimationGraph* animGraph, float dt, uint frameId, EventList eventsToSend)
@@ -155,6 +163,8 @@ BasicAnimation::BasicAnimation()
   mDirection = 1.0f;
   mPlayMode = AnimationPlayMode::PlayOnce;
   mLoopCount = 0;
+  mPoseAnimation = nullptr;
+  mPoseTime = 0.0f;
 }
 
 BasicAnimation::BasicAnimation(AnimationGraph* animGraph)
@@ -163,6 +173,8 @@ BasicAnimation::BasicAnimation(AnimationGraph* animGraph)
   mPlayMode = AnimationPlayMode::PlayOnce;
   mLoopCount = 0;
   mAnimGraph = animGraph;
+  mPoseAnimation = nullptr;
+  mPoseTime = 0.0f;
 }
 
 BasicAnimation::BasicAnimation(AnimationGraph* animGraph,
@@ -175,11 +187,17 @@ BasicAnimation::BasicAnimation(AnimationGraph* animGraph,
   mPlayMode = playMode;
   mLoopCount = 0;
   mAnimGraph = animGraph;
+  mPoseAnimation = nullptr;
+  mPoseTime = 0.0f;
   SetAnimation(animation);
 }
 
 void BasicAnimation::ReLinkAnimations()
 {
+  // A queued pose still reads the play data
+  if (AnimationGraph* animGraph = mAnimGraph)
+    animGraph->EvaluatePoses();
+
   mPlayData.Clear();
   mDuration = 0.0f;
   if (mAnimation)
@@ -202,7 +220,7 @@ AnimationNode* BasicAnimation::Update(AnimationGraph* animGraph, float dt, uint
     // the animation. Otherwise, we're just using last frames data
     if (HasUpdatedAtLeastOnce())
       UpdateFrame(animGraph);
-    return new PoseNode(mFrameData);
+    return CreatePoseNode(animGraph);
   }
 
   // Update the frame id
@@ -236,7 +254,7 @@ AnimationNode* BasicAnimation::Update(AnimationGraph* animGraph, float dt, uint
         // Update the frame before collapsing
         UpdateFrame(animGraph);
 
-        return new PoseNode(mFrameData);
+        return CreatePoseNode(animGraph);
       }
       else
         return nullptr;
@@ -281,6 +299,18 @@ void BasicAnimation::UpdateFrame(AnimationGraph* animGraph)
 
   mFrameData.Tracks.Resize(animGraph->mBlendTracks.Size());
   mAnimation->UpdateFrame(mPlayData, params, mFrameData);
+
+  // Transforms are sampled later along with the rest of the graph's pose
+  mFrameData.Pose.Resize(animGraph->GetPoseSize());
+  mPoseAnimation = mAnimation;
+  mPoseTime = mTime;
+  animGraph->QueuePose(this);
+}
+
+void BasicAnimation::EvaluatePose()
+{
+  if (mPoseAnimation)
+    mPoseAnimation->UpdatePose(mPlayData, mPoseTime, mFrameData.Pose);
 }
 
 AnimationNode* BasicAnimation::Clone()
@@ -364,7 +394,7 @@ AnimationNode* DirectBlend::Update(AnimationGraph* animGraph, float dt, uint fra
     // Use the last frames data for the pose. If we haven't been updated yet,
     // we need to update with a dt of 0.0, then create the pose node
     if (HasUpdatedAtLeastOnce())
-      return new PoseNode(mFrameData);
+      return CreatePoseNode(animGraph);
 
     // If we're collapsing to pose, we want to pull all animation data without
     // stepping forward in time
@@ -400,14 +430,20 @@ AnimationNode* DirectBlend::Update(AnimationGraph* animGraph, float dt, uint fra
 
   // Interpolate between the two branches
   LerpFrame(mA->mFrameData, mB->mFrameData, t, mFrameData);
+  QueuePose(animGraph, t);
 
   // Now that we've updated our frame data, we can create the pose node
   if (mCollapseToPose)
-    return new PoseNode(mFrameData);
+    return CreatePoseNode(animGraph);
 
   return this;
 }
 
+void DirectBlend::EvaluatePose()
+{
+  LerpPose(*mPoseA, *mPoseB, mPoseT, mFrameData.Pose);
+}
+
 void DirectBlend::PrintNode(uint tabs)
 {
   PrintTabs(tabs);
@@ -464,7 +500,7 @@ AnimationNode* CrossBlend::Update(AnimationGraph* animGraph, float dt, uint fram
     // Use the last frames data for the pose. If we haven't been updated yet,
     // we need to update with a dt of 0.0, then create the pose node
     if (HasUpdatedAtLeastOnce())
-      return new PoseNode(mFrameData);
+      return CreatePoseNode(animGraph);
 
     // If we're collapsing to pose, we want to pull all animation data without
     // stepping forward in time
@@ -531,14 +567,20 @@ AnimationNode* CrossBlend::Update(AnimationGraph* animGraph, float dt, uint fram
 
   // Interpolate between the two branches
   LerpFrame(mA->mFrameData, mB->mFrameData, blendT, mFrameData);
+  QueuePose(animGraph, blendT);
 
   // Now that we've updated our frame data, we can create the pose node
   if (mCollapseToPose)
-    return new PoseNode(mFrameData);
+    return CreatePoseNode(animGraph);
 
   return this;
 }
 
+void CrossBlend::EvaluatePose()
+{
+  LerpPose(*mPoseA, *mPoseB, mPoseT, mFrameData.Pose);
+}
+
 void CrossBlend::PrintNode(uint tabs)
 {
   PrintTabs(tabs);
@@ -636,7 +678,7 @@ AnimationNode* SelectiveNode::Update(AnimationGraph* animGraph, float dt, uint f
     // Use the last frames data for the pose. If we haven't been updated yet,
     // we need to update with a dt of 0.0, then create the pose node
     if (HasUpdatedAtLeastOnce())
-      return new PoseNode(mFrameData);
+      return CreatePoseNode(animGraph);
 
     // If we're collapsing to pose, we want to pull all animation data without
     // stepping forward in time
@@ -678,13 +720,21 @@ AnimationNode* SelectiveNode::Update(AnimationGraph* animGraph, float dt, uint f
     }
   }
 
+  UpdateSelectedPose(animGraph);
+  QueuePose(animGraph, 0.0f);
+
   // Now that we've updated our frame data, we can create the pose node
   if (mCollapseToPose)
-    return new PoseNode(mFrameData);
+    return CreatePoseNode(animGraph);
 
   return this;
 }
 
+void SelectiveNode::EvaluatePose()
+{
+  SelectPose(mPoseA, *mPoseB, mSelectedPose, mFrameData.Pose);
+}
+
 AnimationNode* SelectiveNode::Clone()
 {
   SelectiveNode* clone = new SelectiveNode();
@@ -742,6 +792,22 @@ void SelectiveNode::SetRoot(Cog* root)
   mRoot = root;
   AnimationGraph* animGraph = GetAnimationGraph(root);
   GetChildIndices(root, animGraph, mSelectiveBones);
+  mSelectedPose.Clear();
+}
+
+void SelectiveNode::UpdateSelectedPose(AnimationGraph* animGraph)
+{
+  uint poseSize = animGraph->GetPoseSize();
+  if (mSelectedPose.Size() == poseSize)
+    return;
+
+  mSelectedPose.Clear();
+  mSelectedPose.Resize(poseSize, false);
+  forRange (BlendTrack* track, animGraph->mBlendTracks.Values())
+  {
+    if (track->PoseIndex != -1 && mSelectiveBones.Contains(track->Index))
+      mSelectedPose[track->PoseIndex] = true;
+  }
 }
 
 Cog* SelectiveNode::GetRoot()
@@ -788,7 +854,7 @@ AnimationNode* ChainNode::Update(AnimationGraph* animGraph, float dt, uint frame
     // Use the last frames data for the pose. If we haven't been updated yet,
     // we need to update with a dt of 0.0, then create the pose node
     if (HasUpdatedAtLeastOnce())
-      return new PoseNode(mFrameData);
+      return CreatePoseNode(animGraph);
 
     // If we're collapsing to pose, we want to pull all animation data without
     // stepping forward in time
@@ -812,14 +878,20 @@ AnimationNode* ChainNode::Update(AnimationGraph* animGraph, float dt, uint frame
 
   // Copy over tracks from the current child. This should be optimized
   mFrameData.Tracks.Assign(mA->mFrameData.Tracks.All());
+  QueuePose(animGraph, 0.0f);
 
   // Now that we've updated our frame data, we can create the pose node
   if (mCollapseToPose)
-    return new PoseNode(mFrameData);
+    return CreatePoseNode(animGraph);
 
   return this;
 }
 
+void ChainNode::EvaluatePose()
+{
+  mFrameData.Pose = *mPoseA;
+}
+
 bool ChainNode::IsPlayingInNode(StringParam animName)
 {
   return mA->IsPlayingInNode(animName) || mB->IsPlayingInNode(animName);
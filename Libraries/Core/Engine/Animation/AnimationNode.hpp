@@ -33,6 +33,11 @@ struct BlendTrack
   uint Index;
   Property* Property;
   Handle Object;
+  /// Index of the animated Transform in the AnimationPose, or -1 if the
+  /// property is set through meta.
+  int PoseIndex;
+  /// The AnimationPoseChannels the property is stored in.
+  uint PoseChannel;
 };
 
 typedef HashMap<String, BlendTrack*> BlendTracks;
@@ -79,6 +84,8 @@ struct AnimationFrameData
 struct AnimationFrame
 {
   Array<AnimationFrameData> Tracks;
+  /// The values of the tracks that animate Transforms.
+  AnimationPose Pose;
 };
 
 typedef Array<ObjectTrackPlayData> PlayData;
@@ -105,6 +112,11 @@ public:
   }
 
   virtual AnimationNode* Update(AnimationGraph* animGraph, float dt, uint frameId, EventList eventsToSend) = 0;
+  /// Computes the pose from what the last Update queued on the graph. Called
+  /// after every node has updated, possibly on another thread.
+  virtual void EvaluatePose()
+  {
+  }
   virtual AnimationNode* Clone()
   {
     return NULL;
@@ -122,6 +134,9 @@ public:
 
   /// Collapses all children to a pose node on the next Update.
   void CollapseToPose();
+  /// Creates a pose node from the current frame, evaluating any of the graph's
+  /// queued poses first.
+  AnimationNode* CreatePoseNode(AnimationGraph* animGraph);
 
   /// The duration of the node.
   void SetDuration(float duration);
@@ -199,6 +214,7 @@ public:
   /// AnimationNode Interface.
   void ReLinkAnimations() override;
   AnimationNode* Update(AnimationGraph* animGraph, float dt, uint frameId, EventList eventsToSend) override;
+  void EvaluatePose() override;
   void UpdateFrame(AnimationGraph* animGraph);
   AnimationNode* Clone() override;
   bool IsPlayingInNode(StringParam animName) override;
@@ -226,6 +242,10 @@ protected:
   float mDirection;
 
   PlayData mPlayData;
+
+  /// The animation and time to sample the pose at, set when it's queued.
+  Animation* mPoseAnimation;
+  float mPoseTime;
 };
 
 /// This node is an interface for animation nodes that deal with
@@ -249,6 +269,9 @@ public:
   AnimationNode* CollapseToB(AnimationGraph* animGraph, uint frameId, EventList eventsToSend);
   bool IsPlayingInNode(StringParam animName) override;
 
+  /// Queues this node's pose to be evaluated from the current children's poses.
+  void QueuePose(AnimationGraph* animGraph, float t);
+
   /// Left node.
   void SetFrom(AnimationNode* node);
   AnimationNode* GetFrom();
@@ -262,6 +285,11 @@ public:
   HandleOf<AnimationNode> mLastReturned;
   HandleOf<AnimationNode> mA;
   HandleOf<AnimationNode> mB;
+
+  /// The children's poses and the blend value, set when the pose is queued.
+  AnimationPose* mPoseA;
+  AnimationPose* mPoseB;
+  float mPoseT;
 };
 
 /// Blends directly between the two animations (the animations do not continue
@@ -277,6 +305,7 @@ public:
   /// AnimationNode Interface.
   String GetName() override;
   AnimationNode* Update(AnimationGraph* animGraph, float dt, uint frameId, EventList eventsToSend) override;
+  void EvaluatePose() override;
   void PrintNode(uint tabs) override;
 };
 
@@ -308,6 +337,7 @@ public:
   /// AnimationNode Interface.
   String GetName() override;
   AnimationNode* Update(AnimationGraph* animGraph, float dt, uint frameId, EventList eventsToSend) override;
+  void EvaluatePose() override;
   void PrintNode(uint tabs) override;
 
   /// Updates the time of the 'To' animation to sync the cadence with the
@@ -340,14 +370,21 @@ public:
   /// AnimationNode Interface.
   String GetName() override;
   AnimationNode* Update(AnimationGraph* animGraph, float dt, uint frameId, EventList eventsToSend) override;
+  void EvaluatePose() override;
   AnimationNode* Clone() override;
   void PrintNode(uint tabs) override;
 
   void SetRoot(Cog* root);
   Cog* GetRoot();
 
+  /// Finds the pose transforms of the selected blend tracks whenever the
+  /// graph's pose layout changes.
+  void UpdateSelectedPose(AnimationGraph* animGraph);
+
   CogId mRoot;
   HashSet<uint> mSelectiveBones;
+  /// Whether each transform in the pose is taken from 'B'.
+  Array<bool> mSelectedPose;
 };
 
 class ChainNode : public DualBlend<ChainNode>
@@ -360,6 +397,7 @@ public:
 
   String GetName() override;
   AnimationNode* Update(AnimationGraph* animGraph, float dt, uint frameId, EventList eventsToSend) override;
+  void EvaluatePose() override;
   bool IsPlayingInNode(StringParam animName) override;
   void PrintNode(uint tabs) override;
 };
@@ -15,6 +15,9 @@ template <typename DerivedType>
 DualBlend<DerivedType>::DualBlend()
 {
   mDuration = 1.0f;
+  mPoseA = nullptr;
+  mPoseB = nullptr;
+  mPoseT = 0.0f;
 }
 
 template <typename DerivedType>
@@ -74,6 +77,17 @@ bool DualBlend<DerivedType>::IsPlayingInNode(StringParam animName)
   return mA->IsPlayingInNode(animName) || mB->IsPlayingInNode(animName);
 }
 
+template <typename DerivedType>
+void DualBlend<DerivedType>::QueuePose(AnimationGraph* animGraph, float t)
+{
+  AnimationNode* a = mA;
+  AnimationNode* b = mB;
+  mPoseA = a ? &a->mFrameData.Pose : nullptr;
+  mPoseB = b ? &b->mFrameData.Pose : nullptr;
+  mPoseT = t;
+  animGraph->QueuePose(this, a, b);
+}
+
 template <typename DerivedType>
 void DualBlend<DerivedType>::SetFrom(AnimationNode* node)
 {
@@ -0,0 +1,182 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+// Below this many graphs it's faster to evaluate everything on the main thread
+// than to wake up the workers.
+const size_t cAnimationGraphsPerJob = 16;
+
+// Animation Pose
+void AnimationPose::Resize(uint transformCount)
+{
+  mTranslations.Resize(transformCount);
+  mRotations.Resize(transformCount);
+  mScales.Resize(transformCount);
+  mChannels.Resize(transformCount, AnimationPoseChannels::None);
+}
+
+uint AnimationPose::Size() const
+{
+  return mChannels.Size();
+}
+
+void AnimationPose::SetValue(uint index, uint channel, Vec3Param value)
+{
+  mChannels[index] |= channel;
+  if (channel == AnimationPoseChannels::Scale)
+    mScales[index] = value;
+  else
+    mTranslations[index] = value;
+}
+
+void AnimationPose::SetValue(uint index, uint channel, QuatParam value)
+{
+  mChannels[index] |= channel;
+  mRotations[index] = value;
+}
+
+void LerpPose(const AnimationPose& a, const AnimationPose& b, float t, AnimationPose& result)
+{
+  uint count = Math::Min(a.Size(), b.Size());
+  result.Resize(count);
+
+  for (uint i = 0; i < count; ++i)
+  {
+    uint channelsA = a.mChannels[i];
+    uint channelsB = b.mChannels[i];
+    uint blended = channelsA & channelsB;
+    result.mChannels[i] = channelsA | channelsB;
+
+    if (blended & AnimationPoseChannels::Translation)
+      result.mTranslations[i] = Math::Lerp(a.mTranslations[i], b.mTranslations[i], t);
+    else if (channelsA & AnimationPoseChannels::Translation)
+      result.mTranslations[i] = a.mTranslations[i];
+    else
+      result.mTranslations[i] = b.mTranslations[i];
+
+    if (blended & AnimationPoseChannels::Rotation)
+      result.mRotations[i] = Quat::SlerpUnnormalized(a.mRotations[i], b.mRotations[i], t);
+    else if (channelsA & AnimationPoseChannels::Rotation)
+      result.mRotations[i] = a.mRotations[i];
+    else
+      result.mRotations[i] = b.mRotations[i];
+
+    if (blended & AnimationPoseChannels::Scale)
+      result.mScales[i] = Math::Lerp(a.mScales[i], b.mScales[i], t);
+    else if (channelsA & AnimationPoseChannels::Scale)
+      result.mScales[i] = a.mScales[i];
+    else
+      result.mScales[i] = b.mScales[i];
+  }
+}
+
+void SelectPose(const AnimationPose* a, const AnimationPose& b, const Array<bool>& selected, AnimationPose& result)
+{
+  uint count = Math::Min(b.Size(), (uint)selected.Size());
+  if (a != nullptr)
+    count = Math::Min(count, a->Size());
+  result.Resize(count);
+
+  for (uint i = 0; i < count; ++i)
+  {
+    const AnimationPose* source = selected[i] ? &b : a;
+    if (source == nullptr)
+      continue;
+
+    result.mTranslations[i] = source->mTranslations[i];
+    result.mRotations[i] = source->mRotations[i];
+    result.mScales[i] = source->mScales[i];
+    result.mChannels[i] = source->mChannels[i];
+  }
+}
+
+// Animation Pose Job
+class AnimationPoseJob : public Job
+{
+public:
+  void Execute() override
+  {
+    for (size_t i = mBegin; i < mEnd; ++i)
+      (*mGraphs)[i]->EvaluatePoses();
+
+    mCountdownEvent->DecrementCount();
+  }
+
+  Array<AnimationGraph*>* mGraphs;
+  size_t mBegin;
+  size_t mEnd;
+  CountdownEvent* mCountdownEvent;
+};
+
+// Animation Pose Updater
+void AnimationPoseUpdater::AddGraph(AnimationGraph* graph)
+{
+  mGraphs.PushBack(graph->GetOwner());
+}
+
+void AnimationPoseUpdater::Update()
+{
+  if (mGraphs.Empty())
+    return;
+
+  // Graphs added while the events below are sent are finished next frame
+  Array<CogId> graphIds;
+  graphIds.Swap(mGraphs);
+
+  mPending.Clear();
+  forRange (CogId& id, graphIds.All())
+  {
+    Cog* cog = id.ToCog();
+    if (cog == nullptr)
+      continue;
+
+    // The graph may have already been finished by a direct call to Update
+    AnimationGraph* graph = cog->has(AnimationGraph);
+    if (graph != nullptr && graph->mUpdatePending)
+      mPending.PushBack(graph);
+  }
+
+  if (mPending.Size() < cAnimationGraphsPerJob)
+  {
+    forRange (AnimationGraph* graph, mPending.All())
+      graph->EvaluatePoses();
+  }
+  else
+  {
+    CountdownEvent countdownEvent;
+    for (size_t begin = 0; begin < mPending.Size(); begin += cAnimationGraphsPerJob)
+    {
+      countdownEvent.IncrementCount();
+
+      AnimationPoseJob* job = new AnimationPoseJob();
+      job->mGraphs = &mPending;
+      job->mBegin = begin;
+      job->mEnd = Math::Min(begin + cAnimationGraphsPerJob, mPending.Size());
+      job->mCountdownEvent = &countdownEvent;
+      job->mRunImmediateWhenThreadingDisabled = true;
+      Z::gJobs->AddJob(job);
+    }
+
+    // The jobs only write to the graphs' nodes, but those can't change until
+    // they're done
+    countdownEvent.Wait();
+  }
+  mPending.Clear();
+
+  // Applying the poses sends transform updates and events, so it's done on the
+  // main thread. The graphs are looked up again since the events can destroy
+  // them.
+  forRange (CogId& id, graphIds.All())
+  {
+    Cog* cog = id.ToCog();
+    if (cog == nullptr)
+      continue;
+
+    if (AnimationGraph* graph = cog->has(AnimationGraph))
+      graph->FinishUpdate();
+  }
+}
+
+} // namespace Zero
@@ -0,0 +1,66 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+class AnimationGraph;
+
+/// Which of a Transform's properties an animation pose holds.
+DeclareBitField3(AnimationPoseChannels, Translation, Rotation, Scale);
+
+// Animation Pose
+/// The local transforms of every Transform that an AnimationGraph animates.
+/// Each channel is stored in its own array so that sampling and blending run
+/// over contiguous memory instead of through the meta properties.
+class AnimationPose
+{
+public:
+  /// Grows or shrinks the pose. Added transforms have no channels set.
+  void Resize(uint transformCount);
+  uint Size() const;
+
+  void SetValue(uint index, uint channel, Vec3Param value);
+  void SetValue(uint index, uint channel, QuatParam value);
+  /// Only Vec3 and Quat properties are stored in the pose.
+  template <typename T>
+  void SetValue(uint index, uint channel, const T& value)
+  {
+  }
+
+  Array<Vec3> mTranslations;
+  Array<Quat> mRotations;
+  Array<Vec3> mScales;
+  /// The AnimationPoseChannels that have been written for each transform.
+  Array<uint> mChannels;
+};
+
+/// Blends the channels set in both poses. Channels set in only one of them
+/// are copied from that one.
+void LerpPose(const AnimationPose& a, const AnimationPose& b, float t, AnimationPose& result);
+
+/// Takes the transforms at the selected indices from 'b' and the rest from
+/// 'a' ('a' may be null).
+void SelectPose(const AnimationPose* a, const AnimationPose& b, const Array<bool>& selected, AnimationPose& result);
+
+// Animation Pose Updater
+/// Evaluates the poses of every AnimationGraph in a space that updated this
+/// frame on the job system, then applies them to the Transforms and sends the
+/// graphs' events on the main thread.
+class AnimationPoseUpdater
+{
+public:
+  /// Called by a graph once its nodes have updated for the frame.
+  void AddGraph(AnimationGraph* graph);
+
+  /// Finishes the update of every graph added since the last call.
+  void Update();
+
+private:
+  /// Stored as ids since the objects can be destroyed before the update.
+  Array<CogId> mGraphs;
+  /// Kept between frames to avoid re-allocating.
+  Array<AnimationGraph*> mPending;
+};
+
+} // namespace Zero
@@ -0,0 +1,517 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+namespace
+{
+
+const float cMaxQuantized = 65535.0f;
+// One bit of each rotation component is used for the index of the dropped one
+const float cMaxQuantizedComponent = 32767.0f;
+// Every component but the largest of a unit quaternion is within this range
+const float cSmallestThreeRange = 0.70710678f;
+
+u16 Quantize(float value, float min, float extent)
+{
+  if (extent <= 0.0f)
+    return 0;
+
+  float normalized = Math::Clamp((value - min) / extent, 0.0f, 1.0f);
+  return (u16)(normalized * cMaxQuantized + 0.5f);
+}
+
+float Dequantize(u16 value, float min, float extent)
+{
+  return min + extent * (value / cMaxQuantized);
+}
+
+void PackQuat(QuatParam rotation, u16* packed)
+{
+  Quat quat = Math::Normalized(rotation);
+
+  uint largest = 0;
+  for (uint i = 1; i < 4; ++i)
+  {
+    if (Math::Abs(quat[i]) > Math::Abs(quat[largest]))
+      largest = i;
+  }
+
+  // Both signs are the same rotation, so flip it to make the dropped
+  // component positive
+  if (quat[largest] < 0.0f)
+    quat = -quat;
+
+  uint component = 0;
+  for (uint i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+
+    float normalized = Math::Clamp(quat[i] / cSmallestThreeRange * 0.5f + 0.5f, 0.0f, 1.0f);
+    packed[component] = (u16)(normalized * cMaxQuantizedComponent + 0.5f);
+    ++component;
+  }
+
+  packed[0] |= (largest >> 1) << 15;
+  packed[1] |= (largest & 1) << 15;
+}
+
+Quat UnpackQuat(const u16* packed)
+{
+  uint largest = ((packed[0] >> 15) << 1) | (packed[1] >> 15);
+
+  Quat quat;
+  float lengthSq = 0.0f;
+  uint component = 0;
+  for (uint i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+
+    float normalized = (packed[component] & 0x7FFF) / cMaxQuantizedComponent;
+    quat[i] = (normalized * 2.0f - 1.0f) * cSmallestThreeRange;
+    lengthSq += quat[i] * quat[i];
+    ++component;
+  }
+
+  quat[largest] = Math::Sqrt(Math::Max(1.0f - lengthSq, 0.0f));
+  return quat;
+}
+
+Vec3 InterpolateKey(Vec3Param a, Vec3Param b, float t)
+{
+  return Math::Lerp(a, b, t);
+}
+
+Quat InterpolateKey(QuatParam a, QuatParam b, float t)
+{
+  return Quat::SlerpUnnormalized(a, b, t);
+}
+
+float GetKeyError(Vec3Param a, Vec3Param b)
+{
+  return Math::Length(a - b);
+}
+
+float GetKeyError(QuatParam a, QuatParam b)
+{
+  return Math::AngleBetween(Math::Normalized(a), Math::Normalized(b));
+}
+
+// Whether every key between start and end is within the tolerance of the
+// line between them
+template <typename T>
+bool CanRemoveKeys(const Array<float>& times, const Array<T>& values, uint start, uint end, float tolerance)
+{
+  float duration = times[end] - times[start];
+  for (uint i = start + 1; i < end; ++i)
+  {
+    float t = 0.0f;
+    if (duration > 0.0f)
+      t = (times[i] - times[start]) / duration;
+
+    if (GetKeyError(InterpolateKey(values[start], values[end], t), values[i]) > tolerance)
+      return false;
+  }
+  return true;
+}
+
+// Returns the indices of the keys to keep
+template <typename T>
+void ReduceKeys(const Array<float>& times, const Array<T>& values, float tolerance, Array<uint>& keys)
+{
+  uint count = times.Size();
+  if (count == 0)
+    return;
+
+  // Greedily extend each interval until the keys inside of it can't be removed
+  keys.PushBack(0);
+  uint start = 0;
+  while (start + 1 < count)
+  {
+    uint end = start + 1;
+    while (end + 1 < count && CanRemoveKeys(times, values, start, end + 1, tolerance))
+      ++end;
+
+    keys.PushBack(end);
+    start = end;
+  }
+
+  // A track that doesn't move only needs its first key
+  if (keys.Size() != 2)
+    return;
+  for (uint i = 1; i < count; ++i)
+  {
+    if (GetKeyError(values[0], values[i]) > tolerance)
+      return;
+  }
+  keys.PopBack();
+}
+
+uint GetCompressedChannel(PropertyTrack* track)
+{
+  if (track->Name == "Transform.Translation" && track->TypeId == ZilchTypeId(Vec3))
+    return AnimationPoseChannels::Translation;
+  if (track->Name == "Transform.Rotation" && track->TypeId == ZilchTypeId(Quat))
+    return AnimationPoseChannels::Rotation;
+  if (track->Name == "Transform.Scale" && track->TypeId == ZilchTypeId(Vec3))
+    return AnimationPoseChannels::Scale;
+  return AnimationPoseChannels::None;
+}
+
+template <typename T>
+PropertyTrack* CompressTrack(PropertyTrack* track, uint channel, float tolerance, AnimationCompressionReport& report)
+{
+  track->ResortKeyFrames();
+
+  Array<float> times;
+  Array<Any> keyValues;
+  track->GetKeyTimes(times);
+  track->GetKeyValues(keyValues);
+
+  Array<T> values;
+  values.Reserve(keyValues.Size());
+  forRange (Any& value, keyValues.All())
+    values.PushBack(value.Get<T>());
+
+  StringTokenRange names(track->Name, '.');
+  String componentName = names.Front();
+  names.PopFront();
+  String propertyName = names.Front();
+
+  CompressedPropertyTrack<T>* compressedTrack = new CompressedPropertyTrack<T>(componentName, propertyName);
+  CompressedCurve& curve = compressedTrack->mCurve;
+  curve.Compress(times, values, tolerance);
+
+  report.AddCurve(channel, times.Size(), sizeof(float) + sizeof(T), curve, curve.GetMaxError(times, values));
+  return compressedTrack;
+}
+
+} // namespace
+
+// Animation Compression Settings
+AnimationCompressionSettings::AnimationCompressionSettings() :
+    mTranslationTolerance(0.001f),
+    mRotationTolerance(0.001f),
+    mScaleTolerance(0.001f)
+{
+}
+
+// Animation Compression Report
+AnimationCompressionReport::AnimationCompressionReport() :
+    mOriginalKeys(0),
+    mCompressedKeys(0),
+    mOriginalBytes(0),
+    mCompressedBytes(0),
+    mMaxTranslationError(0.0f),
+    mMaxRotationError(0.0f),
+    mMaxScaleError(0.0f)
+{
+}
+
+void AnimationCompressionReport::AddCurve(
+    uint channel, uint originalKeys, uint originalKeySize, const CompressedCurve& curve, float error)
+{
+  mOriginalKeys += originalKeys;
+  mCompressedKeys += curve.GetKeyCount();
+  mOriginalBytes += originalKeys * originalKeySize;
+  mCompressedBytes += curve.GetMemorySize();
+
+  if (channel == AnimationPoseChannels::Translation)
+    mMaxTranslationError = Math::Max(mMaxTranslationError, error);
+  else if (channel == AnimationPoseChannels::Rotation)
+    mMaxRotationError = Math::Max(mMaxRotationError, error);
+  else if (channel == AnimationPoseChannels::Scale)
+    mMaxScaleError = Math::Max(mMaxScaleError, error);
+}
+
+void AnimationCompressionReport::Print(StringParam animationName)
+{
+  ZPrint("Compressed animation '%s' from %u keys (%u bytes) to %u keys (%u bytes). Max error: translation %g, "
+         "rotation %g radians, scale %g\n",
+         animationName.c_str(),
+         mOriginalKeys,
+         mOriginalBytes,
+         mCompressedKeys,
+         mCompressedBytes,
+         mMaxTranslationError,
+         mMaxRotationError,
+         mMaxScaleError);
+}
+
+// Compressed Curve
+CompressedCurve::CompressedCurve() : mMin(Vec3::cZero), mExtent(Vec3::cZero)
+{
+}
+
+void CompressedCurve::Compress(const Array<float>& times, const Array<Vec3>& values, float tolerance)
+{
+  Array<uint> keys;
+  ReduceKeys(times, values, tolerance, keys);
+
+  mMin = Vec3::cZero;
+  Vec3 max = Vec3::cZero;
+  if (!keys.Empty())
+  {
+    mMin = max = values[keys.Front()];
+    forRange (uint key, keys.All())
+    {
+      mMin = Math::Min(mMin, values[key]);
+      max = Math::Max(max, values[key]);
+    }
+  }
+  mExtent = max - mMin;
+
+  mTimes.Resize(keys.Size());
+  mValues.Resize(keys.Size() * 3);
+  for (uint i = 0; i < keys.Size(); ++i)
+  {
+    Vec3Param value = values[keys[i]];
+    mTimes[i] = times[keys[i]];
+    for (uint axis = 0; axis < 3; ++axis)
+      mValues[i * 3 + axis] = Quantize(value[axis], mMin[axis], mExtent[axis]);
+  }
+
+  BuildSegments();
+}
+
+void CompressedCurve::Compress(const Array<float>& times, const Array<Quat>& values, float tolerance)
+{
+  Array<uint> keys;
+  ReduceKeys(times, values, tolerance, keys);
+
+  mMin = Vec3::cZero;
+  mExtent = Vec3::cZero;
+  mTimes.Resize(keys.Size());
+  mValues.Resize(keys.Size() * 3);
+  for (uint i = 0; i < keys.Size(); ++i)
+  {
+    mTimes[i] = times[keys[i]];
+    PackQuat(values[keys[i]], &mValues[i * 3]);
+  }
+
+  BuildSegments();
+}
+
+void CompressedCurve::Sample(float time, uint& cursor, Vec3& result) const
+{
+  float t;
+  uint key = GetInterval(time, cursor, t);
+  GetKeyValue(key, result);
+
+  if (t > 0.0f)
+  {
+    Vec3 next;
+    GetKeyValue(key + 1, next);
+    result = InterpolateKey(result, next, t);
+  }
+}
+
+void CompressedCurve::Sample(float time, uint& cursor, Quat& result) const
+{
+  float t;
+  uint key = GetInterval(time, cursor, t);
+  GetKeyValue(key, result);
+
+  if (t > 0.0f)
+  {
+    Quat next;
+    GetKeyValue(key + 1, next);
+    result = InterpolateKey(result, next, t);
+  }
+}
+
+uint CompressedCurve::GetKeyCount() const
+{
+  return mTimes.Size();
+}
+
+float CompressedCurve::GetKeyTime(uint index) const
+{
+  return mTimes[index];
+}
+
+void CompressedCurve::GetKeyValue(uint index, Vec3& result) const
+{
+  const u16* value = &mValues[index * 3];
+  for (uint axis = 0; axis < 3; ++axis)
+    result[axis] = Dequantize(value[axis], mMin[axis], mExtent[axis]);
+}
+
+void CompressedCurve::GetKeyValue(uint index, Quat& result) const
+{
+  result = UnpackQuat(&mValues[index * 3]);
+}
+
+uint CompressedCurve::GetMemorySize() const
+{
+  return sizeof(mMin) + sizeof(mExtent) + mTimes.Size() * sizeof(float) + mValues.Size() * sizeof(u16) +
+         mSegmentTimes.Size() * sizeof(float);
+}
+
+float CompressedCurve::GetMaxError(const Array<float>& times, const Array<Vec3>& values) const
+{
+  if (mTimes.Empty())
+    return 0.0f;
+
+  float error = 0.0f;
+  uint cursor = 0;
+  for (uint i = 0; i < times.Size(); ++i)
+  {
+    Vec3 value;
+    Sample(times[i], cursor, value);
+    error = Math::Max(error, GetKeyError(value, values[i]));
+  }
+  return error;
+}
+
+float CompressedCurve::GetMaxError(const Array<float>& times, const Array<Quat>& values) const
+{
+  if (mTimes.Empty())
+    return 0.0f;
+
+  float error = 0.0f;
+  uint cursor = 0;
+  for (uint i = 0; i < times.Size(); ++i)
+  {
+    Quat value;
+    Sample(times[i], cursor, value);
+    error = Math::Max(error, GetKeyError(value, values[i]));
+  }
+  return error;
+}
+
+void CompressedCurve::Serialize(Serializer& stream)
+{
+  SerializeNameDefault(mMin, Vec3::cZero);
+  SerializeNameDefault(mExtent, Vec3::cZero);
+  SerializeNameDefault(mTimes, Array<float>());
+
+  // There's no 16 bit serialization, so the values are widened in text files
+  Array<uint> values;
+  if (stream.GetMode() == SerializerMode::Saving)
+  {
+    values.Resize(mValues.Size());
+    for (uint i = 0; i < mValues.Size(); ++i)
+      values[i] = mValues[i];
+  }
+
+  stream.SerializeFieldDefault("Values", values, Array<uint>());
+
+  if (stream.GetMode() == SerializerMode::Loading)
+  {
+    mValues.Resize(values.Size());
+    for (uint i = 0; i < values.Size(); ++i)
+      mValues[i] = (u16)values[i];
+
+    // Drop anything that doesn't have a full key
+    uint keyCount = Math::Min(mTimes.Size(), mValues.Size() / 3);
+    mTimes.Resize(keyCount);
+    mValues.Resize(keyCount * 3);
+    BuildSegments();
+  }
+}
+
+void CompressedCurve::BuildSegments()
+{
+  mSegmentTimes.Clear();
+  for (uint i = 0; i < mTimes.Size(); i += cKeysPerSegment)
+    mSegmentTimes.PushBack(mTimes[i]);
+}
+
+uint CompressedCurve::FindKey(float time, uint cursor) const
+{
+  uint last = mTimes.Size() - 1;
+  if (cursor > last)
+    cursor = 0;
+
+  // Playing forward stays in the interval sampled last or moves to the next
+  if (mTimes[cursor] <= time)
+  {
+    if (cursor == last || time < mTimes[cursor + 1])
+      return cursor;
+    if (cursor + 1 == last || time < mTimes[cursor + 2])
+      return cursor + 1;
+  }
+
+  // Otherwise only the segment that holds the time is searched
+  uint low = 0;
+  uint high = mSegmentTimes.Size();
+  while (high - low > 1)
+  {
+    uint middle = (low + high) / 2;
+    if (mSegmentTimes[middle] <= time)
+      low = middle;
+    else
+      high = middle;
+  }
+
+  uint key = low * cKeysPerSegment;
+  uint end = Math::Min(key + cKeysPerSegment, last);
+  while (key < end && mTimes[key + 1] <= time)
+    ++key;
+  return key;
+}
+
+uint CompressedCurve::GetInterval(float time, uint& cursor, float& t) const
+{
+  uint key = FindKey(time, cursor);
+  cursor = key;
+
+  // Times before the first key and after the last are clamped
+  t = 0.0f;
+  if (key + 1 < mTimes.Size() && time > mTimes[key])
+    t = Math::Min((time - mTimes[key]) / (mTimes[key + 1] - mTimes[key]), 1.0f);
+  return key;
+}
+
+bool CanCompressPropertyTrack(PropertyTrack* track)
+{
+  return GetCompressedChannel(track) != AnimationPoseChannels::None && !track->IsCompressed();
+}
+
+PropertyTrack* MakeCompressedPropertyTrack(StringParam componentName, StringParam propertyName, BoundType* propertyType)
+{
+  if (propertyType == ZilchTypeId(Vec3))
+    return new CompressedPropertyTrack<Vec3>(componentName, propertyName);
+  if (propertyType == ZilchTypeId(Quat))
+    return new CompressedPropertyTrack<Quat>(componentName, propertyName);
+  return nullptr;
+}
+
+void CompressAnimation(Animation* animation,
+                       const AnimationCompressionSettings& settings,
+                       AnimationCompressionReport& report)
+{
+  forRange (ObjectTrack& objectTrack, animation->ObjectTracks.All())
+  {
+    Array<PropertyTrack*> tracks;
+    forRange (PropertyTrack& track, objectTrack.PropertyTracks.All())
+      tracks.PushBack(&track);
+
+    forRange (PropertyTrack* track, tracks.All())
+    {
+      if (!CanCompressPropertyTrack(track))
+        continue;
+
+      PropertyTrack* compressedTrack = nullptr;
+      uint channel = GetCompressedChannel(track);
+      if (channel == AnimationPoseChannels::Translation)
+        compressedTrack = CompressTrack<Vec3>(track, channel, settings.mTranslationTolerance, report);
+      else if (channel == AnimationPoseChannels::Rotation)
+        compressedTrack = CompressTrack<Quat>(track, channel, settings.mRotationTolerance, report);
+      else
+        compressedTrack = CompressTrack<Vec3>(track, channel, settings.mScaleTolerance, report);
+
+      // Takes the original's place so the play data indices don't change
+      compressedTrack->TrackIndex = track->TrackIndex;
+      objectTrack.PropertyTracks.InsertBefore(track, compressedTrack);
+      PropertyTrackList::Unlink(track);
+      delete track;
+    }
+  }
+}
+
+} // namespace Zero
@@ -0,0 +1,158 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+const uint CompressedObjectTrackChunk = 'ctrk';
+
+/// The largest error allowed when removing keys from the Transform tracks of
+/// an animation. Rotation is in radians.
+struct AnimationCompressionSettings
+{
+  AnimationCompressionSettings();
+
+  float mTranslationTolerance;
+  float mRotationTolerance;
+  float mScaleTolerance;
+};
+
+class CompressedCurve;
+
+/// What compressing an animation saved and how far the compressed tracks
+/// are from the original keys.
+struct AnimationCompressionReport
+{
+  AnimationCompressionReport();
+
+  /// Adds a curve made from the given number of keys of the given size.
+  void AddCurve(uint channel, uint originalKeys, uint originalKeySize, const CompressedCurve& curve, float error);
+  /// Prints the report for the named animation.
+  void Print(StringParam animationName);
+
+  uint mOriginalKeys;
+  uint mCompressedKeys;
+  uint mOriginalBytes;
+  uint mCompressedBytes;
+  float mMaxTranslationError;
+  float mMaxRotationError;
+  float mMaxScaleError;
+};
+
+// Compressed Curve
+/// The keys of a Vec3 or Quat track after every key that could be
+/// interpolated from its neighbors within a tolerance was removed. Values are
+/// quantized to three 16 bit components (rotations store their smallest three
+/// components) and the keys are grouped into segments so that a time can be
+/// found without searching every key.
+class CompressedCurve
+{
+public:
+  static const uint cKeysPerSegment = 16;
+
+  CompressedCurve();
+
+  /// The times must be sorted.
+  void Compress(const Array<float>& times, const Array<Vec3>& values, float tolerance);
+  void Compress(const Array<float>& times, const Array<Quat>& values, float tolerance);
+
+  /// The cursor is the key that was sampled last. Sampling at or just after
+  /// the last time doesn't search, anything else searches only the segment
+  /// that holds the time.
+  void Sample(float time, uint& cursor, Vec3& result) const;
+  void Sample(float time, uint& cursor, Quat& result) const;
+
+  uint GetKeyCount() const;
+  float GetKeyTime(uint index) const;
+  void GetKeyValue(uint index, Vec3& result) const;
+  void GetKeyValue(uint index, Quat& result) const;
+  /// Bytes used by the keys.
+  uint GetMemorySize() const;
+  /// The largest difference between the curve and the keys it was made from.
+  /// Rotation error is the angle between them in radians.
+  float GetMaxError(const Array<float>& times, const Array<Vec3>& values) const;
+  float GetMaxError(const Array<float>& times, const Array<Quat>& values) const;
+
+  void Serialize(Serializer& stream);
+
+  template <typename writerType>
+  void Write(writerType& writer)
+  {
+    u32 keyCount = mTimes.Size();
+    writer.Write(keyCount);
+    writer.Write(mMin);
+    writer.Write(mExtent);
+    writer.Write(mTimes.Data(), keyCount);
+    writer.Write(mValues.Data(), keyCount * 3);
+  }
+
+  template <typename readerType>
+  void Read(readerType& reader)
+  {
+    u32 keyCount = 0;
+    reader.Read(keyCount);
+    reader.Read(mMin);
+    reader.Read(mExtent);
+    mTimes.Resize(keyCount);
+    mValues.Resize(keyCount * 3);
+    reader.ReadArray(mTimes.Data(), keyCount);
+    reader.ReadArray(mValues.Data(), keyCount * 3);
+    BuildSegments();
+  }
+
+private:
+  void BuildSegments();
+  /// Returns the key at or before the time.
+  uint FindKey(float time, uint cursor) const;
+  /// Returns the key to interpolate from and the amount to interpolate by.
+  uint GetInterval(float time, uint& cursor, float& t) const;
+
+  /// The range the Vec3 values are quantized over.
+  Vec3 mMin;
+  Vec3 mExtent;
+  Array<float> mTimes;
+  /// Three per key.
+  Array<u16> mValues;
+  /// The time of the first key of each segment.
+  Array<float> mSegmentTimes;
+};
+
+// Compressed Property Track
+/// Animates a Transform's translation, rotation or scale from a
+/// CompressedCurve.
+template <typename propertyType>
+class CompressedPropertyTrack : public PropertyTrack
+{
+public:
+  CompressedPropertyTrack(StringParam componentName, StringParam propertyName);
+
+  /// PropertyTrack Interface.
+  void Serialize(Serializer& stream) override;
+  void LinkInstance(PropertyTrackPlayData& data, BlendTracks& tracks, StringParam objectPath, Cog* object) override;
+  void UpdateFrame(PropertyTrackPlayData& data, TrackParams& params, AnimationFrame& animationFrame) override;
+  void UpdatePose(PropertyTrackPlayData& data, float time, AnimationPose& pose) override;
+  void GetKeyTimes(Array<float>& times) override;
+  void GetKeyValues(Array<Any>& values) override;
+  bool IsCompressed() override;
+
+  CompressedCurve mCurve;
+  String mComponentName;
+  String mPropertyName;
+};
+
+/// Returns whether the track is one that can be replaced by a compressed
+/// track (a Transform's translation, rotation or scale).
+bool CanCompressPropertyTrack(PropertyTrack* track);
+
+/// Creates an empty compressed track to be loaded into.
+PropertyTrack* MakeCompressedPropertyTrack(StringParam componentName, StringParam propertyName, BoundType* propertyType);
+
+/// Replaces every track in the animation that can be compressed with a
+/// compressed track and adds them to the report.
+void CompressAnimation(Animation* animation,
+                       const AnimationCompressionSettings& settings,
+                       AnimationCompressionReport& report);
+
+#include "CompressedTrack.inl"
+
+} // namespace Zero
@@ -0,0 +1,81 @@
+// MIT Licensed (see LICENSE.md).
+
+template <typename propertyType>
+CompressedPropertyTrack<propertyType>::CompressedPropertyTrack(StringParam componentName, StringParam propertyName)
+{
+  mComponentName = componentName;
+  mPropertyName = propertyName;
+  Name = BuildString(componentName, ".", propertyName);
+  TypeId = ZilchTypeId(propertyType);
+  TypeName = TypeId->Name;
+}
+
+template <typename propertyType>
+void CompressedPropertyTrack<propertyType>::Serialize(Serializer& stream)
+{
+  PropertyTrack::Serialize(stream);
+  mCurve.Serialize(stream);
+}
+
+template <typename propertyType>
+void CompressedPropertyTrack<propertyType>::LinkInstance(PropertyTrackPlayData& data,
+                                                         BlendTracks& tracks,
+                                                         StringParam objectPath,
+                                                         Cog* object)
+{
+  LinkPropertyTrack(data, tracks, objectPath, object, mComponentName, mPropertyName, TypeId);
+}
+
+template <typename propertyType>
+void CompressedPropertyTrack<propertyType>::UpdateFrame(PropertyTrackPlayData& data,
+                                                        TrackParams& params,
+                                                        AnimationFrame& animationFrame)
+{
+  // Transform tracks are sampled into the pose instead
+  if (data.mBlend == NULL || data.mBlend->PoseIndex != -1 || mCurve.GetKeyCount() == 0)
+    return;
+
+  propertyType value;
+  mCurve.Sample(params.Time, data.mKeyframeIndex, value);
+
+  animationFrame.Tracks[data.mBlend->Index].Active = true;
+  animationFrame.Tracks[data.mBlend->Index].Value = value;
+}
+
+template <typename propertyType>
+void CompressedPropertyTrack<propertyType>::UpdatePose(PropertyTrackPlayData& data, float time, AnimationPose& pose)
+{
+  if (data.mBlend == NULL || data.mBlend->PoseIndex == -1 || uint(data.mBlend->PoseIndex) >= pose.Size())
+    return;
+  if (mCurve.GetKeyCount() == 0)
+    return;
+
+  propertyType value;
+  mCurve.Sample(time, data.mKeyframeIndex, value);
+
+  pose.SetValue(data.mBlend->PoseIndex, data.mBlend->PoseChannel, value);
+}
+
+template <typename propertyType>
+void CompressedPropertyTrack<propertyType>::GetKeyTimes(Array<float>& times)
+{
+  for (uint i = 0; i < mCurve.GetKeyCount(); ++i)
+    times.PushBack(mCurve.GetKeyTime(i));
+}
+
+template <typename propertyType>
+void CompressedPropertyTrack<propertyType>::GetKeyValues(Array<Any>& values)
+{
+  for (uint i = 0; i < mCurve.GetKeyCount(); ++i)
+  {
+    propertyType value;
+    mCurve.GetKeyValue(i, value);
+    values.PushBack(Any(value));
+  }
+}
+
+template <typename propertyType>
+bool CompressedPropertyTrack<propertyType>::IsCompressed()
+{
+  return true;
+}
@@ -95,6 +95,35 @@ void InterpolateKeyFrame(float time, uint& keyFrameIndex, keyFrames& mKeyFrames,
   keyFrameIndex = CurKey;
 }
 
+uint GetPoseChannel(HandleParam instance, Property* prop)
+{
+  if (instance.StoredType != ZilchTypeId(Transform))
+    return AnimationPoseChannels::None;
+
+  if (prop->Name == "Translation")
+    return AnimationPoseChannels::Translation;
+  if (prop->Name == "Rotation")
+    return AnimationPoseChannels::Rotation;
+  if (prop->Name == "Scale")
+    return AnimationPoseChannels::Scale;
+  return AnimationPoseChannels::None;
+}
+
+int GetPoseIndex(BlendTracks& tracks, HandleParam instance)
+{
+  // Every channel of the same Transform shares an index
+  int poseSize = 0;
+  forRange (BlendTrack* blendTrack, tracks.Values())
+  {
+    if (blendTrack->PoseIndex == -1)
+      continue;
+    if (blendTrack->Object == instance)
+      return blendTrack->PoseIndex;
+    poseSize = Math::Max(poseSize, blendTrack->PoseIndex + 1);
+  }
+  return poseSize;
+}
+
 BlendTrack* GetBlendTrack(StringParam name, BlendTracks& tracks, HandleParam instance, Property* prop)
 {
   BlendTrack* blendTrack = tracks.FindValue(name, nullptr);
@@ -105,12 +134,48 @@ BlendTrack* GetBlendTrack(StringParam name, BlendTracks& tracks, HandleParam ins
     blendTrack->Index = tracks.Size();
     blendTrack->Object = instance;
     blendTrack->Property = prop;
+    blendTrack->PoseChannel = GetPoseChannel(instance, prop);
+    blendTrack->PoseIndex = -1;
+    if (blendTrack->PoseChannel != AnimationPoseChannels::None)
+      blendTrack->PoseIndex = GetPoseIndex(tracks, instance);
     tracks.Insert(name, blendTrack);
   }
 
   return blendTrack;
 }
 
+void LinkPropertyTrack(PropertyTrackPlayData& data,
+                       BlendTracks& tracks,
+                       StringParam objectPath,
+                       Cog* object,
+                       StringParam componentName,
+                       StringParam propertyName,
+                       BoundType* propertyType)
+{
+  BoundType* componentMeta = MetaDatabase::GetInstance()->FindType(componentName);
+
+  if (componentMeta == nullptr)
+    return;
+
+  data.mComponent = object->QueryComponentType(componentMeta);
+  if (data.mComponent == nullptr)
+    return;
+
+  BoundType* componentType = ZilchVirtualTypeId(data.mComponent);
+  Property* property = componentType->GetProperty(propertyName);
+  ReturnIf(property == nullptr, , "Failed to find property.");
+
+  // The property type has changed, so do nothing
+  if (property->PropertyType != propertyType)
+    return;
+
+  String fullPropertyName = BuildString(componentType->Name, ".", propertyName);
+  String fullName = BuildString(objectPath, ".", fullPropertyName);
+
+  data.mBlend = GetBlendTrack(fullName, tracks, data.mComponent, property);
+  data.mKeyframeIndex = 0;
+}
+
 bool ValidPropertyTrack(Property* property)
 {
   // Cannot animate read only properties
@@ -40,6 +40,14 @@ public:
   virtual ~PropertyTrack(){};
   virtual void LinkInstance(PropertyTrackPlayData& data, BlendTracks& tracks, StringParam objectPath, Cog* object) = 0;
   virtual void UpdateFrame(PropertyTrackPlayData& data, TrackParams& params, AnimationFrame& animationFrame){};
+  /// Samples tracks that animate a Transform into the pose. Only touches the
+  /// keys, the play data and the pose so that it can run on another thread.
+  virtual void UpdatePose(PropertyTrackPlayData& data, float time, AnimationPose& pose){};
+  /// Compressed tracks can't be edited and are saved differently.
+  virtual bool IsCompressed()
+  {
+    return false;
+  }
 
   // Editing
   virtual void InsertKey(PropertyTrackPlayData& data, float time)
@@ -85,6 +93,7 @@ public:
   void Serialize(Serializer& stream) override;
   void LinkInstance(PropertyTrackPlayData& data, BlendTracks& tracks, StringParam objectPath, Cog* object) override;
   void UpdateFrame(PropertyTrackPlayData& data, TrackParams& params, AnimationFrame& animationFrame) override;
+  void UpdatePose(PropertyTrackPlayData& data, float time, AnimationPose& pose) override;
   void GetKeyTimes(Array<float>& times) override;
   void GetKeyValues(Array<Any>& values) override;
   void InsertKey(PropertyTrackPlayData& data, float time) override;
@@ -133,6 +142,14 @@ public:
 };
 
 BlendTrack* GetBlendTrack(StringParam name, BlendTracks& tracks, HandleParam instance, Property* prop);
+/// Finds the component and blend track that a track animates on the object.
+void LinkPropertyTrack(PropertyTrackPlayData& data,
+                       BlendTracks& tracks,
+                       StringParam objectPath,
+                       Cog* object,
+                       StringParam componentName,
+                       StringParam propertyName,
+                       BoundType* propertyType);
 /// Returns whether or not the given property can be animated.
 bool ValidPropertyTrack(Property* property);
 
@@ -24,28 +24,7 @@ void AnimatePropertyType<propertyType>::LinkInstance(PropertyTrackPlayData& data
                                                      StringParam objectPath,
                                                      Cog* object)
 {
-  BoundType* componentMeta = MetaDatabase::GetInstance()->FindType(mComponentName);
-
-  if (componentMeta == nullptr)
-    return;
-
-  data.mComponent = object->QueryComponentType(componentMeta);
-  if (data.mComponent == nullptr)
-    return;
-
-  BoundType* componentType = ZilchVirtualTypeId(data.mComponent);
-  Property* property = componentType->GetProperty(mPropertyName);
-  ReturnIf(property == nullptr, , "Failed to find property.");
-
-  // The property type has changed, so do nothing
-  if (property->PropertyType != TypeId)
-    return;
-
-  String propertyName = BuildString(componentType->Name, ".", mPropertyName);
-  String fullName = BuildString(objectPath, ".", propertyName);
-
-  data.mBlend = GetBlendTrack(fullName, tracks, data.mComponent, property);
-  data.mKeyframeIndex = 0;
+  LinkPropertyTrack(data, tracks, objectPath, object, mComponentName, mPropertyName, this->TypeId);
 }
 
 template <typename propertyType>
@@ -53,7 +32,8 @@ void AnimatePropertyType<propertyType>::UpdateFrame(PropertyTrackPlayData& data,
                                                     TrackParams& params,
                                                     AnimationFrame& animationFrame)
 {
-  if (data.mBlend == NULL)
+  // Transform tracks are sampled into the pose instead
+  if (data.mBlend == NULL || data.mBlend->PoseIndex != -1)
     return;
 
   KeyFrameT keyFrame;
@@ -63,6 +43,18 @@ void AnimatePropertyType<propertyType>::UpdateFrame(PropertyTrackPlayData& data,
   animationFrame.Tracks[data.mBlend->Index].Value = keyFrame.KeyValue;
 };
 
+template <typename propertyType>
+void AnimatePropertyType<propertyType>::UpdatePose(PropertyTrackPlayData& data, float time, AnimationPose& pose)
+{
+  if (data.mBlend == NULL || data.mBlend->PoseIndex == -1 || uint(data.mBlend->PoseIndex) >= pose.Size())
+    return;
+
+  KeyFrameT keyFrame;
+  InterpolateKeyFrame(time, data.mKeyframeIndex, this->mKeyFrames, keyFrame);
+
+  pose.SetValue(data.mBlend->PoseIndex, data.mBlend->PoseChannel, keyFrame.KeyValue);
+}
+
 template <typename propertyType>
 void AnimatePropertyType<propertyType>::GetKeyTimes(Array<float>& times)
 {
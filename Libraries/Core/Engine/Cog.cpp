@@ -613,6 +613,7 @@ bool Cog::AddComponentByType(BoundType* componentType)
     return false;
 
   // Create the component
+  ComponentPoolSpaceScope poolScope(GetSpace());
   Component* component = ZilchAllocate(Component, componentType, HeapFlags::NonReferenceCounted);
 
   // If the returned component is null, most likely a script was
@@ -18,6 +18,8 @@ void* Component::operator new(size_t size)
 }
 void Component::operator delete(void* pMem, size_t size)
 {
+  if (ComponentPools::Deallocate(pMem))
+    return;
   return sHeap->Deallocate(pMem, size);
 }
 
@@ -159,7 +161,9 @@ void ComponentHandleManager::Allocate(BoundType* type, Handle& handleToInitializ
 
   ComponentHandleData& data = *(ComponentHandleData*)(handleToInitialize.Data);
   data.mCogId = CogId();
-  data.mRawObject = zAllocate(type->Size);
+  data.mRawObject = ComponentPools::Allocate(type);
+  if (data.mRawObject == nullptr)
+    data.mRawObject = zAllocate(type->Size);
   memset(data.mRawObject, 0, type->Size);
   data.mComponentType = type;
 }
@@ -226,7 +230,8 @@ void ComponentHandleManager::Delete(const Handle& handle)
 
   // METAREFACTOR This is what was previously happening with delete, except this
   // doesn't seem correct since mRawObject is not set in all cases...
-  zDeallocate(data.mRawObject);
+  if (!ComponentPools::Deallocate(data.mRawObject))
+    zDeallocate(data.mRawObject);
 }
 
 } // namespace Zero
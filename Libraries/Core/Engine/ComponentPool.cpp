@@ -0,0 +1,293 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+// Enough slots that a handful of pages cover a typical space, small enough
+// that mostly empty spaces (editor previews, Ui) don't waste much.
+const size_t cComponentPoolPageSlots = 64;
+
+// Component Pool Page
+ComponentPoolPage::ComponentPoolPage(ComponentPool* pool, Space* space) :
+    mPool(pool),
+    mSpace(space),
+    mSlotCount(cComponentPoolPageSlots),
+    mLiveCount(0)
+{
+  mSlots = (::byte*)Component::sHeap->Allocate(mPool->mSlotSize * mSlotCount);
+  mLive.Resize(mSlotCount, false);
+
+  // Hand out slots front to back so iteration walks memory in order
+  mFreeSlots.Reserve(mSlotCount);
+  for (size_t i = mSlotCount; i > 0; --i)
+    mFreeSlots.PushBack((uint)(i - 1));
+}
+
+ComponentPoolPage::~ComponentPoolPage()
+{
+  ErrorIf(mLiveCount != 0, "Freeing a component pool page that still has live components.");
+  Component::sHeap->Deallocate(mSlots, mPool->mSlotSize * mSlotCount);
+}
+
+MemPtr ComponentPoolPage::Allocate()
+{
+  if (mFreeSlots.Empty())
+    return nullptr;
+
+  uint slot = mFreeSlots.Back();
+  mFreeSlots.PopBack();
+
+  mLive[slot] = true;
+  ++mLiveCount;
+  return mSlots + slot * mPool->mSlotSize;
+}
+
+void ComponentPoolPage::Deallocate(MemPtr memory)
+{
+  size_t slot = ((::byte*)memory - mSlots) / mPool->mSlotSize;
+  ErrorIf(!mLive[slot], "Component pool slot was deallocated twice.");
+
+  mLive[slot] = false;
+  --mLiveCount;
+  mFreeSlots.PushBack((uint)slot);
+}
+
+bool ComponentPoolPage::Contains(MemPtr memory)
+{
+  ::byte* bytes = (::byte*)memory;
+  return bytes >= mSlots && bytes < mSlots + mPool->mSlotSize * mSlotCount;
+}
+
+bool ComponentPoolPage::IsFull()
+{
+  return mFreeSlots.Empty();
+}
+
+bool ComponentPoolPage::IsEmpty()
+{
+  return mLiveCount == 0;
+}
+
+// Component Pool
+ComponentPool::ComponentPool(BoundType* type) : mType(type)
+{
+  // Keep every slot pointer aligned for the component's members
+  const size_t alignment = 16;
+  mSlotSize = (type->Size + alignment - 1) & ~(alignment - 1);
+}
+
+ComponentPool::~ComponentPool()
+{
+  forRange (ComponentPoolPage* page, mPages.All())
+  {
+    ComponentPools::RemovePage(page);
+    delete page;
+  }
+}
+
+MemPtr ComponentPool::Allocate(Space* space)
+{
+  forRange (ComponentPoolPage* page, mPages.All())
+  {
+    if (page->mSpace == space && !page->IsFull())
+      return page->Allocate();
+  }
+
+  ComponentPoolPage* page = new ComponentPoolPage(this, space);
+  mPages.PushBack(page);
+  ComponentPools::AddPage(page);
+  return page->Allocate();
+}
+
+void ComponentPool::Deallocate(ComponentPoolPage* page, MemPtr memory)
+{
+  page->Deallocate(memory);
+
+  // Pages of live spaces are kept around to be refilled
+  if (page->mSpace == nullptr && page->IsEmpty())
+  {
+    ComponentPools::RemovePage(page);
+    mPages.EraseValue(page);
+    delete page;
+  }
+}
+
+void ComponentPool::ReleaseSpace(Space* space)
+{
+  for (size_t i = 0; i < mPages.Size();)
+  {
+    ComponentPoolPage* page = mPages[i];
+    if (page->mSpace != space)
+    {
+      ++i;
+      continue;
+    }
+
+    page->mSpace = nullptr;
+    if (page->IsEmpty())
+    {
+      ComponentPools::RemovePage(page);
+      mPages.EraseAt(i);
+      delete page;
+    }
+    else
+    {
+      ++i;
+    }
+  }
+}
+
+ComponentPool::range ComponentPool::All(Space* space)
+{
+  return range(mPages, space);
+}
+
+ComponentPool::range::range(Array<ComponentPoolPage*>& pages, Space* space) :
+    mPages(pages.All()),
+    mSpace(space),
+    mSlot(0)
+{
+  SkipDead();
+}
+
+Component& ComponentPool::range::Front()
+{
+  ComponentPoolPage* page = mPages.Front();
+  return *(Component*)(page->mSlots + mSlot * page->mPool->mSlotSize);
+}
+
+void ComponentPool::range::PopFront()
+{
+  ++mSlot;
+  SkipDead();
+}
+
+bool ComponentPool::range::Empty()
+{
+  return mPages.Empty();
+}
+
+void ComponentPool::range::SkipDead()
+{
+  while (!mPages.Empty())
+  {
+    ComponentPoolPage* page = mPages.Front();
+    if (page->mSpace == mSpace)
+    {
+      while (mSlot < page->mSlotCount && !page->mLive[mSlot])
+        ++mSlot;
+
+      if (mSlot < page->mSlotCount)
+        return;
+    }
+
+    mPages.PopFront();
+    mSlot = 0;
+  }
+}
+
+// Component Pools
+bool ComponentPools::sEnabled = false;
+Space* ComponentPools::sAllocationSpace = nullptr;
+HashMap<BoundType*, ComponentPool*> ComponentPools::sPools;
+Array<ComponentPoolPage*> ComponentPools::sPagesByAddress;
+
+MemPtr ComponentPools::Allocate(BoundType* type)
+{
+  if (sAllocationSpace == nullptr)
+    return nullptr;
+
+  ComponentPool* pool = GetPool(type);
+  if (pool == nullptr)
+    return nullptr;
+
+  return pool->Allocate(sAllocationSpace);
+}
+
+bool ComponentPools::Deallocate(MemPtr memory)
+{
+  if (sPagesByAddress.Empty())
+    return false;
+
+  ComponentPoolPage* page = FindPage(memory);
+  if (page == nullptr)
+    return false;
+
+  page->mPool->Deallocate(page, memory);
+  return true;
+}
+
+void ComponentPools::ReleaseSpace(Space* space)
+{
+  forRange (ComponentPool* pool, sPools.Values())
+  {
+    if (pool)
+      pool->ReleaseSpace(space);
+  }
+}
+
+bool ComponentPools::Contains(Space* space, MemPtr memory)
+{
+  ComponentPoolPage* page = FindPage(memory);
+  return page != nullptr && page->mSpace == space;
+}
+
+ComponentPool* ComponentPools::GetPool(BoundType* type)
+{
+  if (!sEnabled || !type->Native)
+    return nullptr;
+
+  // Non pooled types are stored as null so the attribute is only looked up once
+  ComponentPool*& pool = sPools[type];
+  if (pool == nullptr && type->HasAttribute(ObjectAttributes::cPooledStorage))
+    pool = new ComponentPool(type);
+  return pool;
+}
+
+void ComponentPools::Shutdown()
+{
+  forRange (ComponentPool* pool, sPools.Values())
+    delete pool;
+  sPools.Clear();
+  sPagesByAddress.Clear();
+}
+
+void ComponentPools::AddPage(ComponentPoolPage* page)
+{
+  size_t index = 0;
+  while (index < sPagesByAddress.Size() && sPagesByAddress[index]->mSlots < page->mSlots)
+    ++index;
+  sPagesByAddress.InsertAt(index, page);
+}
+
+void ComponentPools::RemovePage(ComponentPoolPage* page)
+{
+  sPagesByAddress.EraseValue(page);
+}
+
+ComponentPoolPage* ComponentPools::FindPage(MemPtr memory)
+{
+  // Find the last page starting at or before the memory
+  ::byte* bytes = (::byte*)memory;
+  size_t begin = 0;
+  size_t end = sPagesByAddress.Size();
+  while (begin < end)
+  {
+    size_t middle = (begin + end) / 2;
+    if (sPagesByAddress[middle]->mSlots <= bytes)
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+
+  if (begin == 0)
+    return nullptr;
+
+  ComponentPoolPage* page = sPagesByAddress[begin - 1];
+  if (!page->Contains(memory))
+    return nullptr;
+  return page;
+}
+
+} // namespace Zero
@@ -0,0 +1,180 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+class ComponentPool;
+
+// Component Pool Page
+/// A block of fixed size slots for one component type. Every page belongs to
+/// a single space so that a space's components of a type are stored together.
+class ComponentPoolPage
+{
+public:
+  ComponentPoolPage(ComponentPool* pool, Space* space);
+  ~ComponentPoolPage();
+
+  /// Returns null if every slot is in use.
+  MemPtr Allocate();
+  void Deallocate(MemPtr memory);
+
+  bool Contains(MemPtr memory);
+  bool IsFull();
+  bool IsEmpty();
+
+  ComponentPool* mPool;
+  /// Cleared when the space is destroyed, the page is freed once empty.
+  Space* mSpace;
+  ::byte* mSlots;
+  size_t mSlotCount;
+  size_t mLiveCount;
+  /// Whether each slot currently holds a component.
+  Array<bool> mLive;
+  Array<uint> mFreeSlots;
+};
+
+// Component Pool
+/// Contiguous storage for a native component type that is iterated every frame
+/// (Transform, RigidBody, Graphicals...). Slots never move, so component
+/// pointers and handles are as stable as heap allocated components and
+/// Cog::QueryComponentType is unaffected.
+class ComponentPool
+{
+public:
+  ComponentPool(BoundType* type);
+  ~ComponentPool();
+
+  MemPtr Allocate(Space* space);
+  void Deallocate(ComponentPoolPage* page, MemPtr memory);
+
+  /// Detaches every page owned by the space. Pages that are still holding
+  /// components are freed when their last component is deleted.
+  void ReleaseSpace(Space* space);
+
+  /// Iterates the live components of this type that were allocated in a space.
+  /// Components are visited in memory order and may not have finished
+  /// initializing yet.
+  struct range
+  {
+    range(Array<ComponentPoolPage*>& pages, Space* space);
+
+    Component& Front();
+    void PopFront();
+    bool Empty();
+    range& All()
+    {
+      return *this;
+    }
+
+  private:
+    void SkipDead();
+
+    Array<ComponentPoolPage*>::range mPages;
+    Space* mSpace;
+    size_t mSlot;
+  };
+
+  range All(Space* space);
+
+  BoundType* mType;
+  size_t mSlotSize;
+  Array<ComponentPoolPage*> mPages;
+};
+
+/// Typed wrapper around a ComponentPool range for systems.
+template <typename ComponentType>
+struct PooledComponentRange
+{
+  PooledComponentRange(ComponentPool::range range) : mRange(range)
+  {
+  }
+
+  ComponentType& Front()
+  {
+    return static_cast<ComponentType&>(mRange.Front());
+  }
+  void PopFront()
+  {
+    mRange.PopFront();
+  }
+  bool Empty()
+  {
+    return mRange.Empty();
+  }
+  PooledComponentRange& All()
+  {
+    return *this;
+  }
+
+  ComponentPool::range mRange;
+};
+
+// Component Pools
+/// Opt-in pooled storage for native components marked with
+/// ObjectAttributes::cPooledStorage. Only components created while the owning
+/// space is known (see ComponentPoolSpaceScope) are pooled, all others fall back
+/// to the component heap.
+class ComponentPools
+{
+public:
+  /// Enabled at startup with the 'PooledComponents' command line argument.
+  static bool sEnabled;
+  /// The space components are currently being created in.
+  static Space* sAllocationSpace;
+
+  /// Returns null if the type isn't pooled or no space is being created in.
+  static MemPtr Allocate(BoundType* type);
+  /// Returns false if the memory didn't come from a pool.
+  static bool Deallocate(MemPtr memory);
+
+  /// Called when a space is destroyed.
+  static void ReleaseSpace(Space* space);
+
+  /// Whether the memory came from one of the space's pool pages.
+  static bool Contains(Space* space, MemPtr memory);
+
+  /// Returns null if the type is not pooled.
+  static ComponentPool* GetPool(BoundType* type);
+
+  /// All pooled components of the given type in a space.
+  template <typename ComponentType>
+  static PooledComponentRange<ComponentType> All(Space* space)
+  {
+    ComponentPool* pool = GetPool(ZilchTypeId(ComponentType));
+    ErrorIf(pool == nullptr, "Component type is not pooled.");
+    return PooledComponentRange<ComponentType>(pool->All(space));
+  }
+
+  static void Shutdown();
+
+private:
+  friend class ComponentPool;
+
+  static void AddPage(ComponentPoolPage* page);
+  static void RemovePage(ComponentPoolPage* page);
+  static ComponentPoolPage* FindPage(MemPtr memory);
+
+  /// Only native types are stored, script types are never pooled.
+  static HashMap<BoundType*, ComponentPool*> sPools;
+  /// Sorted by slot address for finding the page on deallocation.
+  static Array<ComponentPoolPage*> sPagesByAddress;
+};
+
+/// Sets the space that components are pooled into for the current scope.
+class ComponentPoolSpaceScope
+{
+public:
+  ComponentPoolSpaceScope(Space* space) : mPreviousSpace(ComponentPools::sAllocationSpace)
+  {
+    ComponentPools::sAllocationSpace = space;
+  }
+  ~ComponentPoolSpaceScope()
+  {
+    ComponentPools::sAllocationSpace = mPreviousSpace;
+  }
+
+  Space* mPreviousSpace;
+};
+
+} // namespace Zero
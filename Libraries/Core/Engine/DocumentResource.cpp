@@ -6,6 +6,7 @@ namespace Zero
 namespace Events
 {
 DefineEvent(ClearAllAnnotations);
+DefineEvent(ResourceTextModified);
 }
 
 ZilchDefineType(SavingEvent, builder, type)
@@ -502,6 +503,12 @@ void DocumentResource::SetAndSaveData(StringRange data)
 
   ReloadData(data);
   UpdatePossibleProxiedClasses();
+
+  ResourceEvent event;
+  event.Manager = GetManager();
+  event.EventResource = this;
+  event.Name = Name;
+  Z::gResources->DispatchEvent(Events::ResourceTextModified, &event);
 }
 
 namespace Events
@@ -10,6 +10,9 @@ namespace Events
 // (such as errors) This is primarily used when Zilch fully compiles and informs
 // all script editors to clear their errors
 DeclareEvent(ClearAllAnnotations);
+// Sent on the resource system when the text of a document resource is replaced
+// (saved from an editor or reloaded after the file changed)
+DeclareEvent(ResourceTextModified);
 } // namespace Events
 
 class MethodDoc;
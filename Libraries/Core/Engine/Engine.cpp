@@ -153,6 +153,12 @@ void Engine::Update()
   {
     ProfileScopeFunction();
 
+    // Folding every frame keeps the raw sample buffer from filling up (the
+    // samples are also folded before scripts are replaced, see
+    // ZilchManager::InternalCompile)
+    if (Profile::SamplingProfiler::Instance != nullptr)
+      Profile::SamplingProfiler::Instance->Flush();
+
     Z::gTracker->ClearDeletedObjects();
 
     Z::gJobs->RunJobsTimeSliced();
@@ -335,6 +341,11 @@ void Engine::LoadingFinish()
   --mLoadingCount;
 }
 
+bool Engine::IsLoading()
+{
+  return mLoadingCount != 0;
+}
+
 InputDevice::Enum Engine::GetCurrentInputDevice()
 {
   return mCurrentInputDevice;
@@ -82,6 +82,8 @@ public:
                      ProgressType::Enum progressType,
                      float percentage = 0.0f);
   void LoadingFinish();
+  /// Whether a LoadingStart is currently waiting for its LoadingFinish.
+  bool IsLoading();
 
   /// The input device that the user last used (pressed buttons, moved sticks or
   /// triggers, etc...)
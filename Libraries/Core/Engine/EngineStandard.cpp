@@ -511,6 +511,9 @@ void EngineLibrary::Shutdown()
   SafeDelete(Z::gFactory);
   SafeDelete(Z::gTweakables);
 
+  // Every space and component has been destroyed by now
+  ComponentPools::Shutdown();
+
   GetLibrary()->ClearComponents();
 }
 
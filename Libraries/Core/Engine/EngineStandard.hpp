@@ -54,9 +54,12 @@ private:
 #include "HierarchyRange.hpp"
 #include "Cog.hpp"
 #include "Component.hpp"
+#include "ComponentPool.hpp"
 #include "ComponentMeta.hpp"
 #include "CogMetaComposition.hpp"
 #include "CogMeta.hpp"
+#include "WorldMatrixUpdater.hpp"
+#include "Animation/AnimationPose.hpp"
 #include "Space.hpp"
 #include "DocumentResource.hpp"
 #include "Scripting/ZilchResource.hpp"
@@ -64,9 +67,9 @@ private:
 #include "JobSystem.hpp"
 #include "EngineEvents.hpp"
 #include "System.hpp"
+#include "ThreadDispatch.hpp"
 #include "Time.hpp"
 #include "Engine.hpp"
-#include "ThreadDispatch.hpp"
 #include "Game.hpp"
 #include "Factory.hpp"
 #include "ArchetypeRebuilder.hpp"
@@ -109,6 +112,7 @@ private:
 #include "Animation/AnimationGraph.hpp"
 #include "Animation/AnimationGraphEvents.hpp"
 #include "Animation/Animation.hpp"
+#include "Animation/CompressedTrack.hpp"
 #include "CogSelection.hpp"
 #include "Configuration.hpp"
 #include "LauncherConfiguration.hpp"
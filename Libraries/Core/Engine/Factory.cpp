@@ -311,6 +311,7 @@ Cog* Factory::BuildFromStream(CogCreationContext* context, Serializer& stream)
             }
 
             // Create the component by using the ComponentMeta
+            ComponentPoolSpaceScope poolScope(context ? context->mSpace : nullptr);
             component = ZilchAllocate(Component, componentMeta, HeapFlags::NonReferenceCounted);
 
             // If we failed to create the object (should only happen on Script
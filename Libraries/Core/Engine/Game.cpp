@@ -294,7 +294,8 @@ bool GameSession::IsEditorMode()
 void GameSession::SetInEditor(bool inEditor)
 {
   mInEditor = inEditor;
-  if (!inEditor)
+  // Headless servers don't have a main window
+  if (!inEditor && mMainWindow)
   {
     // Listen to events from the main window
     ConnectThisTo(mMainWindow, Events::OsClose, OnClose);
@@ -311,11 +312,15 @@ void GameSession::DispatchOnSpaces(StringParam eventName, Event* event)
 
 Vec2 GameSession::GetResolution()
 {
+  if (mMainWindow == nullptr)
+    return Vec2::cZero;
   return ToVec2(mMainWindow->GetClientSize());
 }
 
 bool GameSession::GetFullScreen()
 {
+  if (mMainWindow == nullptr)
+    return false;
   return mMainWindow->GetState() == WindowState::Fullscreen;
 }
 
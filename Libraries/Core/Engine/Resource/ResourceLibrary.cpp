@@ -343,6 +343,10 @@ void ResourceLibrary::Unload()
 {
   ErrorIf(!Dependents.Empty(), "Cannot unload a Resource Library when other libraries depend on us");
 
+  // Sampled script functions may belong to this library's scripts
+  if (Profile::SamplingProfiler::Instance != nullptr)
+    Profile::SamplingProfiler::Instance->Flush();
+
   // Call unload on every resource so that references to other resources within
   // the library can be cleared.
   forRange (Resource* resource, Resources.All())
@@ -568,6 +572,15 @@ bool ResourceLibrary::CompileFragments(HashSet<ResourceLibrary*>& modifiedLibrar
   if (mSwapFragment.mCompileStatus == ZilchCompileStatus::Compiled)
     return true;
 
+  // Without a GraphicsEngine (running headless) nothing compiles fragments,
+  // so there is no fragment library to wait on
+  ZilchManager* zilchManager = ZilchManager::GetInstance();
+  if (!zilchManager->HasReceivers(Events::CompileZilchFragments))
+  {
+    mSwapFragment.mCompileStatus = ZilchCompileStatus::Compiled;
+    return true;
+  }
+
   Module dependencies;
 
   // Remove the default core library
@@ -579,13 +592,13 @@ bool ResourceLibrary::CompileFragments(HashSet<ResourceLibrary*>& modifiedLibrar
   ZPrint("  Compiling %s Fragments\n", this->Name.c_str());
 
   ZilchCompileFragmentEvent e(dependencies, mFragments, this);
-  ZilchManager::GetInstance()->DispatchEvent(Events::CompileZilchFragments, &e);
+  zilchManager->DispatchEvent(Events::CompileZilchFragments, &e);
   mSwapFragment.mPendingLibrary = e.mReturnedLibrary;
 
   if (mSwapFragment.mPendingLibrary != nullptr)
   {
     modifiedLibraries.Insert(this);
-    ZilchManager::GetInstance()->mPendingFragmentProjectLibrary = mSwapFragment.mPendingLibrary;
+    zilchManager->mPendingFragmentProjectLibrary = mSwapFragment.mPendingLibrary;
     mSwapFragment.mCompileStatus = ZilchCompileStatus::Compiled;
     return true;
   }
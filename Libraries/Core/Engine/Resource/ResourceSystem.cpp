@@ -17,6 +17,9 @@ DefineEvent(PackagedStarted);
 DefineEvent(PackagedFinished);
 } // namespace Events
 
+// How many entries ahead of the one being loaded are prefetched
+const uint cResourcePrefetchCount = 16;
+
 ZilchDefineType(ResourceSystem, builder, type)
 {
   type->HandleManager = ZilchManagerId(PointerManager);
@@ -281,8 +284,17 @@ void ResourceSystem::LoadIntoLibrary(Status& status,
 
   ProgressType::Enum progressType = count > 1 ? ProgressType::Normal : ProgressType::None;
 
+  uint prefetched = 0;
   for (uint i = 0; i < count; ++i)
   {
+    // Let the platform start reading the next few files while this one loads
+    for (; prefetched < count && prefetched <= i + cResourcePrefetchCount; ++prefetched)
+    {
+      ResourceEntry& upcoming = resourcePackage->Resources[prefetched];
+      if (!upcoming.Block)
+        PrefetchFile(FilePath::Combine(resourcePackage->Location, upcoming.Location));
+    }
+
     ResourceEntry& entry = resourcePackage->Resources[i];
     entry.mLibrary = resourceLibrary;
 
@@ -386,6 +398,15 @@ void ResourceSystem::ReloadEntry(Resource* resource, ResourceEntry& entry)
 
       if (entry.mLibrarySource->EditMode == ContentEditMode::ResourceObject)
         entry.mLibrarySource->mRuntimeResource = resource->mResourceId;
+
+      if (Type::DynamicCast<DocumentResource*>(resource) != nullptr)
+      {
+        ResourceEvent event;
+        event.Manager = manager;
+        event.EventResource = resource;
+        event.Name = resource->Name;
+        DispatchEvent(Events::ResourceTextModified, &event);
+      }
     }
   }
   else
@@ -117,6 +117,11 @@ void ZilchManager::InternalCompile()
   // Library commits must happen after all systems have handle PrePatch
   this->DispatchEvent(Events::ScriptsCompiledCommit, &compileEvent);
 
+  // Samples hold pointers to the script functions that were running, so they
+  // have to be resolved before the old libraries are released
+  if (Profile::SamplingProfiler::Instance != nullptr)
+    Profile::SamplingProfiler::Instance->Flush();
+
   // Unload ALL affected libraries before committing any of them.
   forRange (ResourceLibrary* resourceLibrary, compileEvent.mModifiedLibraries.All())
     resourceLibrary->PreCommitUnload();
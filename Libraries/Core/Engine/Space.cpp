@@ -69,6 +69,8 @@ Space::~Space()
   ErrorIf(!mCogList.Empty(), "Not all objects in space destroyed.");
   Z::gEngine->mSpaceList.Erase(this);
 
+  ComponentPools::ReleaseSpace(this);
+
   // Remove ourself from the game session list
   if (GameSession* gameSession = GetGameSession())
     gameSession->InternalRemove(this);
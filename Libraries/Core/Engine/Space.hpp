@@ -199,6 +199,12 @@ public:
   HierarchyList mRoots;
   uint mRootCount;
 
+  // Dirty transforms whose world matrices are recomputed once per frame
+  WorldMatrixUpdater mWorldMatrixUpdater;
+
+  // Animation graphs whose poses are evaluated together after the logic update
+  AnimationPoseUpdater mAnimationPoseUpdater;
+
   // If valid a load is pending for next update
   HandleOf<Level> mPendingLevel;
   // Allows CameraViewports to attach viewport to a space specific GameWidget
@@ -131,6 +131,58 @@ void ObjectThreadDispatch::OnEngineUpdate(Event* e)
   DispatchEvents();
 }
 
+CrossSpaceEventQueue::~CrossSpaceEventQueue()
+{
+  ClearEvents();
+}
+
+void CrossSpaceEventQueue::Queue(Cog* target, StringParam eventId, Event* event)
+{
+  QueuedCrossSpaceEvent queuedEvent;
+  queuedEvent.Target = target;
+  queuedEvent.EventId = eventId;
+  queuedEvent.EventToSend = event;
+
+  mLock.Lock();
+  mEvents.PushBack(queuedEvent);
+  mLock.Unlock();
+}
+
+void CrossSpaceEventQueue::DispatchEvents()
+{
+  Array<QueuedCrossSpaceEvent> eventsToDispatch;
+
+  // Pull out all events before dispatching (dispatching may queue more)
+  mLock.Lock();
+  eventsToDispatch.Swap(mEvents);
+  mLock.Unlock();
+
+  forRange (QueuedCrossSpaceEvent& queuedEvent, eventsToDispatch.All())
+  {
+    // The target may have been destroyed since the event was queued
+    if (Cog* target = queuedEvent.Target.ToCog())
+      target->DispatchEvent(queuedEvent.EventId, queuedEvent.EventToSend);
+
+    delete queuedEvent.EventToSend;
+  }
+  eventsToDispatch.Clear();
+}
+
+void CrossSpaceEventQueue::ClearEvents()
+{
+  Array<QueuedCrossSpaceEvent> eventsToDispatch;
+
+  mLock.Lock();
+  eventsToDispatch.Swap(mEvents);
+  mLock.Unlock();
+
+  forRange (QueuedCrossSpaceEvent& queuedEvent, eventsToDispatch.All())
+  {
+    delete queuedEvent.EventToSend;
+  }
+  eventsToDispatch.Clear();
+}
+
 void StartThreadSystem()
 {
   Z::gDispatch = new ThreadDispatch();
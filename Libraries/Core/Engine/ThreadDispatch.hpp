@@ -70,6 +70,33 @@ private:
   Array<ObjectQueuedEvent> mEvents;
 };
 
+/// Events sent between spaces while they are being updated concurrently. They
+/// are held until the spaces sync back up and then sent on the main thread.
+/// Targets are stored by id since they can be destroyed in the meantime.
+class CrossSpaceEventQueue
+{
+public:
+  ~CrossSpaceEventQueue();
+
+  /// Takes ownership of the event.
+  void Queue(Cog* target, StringParam eventId, Event* event);
+
+  /// Should only be called on the main thread.
+  void DispatchEvents();
+  void ClearEvents();
+
+private:
+  struct QueuedCrossSpaceEvent
+  {
+    CogId Target;
+    String EventId;
+    Event* EventToSend;
+  };
+
+  ThreadLock mLock;
+  Array<QueuedCrossSpaceEvent> mEvents;
+};
+
 namespace Z
 {
 extern ThreadDispatch* gDispatch;
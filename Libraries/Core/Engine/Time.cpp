@@ -7,6 +7,8 @@ namespace Zero
 namespace Events
 {
 DefineEvent(SystemLogicUpdate);
+DefineEvent(PreConcurrentSystemLogicUpdate);
+DefineEvent(ConcurrentSystemLogicUpdate);
 DefineEvent(FrameUpdate);
 DefineEvent(GraphicsFrameUpdate);
 DefineEvent(LogicUpdate);
@@ -16,6 +18,7 @@ DefineEvent(EngineDebuggerUpdate);
 DefineEvent(EngineShutdown);
 DefineEvent(ActionFrameUpdate);
 DefineEvent(ActionLogicUpdate);
+DefineEvent(AnimationLogicUpdate);
 } // namespace Events
 
 const float cFixedDt = (1.0f / 60.0f);
@@ -69,6 +72,7 @@ ZilchDefineType(TimeSpace, builder, type)
   ZilchBindField(mRealTimePassed);
   ZilchBindField(mFrame);
   ZilchBindFieldProperty(mStepCount);
+  ZilchBindFieldProperty(mIsolated);
 }
 
 TimeSpace::TimeSpace()
@@ -76,6 +80,7 @@ TimeSpace::TimeSpace()
   mTimeSystem = NULL;
 
   mPaused = false;
+  mIsolated = false;
   mFrame = 0;
 
   mRealTimePassed = 0.0;
@@ -97,6 +102,7 @@ void TimeSpace::Serialize(Serializer& stream)
   SerializeNameDefault(mTimeScale, 1.0f);
   SerializeEnumNameDefault(TimeMode, mTimeMode, TimeMode::FixedFrametime);
   SerializeNameDefault(mStepCount, (uint)1);
+  SerializeNameDefault(mIsolated, false);
 }
 
 void TimeSpace::Initialize(CogInitializer& initializer)
@@ -129,28 +135,53 @@ void TimeSpace::SetTimeScale(float timeScale)
   mTimeScale = Math::Max(timeScale, 0.0f);
 }
 
+// Time Space Event Scope
+// Sets up the state that everything run from a time space's events expects.
+// Only used on the main thread.
+class TimeSpaceEventScope
+{
+public:
+  TimeSpaceEventScope(TimeSpace* timeSpace) :
+      // If this is a preview space and we're sending out update (should include
+      // any special preview update) we don't want notifications to happen which
+      // we're previewing, as its very annoying to the user
+      mDoNotifyOverride(timeSpace->GetSpace()->IsPreviewMode() ? IgnoreDoNotify : nullptr),
+      // push on id of this space for the debug drawer so anyone who debug
+      // draws will by default be in the correct space.
+      mDrawSpace(timeSpace->GetOwner()->GetId().Id)
+  {
+  }
+
+  TemporaryDoNotifyOverride mDoNotifyOverride;
+  Debug::ActiveDrawSpace mDrawSpace;
+};
+
 void TimeSpace::Update(float dt)
 {
-  // Enable for logic update loop only in debug
-  FpuExceptionsEnablerDebug();
+  uint stepCount = BeginUpdate(dt);
+
+  for (uint i = 0; i < stepCount; ++i)
+  {
+    FrameStep();
+
+    if (!GetGloballyPaused())
+    {
+      // Enable for logic update loop only in debug
+      FpuExceptionsEnablerDebug();
+      TimeSpaceEventScope eventScope(this);
+      Step();
+    }
+  }
 
-  Space* space = GetSpace();
+  EndUpdate();
+}
 
-  // If this is a preview space and we're sending out update (should include any
-  // special preview update) we don't want notifications to happen which we're
-  // previewing, as its very annoying to the user
-  NotificationCallback notify = nullptr;
-  if (space->IsPreviewMode())
-    notify = IgnoreDoNotify;
-  TemporaryDoNotifyOverride doNotifyOverride(notify);
-  Array<NotificationCallback>& cb = Z::gNotifyCallbackStack;
-  space->CheckForChangedObjects();
+uint TimeSpace::BeginUpdate(float dt)
+{
+  FpuExceptionsEnablerDebug();
+  TimeSpaceEventScope eventScope(this);
 
-  // push on id of this space for the debug drawer so anyone who debug
-  // draws will by default be in the correct space.
-  // Debug::DefaultConfig config;
-  // config.SpaceId(this->GetOwner()->GetId().Id);
-  Debug::ActiveDrawSpace drawSpace(GetOwner()->GetId().Id);
+  GetSpace()->CheckForChangedObjects();
 
   mRealDt = dt;
 
@@ -172,43 +203,74 @@ void TimeSpace::Update(float dt)
 
   // We don't want the engine to lock down, so cap it at 60 steps per update
   mStepCount = Math::Clamp(mStepCount, 1u, 60u);
+  return mStepCount;
+}
 
-  for (uint i = 0; i < mStepCount; ++i)
-  {
-    ++mFrame;
+void TimeSpace::FrameStep()
+{
+  FpuExceptionsEnablerDebug();
+  TimeSpaceEventScope eventScope(this);
 
-    mRealTimePassed += mRealDt;
-    mScaledClampedTimePassed += mScaledClampedDt;
+  ++mFrame;
 
-    EventDispatcher* dispatcher = GetOwner()->GetDispatcher();
-    UpdateEvent updateEvent(mScaledClampedDt, mRealDt, mScaledClampedTimePassed, mRealTimePassed);
+  mRealTimePassed += mRealDt;
+  mScaledClampedTimePassed += mScaledClampedDt;
 
-    {
-      ProfileScopeTree("FrameUpdate", "TimeSystem", Color::PaleGoldenrod);
-      dispatcher->Dispatch(Events::FrameUpdate, &updateEvent);
-    }
+  EventDispatcher* dispatcher = GetOwner()->GetDispatcher();
+  UpdateEvent updateEvent(mScaledClampedDt, mRealDt, mScaledClampedTimePassed, mRealTimePassed);
 
-    {
-      ProfileScopeTree("ActionFrameUpdateEvent", "TimeSystem", Color::BlueViolet);
-      dispatcher->Dispatch(Events::ActionFrameUpdate, &updateEvent);
-    }
+  {
+    ProfileScopeTree("FrameUpdate", "TimeSystem", Color::PaleGoldenrod);
+    dispatcher->Dispatch(Events::FrameUpdate, &updateEvent);
+  }
 
-    if (space->IsPreviewMode())
-    {
-      ProfileScopeTree("PreviewUpdateEvent", "TimeSystem", Color::Gainsboro);
-      dispatcher->Dispatch(Events::PreviewUpdate, &updateEvent);
-    }
+  {
+    ProfileScopeTree("ActionFrameUpdateEvent", "TimeSystem", Color::BlueViolet);
+    dispatcher->Dispatch(Events::ActionFrameUpdate, &updateEvent);
+  }
 
-    if (!GetGloballyPaused())
-      Step();
+  if (GetSpace()->IsPreviewMode())
+  {
+    ProfileScopeTree("PreviewUpdateEvent", "TimeSystem", Color::Gainsboro);
+    dispatcher->Dispatch(Events::PreviewUpdate, &updateEvent);
+  }
 
-    {
-      // ProfileScopeTree("GraphicsFrameUpdate", "TimeSystem", Color::SkyBlue);
-      // dispatcher->Dispatch(Events::GraphicsFrameUpdate, &updateEvent);
-    }
+  {
+    // ProfileScopeTree("GraphicsFrameUpdate", "TimeSystem", Color::SkyBlue);
+    // dispatcher->Dispatch(Events::GraphicsFrameUpdate, &updateEvent);
   }
 }
 
+void TimeSpace::PreConcurrentStep()
+{
+  TimeSpaceEventScope eventScope(this);
+
+  EventDispatcher* dispatcher = GetOwner()->GetDispatcher();
+  UpdateEvent updateEvent(mScaledClampedDt, mRealDt, mScaledClampedTimePassed, mRealTimePassed);
+  dispatcher->Dispatch(Events::PreConcurrentSystemLogicUpdate, &updateEvent);
+}
+
+void TimeSpace::ConcurrentStep()
+{
+  // The notification and debug draw stacks are global, so they aren't pushed
+  // here. Listeners must not notify or debug draw.
+  FpuExceptionsEnablerDebug();
+
+  EventDispatcher* dispatcher = GetOwner()->GetDispatcher();
+  UpdateEvent updateEvent(mScaledClampedDt, mRealDt, mScaledClampedTimePassed, mRealTimePassed);
+
+  ProfileScopeTree("ConcurrentSystemLogicUpdate", "TimeSystem", Color::SteelBlue);
+  dispatcher->Dispatch(Events::ConcurrentSystemLogicUpdate, &updateEvent);
+}
+
+void TimeSpace::EndUpdate()
+{
+  // Everything that moves objects has run, compute all the world matrices
+  // that were invalidated this frame at once
+  ProfileScopeTree("WorldMatrixUpdate", "TimeSystem", Color::LightSteelBlue);
+  GetSpace()->mWorldMatrixUpdater.Update();
+}
+
 void TimeSpace::TogglePause()
 {
   mPaused = !mPaused;
@@ -229,6 +291,15 @@ void TimeSpace::Step()
     dispatcher->Dispatch(Events::SystemLogicUpdate, &updateEvent);
   }
 
+  // Animation graphs update their nodes first, then every queued pose is
+  // evaluated and applied (and the graphs' events sent) before LogicUpdate so
+  // script sees this frame's pose
+  {
+    ProfileScopeTree("AnimationPoseUpdate", "TimeSystem", Color::Plum);
+    dispatcher->Dispatch(Events::AnimationLogicUpdate, &updateEvent);
+    GetSpace()->mAnimationPoseUpdater.Update();
+  }
+
   {
     ProfileScopeTree("LogicUpdate", "TimeSystem", Color::Gainsboro);
     dispatcher->Dispatch(Events::LogicUpdate, &updateEvent);
@@ -250,6 +321,20 @@ void TimeSpace::SetTimeMode(TimeMode::Enum value)
   mTimeMode = value;
 }
 
+// Concurrent Step Job
+class ConcurrentStepJob : public Job
+{
+public:
+  void Execute() override
+  {
+    mTimeSpace->ConcurrentStep();
+    mCountdownEvent->DecrementCount();
+  }
+
+  TimeSpace* mTimeSpace;
+  CountdownEvent* mCountdownEvent;
+};
+
 ZilchDefineType(TimeSystem, builder, type)
 {
 }
@@ -259,6 +344,7 @@ void TimeSystem::Initialize(SystemInitializer& initializer)
   ConnectThisTo(Z::gEngine, Events::ProjectLoaded, OnProjectLoaded);
   mLimitFrameRate = true;
   mFrameRate = 60;
+  mParallelIsolatedSpaces = Environment::GetValue<bool>("ParallelSpaces", false);
 
   // Set the time frequency to 1 ms. If the frame limiter is active
   // it needs a high frequency to prevent sleep from waiting too long
@@ -271,6 +357,7 @@ TimeSystem::TimeSystem()
 {
   mEngineDt = 0.0f;
   mEngineRuntime = 0.0;
+  mParallelIsolatedSpaces = false;
 }
 
 TimeSystem::~TimeSystem()
@@ -319,19 +406,131 @@ void TimeSystem::Update(bool debugger)
 
   if (!debugger)
   {
-    // Update every space in the engine
-    TimeSpaceList::range range = List.All();
-    for (; !range.Empty(); range.PopFront())
+    if (mParallelIsolatedSpaces)
     {
-      TimeSpace& timeSpace = range.Front();
-      timeSpace.Update(dt);
+      UpdateSpacesInParallel(dt);
+    }
+    else
+    {
+      // Update every space in the engine
+      TimeSpaceList::range range = List.All();
+      for (; !range.Empty(); range.PopFront())
+      {
+        TimeSpace& timeSpace = range.Front();
+        timeSpace.Update(dt);
+      }
     }
   }
 
+  // Anything queued outside of a parallel update still goes out this frame
+  mCrossSpaceEvents.DispatchEvents();
+
   UpdateEvent uiUpdate(dt, 0, 0, 0);
   GetDispatcher()->Dispatch("UiUpdate", &uiUpdate);
 }
 
+void TimeSystem::QueueCrossSpaceEvent(Cog* target, StringParam eventId, Event* event)
+{
+  mCrossSpaceEvents.Queue(target, eventId, event);
+}
+
+void TimeSystem::UpdateSpacesInParallel(float dt)
+{
+  // Spaces that aren't isolated are updated one after another as usual
+  Array<TimeSpace*> isolatedSpaces;
+  TimeSpaceList::range range = List.All();
+  for (; !range.Empty(); range.PopFront())
+  {
+    TimeSpace& timeSpace = range.Front();
+    if (timeSpace.mIsolated && !timeSpace.GetSpace()->IsEditorMode())
+      isolatedSpaces.PushBack(&timeSpace);
+    else
+      timeSpace.Update(dt);
+  }
+
+  if (isolatedSpaces.Size() < 2)
+  {
+    forRange (TimeSpace* timeSpace, isolatedSpaces.All())
+      timeSpace->Update(dt);
+    return;
+  }
+
+  ProfileScopeTree("ParallelSpaces", "TimeSystem", Color::SteelBlue);
+
+  // Spaces can have different step counts, a space only takes part in the
+  // steps it would have run on its own
+  Array<uint> stepCounts;
+  uint maxStepCount = 0;
+  forRange (TimeSpace* timeSpace, isolatedSpaces.All())
+  {
+    uint stepCount = timeSpace->BeginUpdate(dt);
+    stepCounts.PushBack(stepCount);
+    maxStepCount = Math::Max(maxStepCount, stepCount);
+  }
+
+  Array<TimeSpace*> steppingSpaces;
+  for (uint step = 0; step < maxStepCount; ++step)
+  {
+    steppingSpaces.Clear();
+    for (size_t i = 0; i < isolatedSpaces.Size(); ++i)
+    {
+      if (step >= stepCounts[i])
+        continue;
+
+      TimeSpace* timeSpace = isolatedSpaces[i];
+      timeSpace->FrameStep();
+      if (!timeSpace->GetGloballyPaused())
+        steppingSpaces.PushBack(timeSpace);
+    }
+
+    RunConcurrentSteps(steppingSpaces);
+
+    // Sync point, everything sent between spaces during the concurrent part
+    // of the step arrives before any script logic runs
+    mCrossSpaceEvents.DispatchEvents();
+
+    forRange (TimeSpace* timeSpace, steppingSpaces.All())
+    {
+      FpuExceptionsEnablerDebug();
+      TimeSpaceEventScope eventScope(timeSpace);
+      timeSpace->Step();
+    }
+  }
+
+  forRange (TimeSpace* timeSpace, isolatedSpaces.All())
+    timeSpace->EndUpdate();
+}
+
+void TimeSystem::RunConcurrentSteps(Array<TimeSpace*>& timeSpaces)
+{
+  if (timeSpaces.Empty())
+    return;
+
+  ProfileScopeTree("ConcurrentSteps", "TimeSystem", Color::SteelBlue);
+
+  // Anything that has to happen on the main thread before a space steps
+  forRange (TimeSpace* timeSpace, timeSpaces.All())
+    timeSpace->PreConcurrentStep();
+
+  // World matrices can be cached from any of the spaces while they step
+  Transform::sLockCachedWorldMatrices = true;
+
+  CountdownEvent countdownEvent;
+  forRange (TimeSpace* timeSpace, timeSpaces.All())
+  {
+    countdownEvent.IncrementCount();
+
+    ConcurrentStepJob* job = new ConcurrentStepJob();
+    job->mTimeSpace = timeSpace;
+    job->mCountdownEvent = &countdownEvent;
+    job->mRunImmediateWhenThreadingDisabled = true;
+    Z::gJobs->AddJob(job);
+  }
+  countdownEvent.Wait();
+
+  Transform::sLockCachedWorldMatrices = false;
+}
+
 float TimeSystem::GetTargetDt() const
 {
   return 1.0f / mFrameRate;
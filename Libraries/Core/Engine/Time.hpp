@@ -7,6 +7,8 @@ namespace Zero
 namespace Events
 {
 DeclareEvent(SystemLogicUpdate);
+DeclareEvent(PreConcurrentSystemLogicUpdate);
+DeclareEvent(ConcurrentSystemLogicUpdate);
 DeclareEvent(FrameUpdate);
 // DeclareEvent(GraphicsFrameUpdate);
 DeclareEvent(LogicUpdate);
@@ -16,6 +18,7 @@ DeclareEvent(EngineDebuggerUpdate);
 DeclareEvent(EngineShutdown);
 DeclareEvent(ActionFrameUpdate);
 DeclareEvent(ActionLogicUpdate);
+DeclareEvent(AnimationLogicUpdate);
 } // namespace Events
 
 extern const float cFixedDt;
@@ -63,6 +66,22 @@ public:
 
   void Update(float dt);
 
+  // The phases of Update. Between FrameStep and Step, isolated spaces being
+  // updated in parallel run ConcurrentStep on the job system.
+
+  /// Computes the frame's dt and returns how many steps to run.
+  uint BeginUpdate(float dt);
+  /// Advances time and sends the frame events for one step.
+  void FrameStep();
+  /// Sends PreConcurrentSystemLogicUpdate on the main thread right before the
+  /// concurrent step is started.
+  void PreConcurrentStep();
+  /// Sends ConcurrentSystemLogicUpdate. Called from a worker thread, so only
+  /// native systems that don't touch anything outside of the space may listen.
+  void ConcurrentStep();
+  /// Computes the world matrices invalidated during the update.
+  void EndUpdate();
+
   /// Toggles the state of paused.
   void TogglePause();
   void SetPaused(bool state);
@@ -145,6 +164,13 @@ public:
   /// Causes the engine to update multiple times before rendering a frame.
   uint mStepCount;
 
+  /// The space doesn't interact with objects or events in other spaces during
+  /// its update. When parallel space updates are enabled ('ParallelSpaces' on
+  /// the command line) the systems of isolated spaces are updated concurrently.
+  /// Events to other spaces should be sent with
+  /// TimeSystem::QueueCrossSpaceEvent.
+  bool mIsolated;
+
   // Internals
   Link<TimeSpace> link;
   TimeSystem* mTimeSystem;
@@ -185,9 +211,21 @@ public:
   bool mLimitFrameRate;
   uint mFrameRate;
 
+  /// Whether isolated spaces are updated concurrently.
+  bool mParallelIsolatedSpaces;
+
+  /// Sends an event to an object in another space once the spaces being
+  /// updated concurrently have synced back up. Safe to call from any thread,
+  /// takes ownership of the event.
+  void QueueCrossSpaceEvent(Cog* target, StringParam eventId, Event* event);
+
 private:
+  void UpdateSpacesInParallel(float dt);
+  void RunConcurrentSteps(Array<TimeSpace*>& timeSpaces);
+
   // Main system timer
   Timer mTimer;
+  CrossSpaceEventQueue mCrossSpaceEvents;
 };
 
 } // namespace Zero
@@ -98,12 +98,15 @@ Memory::Pool* Transform::sCachedWorldMatrixPool =
     new Memory::Pool("TransformWorldMatrixCache", Memory::GetRoot(), sizeof(Mat4), 100);
 
 bool Transform::sCacheWorldMatrices = true;
+bool Transform::sLockCachedWorldMatrices = false;
+ThreadLock Transform::sCachedWorldMatrixLock;
 
 ZilchDefineType(Transform, builder, type)
 {
   type->Add(new TransformMetaTransform());
 
   ZeroBindComponent();
+  type->AddAttribute(ObjectAttributes::cPooledStorage);
   ZeroBindDocumented();
   ZeroBindSetup(SetupMode::CallSetDefaults);
   ZilchBindGetterSetterProperty(Translation)->ZeroLocalModificationOverride();
@@ -333,7 +336,7 @@ Mat4 Transform::GetWorldMatrix()
   // Cache it if we should
   if (sCacheWorldMatrices)
   {
-    mCachedWorldMatrix = (Mat4*)sCachedWorldMatrixPool->Allocate(sizeof(Mat4));
+    mCachedWorldMatrix = AllocateCachedMatrix();
     *mCachedWorldMatrix = worldMatrix;
   }
 
@@ -551,6 +554,34 @@ void Transform::SetLocalTranslationInternal(Vec3Param localTranslation)
   SetDirty();
 }
 
+void Transform::SetLocalTransform(Vec3Param localTranslation, QuatParam localRotation, Vec3Param localScale)
+{
+  uint flags = 0;
+  if (localTranslation != Translation)
+    flags |= TransformUpdateFlags::Translation;
+  if (localRotation != Rotation)
+    flags |= TransformUpdateFlags::Rotation;
+  if (localScale != Scale)
+    flags |= TransformUpdateFlags::Scale;
+
+  if (flags == 0)
+    return;
+
+  Mat4 oldMat;
+  if (IsInitialized())
+    oldMat = GetWorldMatrix();
+
+  if (flags & TransformUpdateFlags::Scale)
+    SetLocalScaleInternal(localScale);
+  if (flags & TransformUpdateFlags::Rotation)
+    SetLocalRotationInternal(localRotation.Normalized());
+  if (flags & TransformUpdateFlags::Translation)
+    SetLocalTranslationInternal(localTranslation);
+
+  if (IsInitialized())
+    Update(flags, oldMat);
+}
+
 Vec3 Transform::GetWorldScale()
 {
   if (!InWorld && TransformParent)
@@ -772,14 +803,12 @@ void Transform::SetDirty()
   if (mCachedWorldMatrix == nullptr)
     return;
 
-  // Free the memory
-  FreeCachedMatrix();
+  // Only the top of the dirtied subtree is queued, the space recomputes
+  // everything below it in one batch
+  if (Space* space = GetSpace())
+    space->mWorldMatrixUpdater.AddDirtyRoot(this);
 
-  forRange (Cog& child, GetOwner()->GetChildren())
-  {
-    if (Transform* t = child.has(Transform))
-      t->SetDirty();
-  }
+  FreeCachedMatrices();
 }
 
 Vec3 Transform::ClampTranslation(Space* space, Cog* owner, Vec3 translation)
@@ -943,15 +972,55 @@ Aabb FromMatrix(Mat4Param worldMatrix, Vec3Param extents, Vec3Param translation)
   return aabb;
 }
 
+void Transform::FreeCachedMatrices()
+{
+  // Don't need to do anything if we're already dirty
+  if (mCachedWorldMatrix == nullptr)
+    return;
+
+  // Free the memory
+  FreeCachedMatrix();
+
+  forRange (Cog& child, GetOwner()->GetChildren())
+  {
+    if (Transform* t = child.has(Transform))
+      t->FreeCachedMatrices();
+  }
+}
+
 void Transform::FreeCachedMatrix()
 {
   // If we have a cached world matrix then deallocate it
   if (mCachedWorldMatrix != nullptr)
   {
-    sCachedWorldMatrixPool->Deallocate(mCachedWorldMatrix, sizeof(Mat4));
+    DeallocateCachedMatrix(mCachedWorldMatrix);
     // Make sure to always null out the cached matrix to prevent double frees
     mCachedWorldMatrix = nullptr;
   }
 }
 
+Mat4* Transform::AllocateCachedMatrix()
+{
+  if (!sLockCachedWorldMatrices)
+    return (Mat4*)sCachedWorldMatrixPool->Allocate(sizeof(Mat4));
+
+  sCachedWorldMatrixLock.Lock();
+  Mat4* matrix = (Mat4*)sCachedWorldMatrixPool->Allocate(sizeof(Mat4));
+  sCachedWorldMatrixLock.Unlock();
+  return matrix;
+}
+
+void Transform::DeallocateCachedMatrix(Mat4* matrix)
+{
+  if (!sLockCachedWorldMatrices)
+  {
+    sCachedWorldMatrixPool->Deallocate(matrix, sizeof(Mat4));
+    return;
+  }
+
+  sCachedWorldMatrixLock.Lock();
+  sCachedWorldMatrixPool->Deallocate(matrix, sizeof(Mat4));
+  sCachedWorldMatrixLock.Unlock();
+}
+
 } // namespace Zero
@@ -35,6 +35,10 @@ public:
   /// important for memory restrictive platforms.
   static bool sCacheWorldMatrices;
   static Memory::Pool* sCachedWorldMatrixPool;
+  /// The pool is shared by every space, so it has to be locked while spaces
+  /// are being updated concurrently.
+  static bool sLockCachedWorldMatrices;
+  static ThreadLock sCachedWorldMatrixLock;
 
   /// Constructor / Destructor.
   Transform();
@@ -92,6 +96,9 @@ public:
   Vec3 GetLocalTranslation();
   void SetLocalTranslation(Vec3Param localTranslation);
   void SetLocalTranslationInternal(Vec3Param localTranslation);
+  /// Sets all of the local values at once, sending a single transform update
+  /// for the ones that changed.
+  void SetLocalTransform(Vec3Param localTranslation, QuatParam localRotation, Vec3Param localScale);
 
   /// Scale in World Space.
   Vec3 GetWorldScale();
@@ -153,7 +160,8 @@ public:
   void SetInWorld(bool state);
   bool GetInWorld();
 
-  /// Free's the cached world matrix for this and all child objects.
+  /// Free's the cached world matrix for this and all child objects. They are
+  /// recomputed by the space at the end of the frame or when first requested.
   void SetDirty();
 
   /// Clamps a translation value between the max values on the space.
@@ -163,8 +171,14 @@ public:
   Transform* TransformParent;
 
 private:
+  friend class WorldMatrixBatch;
+  friend class WorldMatrixUpdater;
+
   void OnDestroy(uint flags = 0) override;
   void FreeCachedMatrix();
+  void FreeCachedMatrices();
+  static Mat4* AllocateCachedMatrix();
+  static void DeallocateCachedMatrix(Mat4* matrix);
 
   /// If null, the matrix is dirty.
   Mat4* mCachedWorldMatrix;
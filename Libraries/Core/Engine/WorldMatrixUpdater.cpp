@@ -0,0 +1,188 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+// Below this many transforms it's faster to compute everything on the main
+// thread than to wake up the workers.
+const size_t cWorldMatrixTransformsPerJob = 512;
+
+// World Matrix Batch
+void WorldMatrixBatch::Compute()
+{
+  size_t count = mTransforms.Size();
+  mLocals.Resize(count);
+  mWorlds.Resize(count);
+
+  for (size_t i = 0; i < count; ++i)
+    mLocals[i] = mTransforms[i]->GetLocalMatrix();
+
+  // Only reads and writes the batch's own arrays. Parents always come first
+  for (size_t i = 0; i < count; ++i)
+  {
+    int parentIndex = mParents[i];
+    if (parentIndex >= 0)
+      mWorlds[i] = Math::Multiply(mWorlds[parentIndex], mLocals[i]);
+    else if (i == 0)
+      mWorlds[i] = Math::Multiply(mRootParentWorld, mLocals[i]);
+    else
+      mWorlds[i] = mLocals[i];
+  }
+
+  for (size_t i = 0; i < count; ++i)
+    *mTransforms[i]->mCachedWorldMatrix = mWorlds[i];
+}
+
+// World Matrix Job
+class WorldMatrixJob : public Job
+{
+public:
+  void Execute() override
+  {
+    for (size_t i = mBegin; i < mEnd; ++i)
+      (*mBatches)[i].Compute();
+
+    mCountdownEvent->DecrementCount();
+  }
+
+  Array<WorldMatrixBatch>* mBatches;
+  size_t mBegin;
+  size_t mEnd;
+  CountdownEvent* mCountdownEvent;
+};
+
+// World Matrix Updater
+void WorldMatrixUpdater::AddDirtyRoot(Transform* transform)
+{
+  mDirtyRoots.PushBack(transform->GetOwner());
+}
+
+void WorldMatrixUpdater::Update()
+{
+  if (mDirtyRoots.Empty())
+    return;
+
+  if (!Transform::sCacheWorldMatrices)
+  {
+    mDirtyRoots.Clear();
+    return;
+  }
+
+  // A root recorded earlier in the frame can have had its parent dirtied
+  // since, so walk up to the top most dirty transform first. Doing this for all
+  // roots before gathering guarantees that the parent of every batch root is
+  // already computed.
+  Array<Transform*> roots;
+  roots.Reserve(mDirtyRoots.Size());
+  forRange (CogId& id, mDirtyRoots.All())
+  {
+    Cog* cog = id.ToCog();
+    if (cog == nullptr)
+      continue;
+
+    Transform* transform = cog->has(Transform);
+    if (transform == nullptr)
+      continue;
+
+    while (!transform->InWorld && transform->TransformParent &&
+           transform->TransformParent->mCachedWorldMatrix == nullptr)
+      transform = transform->TransformParent;
+
+    roots.PushBack(transform);
+  }
+  mDirtyRoots.Clear();
+
+  // Gathering allocates the cached matrices, which also marks transforms as
+  // taken so overlapping or duplicate roots are skipped
+  size_t batchCount = 0;
+  size_t transformCount = 0;
+  forRange (Transform* root, roots.All())
+  {
+    if (root->mCachedWorldMatrix != nullptr)
+      continue;
+
+    if (batchCount == mBatches.Size())
+      mBatches.PushBack();
+
+    WorldMatrixBatch& batch = mBatches[batchCount];
+    GatherBatch(root, batch);
+    transformCount += batch.mTransforms.Size();
+    ++batchCount;
+  }
+
+  if (transformCount < cWorldMatrixTransformsPerJob)
+  {
+    for (size_t i = 0; i < batchCount; ++i)
+      mBatches[i].Compute();
+    return;
+  }
+
+  // Split the batches into jobs of roughly even transform counts
+  CountdownEvent countdownEvent;
+  size_t begin = 0;
+  size_t jobTransformCount = 0;
+  for (size_t i = 0; i < batchCount; ++i)
+  {
+    jobTransformCount += mBatches[i].mTransforms.Size();
+    if (jobTransformCount < cWorldMatrixTransformsPerJob && i + 1 != batchCount)
+      continue;
+
+    countdownEvent.IncrementCount();
+
+    WorldMatrixJob* job = new WorldMatrixJob();
+    job->mBatches = &mBatches;
+    job->mBegin = begin;
+    job->mEnd = i + 1;
+    job->mCountdownEvent = &countdownEvent;
+    job->mRunImmediateWhenThreadingDisabled = true;
+    Z::gJobs->AddJob(job);
+
+    begin = i + 1;
+    jobTransformCount = 0;
+  }
+
+  // The jobs write directly into the transforms so nothing can touch the
+  // hierarchy until they're done
+  countdownEvent.Wait();
+}
+
+void WorldMatrixUpdater::GatherBatch(Transform* root, WorldMatrixBatch& batch)
+{
+  batch.mTransforms.Clear();
+  batch.mParents.Clear();
+
+  if (!root->InWorld && root->TransformParent)
+    batch.mRootParentWorld = root->TransformParent->GetWorldMatrix();
+  else
+    batch.mRootParentWorld = Mat4::cIdentity;
+
+  root->mCachedWorldMatrix = Transform::AllocateCachedMatrix();
+  batch.mTransforms.PushBack(root);
+  batch.mParents.PushBack(-1);
+
+  // Breadth first so that every parent is computed before its children
+  for (size_t i = 0; i < batch.mTransforms.Size(); ++i)
+  {
+    Transform* parent = batch.mTransforms[i];
+    forRange (Cog& child, parent->GetOwner()->GetChildren())
+    {
+      Transform* transform = child.has(Transform);
+
+      // Children that aren't attached to this transform yet are left to be
+      // computed lazily
+      if (transform == nullptr || transform->TransformParent != parent)
+        continue;
+
+      // In world children can still be cached under a dirty parent
+      if (transform->mCachedWorldMatrix != nullptr)
+        continue;
+
+      transform->mCachedWorldMatrix = Transform::AllocateCachedMatrix();
+      batch.mTransforms.PushBack(transform);
+      batch.mParents.PushBack(transform->InWorld ? -1 : (int)i);
+    }
+  }
+}
+
+} // namespace Zero
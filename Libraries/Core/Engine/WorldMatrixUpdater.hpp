@@ -0,0 +1,61 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+class Transform;
+
+// World Matrix Batch
+/// A dirty transform subtree flattened in breadth-first order. Parents always
+/// come before their children so the world matrices can be computed in a
+/// single linear pass.
+class WorldMatrixBatch
+{
+public:
+  /// Reads the local matrices into mLocals, computes mWorlds in one pass over
+  /// the batch's arrays and then writes every world matrix into the
+  /// transform's cached world matrix. Safe to call from any thread as long as
+  /// the hierarchy isn't being modified.
+  void Compute();
+
+  /// World matrix of the root's parent (identity when the root doesn't
+  /// inherit from its parent).
+  Mat4 mRootParentWorld;
+  Array<Transform*> mTransforms;
+  /// Index of each transform's parent in this batch. The root and in world
+  /// transforms don't depend on a parent in the batch and store -1.
+  Array<int> mParents;
+  /// Local and world matrix of each transform, kept between frames to avoid
+  /// re-allocating.
+  Array<Mat4> mLocals;
+  Array<Mat4> mWorlds;
+};
+
+// World Matrix Updater
+/// Tracks the transforms in a space whose cached world matrices have been
+/// freed and recomputes all of them once per frame instead of lazily walking
+/// up the parent chain for each one. Independent subtrees are computed on the
+/// job system. Only used when Transform::sCacheWorldMatrices is enabled.
+class WorldMatrixUpdater
+{
+public:
+  /// Called when a transform's cached world matrix is freed while its parent's
+  /// is still cached (the top of a dirtied subtree).
+  void AddDirtyRoot(Transform* transform);
+
+  /// Recomputes every dirty world matrix in the space.
+  void Update();
+
+private:
+  /// Builds a batch for the dirty subtree under the given transform and
+  /// allocates the cached matrices the batch will write to.
+  void GatherBatch(Transform* root, WorldMatrixBatch& batch);
+
+  /// Stored as ids since the objects can be destroyed before the update.
+  Array<CogId> mDirtyRoots;
+  /// Kept between frames to avoid re-allocating.
+  Array<WorldMatrixBatch> mBatches;
+};
+
+} // namespace Zero
@@ -423,6 +423,9 @@ public:
   {
     Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+    // Follows the animation as it plays
+    NeedsRedraw();
+
     Array<StreamedVertex> lines;
 
     DrawVerticalLines(viewBlock, frameBlock, clipRect, lines);
@@ -1020,6 +1020,9 @@ void ScrubberDrawer::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // The play head moves while the animation plays
+  NeedsRedraw();
+
   Array<StreamedVertex> lines;
 
   DrawHashMarks(viewBlock, frameBlock, clipRect, lines);
@@ -4,15 +4,42 @@
 namespace Zero
 {
 
+// Keeps the archive being written from being scanned into itself when it's
+// saved inside the project folder
+class ArchiveDestinationFilter : public FileFilter
+{
+public:
+  String mDestination;
+
+  ArchiveDestinationFilter(StringParam destination) : mDestination(FilePath::Normalize(destination))
+  {
+  }
+
+  FilterResult::Enum Filter(StringParam filename) override
+  {
+    if (FilePath::Normalize(filename) == mDestination)
+      return FilterResult::Ignore;
+    return FilterResult::Include;
+  }
+};
+
 void ArchiveProjectFile(Cog* projectCog, StringParam filename)
 {
   ProjectSettings* project = projectCog->has(ProjectSettings);
   String projectDirectory = project->ProjectFolder;
 
+  // Entries are written as they're compressed so the project is never held
+  // in memory
+  File file;
+  file.Open(filename, FileMode::Write, FileAccessPattern::Sequential);
+
   Status status;
+  ArchiveDestinationFilter filter(filename);
   Archive projectArchive(ArchiveMode::Compressing);
-  projectArchive.ArchiveDirectory(status, projectDirectory);
-  projectArchive.WriteZipFile(filename);
+  projectArchive.BeginStreaming(file);
+  projectArchive.ArchiveDirectory(status, projectDirectory, String(), &filter);
+  projectArchive.EndStreaming();
+  file.Close();
   Download(filename);
 }
 
@@ -232,10 +232,15 @@ void BugReportJob::Execute()
   {
     String projectDirectory = project->ProjectFolder;
 
+    File file;
+    file.Open(mFileName, FileMode::Write, FileAccessPattern::Sequential);
+
     Status status;
     Archive projectArchive(ArchiveMode::Compressing);
+    projectArchive.BeginStreaming(file);
     projectArchive.ArchiveDirectory(status, projectDirectory);
-    projectArchive.WriteZipFile(mFileName);
+    projectArchive.EndStreaming();
+    file.Close();
 
     ++fileCount;
     request.AddFile(BuildString("File", ToString(fileCount)), mFileName);
@@ -134,6 +134,9 @@ void GradientKeyDrawer::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // Keys are dragged without marking
+  NeedsRedraw();
+
   Array<StreamedVertex> lines;
   Array<StreamedVertex> triangles;
 
@@ -67,8 +67,12 @@ void LoadContentPackageListing(ContentPackageListing& listing, StringParam filen
 
 void ExportContentPackageListing(ContentPackageListing& listing, StringParam filename)
 {
-  // Start compressing files to an archive
+  // Start compressing files to an archive, each file is written out as soon
+  // as it's compressed
+  File file;
+  file.Open(filename, FileMode::Write, FileAccessPattern::Sequential);
   Archive archive(ArchiveMode::Compressing);
+  archive.BeginStreaming(file);
 
   forRange (ContentPackageEntry* entry, listing.Entries.Values())
   {
@@ -87,8 +91,9 @@ void ExportContentPackageListing(ContentPackageListing& listing, StringParam fil
     }
   }
 
-  // Write out the zip file
-  archive.WriteZipFile(filename);
+  // Finish the zip file
+  archive.EndStreaming();
+  file.Close();
 }
 
 void ImportContentPackageListing(ContentPackageListing& listing, ContentLibrary* library, StringParam filename)
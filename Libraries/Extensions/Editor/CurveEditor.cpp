@@ -138,6 +138,9 @@ void CurveDrawer::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // Drawn straight from the curve being edited
+  NeedsRedraw();
+
   if (!mCurveEditor->mEnabled)
     return;
 
@@ -712,19 +712,16 @@ void Editor::OnProjectFileModified(FileEditEvent* e)
   if (mProjectLibrary == nullptr)
     return;
 
-  // Walk through each content item in the loaded library and find any
-  // files we need to reload
-  forRange (ContentItem* contentItem, mProjectLibrary->GetContentItems())
-  {
-    if (contentItem->Filename == e->FileName)
-    {
-      String filePath = contentItem->GetFullPath();
+  // Only the content item for the changed file is rebuilt
+  ContentItem* contentItem = mProjectLibrary->FindContentItemByFileName(e->FileName);
+  if (contentItem == nullptr)
+    return;
 
-      // Don't reload it if we were the one that modified it
-      if (!FileModifiedState::HasModifiedSinceTime(filePath, e->TimeStamp))
-        ReloadContentItem(contentItem);
-    }
-  }
+  String filePath = contentItem->GetFullPath();
+
+  // Don't reload it if we were the one that modified it
+  if (!FileModifiedState::HasModifiedSinceTime(filePath, e->TimeStamp))
+    ReloadContentItem(contentItem);
 }
 
 PropertyView* Editor::GetPropertyView()
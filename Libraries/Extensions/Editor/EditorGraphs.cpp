@@ -220,12 +220,45 @@ void EndTracing(Editor* editor)
   new SimpleSaveFileDialog(compressedData, "Save a trace", "Trace Zip File", "*.zip", "zip", defaultFileName);
 }
 
+void BeginSampling(Editor* editor)
+{
+  Profile::SamplingProfiler* profiler = Profile::SamplingProfiler::Instance;
+  profiler->Clear();
+
+  Status status;
+  if (!profiler->Start(status))
+    DoNotifyWarning("Sampling", status.Message);
+}
+
+void EndSampling(Editor* editor)
+{
+  Profile::SamplingProfiler* profiler = Profile::SamplingProfiler::Instance;
+  if (!profiler->IsRunning())
+    return;
+
+  profiler->Stop();
+  ZPrint("Sampled %llu stacks (%llu dropped)\n",
+         (u64)profiler->GetSampleCount(),
+         (u64)profiler->GetDroppedSampleCount());
+
+  // Folded stacks can be opened with speedscope or turned into a flame graph
+  // with flamegraph.pl
+  String foldedStacks = profiler->GetFoldedStacks();
+
+  ProjectSettings* project = Z::gEditor->mProject.has(ProjectSettings);
+  String defaultFileName = BuildString(project->ProjectName, "-", GetTimeAndDateStamp(), ".folded");
+  new SimpleSaveFileDialog(
+      foldedStacks, "Save the sampled stacks", "Folded Stacks File", "*.folded", "folded", defaultFileName);
+}
+
 void SetupGraphCommands(Cog* configCog, CommandManager* commands)
 {
   commands->AddCommand("Performance", BindCommandFunction(AddPerformance), true);
   commands->AddCommand("Graph", BindCommandFunction(AddGraph), true);
   commands->AddCommand("BeginTracing", BindCommandFunction(BeginTracing), true);
   commands->AddCommand("EndTracing", BindCommandFunction(EndTracing), true);
+  commands->AddCommand("BeginSampling", BindCommandFunction(BeginSampling), true);
+  commands->AddCommand("EndSampling", BindCommandFunction(EndSampling), true);
 }
 
 } // namespace Zero
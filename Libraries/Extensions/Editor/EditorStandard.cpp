@@ -96,6 +96,7 @@ ZilchDefineStaticLibrary(EditorLibrary)
   ZilchInitializeType(MessageBoxEvent);
   ZilchInitializeType(ColorEvent);
   ZilchInitializeType(TextEditorEvent);
+  ZilchInitializeType(FindTextIndexEvent);
   ZilchInitializeType(ObjectPollEvent);
   ZilchInitializeType(GizmoEvent);
   ZilchInitializeType(GizmoUpdateEvent);
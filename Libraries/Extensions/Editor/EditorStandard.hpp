@@ -158,6 +158,7 @@ public:
 #include "NotificationUi.hpp"
 #include "NetPropertyIcon.hpp"
 #include "Loading.hpp"
+#include "FindTextIndex.hpp"
 #include "FindDialog.hpp"
 #include "MetaDrop.hpp"
 #include "LibraryView.hpp"
@@ -19,6 +19,9 @@ void PerformanceGraphWidget::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // Profile samples change every frame
+  NeedsRedraw();
+
   mGraphPos = mTranslation + Vec3(1, 1, 0);
   mGraphSize = Vec3(mSize) + Vec3(-2, -2, 0);
 
@@ -276,6 +279,8 @@ void MemoryGraphWidget::RenderUpdate(
     ViewBlock& viewBlock, FrameBlock& frameBlock, Mat4Param parentTx, ColorTransform colorTx, WidgetRect clipRect)
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
+  // Memory usage changes every frame
+  NeedsRedraw();
   DrawMemoryGraph(Vec3(1, 0, 0), Memory::GetRoot(), mSize.x, 0, viewBlock, frameBlock, parentTx, clipRect);
 }
 
@@ -42,7 +42,7 @@ DeclareEnum3(CharacterMode, Normal, Extended, Regex);
 DeclareEnum4(LookIn, CurrentDocument, AllOpenDocuments, EntireProject, CurrentScope);
 
 // Constructor
-FindTextDialog::FindTextDialog(Composite* parent) : Composite(parent)
+FindTextDialog::FindTextDialog(Composite* parent) : Composite(parent), mIndex(this)
 {
   // Finally, set this to be a stacking layout
   this->SetLayout(CreateStackLayout(LayoutDirection::TopToBottom, Vec2(0, 2), Thickness::cZero));
@@ -139,6 +139,16 @@ FindTextDialog::FindTextDialog(Composite* parent) : Composite(parent)
   mRegexFlavor->SetSelectedItem(RegexFlavor::EcmaScript, true);
 
   ConnectThisTo(this, Events::KeyDown, OnKeyDown);
+
+  // Index the project in the background so searching it doesn't load and scan
+  // every resource
+  ConnectThisTo(Z::gResources, Events::ResourceAdded, OnResourceAdded);
+  ConnectThisTo(Z::gResources, Events::ResourceModified, OnResourceModified);
+  ConnectThisTo(Z::gResources, Events::ResourceTextModified, OnResourceModified);
+  ConnectThisTo(Z::gResources, Events::ResourceRemoved, OnResourceRemoved);
+  ConnectThisTo(this, Events::FindTextIndexUpdated, OnIndexUpdated);
+  ConnectThisTo(Z::gWidgetManager, Events::WidgetUpdate, OnWidgetUpdate);
+  mIndex.IndexAll();
 }
 
 void FindTextDialog::OnKeyDown(KeyboardEvent* event)
@@ -548,6 +558,12 @@ bool FindTextDialog::GetEntireProjectRegions()
   ResourceSystem* resourceSystem = Z::gResources;
   ResourceSystem::TextResourceMap::valuerange range = resourceSystem->TextResources.Values();
 
+  // The trigrams every match contains, used to skip resources that the index
+  // says can't match (without loading their text)
+  Array<u32> requiredTrigrams;
+  bool canSkip = FindTextIndex::GetRequiredTrigrams(GetFindRegex(), GetFindRegexFlavor(), requiredTrigrams);
+  bool anySkipped = false;
+
   // Loop through all the instances of document resources
   for (; !range.Empty(); range.PopFront())
   {
@@ -567,6 +583,17 @@ bool FindTextDialog::GetEntireProjectRegions()
       continue;
     }
 
+    // Is their a document with an editor for this resource?
+    Document* document = docManager->Documents.FindValue((u64)current->mResourceId, NULL);
+
+    // An editor may have unsaved changes that aren't indexed
+    bool hasEditor = document && document->mEditor;
+    if (canSkip && !hasEditor && !mIndex.MayContain(current->mResourceId, requiredTrigrams))
+    {
+      anySkipped = true;
+      continue;
+    }
+
     // Get the file name
     String fileName = current->mContentItem->GetFullPath();
 
@@ -576,8 +603,7 @@ bool FindTextDialog::GetEntireProjectRegions()
     // Set the region's resource
     region->Resource = current;
 
-    // Is their a document with an editor for this resource?
-    Document* document = docManager->Documents.FindValue((u64)current->mResourceId, NULL);
+    // Use the editor's text if it has one
     if (document && document->mEditor)
     {
       region->WholeText = document->mEditor->GetAllText();
@@ -595,7 +621,7 @@ bool FindTextDialog::GetEntireProjectRegions()
   }
 
   // If no valid script files exist in the project
-  if (mContext->Regions.Empty())
+  if (mContext->Regions.Empty() && !anySkipped)
   {
     // Show an warning and return that we failed
     DoNotifyWarning("Find/Replace Warning", "No script files exist in the project.");
@@ -938,6 +964,20 @@ String FindTextDialog::GetFindRegex()
   }
 }
 
+// Get the flavor of regular expression the find regex is in
+RegexFlavor::Enum FindTextDialog::GetFindRegexFlavor()
+{
+  // The text is escaped for EcmaScript unless we are in fact in regular
+  // expression mode
+  if (mCharacterMode->GetSelectedItem() == CharacterMode::Regex)
+  {
+    // Get the user-selected flavor of the regular expression
+    return (RegexFlavor::Enum)mRegexFlavor->GetSelectedItem();
+  }
+
+  return RegexFlavor::EcmaScript;
+}
+
 // Constructor
 FindTextDialog::SearchRegion::SearchRegion()
 {
@@ -1015,14 +1055,7 @@ void FindTextDialog::DoSearchAndGetContext()
   String findRegex = GetFindRegex();
 
   // The flavor of regular expressions that we'll be using
-  RegexFlavor::Enum regexFlavor = RegexFlavor::EcmaScript;
-
-  // If we are in fact in regular expression mode...
-  if (mCharacterMode->GetSelectedItem() == CharacterMode::Regex)
-  {
-    // Get the user-selected flavor of the regular expression
-    regexFlavor = (RegexFlavor::Enum)mRegexFlavor->GetSelectedItem();
-  }
+  RegexFlavor::Enum regexFlavor = GetFindRegexFlavor();
 
   // If the find regex is not valid...
   if (Regex::Validate(findRegex, regexFlavor, mMatchCase->GetChecked()) == false)
@@ -1188,6 +1221,33 @@ void FindTextDialog::StartSearch(ObjectEvent* event)
   }
 }
 
+void FindTextDialog::OnResourceAdded(ResourceEvent* event)
+{
+  if (Type::DynamicCast<DocumentResource*>(event->EventResource))
+    mIndex.OnResourceChanged(event->EventResource->mResourceId);
+}
+
+void FindTextDialog::OnResourceModified(ResourceEvent* event)
+{
+  if (Type::DynamicCast<DocumentResource*>(event->EventResource))
+    mIndex.OnResourceChanged(event->EventResource->mResourceId);
+}
+
+void FindTextDialog::OnResourceRemoved(ResourceEvent* event)
+{
+  mIndex.OnResourceRemoved(event->EventResource->mResourceId);
+}
+
+void FindTextDialog::OnIndexUpdated(FindTextIndexEvent* event)
+{
+  mIndex.OnJobFinished(event);
+}
+
+void FindTextDialog::OnWidgetUpdate(UpdateEvent* event)
+{
+  mIndex.StartJob();
+}
+
 // Get the console's text editor
 ConsoleUi* GetConsoleTextBox()
 {
@@ -77,6 +77,13 @@ private:
   // Occurs when we click the go button
   void StartSearch(ObjectEvent* event);
 
+  // Keep the project index up to date
+  void OnResourceAdded(ResourceEvent* event);
+  void OnResourceModified(ResourceEvent* event);
+  void OnResourceRemoved(ResourceEvent* event);
+  void OnIndexUpdated(FindTextIndexEvent* event);
+  void OnWidgetUpdate(UpdateEvent* event);
+
   // A search result
   struct SearchResult
   {
@@ -139,6 +146,9 @@ private:
   // options)
   String GetFindRegex();
 
+  // Get the flavor of regular expression the find regex is in
+  RegexFlavor::Enum GetFindRegexFlavor();
+
   // Advance an input string to the end of a line
   static const char* MoveToEol(StringRange wholeString, const char* currentPosition, EolDirection::Enum direction);
 
@@ -217,6 +227,9 @@ private:
   // rebuilt)
   Context* mContext;
 
+  // Skips resources that can't match when searching the entire project
+  FindTextIndex mIndex;
+
   // Are we in all mode?
   bool mAllMode;
 
@@ -0,0 +1,325 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+namespace Events
+{
+DefineEvent(FindTextIndexUpdated);
+} // namespace Events
+
+// The text copied for one job (on the main thread) is capped so that indexing
+// a whole project is spread over many frames
+const size_t cMaxFindTextIndexJobBytes = 4 * 1024 * 1024;
+
+// The index is case insensitive so that it can answer both kinds of search
+inline u8 FoldTrigramCharacter(u8 character)
+{
+  if (character >= 'A' && character <= 'Z')
+    return character - 'A' + 'a';
+  return character;
+}
+
+inline u32 MakeTrigram(u8 a, u8 b, u8 c)
+{
+  return ((u32)FoldTrigramCharacter(a) << 16) | ((u32)FoldTrigramCharacter(b) << 8) | (u32)FoldTrigramCharacter(c);
+}
+
+// Adds the trigrams of a run of characters that every match contains
+void AddLiteralTrigrams(Array<u8>& literal, Array<u32>& trigrams)
+{
+  for (size_t i = 0; i + 3 <= literal.Size(); ++i)
+    trigrams.PushBack(MakeTrigram(literal[i], literal[i + 1], literal[i + 2]));
+  literal.Clear();
+}
+
+// FindTextIndexEvent
+ZilchDefineType(FindTextIndexEvent, builder, type)
+{
+}
+
+// FindTextIndex
+FindTextIndex::Entry::Entry() : mVersion(0), mIndexed(false)
+{
+}
+
+FindTextIndex::FindTextIndex(FindTextDialog* owner) : mOwner(owner)
+{
+}
+
+FindTextIndex::~FindTextIndex()
+{
+  // The job's event is dropped once the dialog is gone
+  if (mJob)
+    mJob->Cancel();
+}
+
+void FindTextIndex::IndexAll()
+{
+  forRange (ResourceId id, Z::gResources->TextResources.Values())
+    OnResourceChanged(id);
+}
+
+void FindTextIndex::OnResourceChanged(ResourceId id)
+{
+  Entry& entry = mEntries[id];
+  ++entry.mVersion;
+  entry.mIndexed = false;
+  entry.mTrigrams.Clear();
+  // Resources are added before their text is loaded, so the job is started on
+  // the next update
+  mQueued.Insert(id);
+}
+
+void FindTextIndex::OnResourceRemoved(ResourceId id)
+{
+  mEntries.Erase(id);
+  mQueued.Erase(id);
+}
+
+void FindTextIndex::StartJob()
+{
+  if (mJob || mQueued.Empty())
+    return;
+
+  FindTextIndexJob* job = new FindTextIndexJob();
+  job->mDialog = mOwner;
+  job->mDialogDispatcher = mOwner->GetDispatcher();
+
+  // Resources are only read on the main thread, the job gets copies of the text
+  Array<ResourceId> taken;
+  size_t totalBytes = 0;
+  forRange (ResourceId id, mQueued.All())
+  {
+    if (totalBytes >= cMaxFindTextIndexJobBytes)
+      break;
+
+    taken.PushBack(id);
+
+    DocumentResource* resource = Type::DynamicCast<DocumentResource*>(Z::gResources->GetResource(id));
+    Entry* entry = mEntries.FindPointer(id);
+    if (resource == nullptr || entry == nullptr)
+      continue;
+
+    FindTextIndexedText& text = job->mTexts.PushBack();
+    text.mResourceId = id;
+    text.mVersion = entry->mVersion;
+    text.mText = resource->LoadTextData();
+    totalBytes += text.mText.SizeInBytes();
+  }
+
+  forRange (ResourceId id, taken.All())
+    mQueued.Erase(id);
+
+  if (job->mTexts.Empty())
+  {
+    delete job;
+    return;
+  }
+
+  mJob = job;
+  Z::gJobs->AddJob(job);
+}
+
+void FindTextIndex::OnJobFinished(FindTextIndexEvent* event)
+{
+  mJob = nullptr;
+
+  forRange (FindTextIndexedText& text, event->mTexts.All())
+  {
+    // Removed or modified while the job was running
+    Entry* entry = mEntries.FindPointer(text.mResourceId);
+    if (entry == nullptr || entry->mVersion != text.mVersion)
+      continue;
+
+    entry->mTrigrams.Swap(text.mTrigrams);
+    entry->mIndexed = true;
+  }
+}
+
+bool FindTextIndex::MayContain(ResourceId id, const Array<u32>& trigrams)
+{
+  Entry* entry = mEntries.FindPointer(id);
+  if (entry == nullptr || !entry->mIndexed)
+    return true;
+
+  forRange (u32 trigram, trigrams.All())
+  {
+    if (!entry->mTrigrams.Contains(trigram))
+      return false;
+  }
+  return true;
+}
+
+bool FindTextIndex::GetRequiredTrigrams(StringParam regex, RegexFlavor::Enum flavor, Array<u32>& trigrams)
+{
+  // Only EcmaScript (which the plain search modes are escaped for) is parsed
+  if (flavor != RegexFlavor::EcmaScript)
+    return false;
+
+  // Only runs of plain characters outside of any group are used. Anything that
+  // isn't understood ends the current run, which can only lose trigrams
+  Array<u8> literal;
+  cstr data = regex.Data();
+  size_t size = regex.SizeInBytes();
+  size_t groupDepth = 0;
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    u8 character = data[i];
+
+    // Characters above ascii may be folded differently by the regex
+    if (character >= 128)
+    {
+      AddLiteralTrigrams(literal, trigrams);
+      continue;
+    }
+
+    switch (character)
+    {
+    case '\\':
+    {
+      if (i + 1 >= size)
+        break;
+
+      u8 escaped = data[++i];
+      if (!IsAlphaNumeric(escaped))
+      {
+        if (groupDepth == 0)
+          literal.PushBack(escaped);
+        break;
+      }
+
+      // Character classes, anchors, back references and character codes
+      AddLiteralTrigrams(literal, trigrams);
+      if (escaped == 'x')
+        i += 2;
+      else if (escaped == 'u')
+        i += 4;
+      else if (escaped == 'c')
+        i += 1;
+      else if (IsDigit(escaped))
+        while (i + 1 < size && IsDigit(data[i + 1]))
+          ++i;
+      break;
+    }
+
+    case '[':
+    {
+      AddLiteralTrigrams(literal, trigrams);
+      for (++i; i < size && data[i] != ']'; ++i)
+      {
+        if (data[i] == '\\')
+          ++i;
+      }
+      break;
+    }
+
+    case '(':
+      AddLiteralTrigrams(literal, trigrams);
+      ++groupDepth;
+      break;
+
+    case ')':
+      AddLiteralTrigrams(literal, trigrams);
+      if (groupDepth != 0)
+        --groupDepth;
+      break;
+
+    case '|':
+      // Either side can match, so nothing outside a group is required
+      if (groupDepth == 0)
+      {
+        trigrams.Clear();
+        return false;
+      }
+      break;
+
+    case '?':
+    case '*':
+      // The quantified character is optional
+      if (!literal.Empty())
+        literal.PopBack();
+      AddLiteralTrigrams(literal, trigrams);
+      break;
+
+    case '{':
+      if (!literal.Empty())
+        literal.PopBack();
+      AddLiteralTrigrams(literal, trigrams);
+      while (i < size && data[i] != '}')
+        ++i;
+      break;
+
+    case '+':
+    {
+      // The repeated character is still followed by what comes next
+      if (literal.Empty())
+        break;
+      u8 repeated = literal.Back();
+      AddLiteralTrigrams(literal, trigrams);
+      literal.PushBack(repeated);
+      break;
+    }
+
+    case '.':
+    case '^':
+    case '$':
+      AddLiteralTrigrams(literal, trigrams);
+      break;
+
+    default:
+      if (groupDepth == 0)
+        literal.PushBack(character);
+      break;
+    }
+  }
+
+  AddLiteralTrigrams(literal, trigrams);
+  return !trigrams.Empty();
+}
+
+void FindTextIndex::GetTrigrams(StringRange text, HashSet<u32>& trigrams)
+{
+  cstr data = text.Data();
+  size_t size = text.SizeInBytes();
+  for (size_t i = 0; i + 3 <= size; ++i)
+    trigrams.Insert(MakeTrigram(data[i], data[i + 1], data[i + 2]));
+}
+
+// FindTextIndexJob
+FindTextIndexJob::FindTextIndexJob() : mDialogDispatcher(nullptr), mCancel(false)
+{
+}
+
+void FindTextIndexJob::Execute()
+{
+  FindTextIndexEvent* toSend = new FindTextIndexEvent();
+
+  forRange (FindTextIndexedText& text, mTexts.All())
+  {
+    if (mCancel)
+      break;
+
+    FindTextIndex::GetTrigrams(text.mText, text.mTrigrams);
+
+    // The text isn't needed anymore
+    text.mText = String();
+  }
+
+  // Texts that were skipped would look like they contain nothing
+  if (mCancel)
+    mTexts.Clear();
+
+  toSend->mTexts.Swap(mTexts);
+  Z::gDispatch->DispatchOn(mDialog, mDialogDispatcher, Events::FindTextIndexUpdated, toSend);
+}
+
+int FindTextIndexJob::Cancel()
+{
+  mCancel = true;
+  return 0;
+}
+
+} // namespace Zero
@@ -0,0 +1,103 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+// Forward declarations
+class FindTextDialog;
+
+namespace Events
+{
+DeclareEvent(FindTextIndexUpdated);
+} // namespace Events
+
+// FindTextIndexedText
+/// The text of one resource copied for a job, and the trigrams the job found.
+struct FindTextIndexedText
+{
+  ResourceId mResourceId;
+  /// The version of the resource's entry when its text was copied.
+  u32 mVersion;
+  String mText;
+  HashSet<u32> mTrigrams;
+};
+
+// FindTextIndexEvent
+/// Sent to the find dialog when a job finishes indexing a batch of resources.
+class FindTextIndexEvent : public Event
+{
+public:
+  ZilchDeclareType(FindTextIndexEvent, TypeCopyMode::ReferenceType);
+
+  Array<FindTextIndexedText> mTexts;
+};
+
+// FindTextIndex
+/// Indexes the trigrams (every three character sequence, lower cased) of all
+/// text resources so that searching the entire project only loads and runs the
+/// regex on resources that can contain a match. Resources are indexed on
+/// another thread as they're added or modified, a resource that isn't indexed
+/// yet is always searched.
+class FindTextIndex
+{
+public:
+  FindTextIndex(FindTextDialog* owner);
+  ~FindTextIndex();
+
+  /// Queues every text resource that's already loaded.
+  void IndexAll();
+  void OnResourceChanged(ResourceId id);
+  void OnResourceRemoved(ResourceId id);
+
+  /// Starts indexing queued resources if no job is already running. Called
+  /// every update by the dialog.
+  void StartJob();
+  void OnJobFinished(FindTextIndexEvent* event);
+
+  /// Only false when the resource is indexed and is missing one of the
+  /// trigrams.
+  bool MayContain(ResourceId id, const Array<u32>& trigrams);
+
+  /// Gets trigrams that any match of the regex has to contain. Returns false
+  /// if none were found (the regex can't be used to skip resources).
+  static bool GetRequiredTrigrams(StringParam regex, RegexFlavor::Enum flavor, Array<u32>& trigrams);
+
+  /// Adds every trigram of the text to the set.
+  static void GetTrigrams(StringRange text, HashSet<u32>& trigrams);
+
+private:
+  struct Entry
+  {
+    Entry();
+
+    /// Incremented every time the resource changes, so a job that copied the
+    /// text before the change doesn't index the old text.
+    u32 mVersion;
+    bool mIndexed;
+    HashSet<u32> mTrigrams;
+  };
+
+  FindTextDialog* mOwner;
+  HashMap<ResourceId, Entry> mEntries;
+  /// Resources waiting for a job.
+  HashSet<ResourceId> mQueued;
+  HandleOf<Job> mJob;
+};
+
+// FindTextIndexJob
+class FindTextIndexJob : public Job
+{
+public:
+  FindTextIndexJob();
+
+  // Job Interface
+  void Execute() override;
+  int Cancel() override;
+
+  Array<FindTextIndexedText> mTexts;
+  Handle mDialog;
+  EventDispatcher* mDialogDispatcher;
+  bool mCancel;
+};
+
+} // namespace Zero
@@ -42,6 +42,9 @@ void GraphWidget::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // Plots entries that are added every frame
+  NeedsRedraw();
+
   StreamedVertexArray& streamedVertices = frameBlock.mRenderQueues->mStreamedVertices;
 
   // Get the spacing for each
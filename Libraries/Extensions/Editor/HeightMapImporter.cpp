@@ -396,6 +396,9 @@ void PatchGridArea::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // The grid follows the import settings as they're edited
+  NeedsRedraw();
+
   Texture* texture = TextureManager::FindOrNull("White");
   ViewNode& viewNode = AddRenderNodes(viewBlock, frameBlock, clipRect, texture);
   // Setup our view node for drawing lines
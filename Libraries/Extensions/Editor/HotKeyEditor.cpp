@@ -319,7 +319,7 @@ public:
 
   void Filter(StringParam filterString) override
   {
-    mFilteredList.Clear();
+    ResetFilter();
 
     if (filterString.Empty())
       return;
@@ -1166,20 +1166,13 @@ void HotKeyEditor::OnCommandDelete(ObjectEvent* event)
   TreeRow* row = mTreeView->FindRowByIndex(mRightClickedRowIndex);
   row->Remove(); // dispatch event
 
-  mTreeView->mRows.EraseValue(row);
-
   Sort(false);
 
+  // Rows are rebound to the new indices when the tree is refreshed
   int size = (int)mHotKeys->mCommand.Size();
   for (int i = 0; i < size; ++i)
-  {
     mHotKeys->mCommand[i].mIndex = i;
 
-    // +1 as the first row is the header
-    mTreeView->mRows[i + 1]->mIndex = i;
-    mTreeView->mRows[i + 1]->mVisibleRowIndex = i;
-  }
-
   Array<unsigned> toErase;
 
   HashDataSelection* data = (HashDataSelection*)mTreeView->GetSelection();
@@ -1486,9 +1479,6 @@ void HotKeyEditor::OnCommandSetSelected(ObjectEvent* event)
     return;
 
   mTreeView->ClearAllRows();
-  mTreeView->mRows[0]->mChildren.Clear();
-  mTreeView->mRows.Clear();
-  mTreeView->mRowMap.Clear();
   mTreeView->Refresh();
 
   // mHotKeys->mSet = (HotKeyDataSet
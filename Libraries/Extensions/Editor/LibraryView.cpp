@@ -274,6 +274,9 @@ LibraryView::LibraryView(Composite* parent) : Composite(parent), mResourceLibrar
 
   this->SetLayout(CreateStackLayout());
 
+  // The resource tree is mostly static, so reuse its render nodes
+  this->SetRenderCaching(true);
+
   mLibrariesRow = new Composite(this);
   mLibrariesRow->SetSizing(SizeAxis::Y, SizePolicy::Fixed, Pixels(16));
   mLibrariesRow->SetLayout(CreateStackLayout(LayoutDirection::LeftToRight, Pixels(5, 0), Thickness(1, 0, 2, 0)));
@@ -1403,8 +1406,11 @@ void LibraryView::RenameAtIndex(DataIndex& dataIndex)
 
   if (mTreeView->GetActive())
   {
+    // Only rows in view exist
+    mTreeView->ShowRow(dataIndex);
     TreeRow* row = mTreeView->FindRowByIndex(dataIndex);
-    row->Edit(CommonColumns::Name);
+    if (row)
+      row->Edit(CommonColumns::Name);
   }
   else if (mTileView->GetActive())
   {
@@ -32,6 +32,9 @@ void MultiConvexMeshDrawer::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // Drawn from the editor's points, which change without marking
+  NeedsRedraw();
+
   mEditor->DrawMesh();
 
   for (uint i = 0; i < mEditor->mPoints.Size(); ++i)
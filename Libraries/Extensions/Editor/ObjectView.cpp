@@ -95,7 +95,7 @@ public:
 
   void Filter(StringParam filterString) override
   {
-    mFilteredList.Clear();
+    ResetFilter();
 
     if (!mSource)
       return;
@@ -64,6 +64,9 @@ void CameraViewportDrawer::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // The preview space renders into a texture every frame
+  NeedsRedraw();
+
   if (Cog* cameraObject = mCameraObject)
   {
     if (CameraViewport* cameraViewport = cameraObject->has(CameraViewport))
@@ -682,6 +685,9 @@ void SampleCurveDrawer::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // The curve resource can be edited elsewhere
+  NeedsRedraw();
+
   SampleCurve* sampleCurve = mObject.Get<SampleCurve*>();
   if (sampleCurve == nullptr)
     return;
@@ -108,6 +108,9 @@ void GraphView::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // Graphs live values
+  NeedsRedraw();
+
   static RenderFont* font = mFont;
 
   Vec2 size = mSize;
@@ -36,6 +36,9 @@ PropertyView::PropertyView(Composite* parent) : Composite(parent), mFixedHeight(
   mScrollArea->DisableScrollBar(0);
   mMinSize = Vec2(100, 100);
 
+  // Property rows rarely change between frames, so reuse their render nodes
+  SetRenderCaching(true);
+
   mNamePercent = 0.42f;
 
   mDefSet = parent->GetDefinitionSet()->GetDefinitionSet("PropertyGrid");
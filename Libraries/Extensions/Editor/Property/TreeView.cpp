@@ -162,28 +162,20 @@ ZilchDefineType(TreeRow, builder, type)
 {
 }
 
-TreeRow::TreeRow(TreeView* treeView, TreeRow* rowparent, DataEntry* entry) : TreeBase(treeView->mArea)
+TreeRow::TreeRow(TreeView* treeView) : TreeBase(treeView->mArea)
 {
   mExpanded = false;
   mTree = treeView;
   mActive = true;
-  mParentRow = rowparent;
-  mDepth = rowparent ? rowparent->mDepth + 1 : 0;
-  mIndex = treeView->mDataSource->ToIndex(entry);
-  mTree->mRowMap[mIndex.Id] = this;
-  treeView->mRows.PushBack(this);
+  mDepth = 0;
+  mVisibleRowIndex = 0;
+  mIndex = (DataIndex)-1;
   mExpandIcon = nullptr;
   mGraphicBackground = CreateAttached<Element>(cWhiteSquare);
   mGraphicBackground->SetInteractive(false);
   mBackground = new Spacer(this);
   mValid = true;
 
-  // Can this node be expanded?
-  bool isExpandable = treeView->mDataSource->IsExpandable(entry);
-  // Is this node currently expanded. Nodes can be expanded even if
-  // there is node TreeNode currently displaying them.
-  bool isExpaned = mTree->mExpanded->IsSelected(mIndex);
-
   // Create selection highlight
   mSelection = CreateAttached<Element>(cWhiteSquare);
   mSelection->SetTranslation(Pixels(0, 1, 0));
@@ -200,9 +192,6 @@ TreeRow::TreeRow(TreeView* treeView, TreeRow* rowparent, DataEntry* entry) : Tre
   // Clicking on it will expand the row
   ConnectThisTo(mExpandIcon, Events::LeftMouseDown, OnMouseDownExpander);
 
-  if (!isExpandable)
-    mExpandIcon->SetVisible(false);
-
   // Build Edit Columns
   ValueEditorFactory* factory = ValueEditorFactory::GetInstance();
   float offsetX = Pixels(20);
@@ -243,13 +232,6 @@ TreeRow::TreeRow(TreeView* treeView, TreeRow* rowparent, DataEntry* entry) : Tre
   ConnectThisTo(this, Events::ObjectPoll, OnObjectPoll);
   ConnectThisTo(this, Events::MouseEnter, OnMouseEnter);
   ConnectThisTo(this, Events::MouseExit, OnMouseExit);
-
-  // Load data from data source
-  RefreshData();
-
-  // Expand the node if necessary
-  if (isExpaned)
-    Expand();
 }
 
 bool TreeRow::IsRoot()
@@ -450,6 +432,29 @@ void TreeRow::UpdateColumnsTransform(Vec2Param size)
   }
 }
 
+void TreeRow::Bind(DataIndex index, uint depth, uint visibleRowIndex)
+{
+  mIndex = index;
+  mDepth = depth;
+  mVisibleRowIndex = visibleRowIndex;
+  mTree->mRowMap[mIndex.Id] = this;
+  SetActive(true);
+
+  // Load data from data source
+  Refresh();
+}
+
+void TreeRow::Unbind()
+{
+  // The index may already be displayed by another row
+  if (mTree->mRowMap.FindValue(mIndex.Id, nullptr) == this)
+    mTree->mRowMap.Erase(mIndex.Id);
+
+  mIndex = (DataIndex)-1;
+  mExpanded = false;
+  mToolTip.SafeDestroy();
+}
+
 void TreeRow::Refresh()
 {
   DataEntry* entry = mTree->mDataSource->ToEntry(mIndex);
@@ -466,10 +471,6 @@ void TreeRow::Refresh()
 
     // We may have been added to the expanded list externally
     mExpanded = mTree->mExpanded->IsSelected(mIndex);
-
-    // Rebuild the tree if expanded
-    if (this->mExpanded)
-      RebuildChildren();
   }
   else
   {
@@ -477,35 +478,29 @@ void TreeRow::Refresh()
 
     // If node used to be expanded collapse
     if (this->mExpanded)
-      Collapse();
+    {
+      mTree->mExpanded->Deselect(mIndex);
+      mTree->InvalidateEntries();
+    }
+    mExpanded = false;
 
     // Hide Expander
     mExpandIcon->SetVisible(false);
   }
 
+  // Change the expander icon
+  String expandIcon = mExpanded ? cArrowDown : cArrowRight;
+  mExpandIcon->ChangeDefinition(mDefSet->GetDefinition(expandIcon));
+
   // Reload columns
   this->RefreshData();
 }
 
 TreeRow::~TreeRow()
 {
-  // Remove from parent
-  if (mParentRow)
-  {
-    mParentRow = nullptr;
-    TreeRowList::Unlink(this);
-
-    // If the index still refers to this row
-    // erase this row, it will be rebuilt if needed
-    if (mTree->mRowMap.FindValue(mIndex.Id, nullptr) == this)
-      mTree->mRowMap.Erase(mIndex.Id);
-  }
-
-  while (!mChildren.Empty())
-  {
-    mChildren.Front().mParentRow = nullptr;
-    TreeRowList::Unlink(&mChildren.Front());
-  }
+  // If the index still refers to this row erase this row
+  if (mTree->mRowMap.FindValue(mIndex.Id, nullptr) == this)
+    mTree->mRowMap.Erase(mIndex.Id);
 
   mToolTip.SafeDestroy();
 }
@@ -515,20 +510,6 @@ void TreeRow::OnDestroy()
   Composite::OnDestroy();
 }
 
-void TreeRow::DestroyChildren()
-{
-  forRange (TreeRow& child, mChildren.All())
-  {
-    child.RecursiveDestroy();
-  }
-}
-
-void TreeRow::RecursiveDestroy()
-{
-  DestroyChildren();
-  this->Destroy();
-}
-
 void TreeRow::Remove()
 {
   DataEntry* entry = mTree->mDataSource->ToEntry(mIndex);
@@ -556,79 +537,13 @@ void TreeRow::UpdateBgColor(uint index)
   mGraphicBackground->SetColor(color);
 }
 
-void TreeRow::RebuildChildren()
-{
-  // Rebuild children by reusing valid rows and destroying invalid rows
-
-  // Look up the entry
-  DataEntry* entry = mTree->mDataSource->ToEntry(mIndex);
-
-  if (entry == nullptr)
-    return;
-
-  uint numChildren = mTree->mDataSource->ChildCount(entry);
-
-  // Swap out old children
-  TreeRowList oldChildren;
-  oldChildren.Swap(mChildren);
-
-  DataEntry* prev = nullptr;
-  for (uint i = 0; i < numChildren; ++i)
-  {
-    DataEntry* child = mTree->mDataSource->GetChild(entry, i, prev);
-    DataIndex index = mTree->mDataSource->ToIndex(child);
-
-    // Is this row still valid?
-    TreeRow* row = mTree->FindRowByIndex(index);
-    if (row && row->mParentRow == this)
-    {
-      // node is still valid and this row is still the parent
-      // move to current children list
-      oldChildren.Erase(row);
-      mChildren.PushBack(row);
-
-      row->Refresh();
-    }
-    else
-    {
-      // No rows created for this data index
-      // Create a new child TreeRow
-      TreeRow* treeRow = new TreeRow(mTree, this, child);
-      mChildren.PushBack(treeRow);
-    }
-
-    prev = child;
-  }
-
-  // Destroy all children that are no longer valid.
-  while (!oldChildren.Empty())
-  {
-    TreeRow* current = &oldChildren.Front();
-    current->RecursiveDestroy();
-    oldChildren.Erase(current);
-    // Child removes itself in destruction.
-    mChildren.PushBack(current);
-  }
-
-  this->MarkAsNeedsUpdate();
-}
-
 void TreeRow::Collapse()
 {
   // Do not repeat
   if (!mExpanded)
     return;
 
-  // Change the expander icon
-  if (mExpandIcon)
-    mExpandIcon->ChangeDefinition(mDefSet->GetDefinition(cArrowRight));
-
-  // Mark the index as not expanded
-  mTree->mExpanded->Deselect(mIndex);
-
-  DestroyChildren();
-  mExpanded = false;
-  mTree->MarkAsNeedsUpdate();
+  mTree->Collapse(mIndex);
 }
 
 void TreeRow::Expand()
@@ -637,26 +552,7 @@ void TreeRow::Expand()
   if (mExpanded)
     return;
 
-  // Change the expander icon
-  if (mExpandIcon)
-    mExpandIcon->ChangeDefinition(mDefSet->GetDefinition(cArrowDown));
-
-  // Mark the index as expanded
-  mTree->mExpanded->Select(mIndex);
-
-  // Tell the data source to expand
-  DataEntry* entry = mTree->mDataSource->ToEntry(mIndex);
-  if (entry == nullptr)
-    return;
-
-  mTree->mDataSource->Expand(entry);
-
-  // Build children
-  RebuildChildren();
-  this->RefreshData();
-
-  // Mark TreeRow as expanded
-  mExpanded = true;
+  mTree->Expand(mIndex);
 }
 
 void TreeRow::Select(bool singleSelect)
@@ -1064,11 +960,15 @@ void TreeRow::OnMetaDrop(MetaDropEvent* event)
     }
 
     // If we're expanding, forward the event to our first child row
-    if (insertMode == InsertMode::After && mExpanded && !mChildren.Empty())
+    uint childRowIndex = mVisibleRowIndex + 1;
+    Array<TreeViewEntry>& entries = mTree->mEntries;
+    if (insertMode == InsertMode::After && mExpanded && childRowIndex < entries.Size() &&
+        entries[childRowIndex].mDepth == mDepth + 1)
     {
-      if (!IsRoot())
+      // The first child only has a row when it's in view
+      TreeRow* firstChild = mTree->FindRowByIndex(entries[childRowIndex].mIndex);
+      if (!IsRoot() && firstChild != nullptr)
       {
-        TreeRow* firstChild = &mChildren.Front();
         firstChild->OnMetaDrop(event);
         return;
       }
@@ -1131,20 +1031,6 @@ void TreeRow::OnMouseDownExpander(MouseEvent* event)
   }
 }
 
-void TreeRow::Fill(Array<TreeRow*>& nodes, uint depth)
-{
-  if (!mActive || mDestroyed)
-    return;
-
-  nodes.PushBack(this);
-  this->mDepth = depth;
-  this->mVisibleRowIndex = nodes.Size() - 1;
-  forRange (TreeRow& child, mChildren.All())
-  {
-    child.Fill(nodes, depth + 1);
-  }
-}
-
 void TreeRow::OnDoubleClick(MouseEvent* event)
 {
   if (!event->Handled)
@@ -1392,6 +1278,8 @@ TreeView::TreeView(Composite* parent) : Composite(parent)
   mDataSource = nullptr;
 
   mRoot = nullptr;
+  mEntriesDirty = false;
+  mScrollAreaRows = 0;
 
   SetFormatNameAndType();
 
@@ -1487,14 +1375,11 @@ void TreeView::SetFormat(TreeFormatting& format)
 
   mHeaders.Clear();
   mHeaderResizers.Clear();
+
+  // Rows have an editor for each column so they can't be reused
   ClearAllRows();
   if (mDataSource)
-  {
-    // Build new Tree
-    DataEntry* root = mDataSource->GetRoot();
-    mRoot = new TreeRow(this, nullptr, root);
-    mRoot->Expand();
-  }
+    CreateRoot();
 }
 
 void TreeView::SetRowHeight(float height)
@@ -1512,57 +1397,24 @@ void TreeView::ShowRow(DataIndex& index)
   if (entry == nullptr)
     return;
 
-  TreeRow* row = FindRowByIndex(index);
-
+  // Expand every parent so the entry is visible
   DataEntry* parent = mDataSource->Parent(entry);
-  DataIndex parentIndex = mDataSource->ToIndex(parent);
-
-  bool needRefresh = false;
-
-  // We want to search up starting at our parent for the first visible row
   while (parent)
   {
-    DataIndex currIndex = mDataSource->ToIndex(parent);
-
-    // If there is a visible row for this index, expand it and we're done
-    row = FindRowByIndex(currIndex);
-    if (row)
-    {
-      if (row->mExpanded == false)
-      {
-        row->Expand();
-
-        // Expanding the row will require building rows for each child in the
-        // row
-        needRefresh = true;
-      }
-
-      break;
-    }
+    DataIndex parentIndex = mDataSource->ToIndex(parent);
+    if (!mExpanded->IsSelected(parentIndex))
+      Expand(parentIndex);
 
-    // It doesn't have a row, but when the row is created, we want it
-    // to be expanded (instead of recursively creating and then expanding).
-    // Adding it to this data selection will make it automatically be
-    // expanded when it's created
-    mExpanded->Select(currIndex);
-
-    // Go to the next parent
     parent = mDataSource->Parent(parent);
   }
 
-  // Rebuild the tree
-  if (needRefresh)
-    Refresh();
-
   // Update transform will update the size of the scroll area
   UpdateTransform();
 
   // Scroll to this object
-  Zero::TreeRow* dataRow = FindRowByIndex(index);
-
-  if (dataRow)
+  uint rowIndex = mEntryMap.FindValue(index.Id, (uint)-1);
+  if (rowIndex != (uint)-1)
   {
-    uint rowIndex = dataRow->mVisibleRowIndex;
     float yPos = rowIndex * mRowHeight;
     mArea->ScrollAreaToView(Vec2(0, yPos - mRowHeight), Vec2(0, yPos + mRowHeight));
   }
@@ -1585,12 +1437,45 @@ void TreeView::SetRefreshOnValueChange(bool state)
 
 void TreeView::Refresh()
 {
-  if (mRoot)
-    mRoot->Refresh();
+  InvalidateEntries();
+
+  forRange (TreeRow* row, mRows.All())
+    row->Refresh();
 
   UpdateTransform();
 }
 
+void TreeView::Expand(DataIndex& index)
+{
+  // Mark the index as expanded
+  mExpanded->Select(index);
+
+  // Tell the data source to expand
+  DataEntry* entry = mDataSource->ToEntry(index);
+  if (entry == nullptr)
+    return;
+
+  mDataSource->Expand(entry);
+
+  TreeRow* row = FindRowByIndex(index);
+  if (row)
+    row->Refresh();
+
+  InvalidateEntries();
+}
+
+void TreeView::Collapse(DataIndex& index)
+{
+  // Mark the index as not expanded
+  mExpanded->Deselect(index);
+
+  TreeRow* row = FindRowByIndex(index);
+  if (row)
+    row->Refresh();
+
+  InvalidateEntries();
+}
+
 void TreeView::SetDataSource(DataSource* dataSource)
 {
   if (mDataSource)
@@ -1613,9 +1498,7 @@ void TreeView::SetDataSource(DataSource* dataSource)
     ConnectThisTo(mDataSource, Events::DataReplaced, OnDataReplaced);
 
     // Build new Tree
-    DataEntry* root = mDataSource->GetRoot();
-    mRoot = new TreeRow(this, nullptr, root);
-    mRoot->Expand();
+    CreateRoot();
   }
 }
 
@@ -1632,11 +1515,26 @@ void TreeView::SetSelection(DataSelection* selection)
 
 void TreeView::ClearAllRows()
 {
+  forRange (TreeRow* row, mRows.All())
+  {
+    if (row != mRoot)
+      row->Destroy();
+  }
+
+  forRange (TreeRow* row, mFreeRows.All())
+    row->Destroy();
+
   if (mRoot)
   {
-    mRoot->RecursiveDestroy();
+    mRoot->Destroy();
     mRoot = nullptr;
   }
+
+  mRows.Clear();
+  mFreeRows.Clear();
+  mRowMap.Clear();
+  mEntries.Clear();
+  mEntryMap.Clear();
 }
 
 ScrollArea* TreeView::GetScrollArea()
@@ -1667,6 +1565,8 @@ void TreeView::HandleKeyLogic(KeyboardEvent* event)
   if (event->Handled)
     return;
 
+  UpdateEntries();
+
   // We're going to move based on what's currently selected
   uint minIndex, maxIndex;
   GetSelectionRange(&minIndex, &maxIndex);
@@ -1697,7 +1597,7 @@ void TreeView::HandleKeyLogic(KeyboardEvent* event)
     uint newMax = maxIndex + 1;
 
     // Make sure we don't go passed the last row
-    newMax = Math::Min((size_t)newMax, (size_t)(mRows.Size() - 1));
+    newMax = Math::Min((size_t)newMax, (size_t)(mEntries.Size() - 1));
 
     // Select the new row
     if (event->ShiftPressed)
@@ -1709,26 +1609,29 @@ void TreeView::HandleKeyLogic(KeyboardEvent* event)
     float y = float(newMax + 1) * mRowHeight;
     mArea->ScrollAreaToView(Vec2(0, y), Vec2(0, y));
   }
-  else if (event->Key == Keys::Right && minIndex < mRows.Size())
+  else if (event->Key == Keys::Right && minIndex < mEntries.Size())
   {
     // If right is pressed, attempt to expand the row
-    TreeRow* row = mRows[minIndex];
-    row->Expand();
+    DataIndex index = mEntries[minIndex].mIndex;
+    DataEntry* entry = mDataSource->ToEntry(index);
+    if (entry && mDataSource->IsExpandable(entry) && !mExpanded->IsSelected(index))
+      Expand(index);
   }
-  else if (event->Key == Keys::Left && minIndex < mRows.Size())
+  else if (event->Key == Keys::Left && minIndex < mEntries.Size())
   {
     // If the row is expanded, collapse it and remain selected on it
-    TreeRow* row = mRows[minIndex];
-    if (row->mExpanded)
+    DataIndex index = mEntries[minIndex].mIndex;
+    uint parent = mEntries[minIndex].mParent;
+    if (mExpanded->IsSelected(index))
     {
-      row->Collapse();
+      Collapse(index);
     }
     // If it's not expanded and it has a parent that's not the root,
     // move the selection to the parent
-    else if (row->mParentRow && row->mParentRow != mRoot)
+    else if (parent != 0)
     {
       mSelection->SelectNone();
-      mSelection->Select(row->mParentRow->mIndex);
+      mSelection->Select(mEntries[parent].mIndex);
     }
   }
 
@@ -1790,11 +1693,11 @@ void TreeView::OnMouseUpdate(MouseEvent* event)
 
   MarkAsNeedsUpdate();
 
+  UpdateEntries();
   uint index = uint(world.y / mRowHeight) + 1;
-  if (index < mRows.Size())
+  if (index < mEntries.Size())
   {
-    TreeRow* row = mRows[index];
-    mMouseOver = row->mIndex;
+    mMouseOver = mEntries[index].mIndex;
   }
   else
   {
@@ -1821,7 +1724,8 @@ TreeRow* TreeView::FindRowByIndex(DataIndex& index)
 
 uint TreeView::FindRowIndex(TreeRow* row)
 {
-  return mRows.FindIndex(row);
+  UpdateEntries();
+  return mEntryMap.FindValue(row->mIndex.Id, (uint)-1);
 }
 
 void TreeView::MoveToView(TreeRow* row)
@@ -1834,20 +1738,27 @@ void TreeView::MoveToView(TreeRow* row)
 
 TreeRow* TreeView::FindRowByColumnValue(StringParam column, StringParam value)
 {
-  // brute force search through all visible rows
+  // brute force search through all visible entries
+  UpdateEntries();
 
-  // Which column to search in
-  ColumnFormat& format = GetColumn(column);
-
-  forRange (TreeRow* row, mRows.All())
+  forRange (TreeViewEntry& treeEntry, mEntries.All())
   {
+    DataEntry* entry = mDataSource->ToEntry(treeEntry.mIndex);
+    if (entry == nullptr)
+      continue;
+
     // Get the value of the column
     Any var;
-    row->mEditorColumns[format.Index]->GetVariant(var);
+    mDataSource->GetData(entry, var, column);
 
     // Check the value, strings for now
     if (var.ToString() == value)
-      return row;
+    {
+      // Bring the entry into view so it has a row
+      DataIndex index = treeEntry.mIndex;
+      ShowRow(index);
+      return FindRowByIndex(index);
+    }
   }
 
   return nullptr;
@@ -1855,10 +1766,11 @@ TreeRow* TreeView::FindRowByColumnValue(StringParam column, StringParam value)
 
 void TreeView::SelectFirstRow()
 {
-  if (mRows.Size() < 2)
+  UpdateEntries();
+  if (mEntries.Size() < 2)
     return;
   mSelection->SelectNone();
-  mSelection->Select(mRows[1]->mIndex);
+  mSelection->Select(mEntries[1].mIndex);
   MarkAsNeedsUpdate();
 
   mSelection->SelectFinal();
@@ -1868,11 +1780,13 @@ void TreeView::SelectFirstRow()
 void TreeView::OnDataErased(DataEvent* event)
 {
   TreeRow* row = FindRowByIndex(event->Index);
-  if (row)
+  if (row && row != mRoot)
   {
-    mRowMap.Erase(event->Index.Id);
-    row->RecursiveDestroy();
+    mRows.EraseValue(row);
+    ReleaseRow(row);
   }
+
+  InvalidateEntries();
 }
 
 void TreeView::OnDataAdded(DataEvent* event)
@@ -1881,6 +1795,8 @@ void TreeView::OnDataAdded(DataEvent* event)
   TreeRow* row = FindRowByIndex(event->Index);
   if (row)
     row->Refresh();
+
+  InvalidateEntries();
 }
 
 void TreeView::OnDataModified(DataEvent* event)
@@ -1920,12 +1836,16 @@ void TreeView::GetSelectionRange(uint* minIndex, uint* maxIndex)
   Array<DataIndex> selected;
   mSelection->GetSelected(selected);
 
+  UpdateEntries();
+
   // Walk through the selected and min / max
   for (uint i = 0; i < selected.Size(); ++i)
   {
-    // Get the index of the current row
-    TreeRow* currRow = FindRowByIndex(selected[i]);
-    uint currIndex = FindRowIndex(currRow);
+    // Get the index of the current row (entries under a collapsed row have
+    // none)
+    uint currIndex = mEntryMap.FindValue(selected[i].Id, (uint)-1);
+    if (currIndex == (uint)-1)
+      continue;
 
     // Min / max
     *minIndex = Math::Min(currIndex, *minIndex);
@@ -1938,15 +1858,14 @@ void TreeView::SelectRowsInRange(uint min, uint max)
   if (mDataSource == nullptr)
     return;
 
+  UpdateEntries();
+
   // Clear the selection
   mSelection->SelectNone(false);
 
   // Select all in the given range
-  for (uint i = min; i <= max && i < mRows.Size(); ++i)
-  {
-    TreeRow* row = mRows[i];
-    mSelection->Select(row->mIndex, false);
-  }
+  for (uint i = min; i <= max && i < mEntries.Size(); ++i)
+    mSelection->Select(mEntries[i].mIndex, false);
 
   MarkAsNeedsUpdate();
 
@@ -1956,7 +1875,8 @@ void TreeView::SelectRowsInRange(uint min, uint max)
 void TreeView::SelectAll()
 {
   // you can't delete the editor camera so size is always at least 1
-  SelectRowsInRange(0, mRows.Size() - 1);
+  UpdateEntries();
+  SelectRowsInRange(0, mEntries.Size() - 1);
 }
 
 float TreeView::GetHeaderRowHeight()
@@ -2002,12 +1922,8 @@ void TreeView::UpdateTransform()
   mArea->SetSize(mSize);
   mArea->DisableScrollBar(0);
 
-  // Clear all current nodes
-  mRows.Clear();
-
-  // Collect all visible nodes
-  if (mRoot)
-    mRoot->Fill(mRows, 0);
+  // Collect all visible entries
+  UpdateEntries();
 
   // Build the column starting / ending positions
   UpdateColumnTransforms();
@@ -2036,7 +1952,7 @@ void TreeView::UpdateTransform()
   uint visibleRows = uint(Math::Ceil(areaForItems / mRowHeight));
   visibleRows++;
 
-  uint activeRows = mRows.Size();
+  uint activeRows = mEntries.Size();
 
   // scrolling past the end of our total list by half of the visible rows
   // results in a consistent buffer area past the end. Subtracting a flat number
@@ -2051,7 +1967,7 @@ void TreeView::UpdateTransform()
 
   // Skip the root
   bool showRoot = mFormatting.Flags.IsSet(FormatFlags::ShowRoot);
-  if (!showRoot && !mRows.Empty())
+  if (!showRoot && !mEntries.Empty())
   {
     ++startVisible;
     startVisible = Math::Min(activeRows, startVisible);
@@ -2060,21 +1976,16 @@ void TreeView::UpdateTransform()
   }
 
   // Compute the end of the visible rows
-  uint endVisible = Math::Min((size_t)mRows.Size(), (size_t)(startVisible + visibleRows));
+  uint endVisible = Math::Min((size_t)mEntries.Size(), (size_t)(startVisible + visibleRows));
 
-  // Deactivate all rows before the first visible
-  for (uint i = 0; i < startVisible; ++i)
-  {
-    TreeRow* item = mRows[i];
-    item->SetActive(false);
-    rowY += mRowHeight;
-  }
+  // Only the visible entries have rows
+  BindRows(startVisible, endVisible);
+  rowY += float(startVisible) * mRowHeight;
 
-  // Activate and move all visible rows
+  // Move all visible rows
   for (uint i = startVisible; i < endVisible; ++i)
   {
-    TreeRow* item = mRows[i];
-    item->SetActive(true);
+    TreeRow* item = mRows[i - startVisible];
     item->SetTranslation(Vec3(0, rowY, 0));
     item->SetSize(Vec2(rowWidth, mRowHeight));
 
@@ -2092,16 +2003,123 @@ void TreeView::UpdateTransform()
     rowY += mRowHeight;
   }
 
-  // Deactivate all rows from first non visible to the number of rows
-  for (uint i = endVisible; i < activeRows; ++i)
+  Composite::UpdateTransform();
+}
+
+void TreeView::CreateRoot()
+{
+  DataEntry* root = mDataSource->GetRoot();
+  DataIndex rootIndex = mDataSource->ToIndex(root);
+  mRoot = new TreeRow(this);
+  mRoot->Bind(rootIndex, 0, 0);
+  Expand(rootIndex);
+
+  // It's activated when it's bound to the first visible row
+  mRoot->SetActive(false);
+}
+
+void TreeView::InvalidateEntries()
+{
+  mEntriesDirty = true;
+  MarkAsNeedsUpdate();
+}
+
+void TreeView::UpdateEntries()
+{
+  if (!mEntriesDirty)
+    return;
+
+  mEntriesDirty = false;
+  mEntries.Clear();
+  mEntryMap.Clear();
+
+  if (mDataSource == nullptr || mRoot == nullptr)
+    return;
+
+  AddEntries(mDataSource->GetRoot(), 0, 0);
+}
+
+void TreeView::AddEntries(DataEntry* entry, uint depth, uint parent)
+{
+  DataIndex index = mDataSource->ToIndex(entry);
+  uint position = mEntries.Size();
+
+  TreeViewEntry& treeEntry = mEntries.PushBack();
+  treeEntry.mIndex = index;
+  treeEntry.mDepth = depth;
+  treeEntry.mParent = parent;
+  mEntryMap.Insert(index.Id, position);
+
+  // Nodes can be expanded even if there is no row currently displaying them
+  if (!mExpanded->IsSelected(index) || !mDataSource->IsExpandable(entry))
+    return;
+
+  uint childCount = mDataSource->ChildCount(entry);
+  DataEntry* prev = nullptr;
+  for (uint i = 0; i < childCount; ++i)
   {
-    TreeRow* item = mRows[i];
-    item->SetTranslation(Vec3(0, rowY, 0));
-    item->SetActive(false);
-    rowY += mRowHeight;
+    DataEntry* child = mDataSource->GetChild(entry, i, prev);
+    AddEntries(child, depth + 1, position);
+    prev = child;
   }
+}
 
-  Composite::UpdateTransform();
+void TreeView::BindRows(uint start, uint end)
+{
+  // Rows that are still in view keep their entry (and any edit in progress)
+  Array<TreeRow*> rows;
+  rows.Resize(end - start, nullptr);
+  forRange (TreeRow* row, mRows.All())
+  {
+    uint position = mEntryMap.FindValue(row->mIndex.Id, (uint)-1);
+    if (position >= start && position < end && rows[position - start] == nullptr)
+    {
+      row->mDepth = mEntries[position].mDepth;
+      row->mVisibleRowIndex = position;
+      rows[position - start] = row;
+    }
+    else
+    {
+      ReleaseRow(row);
+    }
+  }
+
+  // Bind recycled rows to the entries that scrolled into view
+  for (uint i = 0; i < rows.Size(); ++i)
+  {
+    if (rows[i] != nullptr)
+      continue;
+
+    uint position = start + i;
+    TreeViewEntry& entry = mEntries[position];
+    TreeRow* row = (position == 0) ? mRoot : AcquireRow();
+    row->Bind(entry.mIndex, entry.mDepth, position);
+    rows[i] = row;
+  }
+
+  mRows.Swap(rows);
+}
+
+TreeRow* TreeView::AcquireRow()
+{
+  if (mFreeRows.Empty())
+    return new TreeRow(this);
+
+  TreeRow* row = mFreeRows.Back();
+  mFreeRows.PopBack();
+  return row;
+}
+
+void TreeView::ReleaseRow(TreeRow* row)
+{
+  row->SetActive(false);
+
+  // The root row always displays the root (the background forwards to it)
+  if (row == mRoot)
+    return;
+
+  row->Unbind();
+  mFreeRows.PushBack(row);
 }
 
 bool TreeView::TakeFocusOverride()
@@ -151,14 +151,14 @@ class TreeViewHeaderAddedEvent : public Event
 
 DeclareEnum3(HighlightType, None, Selected, Preview);
 
-// Row in the TreeView.
+// Row in the TreeView. Rows are only created for the entries in view and are
+// rebound to other entries as the tree scrolls.
 class TreeRow : public TreeBase
 {
 public:
   ZilchDeclareType(TreeRow, TypeCopyMode::ReferenceType);
-  typedef InListBaseLink<TreeRow, TreeBase> TreeRowList;
 
-  TreeRow(TreeView* grid, TreeRow* rowparent, DataEntry* entry);
+  TreeRow(TreeView* grid);
   ~TreeRow();
 
   /// Compositions Interface
@@ -170,10 +170,15 @@ public:
 
   bool IsRoot();
 
+  /// Display the entry at the given index of the visible entries
+  void Bind(DataIndex index, uint depth, uint visibleRowIndex);
+  /// Stop displaying the entry so the row can be reused
+  void Unbind();
+
   /// Operations
   /// Refresh Data on this Row
   void RefreshData();
-  /// Rebuild Node and Children
+  /// Refresh the expander and data of this Row
   void Refresh();
   /// Expand this Row
   void Expand();
@@ -191,14 +196,11 @@ public:
 
   void Highlight(HighlightType::Type type, InsertMode::Type mode = InsertMode::On);
 
-  /// Destroy Row and Children
-  void RecursiveDestroy();
   /// Remove Row from DataSource.
   void Remove();
 
   void UpdateBgColor(uint index);
 
-  void Fill(Array<TreeRow*>&, uint depth);
   // events
   void OnKeyPress(KeyboardEvent* event);
   void OnMouseDownExpander(MouseEvent* event);
@@ -220,20 +222,16 @@ public:
   void OnMouseExit(MouseEvent* event);
 
   // Data
-  void DestroyChildren();
-  void RebuildChildren();
   DataIndex mIndex;
   TreeView* mTree;
-  TreeRow* mParentRow;
   uint mDepth;
-  // The index of visible rows (updated when new rows are created or deleted).
+  // The index of the bound entry in the tree's visible entries.
   uint mVisibleRowIndex;
   bool mExpanded;
   bool mActive;
   Element* mExpandIcon;
   Element* mSelection;
   Array<ValueEditor*> mEditorColumns;
-  TreeRowList mChildren;
   Element* mSeparator;
   Element* mGraphicBackground;
   bool mValid;
@@ -244,6 +242,16 @@ public:
   Spacer* mBackground;
 };
 
+/// An entry of the data source that's shown when scrolled to (all of its
+/// parents are expanded).
+struct TreeViewEntry
+{
+  DataIndex mIndex;
+  uint mDepth;
+  /// Position of the parent's entry in the visible entries.
+  uint mParent;
+};
+
 class ColumnHeader : public Composite
 {
 public:
@@ -321,6 +329,11 @@ public:
   // Full refresh of data tree.
   void Refresh();
 
+  /// Expand or collapse the entry whether or not it's in view.
+  void Expand(DataIndex& index);
+  void Collapse(DataIndex& index);
+
+  /// Returns the row displaying the given entry (null when it isn't in view).
   TreeRow* FindRowByIndex(DataIndex& index);
   uint FindRowIndex(TreeRow* row);
   void MoveToView(TreeRow* row);
@@ -403,6 +416,18 @@ public:
   void OnMetaDropUpdate(MetaDropEvent* e);
   void DragScroll(Vec2Param screenPosition);
 
+  /// Creates the row for the data source's root.
+  void CreateRoot();
+  /// The visible entries will be rebuilt before they're next used.
+  void InvalidateEntries();
+  /// Rebuilds the visible entries if they were invalidated.
+  void UpdateEntries();
+  void AddEntries(DataEntry* entry, uint depth, uint parent);
+  /// Binds rows to the visible entries in [start, end) and releases the rest.
+  void BindRows(uint start, uint end);
+  TreeRow* AcquireRow();
+  void ReleaseRow(TreeRow* row);
+
   /// Headers for each column
   Array<ColumnHeader*> mHeaders;
   HashMap<ColumnHeader*, ColumnResizer*> mHeaderResizers;
@@ -430,9 +455,17 @@ public:
   /// The height of each row in the tree.
   float mRowHeight;
 
-  /// Visible rows
+  /// Every entry that's visible when scrolled to in display order (the root
+  /// is first) and each entry's position by index id.
+  Array<TreeViewEntry> mEntries;
+  HashMap<u64, uint> mEntryMap;
+  bool mEntriesDirty;
+
+  /// Rows bound to the entries in view.
   Array<TreeRow*> mRows;
   HashMap<u64, TreeRow*> mRowMap;
+  /// Unbound rows kept for reuse.
+  Array<TreeRow*> mFreeRows;
   uint mScrollAreaRows;
 };
 
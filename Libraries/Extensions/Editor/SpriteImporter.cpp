@@ -16,6 +16,8 @@ void PixelGridArea::RenderUpdate(
     ViewBlock& viewBlock, FrameBlock& frameBlock, Mat4Param parentTx, ColorTransform colorTx, WidgetRect clipRect)
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
+  // Frames are drawn from the importer's settings
+  NeedsRedraw();
   mOwner->DrawRedirect(viewBlock, frameBlock, mWorldTx, colorTx, clipRect);
 }
 
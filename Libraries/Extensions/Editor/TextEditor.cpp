@@ -143,6 +143,9 @@ void ScintillaWidget::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // Scintilla paints on its own schedule
+  NeedsRedraw();
+
   mSurface.mViewBlock = &viewBlock;
   mSurface.mFrameBlock = &frameBlock;
   mSurface.mViewNode = nullptr;
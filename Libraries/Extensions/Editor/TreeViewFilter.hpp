@@ -4,7 +4,8 @@
 namespace Zero
 {
 
-// Data Source that filters another DataSource
+// Data Source that filters another DataSource. Large hierarchies are filtered
+// over several updates (see ContinueFilter).
 class DataSourceFilter : public DataSource
 {
 public:
@@ -15,6 +16,12 @@ public:
   DataSourceFilter()
   {
     mSource = NULL;
+    mFilterFunction = NULL;
+  }
+
+  ~DataSourceFilter()
+  {
+    SafeDelete(mFilterFunction);
   }
 
   // Helper bind for member functions bases filters
@@ -34,27 +41,114 @@ public:
     }
   };
 
-  // Filter the nodes with the give filter functor
+  // Type erased filter functor so filtering can be continued later
+  class FilterFunction
+  {
+  public:
+    virtual ~FilterFunction()
+    {
+    }
+    virtual bool Matches(DataEntry* entry) = 0;
+  };
+
+  template <typename filtertype>
+  class FilterFunctionOf : public FilterFunction
+  {
+  public:
+    FilterFunctionOf(filtertype filter) : mFilter(filter)
+    {
+    }
+
+    bool Matches(DataEntry* entry) override
+    {
+      return mFilter(entry);
+    }
+
+    filtertype mFilter;
+  };
+
+  // A node whose children haven't all been filtered. Indices are stored as
+  // entries may be destroyed between updates.
+  struct PendingNode
+  {
+    DataIndex mIndex;
+    DataIndex mPrevChild;
+    uint mNextChild;
+  };
+
+  // Start filtering the descendants of node with the given filter functor
   template <typename filtertype>
   void FilterNodes(filtertype filter, DataEntry* node)
   {
-    DataEntry* prev = NULL;
+    SafeDelete(mFilterFunction);
+    mFilterFunction = new FilterFunctionOf<filtertype>(filter);
+
+    mPendingNodes.Clear();
+    PushPendingNode(node);
+  }
+
+  void PushPendingNode(DataEntry* node)
+  {
+    PendingNode& pending = mPendingNodes.PushBack();
+    pending.mIndex = mSource->ToIndex(node);
+    pending.mPrevChild = cRootIndex;
+    pending.mNextChild = 0;
+  }
 
-    uint childCount = mSource->ChildCount(node);
+  // Filter more of the hierarchy (in the same order as a full walk), stopping
+  // once timeBudget seconds have passed. Returns whether filtering finished.
+  bool ContinueFilter(double timeBudget)
+  {
+    Timer timer;
+    uint tested = 0;
 
-    for (uint i = 0; i < childCount; ++i)
+    while (!mPendingNodes.Empty())
     {
-      DataEntry* child = mSource->GetChild(node, i, prev);
+      // Reading the time costs more than most filters
+      if (++tested % 64 == 0 && timer.UpdateAndGetTime() > timeBudget)
+        return false;
+
+      PendingNode& pending = mPendingNodes.Back();
+      DataEntry* node = mSource->ToEntry(pending.mIndex);
+      if (node == NULL || pending.mNextChild >= mSource->ChildCount(node))
+      {
+        mPendingNodes.PopBack();
+        continue;
+      }
+
+      DataEntry* prev = NULL;
+      if (pending.mNextChild != 0)
+        prev = mSource->ToEntry(pending.mPrevChild);
+
+      DataEntry* child = mSource->GetChild(node, pending.mNextChild, prev);
+      ++pending.mNextChild;
+      if (child == NULL)
+        continue;
+
+      DataIndex childIndex = mSource->ToIndex(child);
+      pending.mPrevChild = childIndex;
+
+      if (mFilterFunction->Matches(child))
+        mFilteredList.PushBack(childIndex);
+
+      if (mSource->ChildCount(child) > 0)
+        PushPendingNode(child);
+    }
 
-      if (filter(child))
-        mFilteredList.PushBack(mSource->ToIndex(child));
+    return true;
+  }
 
-      uint numbChildren = mSource->ChildCount(child);
-      if (numbChildren > 0)
-        FilterNodes(filter, child);
+  bool IsFiltering()
+  {
+    return !mPendingNodes.Empty();
+  }
 
-      prev = child;
-    }
+  // Clear the results and stop any filtering in progress
+  void ResetFilter()
+  {
+    mFilteredList.Clear();
+    mPendingNodes.Clear();
+    SafeDelete(mFilterFunction);
   }
 
   // Basic filter by name
@@ -71,7 +165,7 @@ public:
   // Filter with the given string
   virtual void Filter(StringParam filterString)
   {
-    mFilteredList.Clear();
+    ResetFilter();
     mFilterString = filterString;
 
     // Default is to filter by name
@@ -83,7 +177,7 @@ public:
   virtual void SetSource(DataSource* dataSource)
   {
     mSource = dataSource;
-    mFilteredList.Clear();
+    ResetFilter();
   }
 
   // Rest is just an adapter to original interface
@@ -169,6 +263,9 @@ public:
 
     return mSource->Remove(dataEntry);
   }
+
+  Array<PendingNode> mPendingNodes;
+  FilterFunction* mFilterFunction;
 };
 
 } // namespace Zero
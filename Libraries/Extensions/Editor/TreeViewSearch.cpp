@@ -4,6 +4,10 @@
 namespace Zero
 {
 
+// How long filtering may take each update. Anything left is filtered on the
+// next update so huge hierarchies don't stall typing.
+const double cFilterTimeBudget = 0.004;
+
 TreeViewSearch::TreeViewSearch(Composite* parent, TreeView* treeView, DataSourceFilter* filter) : Composite(parent)
 {
   mTreeView = treeView;
@@ -30,6 +34,7 @@ TreeViewSearch::TreeViewSearch(Composite* parent, TreeView* treeView, DataSource
   ConnectThisTo(mSearchField, Events::TextChanged, OnTextEntered);
   ConnectThisTo(mSearchField, Events::KeyDown, OnKeyDown);
   ConnectThisTo(mSearchField, Events::KeyRepeated, OnKeyDown);
+  ConnectThisTo(Z::gWidgetManager, Events::WidgetUpdate, OnWidgetUpdate);
 }
 
 TreeViewSearch::~TreeViewSearch()
@@ -92,7 +97,7 @@ void TreeViewSearch::OnTextEntered(Event* event)
 
   // Update the filter with the new string
   mFiltered->Filter(currentText);
-  mTreeView->Refresh();
+  ContinueFilter();
 }
 
 void TreeViewSearch::OnSourceDestroy(Event* event)
@@ -112,10 +117,22 @@ void TreeViewSearch::OnDataModified(Event* event)
   if (mFiltered)
   {
     mFiltered->Filter(mSearchField->GetText());
-    mTreeView->Refresh();
+    ContinueFilter();
   }
 }
 
+void TreeViewSearch::OnWidgetUpdate(UpdateEvent* event)
+{
+  if (mUnFiltered != nullptr && mFiltered->IsFiltering())
+    ContinueFilter();
+}
+
+void TreeViewSearch::ContinueFilter()
+{
+  mFiltered->ContinueFilter(cFilterTimeBudget);
+  mTreeView->Refresh();
+}
+
 void TreeViewSearch::CancelFilter()
 {
   mSearchField->SetText(String());
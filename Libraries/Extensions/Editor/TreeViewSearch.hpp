@@ -25,6 +25,10 @@ public:
   void OnKeyDown(KeyboardEvent* event);
   void OnSourceDestroy(Event* event);
   void OnDataModified(Event* event);
+  void OnWidgetUpdate(UpdateEvent* event);
+
+  /// Filters for up to the time budget and shows the results so far.
+  void ContinueFilter();
 };
 
 } // namespace Zero
@@ -56,6 +56,8 @@ ZilchDefineStaticLibrary(GameplayLibrary)
   ZilchInitializeType(PathFinder);
   ZilchInitializeType(PathFinderRequest);
   ZilchInitializeType(PathFinderGrid);
+  ZilchInitializeType(PathFinderGridFlowField);
+  ZilchInitializeType(PathFinderGridFlowFieldEvent);
   ZilchInitializeType(PathFinderMesh);
 
   ZilchInitializeType(SplineParticleEmitter);
@@ -48,6 +48,8 @@ public:
 #include "PriorityQueue.hpp"
 #include "PathFinder.hpp"
 #include "PathFinderGrid.hpp"
+#include "PathFinderGridSearch.hpp"
+#include "PathFinderGridFlowField.hpp"
 #include "PathFinderMesh.hpp"
 
 #include "MarchingSquares.hpp"
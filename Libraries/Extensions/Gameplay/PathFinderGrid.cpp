@@ -96,7 +96,7 @@ void PathFinderGridNodeRange::PopUntilValid()
       Error("Invalid move cost");
     }
 
-    PathFinderCell* cell = mGrid->mCells.FindPointer(mCurrentIntVec3);
+    const PathFinderCell* cell = mGrid->FindCell(mCurrentIntVec3);
     if (cell)
     {
       if (cell->mCollision)
@@ -115,6 +115,23 @@ PathFinderCell::PathFinderCell() : mCost(0.0f), mCollision(false)
 {
 }
 
+PathFinderGridChunk::PathFinderGridChunk() : mChunkIndex(IntVec3::cZero), mUsedCellCount(0)
+{
+}
+
+IntVec3 PathFinderGridChunk::CellToChunkIndex(IntVec3Param cellIndex)
+{
+  // Arithmetic shifts round negative indices down
+  return IntVec3(cellIndex.x >> cSizeShift, cellIndex.y >> cSizeShift, cellIndex.z >> cSizeShift);
+}
+
+uint PathFinderGridChunk::CellToLocalIndex(IntVec3Param cellIndex)
+{
+  const int cMask = cSize - 1;
+  return (uint)((cellIndex.x & cMask) + ((cellIndex.y & cMask) << cSizeShift) +
+                ((cellIndex.z & cMask) << (cSizeShift * 2)));
+}
+
 PathFinderAlgorithmGrid::PathFinderAlgorithmGrid() : mDiagonalMovement(true)
 {
 }
@@ -124,12 +141,12 @@ PathFinderGridNodeRange PathFinderAlgorithmGrid::QueryNeighbors(IntVec3Param nod
   return PathFinderGridNodeRange(this, node);
 }
 
-bool PathFinderAlgorithmGrid::QueryIsValid(IntVec3Param node)
+bool PathFinderAlgorithmGrid::QueryIsValid(IntVec3Param node) const
 {
   return !GetCollision(node);
 }
 
-float PathFinderAlgorithmGrid::QueryHeuristic(IntVec3Param node, IntVec3Param goal)
+float PathFinderAlgorithmGrid::QueryHeuristic(IntVec3Param node, IntVec3Param goal) const
 {
   int dx = Math::Abs(node.x - goal.x);
   int dy = Math::Abs(node.y - goal.y);
@@ -153,26 +170,20 @@ float PathFinderAlgorithmGrid::QueryHeuristic(IntVec3Param node, IntVec3Param go
   }
 }
 
+void PathFinderAlgorithmGrid::FindNodePath(
+    IntVec3Param start, IntVec3Param goal, Array<IntVec3>& pathOut, size_t maxIterations, const bool* cancel)
+{
+  PathFinderGridSearch::GetThreadSearch()->FindPath(*this, start, goal, pathOut, maxIterations, cancel);
+}
+
 void PathFinderAlgorithmGrid::SetCollision(IntVec3Param index, bool collision)
 {
-  if (collision)
-  {
-    mCells[index].mCollision = true;
-  }
-  else if (PathFinderCell* cell = mCells.FindPointer(index))
-  {
-    // As an optimization if the cell has no cost and no collision we can remove
-    // it
-    if (cell->mCost == 0.0f)
-      mCells.Erase(index);
-    else
-      cell->mCollision = false;
-  }
+  SetCell(index, GetCost(index), collision);
 }
 
-bool PathFinderAlgorithmGrid::GetCollision(IntVec3Param index)
+bool PathFinderAlgorithmGrid::GetCollision(IntVec3Param index) const
 {
-  PathFinderCell* cell = mCells.FindPointer(index);
+  const PathFinderCell* cell = FindCell(index);
   if (!cell)
     return false;
 
@@ -181,24 +192,12 @@ bool PathFinderAlgorithmGrid::GetCollision(IntVec3Param index)
 
 void PathFinderAlgorithmGrid::SetCost(IntVec3Param index, float cost)
 {
-  if (cost != 0.0f)
-  {
-    mCells[index].mCost = cost;
-  }
-  else if (PathFinderCell* cell = mCells.FindPointer(index))
-  {
-    // As an optimization if the cell has no cost and no collision we can remove
-    // it
-    if (cell->mCollision == false)
-      mCells.Erase(index);
-    else
-      cell->mCost = 0.0f;
-  }
+  SetCell(index, cost, GetCollision(index));
 }
 
-float PathFinderAlgorithmGrid::GetCost(IntVec3Param index)
+float PathFinderAlgorithmGrid::GetCost(IntVec3Param index) const
 {
-  PathFinderCell* cell = mCells.FindPointer(index);
+  const PathFinderCell* cell = FindCell(index);
   if (!cell)
     return 0.0f;
 
@@ -207,7 +206,76 @@ float PathFinderAlgorithmGrid::GetCost(IntVec3Param index)
 
 void PathFinderAlgorithmGrid::Clear()
 {
-  mCells.Clear();
+  mChunks.Clear();
+  mChunkIndices.Clear();
+}
+
+const PathFinderCell* PathFinderAlgorithmGrid::FindCell(IntVec3Param index) const
+{
+  const PathFinderGridChunk* chunk = FindChunk(PathFinderGridChunk::CellToChunkIndex(index));
+  if (!chunk)
+    return nullptr;
+
+  return &chunk->mCells[PathFinderGridChunk::CellToLocalIndex(index)];
+}
+
+const PathFinderGridChunk* PathFinderAlgorithmGrid::FindChunk(IntVec3Param chunkIndex) const
+{
+  const uint* arrayIndex = mChunkIndices.FindPointer(chunkIndex);
+  if (!arrayIndex)
+    return nullptr;
+
+  return &mChunks[*arrayIndex];
+}
+
+void PathFinderAlgorithmGrid::SetCell(IntVec3Param index, float cost, bool collision)
+{
+  bool used = (cost != 0.0f || collision);
+
+  IntVec3 chunkIndex = PathFinderGridChunk::CellToChunkIndex(index);
+  uint* arrayIndex = mChunkIndices.FindPointer(chunkIndex);
+  if (!arrayIndex)
+  {
+    // Cells without cost or collision don't need to be stored
+    if (!used)
+      return;
+
+    mChunkIndices.Insert(chunkIndex, mChunks.Size());
+    arrayIndex = mChunkIndices.FindPointer(chunkIndex);
+    mChunks.PushBack().mChunkIndex = chunkIndex;
+  }
+
+  PathFinderGridChunk& chunk = mChunks[*arrayIndex];
+  PathFinderCell& cell = chunk.mCells[PathFinderGridChunk::CellToLocalIndex(index)];
+  bool wasUsed = (cell.mCost != 0.0f || cell.mCollision);
+
+  cell.mCost = cost;
+  cell.mCollision = collision;
+
+  if (used && !wasUsed)
+    ++chunk.mUsedCellCount;
+  else if (!used && wasUsed)
+    --chunk.mUsedCellCount;
+
+  // As an optimization chunks without any cost or collision are removed
+  if (chunk.mUsedCellCount == 0)
+    RemoveChunk(*arrayIndex);
+}
+
+void PathFinderAlgorithmGrid::RemoveChunk(uint arrayIndex)
+{
+  IntVec3 chunkIndex = mChunks[arrayIndex].mChunkIndex;
+
+  // Move the last chunk into the removed chunk's place
+  uint lastIndex = mChunks.Size() - 1;
+  if (arrayIndex != lastIndex)
+  {
+    mChunks[arrayIndex] = mChunks[lastIndex];
+    mChunkIndices[mChunks[arrayIndex].mChunkIndex] = arrayIndex;
+  }
+
+  mChunks.PopBack();
+  mChunkIndices.Erase(chunkIndex);
 }
 
 ZilchDefineType(PathFinderGrid, builder, type)
@@ -219,6 +287,7 @@ ZilchDefineType(PathFinderGrid, builder, type)
   ZeroBindInterface(PathFinder);
   ZeroBindDependency(Transform);
   ZeroBindEvent(Events::PathFinderGridFinished, PathFinderEvent<IntVec3>);
+  ZeroBindEvent(Events::PathFinderGridFlowFieldFinished, PathFinderGridFlowFieldEvent);
 
   ZilchBindOverloadedMethod(FindPath, ZilchInstanceOverload(HandleOf<ArrayClass<IntVec3>>, IntVec3Param, IntVec3Param));
   ZilchBindOverloadedMethod(FindPath, ZilchInstanceOverload(HandleOf<ArrayClass<Real3>>, Real3Param, Real3Param));
@@ -226,6 +295,9 @@ ZilchDefineType(PathFinderGrid, builder, type)
                             ZilchInstanceOverload(HandleOf<PathFinderRequest>, IntVec3Param, IntVec3Param));
   ZilchBindOverloadedMethod(FindPathThreaded,
                             ZilchInstanceOverload(HandleOf<PathFinderRequest>, Real3Param, Real3Param));
+  ZilchBindOverloadedMethod(FindFlowField, ZilchInstanceOverload(HandleOf<PathFinderGridFlowField>, IntVec3Param));
+  ZilchBindOverloadedMethod(FindFlowField, ZilchInstanceOverload(HandleOf<PathFinderGridFlowField>, Real3Param));
+  ZilchBindMethod(ClearFlowFields);
 
   ZilchBindMethod(SetCollision);
   ZilchBindMethod(GetCollision);
@@ -244,7 +316,8 @@ ZilchDefineType(PathFinderGrid, builder, type)
 PathFinderGrid::PathFinderGrid() :
     mTransform(nullptr),
     mLocalCellSize(Vec3(1)),
-    mGrid(new CopyOnWriteData<PathFinderAlgorithmGrid>())
+    mGrid(new CopyOnWriteData<PathFinderAlgorithmGrid>()),
+    mFlowFieldRequestCount(0)
 {
 }
 
@@ -260,32 +333,44 @@ void PathFinderGrid::Initialize(CogInitializer& initializer)
 {
   ZilchBase::Initialize(initializer);
   mTransform = GetOwner()->has(Transform);
+  ConnectThisTo(GetSpace(), Events::LogicUpdate, OnLogicUpdate);
 }
 
 void PathFinderGrid::DebugDraw()
 {
-  forRange (const auto& pair, mGrid->mCells.All())
+  const int cSize = PathFinderGridChunk::cSize;
+
+  forRange (const PathFinderGridChunk& chunk, mGrid->mChunks.All())
   {
-    Vec4 color;
-    if (pair.second.mCollision)
-      color = ToFloatColor(Color::Red);
-    else
-      color = ToFloatColor(Color::Green);
-
-    Vec3 worldCenter = CellIndexToWorldPosition(pair.first);
-
-    float xScale = Math::Length(mTransform->TransformNormal(Vec3::cXAxis));
-    float yScale = Math::Length(mTransform->TransformNormal(Vec3::cYAxis));
-    float zScale = Math::Length(mTransform->TransformNormal(Vec3::cZAxis));
-
-    Vec3 halfExtents(xScale / 2.0f, yScale / 2.0f, zScale / 2.0f);
-
-    Debug::Obb debugObb(worldCenter, halfExtents);
-    debugObb.mColor = color;
-    gDebugDraw->Add(debugObb);
-    debugObb.SetFilled(true);
-    debugObb.mColor.w = 0.1f;
-    gDebugDraw->Add(debugObb);
+    IntVec3 firstCell = chunk.mChunkIndex * cSize;
+    for (int i = 0; i < PathFinderGridChunk::cCellCount; ++i)
+    {
+      const PathFinderCell& cell = chunk.mCells[i];
+      if (cell.mCost == 0.0f && !cell.mCollision)
+        continue;
+
+      Vec4 color;
+      if (cell.mCollision)
+        color = ToFloatColor(Color::Red);
+      else
+        color = ToFloatColor(Color::Green);
+
+      IntVec3 cellIndex = firstCell + IntVec3(i % cSize, (i / cSize) % cSize, i / (cSize * cSize));
+      Vec3 worldCenter = CellIndexToWorldPosition(cellIndex);
+
+      float xScale = Math::Length(mTransform->TransformNormal(Vec3::cXAxis));
+      float yScale = Math::Length(mTransform->TransformNormal(Vec3::cYAxis));
+      float zScale = Math::Length(mTransform->TransformNormal(Vec3::cZAxis));
+
+      Vec3 halfExtents(xScale / 2.0f, yScale / 2.0f, zScale / 2.0f);
+
+      Debug::Obb debugObb(worldCenter, halfExtents);
+      debugObb.mColor = color;
+      gDebugDraw->Add(debugObb);
+      debugObb.SetFilled(true);
+      debugObb.mColor.w = 0.1f;
+      gDebugDraw->Add(debugObb);
+    }
   }
 }
 
@@ -309,6 +394,90 @@ HandleOf<PathFinderRequest> PathFinderGrid::FindPathThreaded(Vec3Param worldStar
   return ZilchBase::FindPathThreaded(worldStart, worldGoal);
 }
 
+// The number of flow fields kept before the least recently requested is dropped
+const uint cMaxFlowFields = 16;
+
+HandleOf<PathFinderGridFlowField> PathFinderGrid::FindFlowField(IntVec3Param goal)
+{
+  ++mFlowFieldRequestCount;
+
+  if (HandleOf<PathFinderGridFlowField>* cached = mFlowFields.FindPointer(goal))
+  {
+    PathFinderGridFlowField* flowField = *cached;
+    flowField->mLastRequest = mFlowFieldRequestCount;
+    return flowField;
+  }
+
+  if (mFlowFields.Size() >= cMaxFlowFields)
+  {
+    IntVec3 oldestGoal = IntVec3::cZero;
+    u64 oldestRequest = (u64)-1;
+    forRange (auto& pair, mFlowFields.All())
+    {
+      PathFinderGridFlowField* flowField = pair.second;
+      if (flowField->mLastRequest < oldestRequest)
+      {
+        oldestGoal = pair.first;
+        oldestRequest = flowField->mLastRequest;
+      }
+    }
+
+    PathFinderGridFlowField* oldest = mFlowFields[oldestGoal];
+    oldest->Detach();
+    mFlowFields.Erase(oldestGoal);
+  }
+
+  PathFinderGridFlowField* flowField = new PathFinderGridFlowField(this, goal);
+  flowField->mLastRequest = mFlowFieldRequestCount;
+  mFlowFields.Insert(goal, flowField);
+  flowField->StartJob();
+  return flowField;
+}
+
+HandleOf<PathFinderGridFlowField> PathFinderGrid::FindFlowField(Vec3Param worldGoal)
+{
+  return FindFlowField(WorldPositionToCellIndex(worldGoal));
+}
+
+void PathFinderGrid::ClearFlowFields()
+{
+  forRange (auto& pair, mFlowFields.All())
+  {
+    PathFinderGridFlowField* flowField = pair.second;
+    flowField->Detach();
+  }
+  mFlowFields.Clear();
+}
+
+void PathFinderGrid::OnLogicUpdate(UpdateEvent* event)
+{
+  // Fields are updated once a frame so that all of the cells changed in a
+  // frame are handled by one job
+  forRange (auto& pair, mFlowFields.All())
+  {
+    PathFinderGridFlowField* flowField = pair.second;
+    flowField->StartJob();
+  }
+}
+
+void PathFinderGrid::OnCellChanged(IntVec3Param index)
+{
+  forRange (auto& pair, mFlowFields.All())
+  {
+    PathFinderGridFlowField* flowField = pair.second;
+    flowField->OnCellChanged(index);
+  }
+}
+
+void PathFinderGrid::InvalidateFlowFields()
+{
+  forRange (auto& pair, mFlowFields.All())
+  {
+    PathFinderGridFlowField* flowField = pair.second;
+    flowField->Invalidate();
+  }
+}
+
 void PathFinderGrid::SetCellSize(Vec3Param size)
 {
   mLocalCellSize = Math::Max(Vec3(0.001f), size);
@@ -323,6 +492,7 @@ void PathFinderGrid::SetDiagonalMovement(bool value)
 {
   mGrid.CopyIfNeeded();
   mGrid->mDiagonalMovement = value;
+  InvalidateFlowFields();
 }
 
 bool PathFinderGrid::GetDiagonalMovement()
@@ -375,6 +545,7 @@ void PathFinderGrid::SetCollision(IntVec3Param index, bool collision)
 {
   mGrid.CopyIfNeeded();
   mGrid->SetCollision(index, collision);
+  OnCellChanged(index);
 }
 
 bool PathFinderGrid::GetCollision(IntVec3Param index)
@@ -386,6 +557,7 @@ void PathFinderGrid::SetCost(IntVec3Param index, float cost)
 {
   mGrid.CopyIfNeeded();
   mGrid->SetCost(index, cost);
+  OnCellChanged(index);
 }
 
 float PathFinderGrid::GetCost(IntVec3Param index)
@@ -397,6 +569,7 @@ void PathFinderGrid::Clear()
 {
   mGrid.CopyIfNeeded();
   mGrid->Clear();
+  InvalidateFlowFields();
 }
 
 Vec3 PathFinderGrid::CellIndexToWorldPosition(IntVec3Param index)
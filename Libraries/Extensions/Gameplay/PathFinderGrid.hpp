@@ -11,6 +11,7 @@ DeclareEvent(PathFinderGridFinished);
 
 // PathFinderAlgorithmGrid
 class PathFinderAlgorithmGrid;
+class PathFinderGridFlowField;
 
 class PathFinderGridNodeRange
 {
@@ -54,6 +55,30 @@ public:
   bool mCollision;
 };
 
+/// A dense block of cells so that neighboring cells are next to each other in
+/// memory instead of each being its own hash map entry. A chunk only exists
+/// while one of its cells has a cost or collision.
+class PathFinderGridChunk
+{
+public:
+  /// Number of cells along each axis of a chunk.
+  static const int cSize = 8;
+  static const int cSizeShift = 3;
+  static const int cCellCount = cSize * cSize * cSize;
+
+  PathFinderGridChunk();
+
+  /// The chunk that contains the cell.
+  static IntVec3 CellToChunkIndex(IntVec3Param cellIndex);
+  /// Index of the cell in mCells.
+  static uint CellToLocalIndex(IntVec3Param cellIndex);
+
+  IntVec3 mChunkIndex;
+  /// Number of cells with a cost or collision.
+  uint mUsedCellCount;
+  PathFinderCell mCells[cCellCount];
+};
+
 class PathFinderAlgorithmGrid : public PathFinderAlgorithm<PathFinderAlgorithmGrid, IntVec3, PathFinderGridNodeRange>
 {
 public:
@@ -61,34 +86,52 @@ public:
 
   // PathFinderAlgorithm Interface
   PathFinderGridNodeRange QueryNeighbors(IntVec3Param node);
-  bool QueryIsValid(IntVec3Param node);
-  float QueryHeuristic(IntVec3Param node, IntVec3Param goal);
+  bool QueryIsValid(IntVec3Param node) const;
+  float QueryHeuristic(IntVec3Param node, IntVec3Param goal) const;
+
+  /// Runs the search with the calling thread's PathFinderGridSearch instead of
+  /// the generic A* so queries don't allocate.
+  void FindNodePath(IntVec3Param start,
+                    IntVec3Param goal,
+                    Array<IntVec3>& pathOut,
+                    size_t maxIterations,
+                    const bool* cancel = nullptr);
 
   /// If there is collision at a cell then the A* algorithm cannot traverse that
   /// cell.
   void SetCollision(IntVec3Param index, bool collision);
-  bool GetCollision(IntVec3Param index);
+  bool GetCollision(IntVec3Param index) const;
 
   /// A higher cost of a cell makes the A* algorithm less likely to traverse
   /// that cell. The default cost of any cell is 1.0.
   void SetCost(IntVec3Param index, float cost);
-  float GetCost(IntVec3Param index);
+  float GetCost(IntVec3Param index) const;
 
   /// Clear the grid of all collision and costs.
   void Clear();
 
+  /// Returns the cell at the index or null if it has no cost or collision.
+  const PathFinderCell* FindCell(IntVec3Param index) const;
+  /// Returns the chunk at the chunk index or null if it has no used cells.
+  const PathFinderGridChunk* FindChunk(IntVec3Param chunkIndex) const;
+
   /// Whether the A* path can move diagonally or only on the cardinal axes.
   bool mDiagonalMovement;
 
   // Internals
-  HashMap<IntVec3, PathFinderCell> mCells;
+  void SetCell(IntVec3Param index, float cost, bool collision);
+  void RemoveChunk(uint arrayIndex);
+
+  Array<PathFinderGridChunk> mChunks;
+  HashMap<IntVec3, uint> mChunkIndices;
 };
 
 // PathFinderGrid
 /// A* pathfinding on a grid. The grid supports cardinal or diagonal movement.
 /// Collision and costs can be set for each tile to make path-finding avoid
 /// cells. Sends the PathFinderGridFinished event on itself when a threaded
-/// request completes.
+/// request completes. Many agents heading to the same goal can share a flow
+/// field instead of each finding a path.
 class PathFinderGrid : public PathFinder
 {
 public:
@@ -143,6 +186,21 @@ public:
   /// this.Owner).
   HandleOf<PathFinderRequest> FindPathThreaded(Vec3Param worldStart, Vec3Param worldGoal);
 
+  /// Returns the flow field leading to the goal cell, which gives the direction
+  /// to move in from any cell. Fields are cached by goal so every agent heading
+  /// to the same goal shares one search. A new field is built on another thread
+  /// and sends PathFinderGridFlowFieldFinished on the field and this.Owner when
+  /// done. Fields stay up to date as collision and costs change.
+  HandleOf<PathFinderGridFlowField> FindFlowField(IntVec3Param goal);
+
+  /// Returns the flow field leading to the cell that the world position
+  /// occupies.
+  HandleOf<PathFinderGridFlowField> FindFlowField(Vec3Param worldGoal);
+
+  /// Drops every cached flow field. Fields still referenced elsewhere stop
+  /// being updated.
+  void ClearFlowFields();
+
   /// The size of the cell in local space units.
   /// If the PathFinderGrid has no parent, or the parent's transform has
   /// no scale then this will be the same as the world cell size.
@@ -166,9 +224,15 @@ public:
   Vec3 CellIndexToLocalPosition(IntVec3Param index);
 
   // Internals
+  void OnLogicUpdate(UpdateEvent* event);
+  void OnCellChanged(IntVec3Param index);
+  void InvalidateFlowFields();
+
   Transform* mTransform;
   CopyOnWriteHandle<PathFinderAlgorithmGrid> mGrid;
   Vec3 mLocalCellSize;
+  HashMap<IntVec3, HandleOf<PathFinderGridFlowField>> mFlowFields;
+  u64 mFlowFieldRequestCount;
 };
 
 } // namespace Zero
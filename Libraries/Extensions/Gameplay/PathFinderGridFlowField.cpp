@@ -0,0 +1,554 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+namespace Events
+{
+DefineEvent(PathFinderGridFlowFieldFinished);
+} // namespace Events
+
+// Changing more cells than this between updates rebuilds the field instead
+const uint cMaxFlowFieldChangedCells = 4096;
+
+// PathFinderGridFlowFieldData
+PathFinderGridFlowFieldData::PathFinderGridFlowFieldData() :
+    mGoal(IntVec3::cZero),
+    mDiagonalMovement(true),
+    mMin(IntVec3::cZero),
+    mMax(IntVec3::cZero),
+    mWrittenAll(true)
+{
+}
+
+bool PathFinderGridFlowFieldData::Build(const PathFinderAlgorithmGrid& grid, IntVec3Param goal, const bool* cancel)
+{
+  const int cSize = PathFinderGridChunk::cSize;
+  const float cInfinity = Math::PositiveMax();
+
+  mGoal = goal;
+  mDiagonalMovement = grid.mDiagonalMovement;
+  mWrittenAll = true;
+  mWrittenCells.Clear();
+
+  // The region is every cell with cost or collision and the goal, grown by a
+  // cell so that paths can go around the outside of everything
+  mMin = goal;
+  mMax = goal;
+  forRange (const PathFinderGridChunk& chunk, grid.mChunks.All())
+  {
+    IntVec3 firstCell = chunk.mChunkIndex * cSize;
+    for (int i = 0; i < PathFinderGridChunk::cCellCount; ++i)
+    {
+      const PathFinderCell& cell = chunk.mCells[i];
+      if (cell.mCost == 0.0f && !cell.mCollision)
+        continue;
+
+      IntVec3 cellIndex = firstCell + IntVec3(i % cSize, (i / cSize) % cSize, i / (cSize * cSize));
+      mMin = Math::Min(mMin, cellIndex);
+      mMax = Math::Max(mMax, cellIndex);
+    }
+  }
+  mMin -= IntVec3(1, 1, 1);
+  mMax += IntVec3(1, 1, 1);
+
+  IntVec3 size = mMax - mMin + IntVec3(1, 1, 1);
+  u64 cellCount = (u64)size.x * (u64)size.y * (u64)size.z;
+  if (cellCount > cMaxCellCount)
+    return false;
+
+  mCellCosts.Clear();
+  mCellCosts.Resize((uint)cellCount, 0.0f);
+  mCostsToGoal.Clear();
+  mCostsToGoal.Resize((uint)cellCount, cInfinity);
+  mDirections.Clear();
+  mDirections.Resize((uint)cellCount, (byte)cNoDirection);
+
+  forRange (const PathFinderGridChunk& chunk, grid.mChunks.All())
+  {
+    IntVec3 firstCell = chunk.mChunkIndex * cSize;
+    for (int i = 0; i < PathFinderGridChunk::cCellCount; ++i)
+    {
+      const PathFinderCell& cell = chunk.mCells[i];
+      if (cell.mCost == 0.0f && !cell.mCollision)
+        continue;
+
+      IntVec3 cellIndex = firstCell + IntVec3(i % cSize, (i / cSize) % cSize, i / (cSize * cSize));
+      mCellCosts[CellToIndex(cellIndex)] = cell.mCollision ? cInfinity : cell.mCost;
+    }
+  }
+
+  mOpen.Clear();
+  uint goalIndex = CellToIndex(goal);
+  if (mCellCosts[goalIndex] != cInfinity)
+  {
+    mCostsToGoal[goalIndex] = 0.0f;
+    mOpen.Push(goalIndex, 0.0f);
+  }
+
+  return Propagate(cancel);
+}
+
+bool PathFinderGridFlowFieldData::Update(const PathFinderAlgorithmGrid& grid,
+                                         const Array<IntVec3>& changedCells,
+                                         const bool* cancel)
+{
+  const byte cAffected = cNoDirection - 1;
+  const float cInfinity = Math::PositiveMax();
+  int firstDirection = PathFinderGridDirections::GetFirst(mDiagonalMovement);
+
+  // Find every cell whose path to the goal went through a changed cell
+  Array<uint> affected;
+  forRange (IntVec3Param changedCell, changedCells.All())
+  {
+    uint index = CellToIndex(changedCell);
+
+    const PathFinderCell* cell = grid.FindCell(changedCell);
+    mCellCosts[index] = 0.0f;
+    if (cell)
+      mCellCosts[index] = cell->mCollision ? cInfinity : cell->mCost;
+
+    if (mDirections[index] != cAffected)
+    {
+      mDirections[index] = cAffected;
+      affected.PushBack(index);
+    }
+  }
+
+  for (uint i = 0; i < affected.Size(); ++i)
+  {
+    IntVec3 cell = IndexToCell(affected[i]);
+    for (int direction = firstDirection; direction < PathFinderGridDirections::cCount; ++direction)
+    {
+      // The neighbor that would move in this direction to get to the cell
+      IntVec3 neighbor = cell - PathFinderGridDirections::cOffsets[direction];
+      if (!Contains(neighbor))
+        continue;
+
+      uint neighborIndex = CellToIndex(neighbor);
+      if (mDirections[neighborIndex] == direction)
+      {
+        mDirections[neighborIndex] = cAffected;
+        affected.PushBack(neighborIndex);
+      }
+    }
+  }
+
+  forRange (uint index, affected.All())
+  {
+    mCostsToGoal[index] = cInfinity;
+    mDirections[index] = cNoDirection;
+  }
+
+  // Everything written from here on is either affected or found by Propagate
+  mWrittenAll = false;
+  mWrittenCells = affected;
+
+  // Start the affected cells from the best of their unaffected neighbors. Cells
+  // that got cheaper are also expanded from here.
+  mOpen.Clear();
+  uint goalIndex = CellToIndex(mGoal);
+  forRange (uint index, affected.All())
+  {
+    if (mCellCosts[index] == cInfinity)
+      continue;
+
+    if (index == goalIndex)
+    {
+      mCostsToGoal[index] = 0.0f;
+      mOpen.Push(index, 0.0f);
+      continue;
+    }
+
+    IntVec3 cell = IndexToCell(index);
+    for (int direction = firstDirection; direction < PathFinderGridDirections::cCount; ++direction)
+    {
+      IntVec3 neighbor = cell + PathFinderGridDirections::cOffsets[direction];
+      if (!Contains(neighbor))
+        continue;
+
+      uint neighborIndex = CellToIndex(neighbor);
+      float costToGoal = mCostsToGoal[neighborIndex];
+      if (costToGoal == cInfinity)
+        continue;
+
+      costToGoal += PathFinderGridDirections::cCosts[direction] + mCellCosts[neighborIndex];
+      if (costToGoal < mCostsToGoal[index])
+      {
+        mCostsToGoal[index] = costToGoal;
+        mDirections[index] = (byte)direction;
+      }
+    }
+
+    if (mCostsToGoal[index] != cInfinity)
+      mOpen.Push(index, mCostsToGoal[index]);
+  }
+
+  return Propagate(cancel);
+}
+
+void PathFinderGridFlowFieldData::CopyChanges(const PathFinderGridFlowFieldData& source)
+{
+  // This must be the field that the source was updated from. The flow field
+  // only ever swaps the two, so it is unless either one was built since.
+  bool sameField = !source.mWrittenAll && !mWrittenAll && mGoal == source.mGoal && mMin == source.mMin &&
+                   mMax == source.mMax && mDiagonalMovement == source.mDiagonalMovement;
+  if (!sameField)
+  {
+    mGoal = source.mGoal;
+    mDiagonalMovement = source.mDiagonalMovement;
+    mMin = source.mMin;
+    mMax = source.mMax;
+    mCellCosts = source.mCellCosts;
+    mCostsToGoal = source.mCostsToGoal;
+    mDirections = source.mDirections;
+    mWrittenAll = false;
+    mWrittenCells.Clear();
+    return;
+  }
+
+  forRange (uint index, source.mWrittenCells.All())
+  {
+    mCellCosts[index] = source.mCellCosts[index];
+    mCostsToGoal[index] = source.mCostsToGoal[index];
+    mDirections[index] = source.mDirections[index];
+  }
+  mWrittenCells.Clear();
+}
+
+bool PathFinderGridFlowFieldData::Contains(IntVec3Param cell) const
+{
+  return cell.x >= mMin.x && cell.y >= mMin.y && cell.z >= mMin.z && cell.x <= mMax.x && cell.y <= mMax.y &&
+         cell.z <= mMax.z;
+}
+
+IntVec3 PathFinderGridFlowFieldData::GetDirection(IntVec3Param cell) const
+{
+  if (Contains(cell))
+  {
+    byte direction = mDirections[CellToIndex(cell)];
+    if (direction == cNoDirection)
+      return IntVec3::cZero;
+    return PathFinderGridDirections::cOffsets[direction];
+  }
+
+  // Move straight towards the region
+  IntVec3 delta = Math::Min(Math::Max(cell, mMin), mMax) - cell;
+  IntVec3 step(Math::Clamp(delta.x, -1, 1), Math::Clamp(delta.y, -1, 1), Math::Clamp(delta.z, -1, 1));
+  if (mDiagonalMovement)
+    return step;
+
+  // Only move on the axis that's furthest away
+  IntVec3 distance = Math::Abs(delta);
+  if (distance.x >= distance.y && distance.x >= distance.z)
+    return IntVec3(step.x, 0, 0);
+  if (distance.y >= distance.z)
+    return IntVec3(0, step.y, 0);
+  return IntVec3(0, 0, step.z);
+}
+
+float PathFinderGridFlowFieldData::GetCostToGoal(IntVec3Param cell) const
+{
+  IntVec3 closest = Math::Min(Math::Max(cell, mMin), mMax);
+  float costToGoal = mCostsToGoal[CellToIndex(closest)];
+  if (costToGoal == Math::PositiveMax())
+    return -1.0f;
+
+  // Nothing outside of the region is in the way of the closest cell in it
+  IntVec3 distance = Math::Abs(closest - cell);
+  if (!mDiagonalMovement)
+    return costToGoal + float(distance.x + distance.y + distance.z);
+
+  int sorted[] = {distance.x, distance.y, distance.z};
+  Zero::InsertionSort(sorted, sorted + 3, Zero::less<int>(), sorted);
+  float straight = float(sorted[2] - sorted[1]);
+  float diagonal2 = float(sorted[1] - sorted[0]);
+  float diagonal3 = float(sorted[0]);
+  return costToGoal + straight + diagonal2 * Math::Sqrt(2.0f) + diagonal3 * Math::Sqrt(3.0f);
+}
+
+uint PathFinderGridFlowFieldData::CellToIndex(IntVec3Param cell) const
+{
+  IntVec3 size = mMax - mMin + IntVec3(1, 1, 1);
+  IntVec3 local = cell - mMin;
+  return (uint)(local.x + size.x * (local.y + size.y * local.z));
+}
+
+IntVec3 PathFinderGridFlowFieldData::IndexToCell(uint index) const
+{
+  IntVec3 size = mMax - mMin + IntVec3(1, 1, 1);
+  int x = (int)(index % (uint)size.x);
+  index /= (uint)size.x;
+  int y = (int)(index % (uint)size.y);
+  int z = (int)(index / (uint)size.y);
+  return mMin + IntVec3(x, y, z);
+}
+
+bool PathFinderGridFlowFieldData::Propagate(const bool* cancel)
+{
+  int firstDirection = PathFinderGridDirections::GetFirst(mDiagonalMovement);
+
+  while (!mOpen.Empty())
+  {
+    // If an outside entity wanted us to terminate early...
+    if (cancel && *cancel)
+      return false;
+
+    PathFinderGridOpenList::Entry entry = mOpen.Pop();
+    if (entry.mPriority != mCostsToGoal[entry.mIndex])
+      continue;
+
+    // Every neighbor that moves into this cell pays for entering it
+    IntVec3 cell = IndexToCell(entry.mIndex);
+    float costThroughCell = entry.mPriority + mCellCosts[entry.mIndex];
+    for (int direction = firstDirection; direction < PathFinderGridDirections::cCount; ++direction)
+    {
+      IntVec3 neighbor = cell - PathFinderGridDirections::cOffsets[direction];
+      if (!Contains(neighbor))
+        continue;
+
+      uint neighborIndex = CellToIndex(neighbor);
+      if (mCellCosts[neighborIndex] == Math::PositiveMax())
+        continue;
+
+      float costToGoal = costThroughCell + PathFinderGridDirections::cCosts[direction];
+      if (costToGoal < mCostsToGoal[neighborIndex])
+      {
+        mCostsToGoal[neighborIndex] = costToGoal;
+        mDirections[neighborIndex] = (byte)direction;
+        mOpen.Push(neighborIndex, costToGoal);
+        if (!mWrittenAll)
+          mWrittenCells.PushBack(neighborIndex);
+      }
+    }
+  }
+  return true;
+}
+
+// PathFinderGridFlowFieldEvent
+ZilchDefineType(PathFinderGridFlowFieldEvent, builder, type)
+{
+  ZeroBindDocumented();
+  ZilchBindFieldGetter(mFlowField);
+  ZilchBindFieldGetter(mDuration);
+}
+
+PathFinderGridFlowFieldEvent::PathFinderGridFlowFieldEvent() : mDuration(0), mData(nullptr)
+{
+}
+
+PathFinderGridFlowFieldEvent::~PathFinderGridFlowFieldEvent()
+{
+  delete mData;
+}
+
+// PathFinderGridFlowField
+ZilchDefineType(PathFinderGridFlowField, builder, type)
+{
+  ZeroBindDocumented();
+  ZeroBindEvent(Events::PathFinderGridFlowFieldFinished, PathFinderGridFlowFieldEvent);
+
+  ZilchBindMethod(GetDirection);
+  ZilchBindMethod(GetWorldDirection);
+  ZilchBindMethod(GetCostToGoal);
+  ZilchBindFieldGetter(mPathFinderComponent);
+  ZilchBindFieldGetter(mGoal);
+  ZilchBindFieldGetter(mStatus);
+}
+
+PathFinderGridFlowField::PathFinderGridFlowField(PathFinderGrid* owner, IntVec3Param goal) :
+    mPathFinderComponent(owner),
+    mGoal(goal),
+    mStatus(PathFinderStatus::Pending),
+    mData(nullptr),
+    mBackData(nullptr),
+    mNeedsRebuild(true),
+    mDetached(false),
+    mLastRequest(0)
+{
+  // The job sends its result to the field, which takes the data and forwards
+  // the event to the PathFinderGrid
+  ConnectThisTo(this, Events::PathFinderGridFlowFieldFinished, OnJobFinished);
+}
+
+PathFinderGridFlowField::~PathFinderGridFlowField()
+{
+  if (mJob)
+    mJob->Cancel();
+  delete mData;
+  delete mBackData;
+}
+
+IntVec3 PathFinderGridFlowField::GetDirection(IntVec3Param cell)
+{
+  if (mData == nullptr)
+    return IntVec3::cZero;
+  return mData->GetDirection(cell);
+}
+
+Vec3 PathFinderGridFlowField::GetWorldDirection(Vec3Param worldPosition)
+{
+  PathFinderGrid* pathFinder = mPathFinderComponent;
+  if (mData == nullptr || pathFinder == nullptr)
+    return Vec3::cZero;
+
+  IntVec3 cell = pathFinder->WorldPositionToCellIndex(worldPosition);
+  IntVec3 direction = mData->GetDirection(cell);
+  if (direction == IntVec3::cZero)
+    return Vec3::cZero;
+
+  Vec3 worldDirection =
+      pathFinder->CellIndexToWorldPosition(cell + direction) - pathFinder->CellIndexToWorldPosition(cell);
+  return Math::AttemptNormalized(worldDirection);
+}
+
+float PathFinderGridFlowField::GetCostToGoal(IntVec3Param cell)
+{
+  if (mData == nullptr)
+    return -1.0f;
+  return mData->GetCostToGoal(cell);
+}
+
+void PathFinderGridFlowField::OnJobFinished(PathFinderGridFlowFieldEvent* event)
+{
+  mJob = nullptr;
+  if (mDetached)
+    return;
+
+  // The only way a job fails is the region growing too large. The current
+  // field becomes the back buffer for the next update.
+  delete mBackData;
+  mBackData = mData;
+  mData = event->mData;
+  event->mData = nullptr;
+  mStatus = (mData != nullptr) ? PathFinderStatus::Succeeded : PathFinderStatus::Failed;
+
+  // Note: The PathFinderGrid component may have been deleted by this point
+  PathFinderGrid* pathFinder = mPathFinderComponent;
+  if (pathFinder != nullptr)
+    pathFinder->DispatchEvent(Events::PathFinderGridFlowFieldFinished, event);
+
+  // Catch up on anything that changed while the job was running
+  StartJob();
+}
+
+void PathFinderGridFlowField::StartJob()
+{
+  PathFinderGrid* pathFinder = mPathFinderComponent;
+  if (pathFinder == nullptr || mDetached || mJob)
+    return;
+
+  if (!mNeedsRebuild && mChangedCells.Empty())
+    return;
+
+  PathFinderGridFlowFieldJob* job = new PathFinderGridFlowFieldJob();
+  job->mGrid = pathFinder->mGrid;
+  job->mGoal = mGoal;
+  job->mFlowField = this;
+  job->mFlowFieldDispatcher = GetDispatcher();
+
+  // Changes outside of the region move the region so the field is built again
+  bool rebuild = mNeedsRebuild || mData == nullptr || mData->mDiagonalMovement != pathFinder->mGrid->mDiagonalMovement;
+  forRange (IntVec3Param cell, mChangedCells.All())
+  {
+    if (rebuild)
+      break;
+    rebuild = !mData->Contains(cell);
+  }
+
+  // The field keeps using its current data until the job finishes, so the
+  // update is run on the back buffer after catching it up to the current data
+  if (!rebuild)
+  {
+    PathFinderGridFlowFieldData* data = mBackData;
+    mBackData = nullptr;
+    if (data == nullptr)
+      data = new PathFinderGridFlowFieldData();
+    data->CopyChanges(*mData);
+
+    job->mData = data;
+    job->mChangedCells.Swap(mChangedCells);
+  }
+
+  mChangedCells.Clear();
+  mNeedsRebuild = false;
+
+  mJob = job;
+  Z::gJobs->AddJob(job);
+}
+
+void PathFinderGridFlowField::OnCellChanged(IntVec3Param cell)
+{
+  if (mNeedsRebuild)
+    return;
+
+  mChangedCells.PushBack(cell);
+  if (mChangedCells.Size() > cMaxFlowFieldChangedCells)
+    Invalidate();
+}
+
+void PathFinderGridFlowField::Invalidate()
+{
+  mNeedsRebuild = true;
+  mChangedCells.Clear();
+}
+
+void PathFinderGridFlowField::Detach()
+{
+  mDetached = true;
+  mChangedCells.Clear();
+  if (mJob)
+    mJob->Cancel();
+}
+
+// PathFinderGridFlowFieldJob
+PathFinderGridFlowFieldJob::PathFinderGridFlowFieldJob() :
+    mGoal(IntVec3::cZero),
+    mData(nullptr),
+    mFlowFieldDispatcher(nullptr),
+    mCancel(false)
+{
+}
+
+PathFinderGridFlowFieldJob::~PathFinderGridFlowFieldJob()
+{
+  delete mData;
+}
+
+void PathFinderGridFlowFieldJob::Execute()
+{
+  Timer timer;
+
+  PathFinderGridFlowFieldEvent* toSend = new PathFinderGridFlowFieldEvent();
+  toSend->mFlowField = mFlowField;
+
+  bool succeeded;
+  if (mData != nullptr)
+  {
+    succeeded = mData->Update(*mGrid, mChangedCells, &mCancel);
+  }
+  else
+  {
+    mData = new PathFinderGridFlowFieldData();
+    succeeded = mData->Build(*mGrid, mGoal, &mCancel);
+  }
+
+  if (succeeded)
+  {
+    toSend->mData = mData;
+    mData = nullptr;
+  }
+
+  toSend->mDuration = (float)timer.UpdateAndGetTime();
+
+  Z::gDispatch->DispatchOn(mFlowField, mFlowFieldDispatcher, Events::PathFinderGridFlowFieldFinished, toSend);
+}
+
+int PathFinderGridFlowFieldJob::Cancel()
+{
+  mCancel = true;
+  return 0;
+}
+
+} // namespace Zero
@@ -0,0 +1,172 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+namespace Events
+{
+DeclareEvent(PathFinderGridFlowFieldFinished);
+} // namespace Events
+
+class PathFinderGrid;
+class PathFinderGridFlowField;
+
+// PathFinderGridFlowFieldData
+/// The cost from every cell in a region to the goal and the direction to move
+/// from each cell to get there. Built from the goal outward with Dijkstra's
+/// algorithm. When cells change only the cells whose paths went through them
+/// are searched again.
+class PathFinderGridFlowFieldData
+{
+public:
+  static const byte cNoDirection = 0xFF;
+  /// Regions larger than this many cells fail to build.
+  static const uint cMaxCellCount = 1 << 22;
+
+  PathFinderGridFlowFieldData();
+
+  /// Builds the field over the bounds of the grid's cells (grown by a cell
+  /// so that paths can go around everything). Returns false if the region is
+  /// too large or the build was cancelled.
+  bool Build(const PathFinderAlgorithmGrid& grid, IntVec3Param goal, const bool* cancel);
+  /// Brings the field up to date after the given cells changed, they must be
+  /// inside of the region. Returns false if it was cancelled.
+  bool Update(const PathFinderAlgorithmGrid& grid, const Array<IntVec3>& changedCells, const bool* cancel);
+  /// Makes this a copy of the given field. If the given field was updated from
+  /// the state this one is in, only the cells that update wrote are copied.
+  void CopyChanges(const PathFinderGridFlowFieldData& source);
+
+  bool Contains(IntVec3Param cell) const;
+  /// The offset to the next cell on the way to the goal. Cells outside of the
+  /// region move towards it, nothing outside of it is in the way. Returns zero
+  /// at the goal or if the goal can't be reached.
+  IntVec3 GetDirection(IntVec3Param cell) const;
+  /// The cost of the cheapest path from the cell to the goal or a negative
+  /// value if the goal can't be reached. Cells outside of the region add the
+  /// cost of moving straight into it.
+  float GetCostToGoal(IntVec3Param cell) const;
+
+  IntVec3 mGoal;
+  bool mDiagonalMovement;
+  IntVec3 mMin;
+  IntVec3 mMax;
+
+  /// Cost of entering each cell (infinite for collision).
+  Array<float> mCellCosts;
+  /// Cost from each cell to the goal (infinite if it can't be reached).
+  Array<float> mCostsToGoal;
+  /// Index into PathFinderGridDirections of the move from each cell.
+  Array<byte> mDirections;
+  /// Set when the field was last built rather than updated.
+  bool mWrittenAll;
+  /// Cells written by the last update (may contain duplicates).
+  Array<uint> mWrittenCells;
+
+private:
+  uint CellToIndex(IntVec3Param cell) const;
+  IntVec3 IndexToCell(uint index) const;
+  /// Dijkstra's algorithm from everything in the open list.
+  bool Propagate(const bool* cancel);
+
+  PathFinderGridOpenList mOpen;
+};
+
+// PathFinderGridFlowFieldEvent
+/// Sent when a flow field finishes building or updating on another thread.
+class PathFinderGridFlowFieldEvent : public Event
+{
+public:
+  ZilchDeclareType(PathFinderGridFlowFieldEvent, TypeCopyMode::ReferenceType);
+
+  PathFinderGridFlowFieldEvent();
+  ~PathFinderGridFlowFieldEvent();
+
+  HandleOf<PathFinderGridFlowField> mFlowField;
+  float mDuration;
+
+  // Internals
+  /// The finished field, null if the job failed. Taken by the flow field,
+  /// otherwise deleted with the event.
+  PathFinderGridFlowFieldData* mData;
+};
+
+// PathFinderGridFlowField
+/// The directions to one goal from every cell of a PathFinderGrid, shared by
+/// every agent heading to that goal. Sampling a direction is a single lookup.
+/// The field is built on another thread and kept up to date as the grid's
+/// collision and costs change, the previous field is used until an update
+/// finishes. The field is double buffered, an update starts from the previous
+/// buffer and only copies the cells that changed since into it.
+class PathFinderGridFlowField : public ReferenceCountedThreadSafeId32EventObject
+{
+public:
+  ZilchDeclareType(PathFinderGridFlowField, TypeCopyMode::ReferenceType);
+
+  PathFinderGridFlowField(PathFinderGrid* owner, IntVec3Param goal);
+  ~PathFinderGridFlowField();
+
+  /// The offset to the next cell on the way to the goal. Returns zero at the
+  /// goal, if the goal can't be reached or if the field hasn't been built yet.
+  IntVec3 GetDirection(IntVec3Param cell);
+  /// The world space direction to move in from the cell that the world position
+  /// occupies. Returns zero in the same cases as GetDirection.
+  Vec3 GetWorldDirection(Vec3Param worldPosition);
+  /// The cost of the cheapest path from the cell to the goal. Returns a negative
+  /// value if the goal can't be reached or the field hasn't been built yet.
+  float GetCostToGoal(IntVec3Param cell);
+
+  // Internals
+  void OnJobFinished(PathFinderGridFlowFieldEvent* event);
+  /// Starts building or updating the field if it's out of date and no job is
+  /// already running.
+  void StartJob();
+  void OnCellChanged(IntVec3Param cell);
+  /// The next job rebuilds the whole field.
+  void Invalidate();
+  /// Stops updating the field, it keeps what it has already built.
+  void Detach();
+
+  /// The component that the field was requested from.
+  HandleOf<PathFinderGrid> mPathFinderComponent;
+  /// The cell that the field leads to.
+  IntVec3 mGoal;
+  /// Pending until the field is first built.
+  PathFinderStatus::Enum mStatus;
+
+  PathFinderGridFlowFieldData* mData;
+  /// The field before the last job finished, reused by the next update.
+  PathFinderGridFlowFieldData* mBackData;
+  HandleOf<Job> mJob;
+  /// Cells changed since the last job was started.
+  Array<IntVec3> mChangedCells;
+  bool mNeedsRebuild;
+  /// Set when the field is dropped from the PathFinderGrid's cache.
+  bool mDetached;
+  /// When the field was last requested, used to choose which field to drop
+  /// when the cache is full.
+  u64 mLastRequest;
+};
+
+// PathFinderGridFlowFieldJob
+class PathFinderGridFlowFieldJob : public Job
+{
+public:
+  PathFinderGridFlowFieldJob();
+  ~PathFinderGridFlowFieldJob();
+
+  // Job Interface
+  void Execute() override;
+  int Cancel() override;
+
+  CopyOnWriteHandle<PathFinderAlgorithmGrid> mGrid;
+  IntVec3 mGoal;
+  /// The field to update (brought up to date with the current field), null to
+  /// build a new field.
+  PathFinderGridFlowFieldData* mData;
+  Array<IntVec3> mChangedCells;
+  HandleOf<PathFinderGridFlowField> mFlowField;
+  EventDispatcher* mFlowFieldDispatcher;
+  bool mCancel;
+};
+
+} // namespace Zero
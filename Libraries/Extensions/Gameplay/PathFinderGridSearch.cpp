@@ -0,0 +1,247 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+namespace
+{
+
+// Breaks ties between nodes of the same priority towards the goal
+const float cTieBreaker = 1.00001f;
+
+const float cSqrt2 = Math::Sqrt(2.0f);
+const float cSqrt3 = Math::Sqrt(3.0f);
+
+ZeroThreadLocal PathFinderGridSearch* sThreadSearch = nullptr;
+
+} // namespace
+
+// PathFinderGridDirections
+// clang-format off
+const IntVec3 PathFinderGridDirections::cOffsets[cCount] =
+{
+  // Diagonal on all three axes
+  IntVec3(-1, -1, -1), IntVec3( 1, -1, -1), IntVec3(-1,  1, -1), IntVec3( 1,  1, -1),
+  IntVec3(-1, -1,  1), IntVec3( 1, -1,  1), IntVec3(-1,  1,  1), IntVec3( 1,  1,  1),
+  // Diagonal on two axes
+  IntVec3( 0, -1, -1), IntVec3(-1,  0, -1), IntVec3( 1,  0, -1), IntVec3( 0,  1, -1),
+  IntVec3(-1, -1,  0), IntVec3( 1, -1,  0), IntVec3(-1,  1,  0), IntVec3( 1,  1,  0),
+  IntVec3( 0, -1,  1), IntVec3(-1,  0,  1), IntVec3( 1,  0,  1), IntVec3( 0,  1,  1),
+  // Cardinal
+  IntVec3( 0,  0, -1), IntVec3( 0, -1,  0), IntVec3(-1,  0,  0),
+  IntVec3( 1,  0,  0), IntVec3( 0,  1,  0), IntVec3( 0,  0,  1)
+};
+
+const float PathFinderGridDirections::cCosts[cCount] =
+{
+  cSqrt3, cSqrt3, cSqrt3, cSqrt3, cSqrt3, cSqrt3, cSqrt3, cSqrt3,
+  cSqrt2, cSqrt2, cSqrt2, cSqrt2, cSqrt2, cSqrt2, cSqrt2, cSqrt2, cSqrt2, cSqrt2, cSqrt2, cSqrt2,
+  1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f
+};
+// clang-format on
+
+int PathFinderGridDirections::GetFirst(bool diagonalMovement)
+{
+  return diagonalMovement ? 0 : cFirstCardinal;
+}
+
+// PathFinderGridOpenList
+void PathFinderGridOpenList::Clear()
+{
+  mEntries.Clear();
+}
+
+bool PathFinderGridOpenList::Empty() const
+{
+  return mEntries.Empty();
+}
+
+void PathFinderGridOpenList::Push(uint index, float priority)
+{
+  Entry entry = {priority, index};
+  uint heapIndex = mEntries.Size();
+  mEntries.PushBack(entry);
+
+  while (heapIndex > 0)
+  {
+    uint parent = (heapIndex - 1) / 2;
+    if (mEntries[parent].mPriority <= entry.mPriority)
+      break;
+    mEntries[heapIndex] = mEntries[parent];
+    heapIndex = parent;
+  }
+  mEntries[heapIndex] = entry;
+}
+
+PathFinderGridOpenList::Entry PathFinderGridOpenList::Pop()
+{
+  Entry top = mEntries.Front();
+  Entry last = mEntries.Back();
+  mEntries.PopBack();
+
+  // Sift the last entry down from the root
+  uint size = mEntries.Size();
+  if (size == 0)
+    return top;
+
+  uint heapIndex = 0;
+  for (;;)
+  {
+    uint child = heapIndex * 2 + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size && mEntries[child + 1].mPriority < mEntries[child].mPriority)
+      ++child;
+    if (last.mPriority <= mEntries[child].mPriority)
+      break;
+    mEntries[heapIndex] = mEntries[child];
+    heapIndex = child;
+  }
+  mEntries[heapIndex] = last;
+  return top;
+}
+
+// PathFinderGridSearch
+PathFinderGridSearch* PathFinderGridSearch::GetThreadSearch()
+{
+  // Kept for the lifetime of the thread, the job threads live as long as the
+  // engine does
+  if (sThreadSearch == nullptr)
+    sThreadSearch = new PathFinderGridSearch();
+  return sThreadSearch;
+}
+
+PathFinderGridSearch::PathFinderGridSearch() :
+    mGrid(nullptr),
+    mGoal(IntVec3::cZero),
+    mCachedChunkIndex(IntVec3::cZero),
+    mCachedChunk(nullptr),
+    mCachedChunkValid(false)
+{
+}
+
+void PathFinderGridSearch::FindPath(const PathFinderAlgorithmGrid& grid,
+                                    IntVec3Param start,
+                                    IntVec3Param goal,
+                                    Array<IntVec3>& pathOut,
+                                    size_t maxIterations,
+                                    const bool* cancel)
+{
+  pathOut.Clear();
+
+  if (!grid.QueryIsValid(start) || !grid.QueryIsValid(goal))
+    return;
+
+  mGrid = &grid;
+  mGoal = goal;
+  mCachedChunkValid = false;
+
+  // Clearing keeps the memory from the last query
+  mNodes.Clear();
+  mNodeIndices.Clear();
+  mOpen.Clear();
+
+  int firstDirection = PathFinderGridDirections::GetFirst(grid.mDiagonalMovement);
+
+  Relax(start, cNoParent, 0.0f);
+  while (maxIterations != 0)
+  {
+    // If an outside entity wanted us to terminate early...
+    if (cancel && *cancel)
+      break;
+
+    uint nodeIndex = PopOpen();
+    if (nodeIndex == cNoParent)
+      break;
+
+    // Copied since relaxing can grow the node array
+    SearchNode node = mNodes[nodeIndex];
+    if (node.mCell == mGoal)
+    {
+      BuildPath(nodeIndex, pathOut);
+      break;
+    }
+
+    for (int direction = firstDirection; direction < PathFinderGridDirections::cCount; ++direction)
+    {
+      IntVec3 next = node.mCell + PathFinderGridDirections::cOffsets[direction];
+      float cost = PathFinderGridDirections::cCosts[direction];
+
+      const PathFinderCell* cell = FindCell(next);
+      if (cell)
+      {
+        if (cell->mCollision)
+          continue;
+        cost += cell->mCost;
+      }
+
+      Relax(next, nodeIndex, node.mCostSoFar + cost);
+    }
+
+    --maxIterations;
+  }
+
+  mGrid = nullptr;
+  mCachedChunk = nullptr;
+}
+
+void PathFinderGridSearch::Relax(IntVec3Param cell, uint parent, float costSoFar)
+{
+  uint nodeIndex;
+  if (uint* existing = mNodeIndices.FindPointer(cell))
+  {
+    nodeIndex = *existing;
+    if (costSoFar >= mNodes[nodeIndex].mCostSoFar)
+      return;
+  }
+  else
+  {
+    nodeIndex = mNodes.Size();
+    mNodeIndices.Insert(cell, nodeIndex);
+    mNodes.PushBack().mCell = cell;
+  }
+
+  SearchNode& node = mNodes[nodeIndex];
+  node.mParent = parent;
+  node.mCostSoFar = costSoFar;
+  node.mPriority = costSoFar + mGrid->QueryHeuristic(cell, mGoal) * cTieBreaker;
+
+  // The old entry is left in the heap and skipped once it's stale
+  mOpen.Push(nodeIndex, node.mPriority);
+}
+
+uint PathFinderGridSearch::PopOpen()
+{
+  while (!mOpen.Empty())
+  {
+    PathFinderGridOpenList::Entry entry = mOpen.Pop();
+    if (entry.mPriority == mNodes[entry.mIndex].mPriority)
+      return entry.mIndex;
+  }
+  return cNoParent;
+}
+
+void PathFinderGridSearch::BuildPath(uint goalNode, Array<IntVec3>& pathOut)
+{
+  for (uint nodeIndex = goalNode; nodeIndex != cNoParent; nodeIndex = mNodes[nodeIndex].mParent)
+    pathOut.PushBack(mNodes[nodeIndex].mCell);
+  Reverse(pathOut.Begin(), pathOut.End());
+}
+
+const PathFinderCell* PathFinderGridSearch::FindCell(IntVec3Param cell)
+{
+  IntVec3 chunkIndex = PathFinderGridChunk::CellToChunkIndex(cell);
+  if (!mCachedChunkValid || chunkIndex != mCachedChunkIndex)
+  {
+    mCachedChunk = mGrid->FindChunk(chunkIndex);
+    mCachedChunkIndex = chunkIndex;
+    mCachedChunkValid = true;
+  }
+
+  if (!mCachedChunk)
+    return nullptr;
+  return &mCachedChunk->mCells[PathFinderGridChunk::CellToLocalIndex(cell)];
+}
+
+} // namespace Zero
@@ -0,0 +1,99 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+// PathFinderGridDirections
+/// The offsets of the 26 neighbors of a cell and the cost of moving to them.
+/// Ordered from the most to the least diagonal so that cardinal movement only
+/// uses the last 6.
+class PathFinderGridDirections
+{
+public:
+  static const int cCount = 26;
+  static const int cFirstCardinal = 20;
+
+  /// The first direction that the movement type can use.
+  static int GetFirst(bool diagonalMovement);
+
+  static const IntVec3 cOffsets[cCount];
+  static const float cCosts[cCount];
+};
+
+// PathFinderGridOpenList
+/// A binary min heap of indices ordered by priority. Entries are never updated
+/// in place, a cheaper priority is pushed again and the caller skips the stale
+/// entry when it comes out.
+class PathFinderGridOpenList
+{
+public:
+  struct Entry
+  {
+    float mPriority;
+    uint mIndex;
+  };
+
+  void Clear();
+  bool Empty() const;
+  void Push(uint index, float priority);
+  Entry Pop();
+
+  Array<Entry> mEntries;
+};
+
+// PathFinderGridSearch
+/// The A* search used by PathFinderAlgorithmGrid. Every thread gets its own
+/// instance whose node storage and open list are reused between queries, so
+/// path finding on the job threads doesn't allocate once it has warmed up.
+class PathFinderGridSearch
+{
+public:
+  /// Returns the calling thread's search, creating it on first use.
+  static PathFinderGridSearch* GetThreadSearch();
+
+  PathFinderGridSearch();
+
+  /// Same interface as PathFinderAlgorithm::FindNodePath.
+  void FindPath(const PathFinderAlgorithmGrid& grid,
+                IntVec3Param start,
+                IntVec3Param goal,
+                Array<IntVec3>& pathOut,
+                size_t maxIterations,
+                const bool* cancel);
+
+private:
+  static const uint cNoParent = (uint)-1;
+
+  struct SearchNode
+  {
+    IntVec3 mCell;
+    uint mParent;
+    float mCostSoFar;
+    float mPriority;
+  };
+
+  /// Records a new cost for the cell if it's cheaper than what was known.
+  void Relax(IntVec3Param cell, uint parent, float costSoFar);
+  /// Returns the open node with the lowest priority, skipping stale entries.
+  /// Returns cNoParent when the open list is empty.
+  uint PopOpen();
+  void BuildPath(uint goalNode, Array<IntVec3>& pathOut);
+
+  const PathFinderCell* FindCell(IntVec3Param cell);
+
+  const PathFinderAlgorithmGrid* mGrid;
+  IntVec3 mGoal;
+
+  /// The last chunk looked up, neighboring cells are almost always in the
+  /// same chunk.
+  IntVec3 mCachedChunkIndex;
+  const PathFinderGridChunk* mCachedChunk;
+  bool mCachedChunkValid;
+
+  Array<SearchNode> mNodes;
+  HashMap<IntVec3, uint> mNodeIndices;
+  PathFinderGridOpenList mOpen;
+};
+
+} // namespace Zero
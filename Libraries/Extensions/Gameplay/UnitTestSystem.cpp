@@ -420,15 +420,21 @@ void UnitTestSystem::RecordToZeroTestFile(StringParam zeroTestFile)
 
   process.WaitForClose();
 
+  File file;
+  file.Open(zeroTestFile, FileMode::Write, FileAccessPattern::Sequential);
+
   Archive archive(ArchiveMode::Compressing);
+  archive.BeginStreaming(file);
   archive.ArchiveDirectory(status, directory);
+  archive.EndStreaming();
+  file.Close();
   if (status.Failed())
   {
     DoNotifyError("UnitTestSystem", status.Message);
+    DeleteFile(zeroTestFile);
     return;
   }
 
-  archive.WriteZipFile(zeroTestFile);
   DeleteDirectory(directory);
 }
 
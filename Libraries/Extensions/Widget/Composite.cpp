@@ -51,6 +51,31 @@ void FilterLayoutChildren::SkipInvalid()
   }
 }
 
+/// The render nodes and streamed vertices a caching composite's children added
+/// the last time they rendered. View nodes are stored relative to the start of
+/// the recorded ranges so they can be appended to any frame.
+struct WidgetRenderCache
+{
+  WidgetRenderCache() : mValid(false), mFontTextureVersion(0), mCacheVersion(0)
+  {
+  }
+
+  Array<FrameNode> mFrameNodes;
+  Array<ViewNode> mViewNodes;
+  Array<StreamedVertex> mStreamedVertices;
+
+  // What the nodes were generated with
+  Mat4 mWorldTx;
+  Mat4 mWorldToView;
+  Vec4 mColorMultiply;
+  WidgetRect mClipRect;
+  uint mFontTextureVersion;
+  uint mCacheVersion;
+  bool mValid;
+};
+
+uint Composite::sRenderCacheVersion = 0;
+
 ZilchDefineType(Composite, builder, type)
 {
 }
@@ -59,12 +84,14 @@ Composite::Composite(Composite* parent, AttachType::Enum attachType) : Widget(pa
 {
   mLayout = nullptr;
   mMinSize = Vec2(10, 10);
+  mRenderCache = nullptr;
   DebugValidate();
 }
 
 Composite::~Composite()
 {
   SafeDelete(mLayout);
+  SafeDelete(mRenderCache);
   ErrorIf(!mChildren.Empty(),
           "Composite still has children. Something is "
           "wrong with OnDestroy!");
@@ -83,6 +110,9 @@ void Composite::InternalDetach(Composite* parent, Widget* child)
   ErrorIf(child->mParent != parent, "Object is not a child of the parent.");
   parent->mChildren.Erase(child);
   child->mParent = nullptr;
+
+  // The child may still be part of the parent's cached render nodes
+  parent->NeedsRedraw();
 }
 
 void Composite::InternalAttach(Composite* parent, Widget* child)
@@ -182,6 +212,38 @@ void Composite::RenderUpdate(
   DebugValidate();
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  if (mRenderCache != nullptr)
+    RenderChildrenCached(viewBlock, frameBlock, colorTx, clipRect);
+  else
+    RenderChildren(viewBlock, frameBlock, colorTx, clipRect);
+}
+
+void Composite::SetRenderCaching(bool caching)
+{
+  if (caching == GetRenderCaching())
+    return;
+
+  if (caching)
+    mRenderCache = new WidgetRenderCache();
+  else
+    SafeDelete(mRenderCache);
+}
+
+bool Composite::GetRenderCaching()
+{
+  return mRenderCache != nullptr;
+}
+
+void Composite::InvalidateRenderCaches()
+{
+  ++sRenderCacheVersion;
+}
+
+void Composite::RenderChildren(ViewBlock& viewBlock,
+                               FrameBlock& frameBlock,
+                               ColorTransform colorTx,
+                               WidgetRect clipRect)
+{
   if (mClipping)
   {
     WidgetRect rect; // = {mWorldTx.m30, mWorldTx.m31, mSize.x, mSize.y};
@@ -208,6 +270,84 @@ void Composite::RenderUpdate(
   }
 }
 
+void Composite::RenderChildrenCached(ViewBlock& viewBlock,
+                                     FrameBlock& frameBlock,
+                                     ColorTransform colorTx,
+                                     WidgetRect clipRect)
+{
+  WidgetRenderCache& cache = *mRenderCache;
+  Array<FrameNode>& frameNodes = frameBlock.mFrameNodes;
+  Array<ViewNode>& viewNodes = viewBlock.mViewNodes;
+  StreamedVertexArray& streamedVertices = frameBlock.mRenderQueues->mStreamedVertices;
+
+  uint frameNodeStart = frameNodes.Size();
+  uint viewNodeStart = viewNodes.Size();
+  uint vertexStart = streamedVertices.Size();
+
+  // Anything marked under this composite, a font that moved its glyphs or a
+  // resource reload all have to regenerate the nodes
+  bool cacheMatches = cache.mValid && !mNeedsRedraw && cache.mCacheVersion == sRenderCacheVersion &&
+                      cache.mFontTextureVersion == RenderFont::sTextureVersion && cache.mWorldTx == mWorldTx &&
+                      cache.mWorldToView == viewBlock.mWorldToView &&
+                      cache.mColorMultiply == colorTx.ColorMultiply && cache.mClipRect == clipRect;
+
+  if (cacheMatches)
+  {
+    frameNodes.Append(cache.mFrameNodes.All());
+
+    forRange (ViewNode& cachedNode, cache.mViewNodes.All())
+    {
+      ViewNode& viewNode = viewNodes.PushBack();
+      viewNode = cachedNode;
+      viewNode.mFrameNodeIndex += frameNodeStart;
+      viewNode.mStreamedVertexStart += vertexStart;
+    }
+
+    forRange (StreamedVertex& vertex, cache.mStreamedVertices.All())
+      streamedVertices.PushBack(vertex);
+    return;
+  }
+
+  // Cleared before the children render so a child that marks itself while
+  // rendering (it changes every frame) keeps the nodes from being reused
+  mNeedsRedraw = false;
+  ++sRedrawEpoch;
+  cache.mFontTextureVersion = RenderFont::sTextureVersion;
+  cache.mCacheVersion = sRenderCacheVersion;
+
+  RenderChildren(viewBlock, frameBlock, colorTx, clipRect);
+
+  cache.mFrameNodes.Clear();
+  cache.mViewNodes.Clear();
+  cache.mStreamedVertices.Clear();
+  cache.mWorldTx = mWorldTx;
+  cache.mWorldToView = viewBlock.mWorldToView;
+  cache.mColorMultiply = colorTx.ColorMultiply;
+  cache.mClipRect = clipRect;
+  cache.mValid = true;
+
+  for (uint i = frameNodeStart; i < frameNodes.Size(); ++i)
+  {
+    // Blend overrides index into another per frame list
+    if (frameNodes[i].mBlendSettingsOverride)
+      cache.mValid = false;
+    cache.mFrameNodes.PushBack(frameNodes[i]);
+  }
+
+  for (uint i = viewNodeStart; i < viewNodes.Size(); ++i)
+  {
+    ViewNode viewNode = viewNodes[i];
+    if (viewNode.mFrameNodeIndex < (int)frameNodeStart || viewNode.mStreamedVertexStart < vertexStart)
+      cache.mValid = false;
+    viewNode.mFrameNodeIndex -= frameNodeStart;
+    viewNode.mStreamedVertexStart -= vertexStart;
+    cache.mViewNodes.PushBack(viewNode);
+  }
+
+  for (uint i = vertexStart; i < streamedVertices.Size(); ++i)
+    cache.mStreamedVertices.PushBack(streamedVertices[i]);
+}
+
 Widget* Composite::HitTest(Vec2 location, Widget* ignore)
 {
   DebugValidate();
@@ -4,6 +4,8 @@
 namespace Zero
 {
 
+struct WidgetRenderCache;
+
 typedef InList<Widget, &Widget::mWidgetLink> WidgetList;
 typedef WidgetList::range WidgetListRange;
 
@@ -68,6 +70,15 @@ public:
                     ColorTransform colorTx,
                     WidgetRect clipRect) override;
 
+  /// Reuses the render nodes the children added last frame while nothing under
+  /// this composite has changed (see Widget::NeedsRedraw). Meant for large,
+  /// mostly static composites.
+  void SetRenderCaching(bool caching);
+  bool GetRenderCaching();
+
+  /// Makes every caching composite rebuild its render nodes.
+  static void InvalidateRenderCaches();
+
   // Widget interface
   void UpdateTransform() override;
   void DispatchDown(StringParam eventId, Event* event) override;
@@ -91,8 +102,16 @@ protected:
   friend class Widget;
   Layout* mLayout;
   Vec2 mMinSize;
+  /// Null unless render caching is enabled.
+  WidgetRenderCache* mRenderCache;
+  static uint sRenderCacheVersion;
 
 private:
+  void RenderChildren(ViewBlock& viewBlock, FrameBlock& frameBlock, ColorTransform colorTx, WidgetRect clipRect);
+  void RenderChildrenCached(ViewBlock& viewBlock,
+                            FrameBlock& frameBlock,
+                            ColorTransform colorTx,
+                            WidgetRect clipRect);
   void UpdateChildTransforms();
   static void InternalDetach(Composite* parent, Widget* child);
   static void InternalAttach(Composite* parent, Widget* child);
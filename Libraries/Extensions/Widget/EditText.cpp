@@ -75,6 +75,10 @@ void EditText::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // The caret blinks and the selection is edited in place while focused
+  if (mHasFocus)
+    NeedsRedraw();
+
   String text;
   if (mPassword)
     text = String::Repeat('*', mDisplayText.SizeInBytes());
@@ -132,6 +136,7 @@ void EditText::SetText(StringParam text)
   mDisplayText = text;
   SelectNone();
   mCaretPos = 0;
+  NeedsRedraw();
 }
 
 void EditText::SetEditable(bool state)
@@ -389,6 +394,7 @@ StringRange EditText::GetSelectedText()
 void EditText::SetTextOffset(float offset)
 {
   mOffset = offset;
+  NeedsRedraw();
 }
 
 String EditText::GetDisplayName()
@@ -728,6 +734,7 @@ void EditText::OnFocusLost(FocusEvent* focusEvent)
   mOffset = 0.0f;
   SelectNone();
   mHasFocus = false;
+  NeedsRedraw();
   if (mTextModified)
   {
     ObjectEvent objectEvent(this);
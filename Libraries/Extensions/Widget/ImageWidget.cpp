@@ -38,6 +38,7 @@ Thickness ImageWidget::GetBorderThickness()
 void ImageWidget::ChangeDefinition(BaseDefinition* def)
 {
   mDef = (SlicedDefinition*)def;
+  NeedsRedraw();
 }
 
 Zero::DisplayOrigin::Type ImageWidget::GetDisplayOrigin()
@@ -48,6 +49,7 @@ Zero::DisplayOrigin::Type ImageWidget::GetDisplayOrigin()
 void ImageWidget::SetDisplayOrigin(DisplayOrigin::Type displayOrigin)
 {
   mOrigin = displayOrigin;
+  NeedsRedraw();
 }
 
 void ImageWidget::RenderUpdate(
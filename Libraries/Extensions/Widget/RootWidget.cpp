@@ -82,6 +82,9 @@ RootWidget::RootWidget(OsWindow* osWindow) : Composite(NULL)
   ConnectThisTo(shell, Events::Copy, OnCutCopyPaste);
   ConnectThisTo(shell, Events::Paste, OnCutCopyPaste);
 
+  ConnectThisTo(Z::gResources, Events::ResourcesLoaded, OnResourcesModified);
+  ConnectThisTo(Z::gResources, Events::ResourcesUnloaded, OnResourcesModified);
+
   ConnectThisTo(Z::gEngine, Events::DebuggerPause, OnDebuggerPause);
   ConnectThisTo(Z::gEngine, Events::DebuggerResume, OnDebuggerResume);
 
@@ -1064,6 +1067,13 @@ void RootWidget::OnClose(OsWindowEvent* windowEvent)
     this->Destroy();
 }
 
+void RootWidget::OnResourcesModified(ResourceEvent* event)
+{
+  // Cached render nodes can reference render data of unloaded resources
+  Composite::InvalidateRenderCaches();
+  MarkAsNeedsUpdate();
+}
+
 void RootWidget::OnDebuggerPause(Event* event)
 {
   mDebuggerOverlay->SetActive(true);
@@ -70,6 +70,8 @@ private:
   void OnOsKeyTyped(KeyboardTextEvent* keyboardTextEvent);
   void OnClose(OsWindowEvent* windowEvent);
 
+  void OnResourcesModified(ResourceEvent* event);
+
   void OnDebuggerPause(Event* event);
   void OnDebuggerResume(Event* event);
   void OnDebuggerResumeDelay();
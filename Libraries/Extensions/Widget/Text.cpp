@@ -42,11 +42,13 @@ void Text::ChangeDefinition(BaseDefinition* def)
   TextDefinition* textDefinition = (TextDefinition*)def;
   mFont = textDefinition->mFont;
   mFontColor = textDefinition->FontColor;
+  NeedsRedraw();
 }
 
 void Text::SetMultiLine(bool multiLine)
 {
   mMultiline = multiLine;
+  NeedsRedraw();
 }
 
 void Text::RenderUpdate(
@@ -88,7 +90,10 @@ void Text::FitToWidth(float maxWidth, float maxHeight)
 
 void Text::SetText(StringParam text)
 {
+  // Also covers members (such as the font color) written directly before the
+  // text is set
   mText = text;
+  NeedsRedraw();
 }
 
 Vec2 Text::GetMinSize()
@@ -133,6 +138,7 @@ void Label::SetText(StringParam text)
 void Label::SetTextClipping(bool value)
 {
   mText->mClipText = value;
+  mText->NeedsRedraw();
 }
 
 String Label::GetText()
@@ -48,11 +48,13 @@ TextureView::TextureView(Composite* composite) : Widget(composite)
 void TextureView::SetTexture(StringParam name)
 {
   mTexture = TextureManager::FindOrNull(name);
+  NeedsRedraw();
 }
 
 void TextureView::SetTexture(Texture* texture)
 {
   mTexture = texture;
+  NeedsRedraw();
 }
 
 void TextureView::OnLeftMouseDown(MouseEvent* e)
@@ -72,6 +74,7 @@ void TextureView::OnMouseScroll(MouseEvent* e)
     {
       mSkyboxInput.z += e->Scroll.y;
       mSkyboxInput.z = Math::Clamp(mSkyboxInput.z, 0.0f, 10.0f);
+      NeedsRedraw();
       e->Handled = true;
     }
   }
@@ -81,12 +84,14 @@ void TextureView::SetUv(Vec2 uv0, Vec2 uv1)
 {
   mUv0 = uv0;
   mUv1 = uv1;
+  NeedsRedraw();
 }
 
 void TextureView::ClipUvToAspectRatio(float targetAspect)
 {
   mUv0 = Vec2(0.0f);
   mUv1 = Vec2(1.0f);
+  NeedsRedraw();
 
   Texture* texture = mTexture;
   if (texture == nullptr)
@@ -136,6 +141,10 @@ void TextureView::RenderUpdate(
 
   if (texture->mType == TextureType::TextureCube)
   {
+    // The preview rotates on its own and its shader inputs are only valid for
+    // this frame
+    NeedsRedraw();
+
     Array<ShaderInput>& shaderInputs = frameBlock.mRenderQueues->mRenderTasks->mShaderInputs;
 
     // Store the starting point
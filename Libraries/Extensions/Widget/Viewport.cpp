@@ -302,6 +302,9 @@ void ViewportDisplay::RenderUpdate(
 {
   Widget::RenderUpdate(viewBlock, frameBlock, parentTx, colorTx, clipRect);
 
+  // The viewport texture and blend override change every frame
+  NeedsRedraw();
+
   if (mViewport->mViewportTexture == nullptr)
     return;
 
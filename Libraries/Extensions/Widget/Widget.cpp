@@ -70,6 +70,7 @@ void WidgetBreak(const char* message, const Widget* widget)
   ZeroDebugBreak();
 }
 bool Widget::sDisableDeletes = false;
+uint Widget::sRedrawEpoch = 1;
 
 Widget::Widget(Composite* parent, AttachType::Enum attachType)
 {
@@ -119,6 +120,7 @@ void Widget::ClearValues()
   mOrigin = DisplayOrigin::TopLeft;
   mTakeFocusMode = FocusMode::Soft;
   mNeedsRedraw = true;
+  mRedrawEpoch = 0;
   mSizePolicy = SizePolicies(SizePolicy::Flex, SizePolicy::Flex);
   mDragDistance = 6.0f;
   mHorizontalAlignment = HorizontalAlignment::Left;
@@ -170,6 +172,7 @@ void Widget::InternalDestroy()
   {
     mDestroyed = true;
     mNotInLayout = true;
+    NeedsRedraw();
 
     Z::gWidgetManager->Widgets.Erase(mId);
     Z::gWidgetManager->DestroyList.PushBack(this);
@@ -356,7 +359,14 @@ void Widget::SetTranslationAndSize(Vec3 newTranslation, Vec2 newSize)
 void Widget::NeedsRedraw()
 {
   DebugValidate();
+
+  // Widgets that change every frame mark themselves on each render, so stop
+  // once the chain is known to be marked (nothing has been cleared since)
+  if (mNeedsRedraw && mRedrawEpoch == sRedrawEpoch)
+    return;
+
   mNeedsRedraw = true;
+  mRedrawEpoch = sRedrawEpoch;
   if (mParent)
     mParent->NeedsRedraw();
 }
@@ -364,7 +374,14 @@ void Widget::NeedsRedraw()
 void Widget::MarkAsNeedsUpdate(bool local)
 {
   DebugValidate();
-  mNeedsRedraw = true;
+
+  // Parents are only marked below while their transform is up to date, but a
+  // composite caching its render nodes has to see every change under it.
+  // Non-local updates come from a child that already marked the chain.
+  if (local)
+    NeedsRedraw();
+  else
+    mNeedsRedraw = true;
 
   if (mTransformUpdateState == TransformUpdateState::Updated)
   {
@@ -638,7 +655,10 @@ void Widget::SetTakeFocusMode(FocusMode::Type focusMode)
 void Widget::SetClipping(bool clipping)
 {
   DebugValidate();
+  if (mClipping == clipping)
+    return;
   mClipping = clipping;
+  NeedsRedraw();
 }
 
 void Widget::DispatchAt(DispatchAtParams& params)
@@ -733,6 +753,8 @@ ViewNode& Widget::AddRenderNodes(ViewBlock& viewBlock, FrameBlock& frameBlock, W
 
   if (texture->mType == TextureType::TextureCube)
     spriteMaterial = MaterialManager::FindOrNull("TextureCubePreview");
+  else if (texture->mDistanceField)
+    spriteMaterial = MaterialManager::FindOrNull("DistanceFieldText");
   else
     spriteMaterial = MaterialManager::FindOrNull("AlphaSprite");
 
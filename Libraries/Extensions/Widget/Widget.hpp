@@ -147,6 +147,9 @@ public:
   ZilchDeclareType(Widget, TypeCopyMode::ReferenceType);
 
   static bool sDisableDeletes;
+  /// Advanced whenever a caching composite clears its flag, so a widget marked
+  /// during the current epoch knows its parents are still marked.
+  static uint sRedrawEpoch;
 
   Widget(Composite* parent, AttachType::Enum attachType = AttachType::Normal);
   virtual ~Widget();
@@ -330,6 +333,9 @@ public:
 
   bool IsMouseOver();
   void MarkAsNeedsUpdate(bool local = true);
+  /// Marks this widget and its parents as drawing differently. Widgets whose
+  /// drawing changes without marking (such as a caret) call this while
+  /// rendering so composites caching their render nodes don't reuse them.
   void NeedsRedraw();
   TransformUpdateState::Enum GetTransformUpdateState()
   {
@@ -347,7 +353,10 @@ public:
   }
   void SetVisible(bool visible)
   {
+    if (mVisible == visible)
+      return;
     mVisible = visible;
+    NeedsRedraw();
   }
 
   virtual void Draw(DisplayRender* render, Mat4Param parentTx, ColorTransform& colorTx, DrawParams& params){};
@@ -373,6 +382,7 @@ public:
   bool mHideOnClose;
   bool mDestroyed;
   bool mNeedsRedraw;
+  uint mRedrawEpoch;
   bool mVisible;
   bool mClipping;
   bool mActive;
@@ -15,6 +15,8 @@ const String sEditorGuid = "51392222-AEDE-4530-8749-9DFAB5725FD7";
 const String sEditorName = "Editor";
 const String sLauncherGuid = "7489829B-8A03-4B26-B3AC-FDDC6668BAF7";
 const String sLauncherName = "Launcher";
+const String sServerGuid = "677AF7E2-5AAB-4556-A2CF-017DD663F03E";
+const String sServerName = "Server";
 
 String GetEditorFullName()
 {
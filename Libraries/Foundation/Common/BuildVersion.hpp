@@ -11,6 +11,8 @@ extern const String sEditorGuid;
 extern const String sEditorName;
 extern const String sLauncherGuid;
 extern const String sLauncherName;
+extern const String sServerGuid;
+extern const String sServerName;
 
 String GetEditorFullName();
 String GetEditorExecutableFileName();
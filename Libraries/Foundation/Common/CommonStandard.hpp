@@ -219,6 +219,7 @@ namespace Zero
 #include "Platform/SocketEnums.hpp"
 #include "Platform/SocketConstants.hpp"
 #include "Platform/Socket.hpp"
+#include "Platform/SocketPoller.hpp"
 #include "Platform/IpAddress.hpp"
 #include "Platform/Timer.hpp"
 #include "Platform/DirectoryWatcher.hpp"
@@ -231,6 +232,7 @@ namespace Zero
 #include "Platform/Intrinsics.hpp"
 #include "Platform/Audio.hpp"
 #include "Platform/CallStack.hpp"
+#include "Platform/ThreadSampler.hpp"
 #include "Platform/WebRequest.hpp"
 
 #include "Platform/ThreadableLoop.hpp"
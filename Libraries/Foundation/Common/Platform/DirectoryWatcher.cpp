@@ -10,13 +10,15 @@ DirectoryWatcher::DirectoryWatcher(cstr directoryToWatch, CallbackFunction callb
 
   mCallbackInstance = callbackInstance;
   mCallback = callback;
+  mCancelled = false;
 
   if (ThreadingEnabled)
   {
+    // The event has to exist before the thread can wait on it
+    mCancelEvent.Initialize(true, false);
     mWorkThread.Initialize(Thread::ObjectEntryCreator<DirectoryWatcher, &DirectoryWatcher::RunThreadEntryPoint>,
                            this,
                            "DirectoryWatcherWorker");
-    mCancelEvent.Initialize(true, false);
   }
 }
 
@@ -29,6 +31,7 @@ void DirectoryWatcher::Shutdown()
 {
   if (ThreadingEnabled)
   {
+    mCancelled = true;
     mCancelEvent.Signal();
     mWorkThread.WaitForCompletion();
   }
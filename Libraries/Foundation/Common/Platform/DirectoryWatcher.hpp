@@ -47,6 +47,8 @@ private:
   OsInt RunThreadEntryPoint();
   Thread mWorkThread;
   OsEvent mCancelEvent;
+  // Set with the cancel event for watchers that can't wait on it
+  Atomic<bool> mCancelled;
 };
 
 } // namespace Zero
@@ -186,6 +186,21 @@ bool CompareFileAndString(Status& status, StringParam filePath, StringParam stri
   return true;
 }
 
+const ::byte* MappedFile::GetData()
+{
+  return mData;
+}
+
+size_t MappedFile::GetSize()
+{
+  return mSize;
+}
+
+DataBlock MappedFile::GetBlock()
+{
+  return DataBlock(mData, mSize);
+}
+
 FileStream::FileStream(File& file) : mFile(&file)
 {
 }
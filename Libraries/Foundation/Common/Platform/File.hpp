@@ -33,6 +33,10 @@ ZeroShared ByteBufferBlock ReadFileIntoByteBufferBlock(cstr path);
 ZeroShared String ReadFileIntoString(StringParam path);
 ZeroShared size_t WriteToFile(cstr filePath, const ::byte* data, size_t bufferSize);
 
+/// Hints that the file will be read soon so the OS can start reading it in the
+/// background. Does nothing on platforms that can't.
+ZeroShared void PrefetchFile(StringParam filePath);
+
 // Auxiliary functions defined once for every platform
 ZeroShared bool CompareFile(Status& status, StringParam filePath1, StringParam filePath2);
 ZeroShared bool CompareFileAndString(Status& status, StringParam filePath, StringParam string);
@@ -103,12 +107,40 @@ public:
   void Duplicate(Status& status, File& destinationFile);
 
 private:
-  ZeroDeclarePrivateData(File, 50);
+  ZeroDeclarePrivateData(File, 64);
 
   String mFilePath;
   FileMode::Enum mFileMode;
 };
 
+/// A read only view of a whole file. Where the platform supports it the file is
+/// memory mapped, so pages are read when they're first touched and are shared
+/// with the OS file cache instead of being copied onto the heap. Elsewhere the
+/// file is read into memory.
+class ZeroShared MappedFile
+{
+public:
+  MappedFile();
+  ~MappedFile();
+
+  bool Open(Status& status, StringParam filePath);
+  void Close();
+
+  /// Hints that a range of the file will be read soon.
+  void WillNeed(size_t offset, size_t sizeInBytes);
+
+  /// The view is only valid until the file is closed.
+  const ::byte* GetData();
+  size_t GetSize();
+  DataBlock GetBlock();
+
+private:
+  ZeroDeclarePrivateData(MappedFile, 16);
+
+  ::byte* mData;
+  size_t mSize;
+};
+
 class FileStream : public Stream
 {
 public:
@@ -251,6 +251,10 @@ public:
   /// asserts
   static bool IsCommonConnectError(int extendedErrorCode);
 
+  /// Returns true if the error code means a non-blocking operation could not
+  /// complete without blocking (try again once the socket is ready), else false
+  static bool IsWouldBlockError(int extendedErrorCode);
+
   /// Returns true if the platform's underlying socket library is initialized
   /// (reference count greater than zero), else false
   static bool IsSocketLibraryInitialized();
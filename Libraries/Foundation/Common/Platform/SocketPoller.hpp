@@ -0,0 +1,48 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+/// Read and Write are the readiness a socket is polled for. Closed is only
+/// ever reported (the peer hung up or the socket has an error).
+DeclareBitField3(SocketPollFlags, Read, Write, Closed);
+
+/// A socket that became ready during SocketPoller::Wait.
+struct SocketPollResult
+{
+  /// The user data the socket was added with.
+  void* mUserData;
+  SocketPollFlags::Type mFlags;
+};
+
+/// Waits on many non-blocking sockets at once so a single thread can service
+/// all of them (epoll on Linux). Readiness is level triggered: a socket is
+/// reported on every wait until it's read from / written to. Sockets can be
+/// added, modified and removed from other threads while a thread waits, but
+/// that wait may still report a socket removed during it.
+class ZeroShared SocketPoller
+{
+public:
+  SocketPoller();
+  ~SocketPoller();
+
+  /// Fails if the platform can't poll sockets.
+  bool Open(Status& status);
+  void Close();
+  bool IsOpen();
+
+  /// The socket must stay open until it's removed.
+  void Add(Status& status, const Socket& socket, SocketPollFlags::Type flags, void* userData);
+  void Modify(Status& status, const Socket& socket, SocketPollFlags::Type flags, void* userData);
+  void Remove(Status& status, const Socket& socket);
+
+  /// Waits until at least one socket is ready or the timeout passes, and
+  /// returns how many results were written (0 on timeout).
+  size_t Wait(Status& status, SocketPollResult* results, size_t maxResults, uint timeoutMs);
+
+private:
+  ZeroDeclarePrivateData(SocketPoller, 16);
+};
+
+} // namespace Zero
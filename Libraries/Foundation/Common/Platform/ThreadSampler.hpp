@@ -0,0 +1,30 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+/// Called on the sampled thread each time it's interrupted. It can interrupt
+/// any code on that thread (including the allocator), so it must not allocate,
+/// lock, or call anything that might.
+typedef void (*ThreadSampleFunction)(void* userData);
+
+/// Interrupts the thread that starts it at a fixed rate of that thread's cpu
+/// time and calls a function on it. Only one thread can be sampled at a time.
+class ZeroShared ThreadSampler
+{
+public:
+  ThreadSampler();
+  ~ThreadSampler();
+
+  /// Fails if the platform can't sample threads or another thread is being
+  /// sampled.
+  bool Start(Status& status, uint samplesPerSecond, ThreadSampleFunction function, void* userData);
+  void Stop();
+  bool IsRunning();
+
+private:
+  ZeroDeclarePrivateData(ThreadSampler, 16);
+};
+
+} // namespace Zero
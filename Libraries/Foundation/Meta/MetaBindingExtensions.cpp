@@ -26,6 +26,7 @@ const String cCommand("Command");
 const String cTags("Tags");
 const String cShortcut("Shortcut");
 const String cTool("Tool");
+const String cPooledStorage("PooledStorage");
 
 } // namespace ObjectAttributes
 
@@ -45,6 +45,9 @@ extern const String cTags;
 /// attribute.
 extern const String cShortcut;
 extern const String cTool;
+/// Native components that are iterated every frame. When pooled components
+/// are enabled they are allocated contiguously per space (see ComponentPools).
+extern const String cPooledStorage;
 
 } // namespace ObjectAttributes
 
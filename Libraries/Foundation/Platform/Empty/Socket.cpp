@@ -360,6 +360,11 @@ bool Socket::IsCommonConnectError(int extendedErrorCode)
   return false;
 }
 
+bool Socket::IsWouldBlockError(int extendedErrorCode)
+{
+  return false;
+}
+
 bool Socket::IsSocketLibraryInitialized()
 {
   return false;
@@ -0,0 +1,51 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+SocketPoller::SocketPoller()
+{
+}
+
+SocketPoller::~SocketPoller()
+{
+}
+
+bool SocketPoller::Open(Status& status)
+{
+  status.SetFailed("Polling sockets is not supported on this platform");
+  return false;
+}
+
+void SocketPoller::Close()
+{
+}
+
+bool SocketPoller::IsOpen()
+{
+  return false;
+}
+
+void SocketPoller::Add(Status& status, const Socket& socket, SocketPollFlags::Type flags, void* userData)
+{
+  status.SetFailed("Polling sockets is not supported on this platform");
+}
+
+void SocketPoller::Modify(Status& status, const Socket& socket, SocketPollFlags::Type flags, void* userData)
+{
+  status.SetFailed("Polling sockets is not supported on this platform");
+}
+
+void SocketPoller::Remove(Status& status, const Socket& socket)
+{
+  status.SetFailed("Polling sockets is not supported on this platform");
+}
+
+size_t SocketPoller::Wait(Status& status, SocketPollResult* results, size_t maxResults, uint timeoutMs)
+{
+  status.SetFailed("Polling sockets is not supported on this platform");
+  return 0;
+}
+
+} // namespace Zero
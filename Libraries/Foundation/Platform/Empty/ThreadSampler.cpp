@@ -0,0 +1,30 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+ThreadSampler::ThreadSampler()
+{
+}
+
+ThreadSampler::~ThreadSampler()
+{
+}
+
+bool ThreadSampler::Start(Status& status, uint samplesPerSecond, ThreadSampleFunction function, void* userData)
+{
+  status.SetFailed("Sampling threads is not supported on this platform");
+  return false;
+}
+
+void ThreadSampler::Stop()
+{
+}
+
+bool ThreadSampler::IsRunning()
+{
+  return false;
+}
+
+} // namespace Zero
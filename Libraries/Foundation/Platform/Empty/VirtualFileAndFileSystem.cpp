@@ -672,4 +672,48 @@ void File::Duplicate(Status& status, File& destinationFile)
   self->mEntry->CopyTo(other->mEntry);
 }
 
+// Mapped File
+// The virtual file system has nothing to map, so the view is a copy of the file
+MappedFile::MappedFile() : mData(nullptr), mSize(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+bool MappedFile::Open(Status& status, StringParam filePath)
+{
+  Close();
+
+  size_t size = 0;
+  mData = ReadFileIntoMemory(filePath.c_str(), size);
+  if (mData == nullptr)
+  {
+    status.SetFailed(String::Format("Failed to open file '%s'", filePath.c_str()));
+    return false;
+  }
+
+  mSize = size;
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (mData != nullptr)
+    zDeallocate(mData);
+
+  mData = nullptr;
+  mSize = 0;
+}
+
+void MappedFile::WillNeed(size_t offset, size_t sizeInBytes)
+{
+}
+
+void PrefetchFile(StringParam filePath)
+{
+}
+
 } // namespace Zero
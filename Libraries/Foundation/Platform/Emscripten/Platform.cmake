@@ -13,7 +13,9 @@ target_sources(Platform
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/ExecutableResource.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Git.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Intrinsics.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/../Empty/SocketPoller.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Thread.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/../Empty/ThreadSampler.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/ThreadSync.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/VirtualFileAndFileSystem.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Posix/Socket.cpp
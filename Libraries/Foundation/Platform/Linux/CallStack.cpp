@@ -0,0 +1,18 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+String GetCallStack(StringParam extraSymbolPath, OsHandle exceptionContext)
+{
+  // Skip this function
+  CallStackAddresses callStack;
+  GetStackAddresses(callStack, CallStackAddresses::mMaxCallstacks, 2);
+
+  CallStackSymbolInfos symbols;
+  GetStackInfo(callStack, symbols);
+  return symbols.ToString();
+}
+
+} // namespace Zero
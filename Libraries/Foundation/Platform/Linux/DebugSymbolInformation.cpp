@@ -0,0 +1,119 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+
+namespace Zero
+{
+
+String DemangleSymbolName(cstr name)
+{
+  int result = 0;
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &result);
+  if (demangled == nullptr)
+    return name;
+
+  String symbolName = demangled;
+  free(demangled);
+  return symbolName;
+}
+
+String CallStackSymbolInfos::ToString() const
+{
+  StringBuilder builder;
+
+  for (size_t i = 0; i < mCaptureSymbolCount; ++i)
+  {
+    const SymbolInfo& symbolInfo = mSymbols[i];
+    builder.Append(String::Format("%p (%s): (filename not available): %s\n",
+                                  symbolInfo.mAddress,
+                                  symbolInfo.mModuleName.c_str(),
+                                  symbolInfo.mSymbolName.c_str()));
+  }
+
+  return builder.ToString();
+}
+
+// Symbols come from the dynamic symbol table, so functions in the executable
+// are only found when it's linked with -rdynamic. There are no line numbers.
+void GetSymbolInfo(void* processHandle, SymbolInfo& symbolInfo)
+{
+  symbolInfo.mLineNumber = 0;
+
+  Dl_info info;
+  if (dladdr(symbolInfo.mAddress, &info) == 0)
+    return;
+
+  if (info.dli_sname != nullptr)
+    symbolInfo.mSymbolName = DemangleSymbolName(info.dli_sname);
+
+  if (info.dli_fname != nullptr)
+  {
+    symbolInfo.mModulePath = info.dli_fname;
+    symbolInfo.mModuleName = FilePath::GetFileNameWithoutExtension(symbolInfo.mModulePath);
+  }
+}
+
+size_t GetStackAddresses(CallStackAddresses& callStack, size_t stacksToCapture, size_t framesToSkip)
+{
+  // Backtrace can't skip frames, so the skipped frames are captured and then
+  // removed
+  size_t toCapture = Math::Min(stacksToCapture + framesToSkip, (size_t)CallStackAddresses::mMaxCallstacks);
+  size_t captured = (size_t)backtrace(callStack.mAddresses, (int)toCapture);
+
+  if (captured <= framesToSkip)
+  {
+    callStack.mCaptureFrameCount = 0;
+    return 0;
+  }
+
+  callStack.mCaptureFrameCount = captured - framesToSkip;
+  memmove(callStack.mAddresses, callStack.mAddresses + framesToSkip, callStack.mCaptureFrameCount * sizeof(void*));
+  return callStack.mCaptureFrameCount;
+}
+
+void GetStackInfo(CallStackAddresses& callStackAddresses, CallStackSymbolInfos& callStackSymbols)
+{
+  callStackSymbols.mCaptureSymbolCount = callStackAddresses.mCaptureFrameCount;
+  for (size_t i = 0; i < callStackAddresses.mCaptureFrameCount; ++i)
+  {
+    SymbolInfo& symbolInfo = callStackSymbols.mSymbols[i];
+    symbolInfo.mAddress = callStackAddresses.mAddresses[i];
+    // Generate the symbol information for each stack entry
+    GetSymbolInfo(nullptr, symbolInfo);
+  }
+}
+
+void SimpleStackWalker::ShowCallstack(void* context, StringParam extraSymbolPaths, int stacksToSkip)
+{
+  // The stack of a crash context can't be walked with backtrace, so the
+  // current stack (which contains the crash handler) is always used
+  CallStackAddresses callStack;
+  GetStackAddresses(callStack, CallStackAddresses::mMaxCallstacks, stacksToSkip + 1);
+
+  for (size_t i = 0; i < callStack.mCaptureFrameCount; ++i)
+  {
+    SymbolInfo symbolInfo;
+    symbolInfo.mAddress = callStack.mAddresses[i];
+    GetSymbolInfo(nullptr, symbolInfo);
+
+    AddSymbolInformation(symbolInfo);
+  }
+}
+
+void SimpleStackWalker::AddSymbolInformation(SymbolInfo& symbolInfo)
+{
+  mBuilder.Append(String::Format("%p (%s): (filename not available): %s\n",
+                                 symbolInfo.mAddress,
+                                 symbolInfo.mModuleName.c_str(),
+                                 symbolInfo.mSymbolName.c_str()));
+}
+
+String SimpleStackWalker::GetFinalOutput()
+{
+  return mBuilder.ToString();
+}
+
+} // namespace Zero
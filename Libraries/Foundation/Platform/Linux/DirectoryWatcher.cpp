@@ -0,0 +1,361 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace Zero
+{
+
+// Changes are reported once the directory has been quiet this long, so a file
+// written in several steps (or saved by writing a temporary and renaming it)
+// is only reported once.
+const int cDirectoryWatcherQuietMs = 100;
+// Changes are reported after this long even if the directory never goes quiet.
+const u64 cDirectoryWatcherMaxDelayMs = 1000;
+
+const uint32_t cDirectoryWatcherMask =
+    IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_EXCL_UNLINK | IN_ONLYDIR;
+
+u64 GetDirectoryWatcherMilliseconds()
+{
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (u64)now.tv_sec * 1000 + (u64)now.tv_nsec / 1000000;
+}
+
+String JoinWatchedPath(StringParam directory, StringParam name)
+{
+  if (directory.Empty())
+    return name;
+  return BuildString(directory, "/", name);
+}
+
+// Pending File Operations
+// Changes seen since the last report, at most one per file.
+class PendingFileOperations
+{
+public:
+  typedef DirectoryWatcher::FileOperation FileOperation;
+
+  struct Operation
+  {
+    FileOperation mOperation;
+    String mOldFileName;
+  };
+
+  bool Empty()
+  {
+    return mOperations.Empty() && mMovedFrom.Empty();
+  }
+
+  void Add(StringParam fileName, FileOperation operation)
+  {
+    Operation* existing = mOperations.FindPointer(fileName);
+    if (existing == nullptr)
+    {
+      Operation& added = mOperations[fileName];
+      added.mOperation = operation;
+      mOrder.PushBack(fileName);
+      return;
+    }
+
+    // Fold the new operation into the one already pending
+    if (operation == DirectoryWatcher::Removed)
+    {
+      if (existing->mOperation == DirectoryWatcher::Added)
+      {
+        mOperations.Erase(fileName);
+      }
+      else if (existing->mOperation == DirectoryWatcher::Renamed)
+      {
+        String oldFileName = existing->mOldFileName;
+        mOperations.Erase(fileName);
+        Add(oldFileName, DirectoryWatcher::Removed);
+      }
+      else
+      {
+        existing->mOperation = DirectoryWatcher::Removed;
+      }
+    }
+    else if (existing->mOperation == DirectoryWatcher::Removed)
+    {
+      // Deleted and written again
+      existing->mOperation = DirectoryWatcher::Modified;
+    }
+  }
+
+  void MovedFrom(uint32_t cookie, StringParam fileName)
+  {
+    mMovedFrom[cookie] = fileName;
+  }
+
+  void MovedTo(uint32_t cookie, StringParam fileName)
+  {
+    String* oldFileName = mMovedFrom.FindPointer(cookie);
+    if (oldFileName == nullptr)
+    {
+      // Moved in from outside of the watched directory
+      Add(fileName, DirectoryWatcher::Added);
+      return;
+    }
+
+    String oldName = *oldFileName;
+    mMovedFrom.Erase(cookie);
+
+    // A file that is still pending as added is reported as added under its
+    // new name, and an existing file replaced by the rename is modified
+    Operation* existingOld = mOperations.FindPointer(oldName);
+    if (existingOld != nullptr && existingOld->mOperation == DirectoryWatcher::Added)
+    {
+      mOperations.Erase(oldName);
+      Add(fileName, DirectoryWatcher::Added);
+      return;
+    }
+    if (existingOld != nullptr && existingOld->mOperation == DirectoryWatcher::Renamed)
+      oldName = existingOld->mOldFileName;
+    mOperations.Erase(oldName);
+
+    if (oldName == fileName)
+    {
+      Add(fileName, DirectoryWatcher::Modified);
+      return;
+    }
+
+    Operation* existingNew = mOperations.FindPointer(fileName);
+    if (existingNew == nullptr)
+    {
+      Operation& renamed = mOperations[fileName];
+      mOrder.PushBack(fileName);
+      existingNew = &renamed;
+    }
+    existingNew->mOperation = DirectoryWatcher::Renamed;
+    existingNew->mOldFileName = oldName;
+  }
+
+  void Report(DirectoryWatcher::CallbackFunction callback, void* callbackInstance)
+  {
+    // Anything moved out of the watched directory is gone
+    forRange (HashMap<uint32_t, String>::pair& pair, mMovedFrom.All())
+      Add(pair.second, DirectoryWatcher::Removed);
+    mMovedFrom.Clear();
+
+    forRange (String& fileName, mOrder.All())
+    {
+      // A file can be in the order more than once if its operation was
+      // dropped and then added again
+      Operation* operation = mOperations.FindPointer(fileName);
+      if (operation == nullptr)
+        continue;
+
+      DirectoryWatcher::FileOperationInfo info;
+      info.Operation = operation->mOperation;
+      info.FileName = fileName;
+      info.OldFileName = operation->mOldFileName;
+      mOperations.Erase(fileName);
+
+      (*callback)(callbackInstance, info);
+    }
+
+    mOrder.Clear();
+  }
+
+  HashMap<String, Operation> mOperations;
+  Array<String> mOrder;
+  // Renames are two events matched by a cookie
+  HashMap<uint32_t, String> mMovedFrom;
+};
+
+// Inotify Watches
+// Inotify doesn't watch subdirectories, so every directory under the watched
+// directory gets its own watch.
+class InotifyWatches
+{
+public:
+  InotifyWatches(int handle, cstr root) : mHandle(handle), mRoot(root)
+  {
+  }
+
+  /// Watches the directory and every directory under it. Files that are
+  /// already in a new directory are reported as added, since they may have
+  /// been created before the watch.
+  void Add(StringParam relativePath, PendingFileOperations* pending)
+  {
+    String fullPath = relativePath.Empty() ? mRoot : FilePath::Combine(mRoot, relativePath);
+    int watch = inotify_add_watch(mHandle, fullPath.c_str(), cDirectoryWatcherMask);
+    if (watch == -1)
+      return;
+
+    mDirectories[watch] = relativePath;
+
+    for (FileRange range(fullPath); !range.Empty(); range.PopFront())
+    {
+      FileEntry entry = range.FrontEntry();
+      String childPath = JoinWatchedPath(relativePath, entry.mFileName);
+      if (DirectoryExists(entry.GetFullPath()))
+        Add(childPath, pending);
+      else if (pending != nullptr)
+        pending->Add(childPath, DirectoryWatcher::Added);
+    }
+  }
+
+  /// Stops watching the directory and every directory under it.
+  void Remove(StringParam relativePath)
+  {
+    String prefix = BuildString(relativePath, "/");
+
+    Array<int> removed;
+    forRange (HashMap<int, String>::pair& pair, mDirectories.All())
+    {
+      if (pair.second == relativePath || pair.second.StartsWith(prefix))
+        removed.PushBack(pair.first);
+    }
+
+    forRange (int watch, removed.All())
+    {
+      inotify_rm_watch(mHandle, watch);
+      mDirectories.Erase(watch);
+    }
+  }
+
+  /// Events were dropped, so everything is watched again and every file is
+  /// reported as modified.
+  void Rescan(PendingFileOperations& pending)
+  {
+    forRange (HashMap<int, String>::pair& pair, mDirectories.All())
+      inotify_rm_watch(mHandle, pair.first);
+    mDirectories.Clear();
+
+    PendingFileOperations added;
+    Add(String(), &added);
+    forRange (String& fileName, added.mOrder.All())
+      pending.Add(fileName, DirectoryWatcher::Modified);
+  }
+
+  int mHandle;
+  String mRoot;
+  // The path relative to the watched directory of each watch
+  HashMap<int, String> mDirectories;
+};
+
+void ProcessInotifyEvent(inotify_event& event, InotifyWatches& watches, PendingFileOperations& pending)
+{
+  if (event.mask & IN_Q_OVERFLOW)
+  {
+    watches.Rescan(pending);
+    return;
+  }
+
+  if (event.mask & IN_IGNORED)
+  {
+    watches.mDirectories.Erase(event.wd);
+    return;
+  }
+
+  String* directory = watches.mDirectories.FindPointer(event.wd);
+  if (directory == nullptr || event.len == 0)
+    return;
+
+  String fileName = JoinWatchedPath(*directory, event.name);
+
+  // Only files are reported, but new directories need to be watched
+  if (event.mask & IN_ISDIR)
+  {
+    if (event.mask & (IN_CREATE | IN_MOVED_TO))
+      watches.Add(fileName, &pending);
+    else if (event.mask & IN_MOVED_FROM)
+      watches.Remove(fileName);
+    return;
+  }
+
+  if (event.mask & IN_CREATE)
+    pending.Add(fileName, DirectoryWatcher::Added);
+  else if (event.mask & IN_DELETE)
+    pending.Add(fileName, DirectoryWatcher::Removed);
+  else if (event.mask & (IN_MODIFY | IN_CLOSE_WRITE))
+    pending.Add(fileName, DirectoryWatcher::Modified);
+  else if (event.mask & IN_MOVED_FROM)
+    pending.MovedFrom(event.cookie, fileName);
+  else if (event.mask & IN_MOVED_TO)
+    pending.MovedTo(event.cookie, fileName);
+}
+
+OsInt DirectoryWatcher::RunThreadEntryPoint()
+{
+  int handle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (handle == -1)
+    return (OsInt)-1;
+
+  InotifyWatches watches(handle, mDirectoryToWatch);
+  watches.Add(String(), nullptr);
+  if (watches.mDirectories.Empty())
+  {
+    close(handle);
+    return (OsInt)-1;
+  }
+
+  PendingFileOperations pending;
+  u64 firstChangeTime = 0;
+
+  // Big enough for many events at once, aligned for inotify_event
+  const size_t cBufferSize = 16 * 1024;
+  alignas(inotify_event) ::byte buffer[cBufferSize];
+
+  // The cancel event can't be polled with the inotify handle, so the flag is
+  // checked each time the wait times out
+  while (!mCancelled)
+  {
+    pollfd pollInfo;
+    pollInfo.fd = handle;
+    pollInfo.events = POLLIN;
+    pollInfo.revents = 0;
+
+    int result = poll(&pollInfo, 1, cDirectoryWatcherQuietMs);
+    if (result == -1 && errno != EINTR)
+      break;
+
+    if (result > 0)
+    {
+      // Drain every event that is ready
+      for (;;)
+      {
+        ssize_t bytesRead = read(handle, buffer, cBufferSize);
+        if (bytesRead <= 0)
+          break;
+
+        for (ssize_t offset = 0; offset < bytesRead;)
+        {
+          inotify_event& event = *(inotify_event*)(buffer + offset);
+          ProcessInotifyEvent(event, watches, pending);
+          offset += sizeof(inotify_event) + event.len;
+        }
+      }
+
+      if (firstChangeTime == 0)
+        firstChangeTime = GetDirectoryWatcherMilliseconds();
+    }
+
+    if (pending.Empty())
+    {
+      firstChangeTime = 0;
+      continue;
+    }
+
+    bool quiet = (result == 0);
+    bool waitedTooLong = GetDirectoryWatcherMilliseconds() - firstChangeTime >= cDirectoryWatcherMaxDelayMs;
+    if (quiet || waitedTooLong)
+    {
+      pending.Report(mCallback, mCallbackInstance);
+      firstChangeTime = 0;
+    }
+  }
+
+  // Closing the handle removes every watch
+  close(handle);
+  return 0;
+}
+
+} // namespace Zero
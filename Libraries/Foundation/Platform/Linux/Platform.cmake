@@ -11,12 +11,9 @@ target_compile_definitions(Platform
 target_sources(Platform
   PRIVATE
     ${CMAKE_CURRENT_LIST_DIR}/../Curl/WebRequest.cpp
-    ${CMAKE_CURRENT_LIST_DIR}/../Empty/CallStack.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/ComPort.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/CrashHandler.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Debug.cpp
-    ${CMAKE_CURRENT_LIST_DIR}/../Empty/DebugSymbolInformation.cpp
-    ${CMAKE_CURRENT_LIST_DIR}/../Empty/DirectoryWatcher.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/ExecutableResource.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Intrinsics.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/MainLoop.cpp
@@ -24,7 +21,7 @@ target_sources(Platform
     ${CMAKE_CURRENT_LIST_DIR}/../Libgit2/Git.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../SDL/Audio.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../SDL/ExternalLibrary.cpp
-    ${CMAKE_CURRENT_LIST_DIR}/../SDL/File.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/../Posix/File.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../SDL/Keys.inl
     ${CMAKE_CURRENT_LIST_DIR}/../SDL/MouseButtons.inl
     ${CMAKE_CURRENT_LIST_DIR}/../SDL/Peripherals.cpp
@@ -39,8 +36,13 @@ target_sources(Platform
     ${CMAKE_CURRENT_LIST_DIR}/../STD/FileSystem.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../STD/FpControl.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../STD/Process.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/CallStack.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/DebugSymbolInformation.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/DirectoryWatcher.cpp
     ${CMAKE_CURRENT_LIST_DIR}/Precompiled.cpp
     ${CMAKE_CURRENT_LIST_DIR}/Precompiled.hpp
+    ${CMAKE_CURRENT_LIST_DIR}/SocketPoller.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/ThreadSampler.cpp
 )
 
 target_link_libraries(Platform
@@ -59,4 +61,10 @@ target_link_libraries(Platform
   PUBLIC
     stdc++fs
     dl
+)
+
+# Exports the executable's functions so call stacks can be symbolized
+target_link_options(Platform
+  PUBLIC
+    -rdynamic
 )
\ No newline at end of file
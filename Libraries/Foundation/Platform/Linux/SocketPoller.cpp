@@ -0,0 +1,159 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace Zero
+{
+
+// The most events read from the kernel in one wait
+const size_t cMaxEpollEvents = 64;
+
+struct SocketPollerPrivateData
+{
+  SocketPollerPrivateData()
+  {
+    mEpoll = -1;
+  }
+
+  int mEpoll;
+};
+
+int SocketFromHandle(const Socket& socket)
+{
+  return static_cast<int>(reinterpret_cast<size_t>(socket.mHandle));
+}
+
+uint32_t TranslateToEpoll(SocketPollFlags::Type flags)
+{
+  // Hang ups and errors are always reported, EPOLLRDHUP also catches a peer
+  // that only shut down its side
+  uint32_t events = EPOLLRDHUP;
+  if (flags & SocketPollFlags::Read)
+    events |= EPOLLIN;
+  if (flags & SocketPollFlags::Write)
+    events |= EPOLLOUT;
+  return events;
+}
+
+SocketPollFlags::Type TranslateFromEpoll(uint32_t events)
+{
+  SocketPollFlags::Type flags = SocketPollFlags::None;
+  if (events & EPOLLIN)
+    flags |= SocketPollFlags::Read;
+  if (events & EPOLLOUT)
+    flags |= SocketPollFlags::Write;
+  if (events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+    flags |= SocketPollFlags::Closed;
+  return flags;
+}
+
+void EpollControl(Status& status, int epoll, int operation, const Socket& socket, uint32_t events, void* userData)
+{
+  if (epoll == -1)
+  {
+    status.SetFailed("The socket poller is not open");
+    return;
+  }
+
+  epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = events;
+  event.data.ptr = userData;
+
+  if (epoll_ctl(epoll, operation, SocketFromHandle(socket), &event) != 0)
+    status.SetFailed(String::Format("Failed to change a polled socket: %s", strerror(errno)), errno);
+}
+
+SocketPoller::SocketPoller()
+{
+  ZeroConstructPrivateData(SocketPollerPrivateData);
+}
+
+SocketPoller::~SocketPoller()
+{
+  Close();
+  ZeroDestructPrivateData(SocketPollerPrivateData);
+}
+
+bool SocketPoller::Open(Status& status)
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  if (self->mEpoll != -1)
+    return true;
+
+  self->mEpoll = epoll_create1(EPOLL_CLOEXEC);
+  if (self->mEpoll == -1)
+  {
+    status.SetFailed(String::Format("Failed to create the socket poller: %s", strerror(errno)), errno);
+    return false;
+  }
+
+  return true;
+}
+
+void SocketPoller::Close()
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  if (self->mEpoll == -1)
+    return;
+
+  close(self->mEpoll);
+  self->mEpoll = -1;
+}
+
+bool SocketPoller::IsOpen()
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  return self->mEpoll != -1;
+}
+
+void SocketPoller::Add(Status& status, const Socket& socket, SocketPollFlags::Type flags, void* userData)
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  EpollControl(status, self->mEpoll, EPOLL_CTL_ADD, socket, TranslateToEpoll(flags), userData);
+}
+
+void SocketPoller::Modify(Status& status, const Socket& socket, SocketPollFlags::Type flags, void* userData)
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  EpollControl(status, self->mEpoll, EPOLL_CTL_MOD, socket, TranslateToEpoll(flags), userData);
+}
+
+void SocketPoller::Remove(Status& status, const Socket& socket)
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  EpollControl(status, self->mEpoll, EPOLL_CTL_DEL, socket, 0, nullptr);
+}
+
+size_t SocketPoller::Wait(Status& status, SocketPollResult* results, size_t maxResults, uint timeoutMs)
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  if (self->mEpoll == -1)
+  {
+    status.SetFailed("The socket poller is not open");
+    return 0;
+  }
+
+  epoll_event events[cMaxEpollEvents];
+  int maxEvents = (int)Math::Min(maxResults, cMaxEpollEvents);
+  int count = epoll_wait(self->mEpoll, events, maxEvents, (int)timeoutMs);
+  if (count < 0)
+  {
+    // A signal (such as the sampling profiler's) isn't an error
+    if (errno != EINTR)
+      status.SetFailed(String::Format("Failed to wait on polled sockets: %s", strerror(errno)), errno);
+    return 0;
+  }
+
+  for (int i = 0; i < count; ++i)
+  {
+    results[i].mUserData = events[i].data.ptr;
+    results[i].mFlags = TranslateFromEpoll(events[i].events);
+  }
+  return (size_t)count;
+}
+
+} // namespace Zero
@@ -0,0 +1,140 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+#include <errno.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef sigev_notify_thread_id
+#  define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace Zero
+{
+
+// The signal handler has no way to find its sampler, which is why only one
+// thread can be sampled at a time
+volatile ThreadSampleFunction gThreadSampleFunction = nullptr;
+void* volatile gThreadSampleUserData = nullptr;
+
+void OnThreadSampleSignal(int signal, siginfo_t* info, void* context)
+{
+  int savedErrno = errno;
+
+  ThreadSampleFunction function = gThreadSampleFunction;
+  if (function != nullptr)
+    function(gThreadSampleUserData);
+
+  errno = savedErrno;
+}
+
+struct ThreadSamplerPrivateData
+{
+  ThreadSamplerPrivateData()
+  {
+    mRunning = false;
+  }
+
+  bool mRunning;
+  timer_t mTimer;
+};
+
+ThreadSampler::ThreadSampler()
+{
+  ZeroConstructPrivateData(ThreadSamplerPrivateData);
+}
+
+ThreadSampler::~ThreadSampler()
+{
+  Stop();
+  ZeroDestructPrivateData(ThreadSamplerPrivateData);
+}
+
+bool ThreadSampler::Start(Status& status, uint samplesPerSecond, ThreadSampleFunction function, void* userData)
+{
+  ZeroGetPrivateData(ThreadSamplerPrivateData);
+
+  if (gThreadSampleFunction != nullptr)
+  {
+    status.SetFailed("Another thread is already being sampled");
+    return false;
+  }
+
+  // The first backtrace loads the unwinder, which can't be done from a signal
+  // handler
+  void* warmUp[1];
+  backtrace(warmUp, 1);
+
+  // The handler is left installed after stopping since a sample may still be
+  // pending, and the default action for SIGPROF ends the process
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = OnThreadSampleSignal;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, nullptr) != 0)
+  {
+    status.SetFailed(String::Format("Failed to install the sample signal handler: %s", strerror(errno)));
+    return false;
+  }
+
+  // Time is measured on the thread's cpu clock so only time spent running is
+  // sampled
+  clockid_t clock;
+  if (pthread_getcpuclockid(pthread_self(), &clock) != 0)
+  {
+    status.SetFailed("Failed to get the thread's cpu clock");
+    return false;
+  }
+
+  // The signal has to go to this thread rather than any thread in the process
+  sigevent event;
+  memset(&event, 0, sizeof(event));
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = (pid_t)syscall(SYS_gettid);
+
+  gThreadSampleUserData = userData;
+  gThreadSampleFunction = function;
+
+  if (timer_create(clock, &event, &self->mTimer) != 0)
+  {
+    gThreadSampleFunction = nullptr;
+    status.SetFailed(String::Format("Failed to create the sample timer: %s", strerror(errno)));
+    return false;
+  }
+
+  long period = 1000000000L / (long)Math::Max(samplesPerSecond, 1u);
+  itimerspec interval;
+  interval.it_interval.tv_sec = period / 1000000000L;
+  interval.it_interval.tv_nsec = period % 1000000000L;
+  interval.it_value = interval.it_interval;
+  timer_settime(self->mTimer, 0, &interval, nullptr);
+
+  self->mRunning = true;
+  return true;
+}
+
+void ThreadSampler::Stop()
+{
+  ZeroGetPrivateData(ThreadSamplerPrivateData);
+  if (!self->mRunning)
+    return;
+
+  timer_delete(self->mTimer);
+  gThreadSampleFunction = nullptr;
+  gThreadSampleUserData = nullptr;
+  self->mRunning = false;
+}
+
+bool ThreadSampler::IsRunning()
+{
+  ZeroGetPrivateData(ThreadSamplerPrivateData);
+  return self->mRunning;
+}
+
+} // namespace Zero
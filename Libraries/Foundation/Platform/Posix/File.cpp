@@ -0,0 +1,529 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace Zero
+{
+
+const int File::PlatformMaxPath = PATH_MAX;
+
+// Small reads (chunk headers, serialized values) are served from this buffer
+// instead of each being a system call. Reads at least this big go straight
+// into the caller's memory.
+const size_t cFileReadBufferSize = 32 * 1024;
+
+struct FilePrivateData
+{
+  FilePrivateData()
+  {
+    mHandle = -1;
+    mSeekable = false;
+    mPosition = 0;
+    mFileSize = 0;
+    mBuffer = nullptr;
+    mBufferPosition = 0;
+    mBufferSize = 0;
+  }
+
+  bool IsValidFile()
+  {
+    return mHandle != -1;
+  }
+
+  void ClearBuffer()
+  {
+    mBufferPosition = 0;
+    mBufferSize = 0;
+  }
+
+  // Copies whatever part of the read at the current position is already in
+  // the buffer
+  size_t ReadFromBuffer(::byte* data, size_t sizeInBytes)
+  {
+    if (mPosition < mBufferPosition || mPosition >= mBufferPosition + mBufferSize)
+      return 0;
+
+    size_t offset = (size_t)(mPosition - mBufferPosition);
+    size_t amount = Math::Min(sizeInBytes, mBufferSize - offset);
+    memcpy(data, mBuffer + offset, amount);
+    mPosition += amount;
+    return amount;
+  }
+
+  int mHandle;
+  // Whether reads and writes go through offsets (only for files we opened)
+  bool mSeekable;
+  FilePosition mPosition;
+  long long mFileSize;
+  ::byte* mBuffer;
+  FilePosition mBufferPosition;
+  size_t mBufferSize;
+};
+
+int ToPosixFlags(FileMode::Enum mode)
+{
+  switch (mode)
+  {
+  case FileMode::Read:
+    return O_RDONLY;
+  case FileMode::Write:
+    return O_WRONLY | O_CREAT | O_TRUNC;
+  case FileMode::Append:
+    return O_WRONLY | O_CREAT | O_APPEND;
+  case FileMode::ReadWrite:
+    return O_RDWR | O_CREAT;
+  }
+  return O_RDONLY;
+}
+
+void FillPosixErrorStatus(Status& status, StringParam filePath, cstr operation)
+{
+  int errorCode = errno;
+  String message = String::Format("Failed to %s file '%s': %s", operation, filePath.c_str(), strerror(errorCode));
+  status.SetFailed(message, errorCode);
+}
+
+File::File()
+{
+  ZeroConstructPrivateData(FilePrivateData);
+  mFileMode = FileMode::Read;
+}
+
+File::~File()
+{
+  Close();
+  ZeroDestructPrivateData(FilePrivateData);
+}
+
+size_t File::Size()
+{
+  ZeroGetPrivateData(FilePrivateData);
+  return (size_t)self->mFileSize;
+}
+
+long long File::CurrentFileSize()
+{
+  ZeroGetPrivateData(FilePrivateData);
+  if (!self->IsValidFile())
+    return 0;
+
+  struct stat info;
+  if (fstat(self->mHandle, &info) != 0)
+    return -1;
+  return (long long)info.st_size;
+}
+
+bool File::Open(StringParam filePath,
+                FileMode::Enum mode,
+                FileAccessPattern::Enum accessPattern,
+                FileShare::Enum share,
+                Status* status)
+{
+  ZeroGetPrivateData(FilePrivateData);
+
+  // Posix has no sharing modes, other processes can always open the file
+  self->mHandle = open(filePath.c_str(), ToPosixFlags(mode) | O_CLOEXEC, 0666);
+  if (self->mHandle == -1)
+  {
+    if (status != nullptr)
+      FillPosixErrorStatus(*status, filePath, "open");
+    else
+      Warn("Failed to open file '%s'. %s", filePath.c_str(), strerror(errno));
+    return false;
+  }
+
+  // Lets the kernel size its read ahead for how the file will be read
+  int advice = accessPattern == FileAccessPattern::Sequential ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_RANDOM;
+  posix_fadvise(self->mHandle, 0, 0, advice);
+
+  self->mSeekable = true;
+  self->mFileSize = CurrentFileSize();
+  self->mPosition = 0;
+  self->ClearBuffer();
+  mFilePath = filePath;
+  mFileMode = mode;
+
+  if (mode == FileMode::Append)
+    self->mPosition = (FilePosition)self->mFileSize;
+
+  if (mode != FileMode::Read)
+    FileModifiedState::BeginFileModified(mFilePath);
+
+  return true;
+}
+
+void File::Open(OsHandle handle, FileMode::Enum mode)
+{
+  ZeroGetPrivateData(FilePrivateData);
+  self->mHandle = (int)(uintptr_t)handle;
+  // Handles from elsewhere (pipes, redirected standard streams) may share
+  // their offset with other writers, so they're read and written in order
+  // instead of by offset
+  self->mSeekable = false;
+  self->mFileSize = CurrentFileSize();
+  self->mPosition = 0;
+  self->ClearBuffer();
+  mFileMode = mode;
+}
+
+void File::Open(Status& status, FILE* file, FileMode::Enum mode)
+{
+  int descriptor = fileno(file);
+  if (descriptor == -1)
+  {
+    status.SetFailed("The FILE pointer was not valid or bound to a stream");
+    return;
+  }
+
+  // The FILE keeps ownership of its descriptor
+  descriptor = dup(descriptor);
+  if (descriptor == -1)
+  {
+    FillPosixErrorStatus(status, mFilePath, "duplicate");
+    return;
+  }
+
+  Open((OsHandle)(uintptr_t)descriptor, mode);
+}
+
+bool File::IsOpen()
+{
+  ZeroGetPrivateData(FilePrivateData);
+  return self->IsValidFile();
+}
+
+void File::Close()
+{
+  ZeroGetPrivateData(FilePrivateData);
+  if (self->mBuffer != nullptr)
+  {
+    zDeallocate(self->mBuffer);
+    self->mBuffer = nullptr;
+  }
+  self->ClearBuffer();
+
+  if (self->IsValidFile())
+  {
+    close(self->mHandle);
+    self->mHandle = -1;
+
+    // Must come after closing the file because it may need access to the
+    // modified date.
+    if (mFileMode != FileMode::Read)
+      FileModifiedState::EndFileModified(mFilePath);
+  }
+}
+
+FilePosition File::Tell()
+{
+  ZeroGetPrivateData(FilePrivateData);
+  return self->mPosition;
+}
+
+bool File::Seek(FilePosition pos, SeekOrigin::Enum rel)
+{
+  ZeroGetPrivateData(FilePrivateData);
+  if (!self->IsValidFile() || !self->mSeekable)
+    return false;
+
+  // Positions are given as unsigned, but relative seeks can be negative
+  s64 offset = (s64)pos;
+  switch (rel)
+  {
+  case SeekOrigin::Begin:
+    break;
+  case SeekOrigin::Current:
+    offset += (s64)self->mPosition;
+    break;
+  case SeekOrigin::End:
+    offset += CurrentFileSize();
+    break;
+  default:
+    return false;
+  }
+
+  if (offset < 0)
+    return false;
+
+  // The buffer is kept since seeking back over a chunk header is common
+  self->mPosition = (FilePosition)offset;
+  return true;
+}
+
+size_t File::Write(::byte* data, size_t sizeInBytes)
+{
+  ZeroGetPrivateData(FilePrivateData);
+  if (!self->IsValidFile())
+    return 0;
+
+  self->ClearBuffer();
+
+  size_t written = 0;
+  while (written < sizeInBytes)
+  {
+    ssize_t result;
+    // Appending ignores the offset
+    if (self->mSeekable && mFileMode != FileMode::Append)
+      result = pwrite(self->mHandle, data + written, sizeInBytes - written, (off_t)(self->mPosition + written));
+    else
+      result = write(self->mHandle, data + written, sizeInBytes - written);
+
+    if (result < 0 && errno == EINTR)
+      continue;
+    if (result <= 0)
+      break;
+    written += (size_t)result;
+  }
+
+  if (mFileMode == FileMode::Append && self->mSeekable)
+    self->mPosition = (FilePosition)lseek(self->mHandle, 0, SEEK_CUR);
+  else
+    self->mPosition += written;
+  return written;
+}
+
+size_t File::Read(Status& status, ::byte* data, size_t sizeInBytes)
+{
+  ZeroGetPrivateData(FilePrivateData);
+  if (!self->IsValidFile())
+  {
+    status.SetFailed("No file was open");
+    return 0;
+  }
+
+  if (!self->mSeekable)
+  {
+    ssize_t result;
+    do
+      result = read(self->mHandle, data, sizeInBytes);
+    while (result < 0 && errno == EINTR);
+
+    if (result < 0)
+    {
+      FillPosixErrorStatus(status, mFilePath, "read");
+      return 0;
+    }
+
+    self->mPosition += (FilePosition)result;
+    return (size_t)result;
+  }
+
+  size_t amountRead = self->ReadFromBuffer(data, sizeInBytes);
+  while (amountRead < sizeInBytes)
+  {
+    size_t remaining = sizeInBytes - amountRead;
+
+    // Big reads skip the buffer
+    if (remaining >= cFileReadBufferSize)
+    {
+      ssize_t result = pread(self->mHandle, data + amountRead, remaining, (off_t)self->mPosition);
+      if (result < 0 && errno == EINTR)
+        continue;
+      if (result < 0)
+      {
+        FillPosixErrorStatus(status, mFilePath, "read");
+        break;
+      }
+      if (result == 0)
+        break;
+
+      self->mPosition += (FilePosition)result;
+      amountRead += (size_t)result;
+      continue;
+    }
+
+    if (self->mBuffer == nullptr)
+      self->mBuffer = (::byte*)zAllocate(cFileReadBufferSize);
+
+    // Reads straight into the caller's memory and fills the buffer with what
+    // comes after it in the same call
+    iovec vectors[2];
+    vectors[0].iov_base = data + amountRead;
+    vectors[0].iov_len = remaining;
+    vectors[1].iov_base = self->mBuffer;
+    vectors[1].iov_len = cFileReadBufferSize;
+
+    ssize_t result = preadv(self->mHandle, vectors, 2, (off_t)self->mPosition);
+    if (result < 0 && errno == EINTR)
+      continue;
+    if (result < 0)
+    {
+      FillPosixErrorStatus(status, mFilePath, "read");
+      break;
+    }
+    if (result == 0)
+      break;
+
+    size_t direct = Math::Min((size_t)result, remaining);
+    amountRead += direct;
+    self->mPosition += direct;
+    self->mBufferPosition = self->mPosition;
+    self->mBufferSize = (size_t)result - direct;
+  }
+
+  return amountRead;
+}
+
+bool File::HasData(Status& status)
+{
+  ZeroGetPrivateData(FilePrivateData);
+  if (!self->IsValidFile())
+  {
+    status.SetFailed("No file was open");
+    return false;
+  }
+
+  if (self->mSeekable)
+    return (long long)Tell() < CurrentFileSize();
+
+  pollfd request;
+  request.fd = self->mHandle;
+  request.events = POLLIN;
+  request.revents = 0;
+  int result = poll(&request, 1, 0);
+  if (result < 0)
+  {
+    FillPosixErrorStatus(status, mFilePath, "poll");
+    return false;
+  }
+  return result > 0 && (request.revents & POLLIN);
+}
+
+void File::Flush()
+{
+  ZeroGetPrivateData(FilePrivateData);
+  if (self->IsValidFile())
+    fsync(self->mHandle);
+}
+
+void File::Duplicate(Status& status, File& destinationFile)
+{
+  ZeroGetPrivateData(FilePrivateData);
+
+  if (!self->IsValidFile())
+  {
+    status.SetFailed("File is not valid. Open a valid file before attempting "
+                     "file operations.");
+    return;
+  }
+
+  int descriptor = dup(self->mHandle);
+  if (descriptor == -1)
+  {
+    FillPosixErrorStatus(status, mFilePath, "duplicate");
+    return;
+  }
+
+  destinationFile.Close();
+  destinationFile.Open((OsHandle)(uintptr_t)descriptor, mFileMode);
+}
+
+// Mapped File
+struct MappedFilePrivateData
+{
+  MappedFilePrivateData()
+  {
+    mMapped = false;
+  }
+
+  // Empty files can't be mapped
+  bool mMapped;
+};
+
+MappedFile::MappedFile() : mData(nullptr), mSize(0)
+{
+  ZeroConstructPrivateData(MappedFilePrivateData);
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+  ZeroDestructPrivateData(MappedFilePrivateData);
+}
+
+bool MappedFile::Open(Status& status, StringParam filePath)
+{
+  ZeroGetPrivateData(MappedFilePrivateData);
+  Close();
+
+  int handle = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (handle == -1)
+  {
+    FillPosixErrorStatus(status, filePath, "open");
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(handle, &info) != 0)
+  {
+    FillPosixErrorStatus(status, filePath, "stat");
+    close(handle);
+    return false;
+  }
+
+  mSize = (size_t)info.st_size;
+  if (mSize != 0)
+  {
+    void* view = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, handle, 0);
+    if (view == MAP_FAILED)
+    {
+      FillPosixErrorStatus(status, filePath, "map");
+      close(handle);
+      mSize = 0;
+      return false;
+    }
+
+    mData = (::byte*)view;
+    self->mMapped = true;
+  }
+
+  // The mapping keeps the file alive
+  close(handle);
+  return true;
+}
+
+void MappedFile::Close()
+{
+  ZeroGetPrivateData(MappedFilePrivateData);
+  if (self->mMapped)
+    munmap(mData, mSize);
+
+  self->mMapped = false;
+  mData = nullptr;
+  mSize = 0;
+}
+
+void MappedFile::WillNeed(size_t offset, size_t sizeInBytes)
+{
+  ZeroGetPrivateData(MappedFilePrivateData);
+  if (!self->mMapped || offset >= mSize)
+    return;
+
+  // madvise needs a page aligned address
+  size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+  size_t begin = offset - offset % pageSize;
+  size_t end = Math::Min(offset + sizeInBytes, mSize);
+  madvise(mData + begin, end - begin, MADV_WILLNEED);
+}
+
+void PrefetchFile(StringParam filePath)
+{
+  int handle = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (handle == -1)
+    return;
+
+  // The kernel starts reading the file in the background and keeps going
+  // after it's closed
+  posix_fadvise(handle, 0, 0, POSIX_FADV_WILLNEED);
+  close(handle);
+}
+
+} // namespace Zero
@@ -49,6 +49,14 @@ typedef sockaddr_storage SOCKET_ADDRESS_STORAGE;
 namespace Zero
 {
 
+// Sending on a socket the peer closed raises SIGPIPE (which ends the process)
+// unless it's suppressed (Winsock only reports the error)
+#ifdef MSG_NOSIGNAL
+static const int cSendFlags = MSG_NOSIGNAL;
+#else
+static const int cSendFlags = 0;
+#endif
+
 /// Sets the status error code and optional error string
 void FailOnError(Status& status, int errorCode, StringParam errorString)
 {
@@ -129,43 +137,120 @@ void TranslateToPosix(Status& status, SocketAddressFamily::Enum& socketAddressFa
     return FailOnError(status, socketAddressFamily, "Unsupported socket address family enumeration");
   }
 }
+/// Moves the flag from the Winsock flags to the POSIX flags if it's set
+void TranslateFlag(uint& remainingFlags, uint& posixFlags, uint winsockFlag, uint posixFlag)
+{
+  if (remainingFlags & winsockFlag)
+  {
+    posixFlags |= posixFlag;
+    remainingFlags &= ~winsockFlag;
+  }
+}
 void TranslateToPosix(Status& status, SocketAddressResolutionFlags::Enum& socketAddressFlags)
 {
-  // TODO: Implement the rest of these
-  return FailOnError(status, socketAddressFlags, "Unsupported socket address flags enumeration");
+  uint remainingFlags = socketAddressFlags;
+  uint posixFlags = 0;
+
+  TranslateFlag(remainingFlags, posixFlags, SocketAddressResolutionFlags::AnyAddress, AI_PASSIVE);
+  TranslateFlag(remainingFlags, posixFlags, SocketAddressResolutionFlags::RequestCannonName, AI_CANONNAME);
+  TranslateFlag(remainingFlags, posixFlags, SocketAddressResolutionFlags::NumericHost, AI_NUMERICHOST);
+  TranslateFlag(remainingFlags, posixFlags, SocketAddressResolutionFlags::NumericService, AI_NUMERICSERV);
+  TranslateFlag(remainingFlags, posixFlags, SocketAddressResolutionFlags::RequestIpv6and4, AI_ALL);
+  TranslateFlag(remainingFlags, posixFlags, SocketAddressResolutionFlags::ResolveIfGlobalAddress, AI_ADDRCONFIG);
+  TranslateFlag(remainingFlags, posixFlags, SocketAddressResolutionFlags::RequestIpv4Mapped, AI_V4MAPPED);
+
+  if (remainingFlags != 0)
+    return FailOnError(status, socketAddressFlags, "Unsupported socket address flags enumeration");
+
+  socketAddressFlags = SocketAddressResolutionFlags::Enum(posixFlags);
 }
 void TranslateToPosix(Status& status, SocketNameResolutionFlags::Enum& socketNameFlags)
 {
-  // TODO: Implement the rest of these
-  return FailOnError(status, socketNameFlags, "Unsupported socket name flags enumeration");
+  uint remainingFlags = socketNameFlags;
+  uint posixFlags = 0;
+
+  TranslateFlag(remainingFlags, posixFlags, SocketNameResolutionFlags::NoFullyQualifiedDomainName, NI_NOFQDN);
+  TranslateFlag(remainingFlags, posixFlags, SocketNameResolutionFlags::NumericHost, NI_NUMERICHOST);
+  TranslateFlag(remainingFlags, posixFlags, SocketNameResolutionFlags::ErrorIfHostNotInDNS, NI_NAMEREQD);
+  TranslateFlag(remainingFlags, posixFlags, SocketNameResolutionFlags::NumericService, NI_NUMERICSERV);
+  TranslateFlag(remainingFlags, posixFlags, SocketNameResolutionFlags::DatagramService, NI_DGRAM);
+
+  if (remainingFlags != 0)
+    return FailOnError(status, socketNameFlags, "Unsupported socket name flags enumeration");
+
+  socketNameFlags = SocketNameResolutionFlags::Enum(posixFlags);
 }
 void TranslateToPosix(Status& status, SocketProtocol::Enum& socketProtocol)
 {
-  // TODO: Implement the rest of these
   switch (socketProtocol)
   {
+  case SocketProtocol::Ip:
+    socketProtocol = SocketProtocol::Enum(IPPROTO_IP);
+    break;
+  case SocketProtocol::Icmp:
+    socketProtocol = SocketProtocol::Enum(IPPROTO_ICMP);
+    break;
+  case SocketProtocol::Tcp:
+    socketProtocol = SocketProtocol::Enum(IPPROTO_TCP);
+    break;
+  case SocketProtocol::Udp:
+    socketProtocol = SocketProtocol::Enum(IPPROTO_UDP);
+    break;
+  case SocketProtocol::Ipv6:
+    socketProtocol = SocketProtocol::Enum(IPPROTO_IPV6);
+    break;
+  case SocketProtocol::IcmpV6:
+    socketProtocol = SocketProtocol::Enum(IPPROTO_ICMPV6);
+    break;
+  case SocketProtocol::Raw:
+    socketProtocol = SocketProtocol::Enum(IPPROTO_RAW);
+    break;
+
   default:
     return FailOnError(status, socketProtocol, "Unsupported socket protocol enumeration");
   }
 }
 void TranslateToPosix(Status& status, SocketFlags::Enum& socketFlags)
 {
-  // TODO: Implement the rest of these
-
   // Note: Winsock doesn't have an equivalent MSG_DONTWAIT flag which is
   // provided in most POSIX socket APIs
   //       So we're unable to represent MSG_DONTWAIT here until we expose a
   //       proper value for it in SocketFlags::Enum However, the behavior of
   //       MSG_DONTWAIT can easily be worked around by using Socket::SetBlocking
   //       when necessary
+  uint remainingFlags = socketFlags;
+  uint posixFlags = 0;
+
+  TranslateFlag(remainingFlags, posixFlags, SocketFlags::OutOfBand, MSG_OOB);
+  TranslateFlag(remainingFlags, posixFlags, SocketFlags::Peek, MSG_PEEK);
+  TranslateFlag(remainingFlags, posixFlags, SocketFlags::DontRoute, MSG_DONTROUTE);
+  TranslateFlag(remainingFlags, posixFlags, SocketFlags::WaitAll, MSG_WAITALL);
 
-  return FailOnError(status, socketFlags, "Unsupported socket flags enumeration");
+  if (remainingFlags != 0)
+    return FailOnError(status, socketFlags, "Unsupported socket flags enumeration");
+
+  socketFlags = SocketFlags::Enum(posixFlags);
 }
 void TranslateToPosix(Status& status, SocketType::Enum& socketType)
 {
-  // TODO: Implement the rest of these
   switch (socketType)
   {
+  case SocketType::Unspecified:
+    socketType = SocketType::Enum(0);
+    break;
+  case SocketType::Stream:
+    socketType = SocketType::Enum(SOCK_STREAM);
+    break;
+  case SocketType::Datagram:
+    socketType = SocketType::Enum(SOCK_DGRAM);
+    break;
+  case SocketType::RawDatagram:
+    socketType = SocketType::Enum(SOCK_RAW);
+    break;
+  case SocketType::StreamPacket:
+    socketType = SocketType::Enum(SOCK_SEQPACKET);
+    break;
+
   default:
     return FailOnError(status, socketType, "Unsupported socket type enumeration");
   }
@@ -1107,6 +1192,21 @@ bool Socket::IsCommonConnectError(int extendedErrorCode)
   }
 }
 
+bool Socket::IsWouldBlockError(int extendedErrorCode)
+{
+  switch (extendedErrorCode)
+  {
+  case EWOULDBLOCK:
+#if EAGAIN != EWOULDBLOCK
+  case EAGAIN:
+#endif
+    return true;
+
+  default:
+    return false;
+  }
+}
+
 bool Socket::IsSocketLibraryInitialized()
 {
   return gSocketLibrary.IsInitialized();
@@ -1373,7 +1473,7 @@ size_t Socket::Send(Status& status, const ::byte* data, size_t dataLength, Socke
   TRANSLATE_TO_PLATFORM_ENUM_OR_RETURN_FAILURE_VALUE(flags, 0);
 
   // Send data over socket to connected remote address
-  int result = send(CAST_HANDLE_TO_SOCKET(mHandle), (const char*)data, (int)dataLength, (int)flags);
+  int result = send(CAST_HANDLE_TO_SOCKET(mHandle), (const char*)data, (int)dataLength, (int)flags | cSendFlags);
   if (result == SOCKET_ERROR) // Unable?
   {
     FailOnLastError(status);
@@ -1396,7 +1496,7 @@ Socket::SendTo(Status& status, const ::byte* data, size_t dataLength, const Sock
   int result = sendto(CAST_HANDLE_TO_SOCKET(mHandle),
                       (const char*)data,
                       (int)dataLength,
-                      (int)flags,
+                      (int)flags | cSendFlags,
                       (SOCKET_ADDRESS_TYPE*)sockAddrStorage,
                       sockAddrLength);
   if (result == SOCKET_ERROR) // Unable?
@@ -21,6 +21,8 @@ target_sources(Platform
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Intrinsics.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/MainLoop.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Socket.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/../Empty/SocketPoller.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/../Empty/ThreadSampler.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Libgit2/Git.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../SDL/Audio.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../SDL/ExternalLibrary.cpp
@@ -25,7 +25,9 @@ target_sources(Platform
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Resolution.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Shell.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Socket.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/../Empty/SocketPoller.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Thread.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/../Empty/ThreadSampler.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/ThreadSync.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Timer.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/Utilities.cpp
@@ -342,4 +342,79 @@ void File::Duplicate(Status& status, File& destinationFile)
     WinReturnIfStatus(status);
 }
 
+// Mapped File
+MappedFile::MappedFile() : mData(nullptr), mSize(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+bool MappedFile::Open(Status& status, StringParam filePath)
+{
+  Close();
+
+  HANDLE file = ::CreateFileW(
+      Widen(filePath).c_str(), GENERIC_READ, FILE_SHARE_READ, NOSECURITY, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    FillWindowsErrorStatus(status);
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  size.QuadPart = 0;
+  ::GetFileSizeEx(file, &size);
+
+  // Empty files can't be mapped
+  if (size.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return true;
+  }
+
+  HANDLE mapping = ::CreateFileMappingW(file, NOSECURITY, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL)
+  {
+    FillWindowsErrorStatus(status);
+    CloseHandle(file);
+    return false;
+  }
+
+  void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view == nullptr)
+    FillWindowsErrorStatus(status);
+
+  // The view keeps the mapping and the file open
+  CloseHandle(mapping);
+  CloseHandle(file);
+
+  if (view == nullptr)
+    return false;
+
+  mData = (::byte*)view;
+  mSize = (size_t)size.QuadPart;
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (mData != nullptr)
+    ::UnmapViewOfFile(mData);
+
+  mData = nullptr;
+  mSize = 0;
+}
+
+void MappedFile::WillNeed(size_t offset, size_t sizeInBytes)
+{
+  // Pages are read when they're touched
+}
+
+void PrefetchFile(StringParam filePath)
+{
+}
+
 } // namespace Zero
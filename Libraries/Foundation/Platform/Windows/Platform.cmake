@@ -7,6 +7,7 @@ target_sources(Platform
   PRIVATE
     ${CMAKE_CURRENT_LIST_DIR}/../Curl/WebRequest.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Empty/MainLoop.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/../Empty/ThreadSampler.cpp
     ${CMAKE_CURRENT_LIST_DIR}/../Libgit2/Git.cpp
     ${CMAKE_CURRENT_LIST_DIR}/Atomic.cpp
     ${CMAKE_CURRENT_LIST_DIR}/Audio.cpp
@@ -33,6 +34,7 @@ target_sources(Platform
     ${CMAKE_CURRENT_LIST_DIR}/Resolution.cpp
     ${CMAKE_CURRENT_LIST_DIR}/Shell.cpp
     ${CMAKE_CURRENT_LIST_DIR}/Socket.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/SocketPoller.cpp
     ${CMAKE_CURRENT_LIST_DIR}/StackWalker.cpp
     ${CMAKE_CURRENT_LIST_DIR}/StackWalker.hpp
     ${CMAKE_CURRENT_LIST_DIR}/Thread.cpp
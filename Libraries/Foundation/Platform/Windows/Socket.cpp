@@ -986,6 +986,18 @@ bool Socket::IsCommonConnectError(int extendedErrorCode)
   }
 }
 
+bool Socket::IsWouldBlockError(int extendedErrorCode)
+{
+  switch (extendedErrorCode)
+  {
+  case WSAEWOULDBLOCK:
+    return true;
+
+  default:
+    return false;
+  }
+}
+
 bool Socket::IsSocketLibraryInitialized()
 {
   return gSocketLibrary.IsInitialized();
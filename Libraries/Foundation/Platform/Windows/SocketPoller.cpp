@@ -0,0 +1,222 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+// Windows has no epoll. WSAPoll takes the whole socket list on every call and
+// can't be woken when it changes, so waits are capped to pick up sockets added
+// or modified by other threads.
+const uint cMaxWSAPollWaitMs = 50;
+
+struct SocketPollerEntries
+{
+  ThreadLock mLock;
+  Array<WSAPOLLFD> mPollFds;
+  Array<void*> mUserData;
+};
+
+struct SocketPollerPrivateData
+{
+  SocketPollerPrivateData()
+  {
+    mEntries = nullptr;
+  }
+
+  SocketPollerEntries* mEntries;
+};
+
+SOCKET SocketFromHandle(const Socket& socket)
+{
+  return static_cast<SOCKET>(reinterpret_cast<size_t>(socket.mHandle));
+}
+
+SHORT TranslateToWSAPoll(SocketPollFlags::Type flags)
+{
+  // Hang ups and errors are always reported
+  SHORT events = 0;
+  if (flags & SocketPollFlags::Read)
+    events |= POLLRDNORM;
+  if (flags & SocketPollFlags::Write)
+    events |= POLLWRNORM;
+  return events;
+}
+
+SocketPollFlags::Type TranslateFromWSAPoll(SHORT events)
+{
+  SocketPollFlags::Type flags = SocketPollFlags::None;
+  if (events & POLLRDNORM)
+    flags |= SocketPollFlags::Read;
+  if (events & POLLWRNORM)
+    flags |= SocketPollFlags::Write;
+  if (events & (POLLHUP | POLLERR | POLLNVAL))
+    flags |= SocketPollFlags::Closed;
+  return flags;
+}
+
+size_t FindPollFd(SocketPollerEntries* entries, SOCKET socket)
+{
+  for (size_t i = 0; i < entries->mPollFds.Size(); ++i)
+  {
+    if (entries->mPollFds[i].fd == socket)
+      return i;
+  }
+  return Array<WSAPOLLFD>::InvalidIndex;
+}
+
+SocketPoller::SocketPoller()
+{
+  ZeroConstructPrivateData(SocketPollerPrivateData);
+}
+
+SocketPoller::~SocketPoller()
+{
+  Close();
+  ZeroDestructPrivateData(SocketPollerPrivateData);
+}
+
+bool SocketPoller::Open(Status& status)
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  if (self->mEntries == nullptr)
+    self->mEntries = new SocketPollerEntries();
+  return true;
+}
+
+void SocketPoller::Close()
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  SafeDelete(self->mEntries);
+}
+
+bool SocketPoller::IsOpen()
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  return self->mEntries != nullptr;
+}
+
+void SocketPoller::Add(Status& status, const Socket& socket, SocketPollFlags::Type flags, void* userData)
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  SocketPollerEntries* entries = self->mEntries;
+  if (entries == nullptr)
+  {
+    status.SetFailed("The socket poller is not open");
+    return;
+  }
+
+  WSAPOLLFD pollFd;
+  pollFd.fd = SocketFromHandle(socket);
+  pollFd.events = TranslateToWSAPoll(flags);
+  pollFd.revents = 0;
+
+  entries->mLock.Lock();
+  if (FindPollFd(entries, pollFd.fd) == Array<WSAPOLLFD>::InvalidIndex)
+  {
+    entries->mPollFds.PushBack(pollFd);
+    entries->mUserData.PushBack(userData);
+  }
+  else
+  {
+    status.SetFailed("The socket is already being polled");
+  }
+  entries->mLock.Unlock();
+}
+
+void SocketPoller::Modify(Status& status, const Socket& socket, SocketPollFlags::Type flags, void* userData)
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  SocketPollerEntries* entries = self->mEntries;
+  if (entries == nullptr)
+  {
+    status.SetFailed("The socket poller is not open");
+    return;
+  }
+
+  entries->mLock.Lock();
+  size_t index = FindPollFd(entries, SocketFromHandle(socket));
+  if (index != Array<WSAPOLLFD>::InvalidIndex)
+  {
+    entries->mPollFds[index].events = TranslateToWSAPoll(flags);
+    entries->mUserData[index] = userData;
+  }
+  else
+  {
+    status.SetFailed("The socket is not being polled");
+  }
+  entries->mLock.Unlock();
+}
+
+void SocketPoller::Remove(Status& status, const Socket& socket)
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  SocketPollerEntries* entries = self->mEntries;
+  if (entries == nullptr)
+  {
+    status.SetFailed("The socket poller is not open");
+    return;
+  }
+
+  entries->mLock.Lock();
+  size_t index = FindPollFd(entries, SocketFromHandle(socket));
+  if (index != Array<WSAPOLLFD>::InvalidIndex)
+  {
+    entries->mPollFds.EraseAt(index);
+    entries->mUserData.EraseAt(index);
+  }
+  else
+  {
+    status.SetFailed("The socket is not being polled");
+  }
+  entries->mLock.Unlock();
+}
+
+size_t SocketPoller::Wait(Status& status, SocketPollResult* results, size_t maxResults, uint timeoutMs)
+{
+  ZeroGetPrivateData(SocketPollerPrivateData);
+  SocketPollerEntries* entries = self->mEntries;
+  if (entries == nullptr)
+  {
+    status.SetFailed("The socket poller is not open");
+    return 0;
+  }
+
+  // The list is copied so sockets can change while this thread waits
+  Array<WSAPOLLFD> pollFds;
+  Array<void*> userData;
+  entries->mLock.Lock();
+  pollFds = entries->mPollFds;
+  userData = entries->mUserData;
+  entries->mLock.Unlock();
+
+  uint waitMs = Math::Min(timeoutMs, cMaxWSAPollWaitMs);
+
+  // WSAPoll fails without any sockets
+  if (pollFds.Empty())
+  {
+    Os::Sleep(waitMs);
+    return 0;
+  }
+
+  int count = WSAPoll(pollFds.Data(), (ULONG)pollFds.Size(), (INT)waitMs);
+  if (count == SOCKET_ERROR)
+  {
+    int errorCode = WSAGetLastError();
+    status.SetFailed(String::Format("Failed to wait on polled sockets (error %d)", errorCode), errorCode);
+    return 0;
+  }
+
+  size_t resultCount = 0;
+  for (size_t i = 0; i < pollFds.Size() && resultCount < maxResults; ++i)
+  {
+    if (pollFds[i].revents == 0)
+      continue;
+
+    results[resultCount].mUserData = userData[i];
+    results[resultCount].mFlags = TranslateFromWSAPoll(pollFds[i].revents);
+    ++resultCount;
+  }
+  return resultCount;
+}
+
+} // namespace Zero
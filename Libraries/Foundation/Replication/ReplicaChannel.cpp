@@ -4,6 +4,338 @@
 namespace Zero
 {
 
+//                           ReplicaChannelSnapshot //
+
+/// Slot offsets are aligned to the largest primitive member type
+static const size_t cSnapshotSlotAlignment = sizeof(uint64);
+
+/// (Arithmetic property type behavior)
+template <typename PropertyType, TF_ENABLE_IF(IsBasicNativeTypeArithmetic<PropertyType>::Value)>
+void GatherSnapshotValueArithmetic(const Variant& value, ::byte* destination)
+{
+  // Primitive member info
+  typedef typename BasicNativeTypePrimitiveMembers<PropertyType>::Type PrimitiveType;
+  static const size_t PrimitiveCount = BasicNativeTypePrimitiveMembers<PropertyType>::Count;
+
+  // Copy each primitive member
+  PrimitiveType* primitiveMembers = reinterpret_cast<PrimitiveType*>(destination);
+  for (size_t i = 0; i < PrimitiveCount; ++i)
+    primitiveMembers[i] = value.GetPrimitiveMemberOrError<PropertyType>(i);
+}
+
+/// (Arithmetic property type behavior)
+template <typename PropertyType, TF_ENABLE_IF(IsBasicNativeTypeArithmetic<PropertyType>::Value)>
+bool CompareSnapshotValueArithmetic(const ::byte* currentValue, const ::byte* lastValue, const ::byte* deltaThreshold)
+{
+  // Primitive member info
+  typedef typename BasicNativeTypePrimitiveMembers<PropertyType>::Type PrimitiveType;
+  static const size_t PrimitiveCount = BasicNativeTypePrimitiveMembers<PropertyType>::Count;
+
+  const PrimitiveType* currentPrimitiveMembers = reinterpret_cast<const PrimitiveType*>(currentValue);
+  const PrimitiveType* lastPrimitiveMembers = reinterpret_cast<const PrimitiveType*>(lastValue);
+  const PrimitiveType* deltaThresholdPrimitiveMembers = reinterpret_cast<const PrimitiveType*>(deltaThreshold);
+
+  // Any current value and last value primitive members differ by more than the
+  // delta threshold value primitive member?
+  // (Every primitive member is checked without branching so the loop can be
+  // vectorized)
+  bool hasChanged = false;
+  for (size_t i = 0; i < PrimitiveCount; ++i)
+    hasChanged |= (Math::Abs(currentPrimitiveMembers[i] - lastPrimitiveMembers[i]) >
+                   deltaThresholdPrimitiveMembers[i]);
+
+  return hasChanged;
+}
+
+/// (Floating point property type behavior)
+template <typename PropertyType, TF_ENABLE_IF(IsBasicNativeTypeFloatingPoint<PropertyType>::Value)>
+bool CompareSnapshotValueExact(const ::byte* currentValue, const ::byte* lastValue, const ::byte* deltaThreshold)
+{
+  // Primitive member info
+  typedef typename BasicNativeTypePrimitiveMembers<PropertyType>::Type PrimitiveType;
+  static const size_t PrimitiveCount = BasicNativeTypePrimitiveMembers<PropertyType>::Count;
+
+  const PrimitiveType* currentPrimitiveMembers = reinterpret_cast<const PrimitiveType*>(currentValue);
+  const PrimitiveType* lastPrimitiveMembers = reinterpret_cast<const PrimitiveType*>(lastValue);
+
+  // Any current value and last value primitive members differ?
+  // (Compared as values rather than bytes, same as the variant comparison, so
+  // -0 equals 0 and NaN never equals itself)
+  bool hasChanged = false;
+  for (size_t i = 0; i < PrimitiveCount; ++i)
+    hasChanged |= (currentPrimitiveMembers[i] != lastPrimitiveMembers[i]);
+
+  return hasChanged;
+}
+
+/// Returns the typed exact comparison for floating point values
+/// (Floating point property type behavior)
+template <typename PropertyType, TF_ENABLE_IF(IsBasicNativeTypeFloatingPoint<PropertyType>::Value)>
+ReplicaChannelSnapshot::CompareFn GetSnapshotExactCompareFn()
+{
+  return CompareSnapshotValueExact<PropertyType>;
+}
+/// Returns null, integral values are compared exactly with memcmp
+/// (Integral property type behavior)
+template <typename PropertyType, TF_DISABLE_IF(IsBasicNativeTypeFloatingPoint<PropertyType>::Value)>
+ReplicaChannelSnapshot::CompareFn GetSnapshotExactCompareFn()
+{
+  return nullptr;
+}
+
+/// (Arithmetic property type behavior)
+template <typename PropertyType, TF_ENABLE_IF(IsBasicNativeTypeArithmetic<PropertyType>::Value)>
+void InitializeSnapshotSlotArithmetic(ReplicaChannelSnapshot::Slot& slot, bool useDeltaThreshold)
+{
+  // Primitive member info
+  typedef typename BasicNativeTypePrimitiveMembers<PropertyType>::Type PrimitiveType;
+  static const size_t PrimitiveCount = BasicNativeTypePrimitiveMembers<PropertyType>::Count;
+
+  slot.mSize = sizeof(PrimitiveType) * PrimitiveCount;
+  slot.mGatherFn = GatherSnapshotValueArithmetic<PropertyType>;
+
+  // (Only integral values can be compared exactly as bytes)
+  if (useDeltaThreshold)
+    slot.mCompareFn = CompareSnapshotValueArithmetic<PropertyType>;
+  else
+    slot.mCompareFn = GetSnapshotExactCompareFn<PropertyType>();
+}
+
+/// Fills in the slot's layout for the replica property's type
+/// Returns true if the replica property can be snapshotted, else false
+bool InitializeSnapshotSlot(ReplicaChannelSnapshot::Slot& slot, const ReplicaPropertyType* replicaPropertyType)
+{
+  bool useDeltaThreshold = replicaPropertyType->GetUseDeltaThreshold();
+
+  // Switch on property's native type
+  switch (replicaPropertyType->GetNativeTypeId())
+  {
+  // Other Types
+  default:
+    return false;
+
+    // Non-Boolean Arithmetic Types
+    SWITCH_CASES_NON_BOOL_ARITHMETIC_CALL_AND_BREAK(InitializeSnapshotSlotArithmetic, slot, useDeltaThreshold);
+  }
+
+  return true;
+}
+
+ReplicaChannelSnapshot::ReplicaChannelSnapshot() :
+    mSlots(),
+    mExactSize(0),
+    mCurrentValues(),
+    mLastValues(),
+    mDeltaThreshold(),
+    mDirtyBits(),
+    mIsBuilt(false),
+    mIsCurrent(false)
+{
+}
+
+bool ReplicaChannelSnapshot::IsBuilt() const
+{
+  return mIsBuilt;
+}
+
+void ReplicaChannelSnapshot::Build(const ReplicaPropertySet& replicaProperties)
+{
+  Clear();
+
+  // Lay out slots compared as bytes first, then slots using a typed comparison
+  size_t size = 0;
+  for (uint pass = 0; pass < 2; ++pass)
+  {
+    bool useCompareFn = (pass == 1);
+
+    // For all replica properties
+    forRange (ReplicaProperty* replicaProperty, replicaProperties.All())
+    {
+      // Unable to snapshot this type?
+      ReplicaPropertyType* replicaPropertyType = replicaProperty->GetReplicaPropertyType();
+      Slot slot;
+      if (!InitializeSnapshotSlot(slot, replicaPropertyType))
+        continue;
+
+      // Not this pass's comparison?
+      if ((slot.mCompareFn != nullptr) != useCompareFn)
+        continue;
+
+      // (The gatherer copies the whole value, so it's only usable when the
+      // value is exactly it's primitive members)
+      slot.mGatherValueFn = nullptr;
+      if (replicaPropertyType->GetNativeType()->mTypeSize == slot.mSize)
+        slot.mGatherValueFn = replicaPropertyType->GetGatherValueFn();
+
+      slot.mReplicaProperty = replicaProperty;
+      slot.mOffset = size;
+      slot.mHasLastValue = false;
+      size += (slot.mSize + cSnapshotSlotAlignment - 1) / cSnapshotSlotAlignment * cSnapshotSlotAlignment;
+
+      replicaProperty->mSnapshotIndex = mSlots.Size();
+      mSlots.PushBack(slot);
+    }
+
+    if (!useCompareFn)
+      mExactSize = size;
+  }
+
+  // (Padding is zeroed in both buffers so it never differs)
+  mCurrentValues.Resize(size, ::byte(0));
+  mLastValues.Resize(size, ::byte(0));
+  mDeltaThreshold.Resize(size, ::byte(0));
+  mDirtyBits.Resize((mSlots.Size() + 63) / 64, uint64(0));
+
+  // Copy the fixed delta thresholds and any existing last values
+  forRange (Slot& slot, mSlots.All())
+  {
+    ReplicaProperty* replicaProperty = slot.mReplicaProperty;
+    if (replicaProperty->GetReplicaPropertyType()->GetUseDeltaThreshold())
+    {
+      const Variant& deltaThreshold = replicaProperty->GetReplicaPropertyType()->GetDeltaThreshold();
+      slot.mGatherFn(deltaThreshold, mDeltaThreshold.Data() + slot.mOffset);
+    }
+
+    SetLastValue(replicaProperty->mSnapshotIndex, replicaProperty->GetLastValue());
+  }
+
+  mIsBuilt = true;
+}
+
+void ReplicaChannelSnapshot::Clear()
+{
+  // Unlink replica properties from their slots
+  forRange (Slot& slot, mSlots.All())
+    slot.mReplicaProperty->mSnapshotIndex = cInvalidSnapshotIndex;
+
+  mSlots.Clear();
+  mExactSize = 0;
+  mCurrentValues.Clear();
+  mLastValues.Clear();
+  mDeltaThreshold.Clear();
+  mDirtyBits.Clear();
+  mIsBuilt = false;
+  mIsCurrent = false;
+}
+
+bool ReplicaChannelSnapshot::Observe()
+{
+  ::byte* currentValues = mCurrentValues.Data();
+  const ::byte* lastValues = mLastValues.Data();
+  const ::byte* deltaThreshold = mDeltaThreshold.Data();
+
+  // Clear dirty bits
+  forRange (uint64& dirtyBits, mDirtyBits.All())
+    dirtyBits = 0;
+
+  // Gather current values
+  bool anyChanged = false;
+  for (size_t i = 0; i < mSlots.Size(); ++i)
+  {
+    Slot& slot = mSlots[i];
+    ReplicaProperty* replicaProperty = slot.mReplicaProperty;
+
+    // Copy the current value straight from the property?
+    if (slot.mGatherValueFn)
+    {
+      // (Unable to get the current value? Then it's our last value)
+      NativeType* nativeType = replicaProperty->GetReplicaPropertyType()->GetNativeType();
+      if (!slot.mGatherValueFn(replicaProperty->GetPropertyData(), nativeType, currentValues + slot.mOffset))
+      {
+        memcpy(currentValues + slot.mOffset, lastValues + slot.mOffset, slot.mSize);
+        continue;
+      }
+    }
+    else
+    {
+      // (Unable to get the current value? Then it's our last value)
+      Variant currentValue = replicaProperty->GetValue();
+      if (currentValue.IsEmpty())
+      {
+        memcpy(currentValues + slot.mOffset, lastValues + slot.mOffset, slot.mSize);
+        continue;
+      }
+
+      slot.mGatherFn(currentValue, currentValues + slot.mOffset);
+    }
+
+    // There is no last value to compare against?
+    if (!slot.mHasLastValue)
+    {
+      // Has changed
+      mDirtyBits[i / 64] |= (uint64(1) << (i % 64));
+      anyChanged = true;
+    }
+  }
+
+  // Any slot compared as bytes has changed?
+  // (Usually nothing has, which only costs a single memcmp of the leading
+  // buffer region)
+  if (mExactSize != 0 && memcmp(currentValues, lastValues, mExactSize) != 0)
+  {
+    // Find the slots that have changed
+    for (size_t i = 0; i < mSlots.Size(); ++i)
+    {
+      const Slot& slot = mSlots[i];
+      if (slot.mOffset >= mExactSize)
+        break;
+
+      if (memcmp(currentValues + slot.mOffset, lastValues + slot.mOffset, slot.mSize) != 0)
+      {
+        mDirtyBits[i / 64] |= (uint64(1) << (i % 64));
+        anyChanged = true;
+      }
+    }
+  }
+
+  // Compare slots using delta thresholds or floating point comparisons
+  for (size_t i = 0; i < mSlots.Size(); ++i)
+  {
+    const Slot& slot = mSlots[i];
+    if (!slot.mCompareFn)
+      continue;
+
+    if (slot.mCompareFn(currentValues + slot.mOffset, lastValues + slot.mOffset, deltaThreshold + slot.mOffset))
+    {
+      mDirtyBits[i / 64] |= (uint64(1) << (i % 64));
+      anyChanged = true;
+    }
+  }
+
+  mIsCurrent = true;
+  return anyChanged;
+}
+
+bool ReplicaChannelSnapshot::IsCurrent() const
+{
+  return mIsCurrent;
+}
+void ReplicaChannelSnapshot::Invalidate()
+{
+  mIsCurrent = false;
+}
+
+bool ReplicaChannelSnapshot::IsDirty(size_t slotIndex) const
+{
+  Assert(slotIndex < mSlots.Size());
+  return (mDirtyBits[slotIndex / 64] & (uint64(1) << (slotIndex % 64))) != 0;
+}
+
+void ReplicaChannelSnapshot::SetLastValue(size_t slotIndex, const Variant& lastValue)
+{
+  Slot& slot = mSlots[slotIndex];
+
+  // Copy last value
+  slot.mHasLastValue = lastValue.IsNotEmpty();
+  if (slot.mHasLastValue)
+    slot.mGatherFn(lastValue, mLastValues.Data() + slot.mOffset);
+  else
+    memset(mLastValues.Data() + slot.mOffset, 0, slot.mSize);
+
+  // Dirty bits were found against the previous last value
+  Invalidate();
+}
+
 //                               ReplicaChannel //
 
 ReplicaChannel::ReplicaChannel(const String& name, ReplicaChannelType* replicaChannelType) :
@@ -17,7 +349,8 @@ ReplicaChannel::ReplicaChannel(const String& name, ReplicaChannelType* replicaCh
     mLastChangeTimestamp(cInvalidMessageTimestamp),
     mLastChangeFrameId(0),
     mAuthority(Authority::Server),
-    mReplicaProperties()
+    mReplicaProperties(),
+    mSnapshot()
 {
   // Replica channel type provided?
   if (replicaChannelType)
@@ -249,12 +582,19 @@ bool ReplicaChannel::ObserveAndReplicateChanges(
     // Set last change detected frame ID
     SetLastChangeFrameId(frameId);
 
+    // (Notifications raised while reacting may modify property values, so the
+    // observed changes are only trusted until now)
+    mSnapshot.Invalidate();
+
     // Handle changed replica channel property values
     ReactToPropertyChanges(timestamp, ReplicationPhase::Change, TransmissionDirection::Outgoing);
   }
   // No change detected?
   else
   {
+    // (Property values may be modified before the next observation)
+    mSnapshot.Invalidate();
+
     // Is awake?
     if (IsAwake())
     {
@@ -378,6 +718,9 @@ ReplicaProperty* ReplicaChannel::AddReplicaProperty(ReplicaPropertyPtr replicaPr
   // added to us
   (*result.first)->SetReplicaChannel(this);
 
+  // Rebuild snapshot when next observed
+  mSnapshot.Clear();
+
   // Success
   return (*result.first);
 }
@@ -392,6 +735,9 @@ bool ReplicaChannel::RemoveReplicaProperty(const String& replicaPropertyName)
     return false;
   }
 
+  // Rebuild snapshot when next observed
+  mSnapshot.Clear();
+
   // Remove replica property
   ReplicaPropertySet::pointer_bool_pair result = mReplicaProperties.EraseValue(replicaPropertyName);
   return result.second;
@@ -409,6 +755,7 @@ void ReplicaChannel::ClearReplicaProperties()
   }
 
   // Remove all replica properties
+  mSnapshot.Clear();
   mReplicaProperties.Clear();
 }
 
@@ -435,16 +782,27 @@ bool ReplicaChannel::ObserveForChange()
   // Get replica channel type
   ReplicaChannelType* replicaChannelType = GetReplicaChannelType();
 
-  // For all replica properties
-  bool propertyChanged = false;
+  // Snapshot not yet built?
+  if (!mSnapshot.IsBuilt())
+    mSnapshot.Build(GetReplicaProperties());
+
+  // Observe all arithmetic replica properties at once
+  // (Their dirty bits are then used by HasChanged until invalidated)
+  bool propertyChanged = mSnapshot.Observe();
+
+  // For all other replica properties (unless a change was already found)
   forRange (ReplicaProperty* replicaProperty, GetReplicaProperties().All())
   {
+    if (propertyChanged)
+      break;
+
+    // Already observed?
+    if (replicaProperty->mSnapshotIndex != cInvalidSnapshotIndex)
+      continue;
+
     // Property has changed?
     if (replicaProperty->HasChanged())
-    {
       propertyChanged = true;
-      break;
-    }
   }
 
   // Channel has changed?
@@ -468,6 +826,15 @@ bool ReplicaChannel::ObserveForChange()
   }
 }
 
+const ReplicaChannelSnapshot& ReplicaChannel::GetSnapshot() const
+{
+  return mSnapshot;
+}
+ReplicaChannelSnapshot& ReplicaChannel::GetSnapshot()
+{
+  return mSnapshot;
+}
+
 bool ReplicaChannel::Serialize(BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp) const
 {
   // Get replica channel type
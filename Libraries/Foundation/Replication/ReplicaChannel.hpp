@@ -4,6 +4,76 @@
 namespace Zero
 {
 
+//                           ReplicaChannelSnapshot //
+
+/// Replica Channel Snapshot
+/// Typed copies of the current and last values of a replica channel's
+/// arithmetic replica properties, laid out contiguously so change detection
+/// compares flat buffers instead of variants
+/// (Current values are gathered with the property type's gatherer when it has
+/// one, else through the property getter's variant)
+/// (Properties of any other type keep using variant comparisons)
+class ReplicaChannelSnapshot
+{
+public:
+  /// Typedefs
+  typedef void (*GatherFn)(const Variant& value, ::byte* destination);
+  typedef bool (*CompareFn)(const ::byte* currentValue, const ::byte* lastValue, const ::byte* deltaThreshold);
+
+  /// Snapshot slot (one per arithmetic replica property)
+  struct Slot
+  {
+    ReplicaProperty* mReplicaProperty; /// Operating replica property
+    size_t mOffset;                    /// Byte offset of the primitive members in each buffer
+    size_t mSize;                      /// Byte size of the primitive members
+    GatherFn mGatherFn;                /// Copies a value's primitive members into a buffer
+    GatherValueFn mGatherValueFn;      /// Copies the current value straight into a buffer (null if gathered from a variant)
+    CompareFn mCompareFn;              /// Delta threshold or floating point comparison (null if compared as bytes)
+    bool mHasLastValue;                /// Does the last value buffer hold a value?
+  };
+
+  /// Constructor
+  ReplicaChannelSnapshot();
+
+  /// Returns true if the slots have been built, else false
+  bool IsBuilt() const;
+
+  /// Builds a slot for every arithmetic replica property
+  /// (Integral slots with exact comparisons are placed before the rest so the
+  /// former can be compared with a single memcmp)
+  void Build(const ReplicaPropertySet& replicaProperties);
+
+  /// Removes all slots (they're rebuilt when next observed)
+  void Clear();
+
+  /// Gathers every slot's current value and compares it against it's last
+  /// value, rebuilding the dirty bits
+  /// Returns true if any slot has changed, else false
+  bool Observe();
+
+  /// Returns true if the dirty bits reflect the latest observation, else false
+  bool IsCurrent() const;
+  /// Marks the dirty bits as out of date
+  void Invalidate();
+
+  /// Returns true if the specified slot changed during the latest observation,
+  /// else false
+  bool IsDirty(size_t slotIndex) const;
+
+  /// Copies the replica property's new last value into the specified slot
+  void SetLastValue(size_t slotIndex, const Variant& lastValue);
+
+  /// Data
+  Array<Slot> mSlots;            /// Snapshot slots
+  size_t mExactSize;             /// Byte size of the leading slots compared as bytes
+  Array<::byte> mCurrentValues;  /// Primitive members of the current values
+  Array<::byte> mLastValues;     /// Primitive members of the last values
+  Array<::byte> mDeltaThreshold; /// Primitive members of the delta thresholds
+  Array<uint64> mDirtyBits;      /// One bit per slot, set if changed during the latest observation
+  bool mIsBuilt;                 /// Have the slots been built?
+  bool mIsCurrent;               /// Do the dirty bits reflect the latest observation?
+};
+
 //                               ReplicaChannel //
 
 /// Replica Channel
@@ -161,6 +231,10 @@ public:
   /// Returns true if a change was detected, else false
   bool ObserveForChange();
 
+  /// Typed snapshot of the arithmetic replica property values
+  const ReplicaChannelSnapshot& GetSnapshot() const;
+  ReplicaChannelSnapshot& GetSnapshot();
+
   /// Serializes the replica channel
   /// Returns true if successful, else false
   bool Serialize(BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp) const;
@@ -181,6 +255,7 @@ public:
   uint64 mLastChangeFrameId;               /// Frame ID of the last detected change
   Authority::Enum mAuthority;              /// Change authority
   ReplicaPropertySet mReplicaProperties;   /// Replica properties
+  ReplicaChannelSnapshot mSnapshot;        /// Arithmetic replica property snapshot
 };
 
 /// Typedefs
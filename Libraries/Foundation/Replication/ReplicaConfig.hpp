@@ -164,6 +164,10 @@ typedef UintN<ReplicaTypeIdBits> ReplicaTypeId;
 static const Bits EmplaceContextIdBits = EMPLACE_CONTEXT_ID_BITS;
 typedef UintN<EmplaceContextIdBits> EmplaceContextId;
 
+/// Replica Channel Snapshot Index
+/// Identifies a replica property's slot in it's replica channel's snapshot
+static const size_t cInvalidSnapshotIndex = size_t(-1);
+
 //                             Property Functions //
 
 /// Property Serializer
@@ -175,6 +179,12 @@ typedef Bits (*SerializeValueFn)(SerializeDirection::Enum direction, BitStream&
 /// Returns the current property value
 typedef Variant (*GetValueFn)(const Variant& propertyData);
 
+/// Property Gatherer
+/// Copies the current property value, which is of the specified native type,
+/// into the destination without going through a variant
+/// Returns true if successful, else false
+typedef bool (*GatherValueFn)(const Variant& propertyData, NativeType* nativeType, ::byte* destination);
+
 /// Property Setter
 /// Sets the current property value
 typedef void (*SetValueFn)(const Variant& value, Variant& propertyData);
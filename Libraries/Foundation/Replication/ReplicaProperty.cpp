@@ -72,6 +72,7 @@ ReplicaProperty::ReplicaProperty(const String& name,
     mIndexListSize(nullptr),
     mPropertyData(propertyData),
     mLastValue(),
+    mSnapshotIndex(cInvalidSnapshotIndex),
     mLastChangeTimestamp(cInvalidMessageTimestamp),
     mLastReceivedChangeValue(),
     mLastReceivedChangeTimestamp(cInvalidMessageTimestamp),
@@ -266,6 +267,14 @@ bool HasChangedArithmetic(const ReplicaProperty* replicaProperty, const ReplicaP
 
 bool ReplicaProperty::HasChanged() const
 {
+  // Replica channel snapshot has just observed this replica property?
+  ReplicaChannel* replicaChannel = GetReplicaChannel();
+  if (mSnapshotIndex != cInvalidSnapshotIndex && replicaChannel && replicaChannel->GetSnapshot().IsCurrent())
+  {
+    // Use the observed result
+    return replicaChannel->GetSnapshot().IsDirty(mSnapshotIndex);
+  }
+
   // Get replica property type
   ReplicaPropertyType* replicaPropertyType = GetReplicaPropertyType();
 
@@ -299,6 +308,10 @@ void ReplicaProperty::SetValue(const Variant& value)
 
   // Set current property value
   mReplicaPropertyType->GetSetValueFn()(value, mPropertyData);
+
+  // Replica channel snapshot no longer reflects the current value
+  if (mSnapshotIndex != cInvalidSnapshotIndex)
+    GetReplicaChannel()->GetSnapshot().Invalidate();
 }
 Variant ReplicaProperty::GetValue() const
 {
@@ -322,6 +335,10 @@ const Variant& ReplicaProperty::GetPropertyData() const
 void ReplicaProperty::SetLastValue(MoveReference<Variant> value)
 {
   mLastValue = ZeroMove(value);
+
+  // Keep the replica channel snapshot's copy of our last value in sync
+  if (mSnapshotIndex != cInvalidSnapshotIndex)
+    GetReplicaChannel()->GetSnapshot().SetLastValue(mSnapshotIndex, mLastValue);
 }
 const Variant& ReplicaProperty::GetLastValue() const
 {
@@ -1908,6 +1925,7 @@ ReplicaPropertyType::ReplicaPropertyType(const String& name,
     mSerializeValueFn(serializeValueFn),
     mGetValueFn(getValueFn),
     mSetValueFn(setValueFn),
+    mGatherValueFn(nullptr),
     mReplicator(nullptr)
 {
   ResetConfig();
@@ -1973,6 +1991,15 @@ SetValueFn ReplicaPropertyType::GetSetValueFn() const
   return mSetValueFn;
 }
 
+void ReplicaPropertyType::SetGatherValueFn(GatherValueFn gatherValueFn)
+{
+  mGatherValueFn = gatherValueFn;
+}
+GatherValueFn ReplicaPropertyType::GetGatherValueFn() const
+{
+  return mGatherValueFn;
+}
+
 bool ReplicaPropertyType::IsValid() const
 {
   return (GetReplicator() != nullptr);
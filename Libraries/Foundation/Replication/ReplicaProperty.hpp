@@ -161,6 +161,7 @@ public:
   size_t* mIndexListSize;                    /// Replica property index list size (may be null)
   Variant mPropertyData;                     /// Property data interpreted by the user
   Variant mLastValue;                        /// Last observed property value
+  size_t mSnapshotIndex;                     /// Replica channel snapshot slot (may be invalid)
   TimeMs mLastChangeTimestamp;               /// Timestamp indicating when this replica property
                                              /// was last changed (on any primitive member)
   Variant mLastReceivedChangeValue;          /// Last received property change value
@@ -271,6 +272,11 @@ public:
   /// Property value setter function
   SetValueFn GetSetValueFn() const;
 
+  /// Property value gatherer function (Optional, used by replica channel
+  /// snapshots in place of the getter)
+  void SetGatherValueFn(GatherValueFn gatherValueFn);
+  GatherValueFn GetGatherValueFn() const;
+
   /// Returns true if the replica property type is valid (registered with the
   /// replicator), else false
   bool IsValid() const;
@@ -444,6 +450,7 @@ public:
   SerializeValueFn mSerializeValueFn;         /// Property value serializer function
   GetValueFn mGetValueFn;                     /// Property value getter function
   SetValueFn mSetValueFn;                     /// Property value setter function
+  GatherValueFn mGatherValueFn;               /// Property value gatherer function (Optional)
   Replicator* mReplicator;                    /// Operating replicator
   ReplicaPropertyIndex mActivePropertyIndex;  /// Active replica properties index
   ReplicaPropertyIndex mRestingPropertyIndex; /// Resting replica properties index
@@ -11,7 +11,14 @@ bool DataTreeParser::BuildTree(DataTreeContext& context, StringRange data, DataN
   return parser.Parse(data, fileRoot);
 }
 
-DataTreeParser::DataTreeParser(DataTreeContext& context) : mLastPoppedNode(nullptr), mCurrentIndex(0), mContext(context)
+DataTreeParser::DataTreeParser(DataTreeContext& context) :
+    mLastPoppedNode(nullptr),
+    mCurrentIndex(0),
+    mContext(context),
+    mIntegerTypeName(Serialization::Trait<int>::TypeName()),
+    mHexTypeName(Serialization::Trait<u64>::TypeName()),
+    mFloatTypeName(Serialization::Trait<float>::TypeName()),
+    mBooleanTypeName(Serialization::Trait<bool>::TypeName())
 {
 }
 
@@ -76,7 +83,7 @@ bool DataTreeParser::Object()
   DataNode* node = CreateNewNode(DataNodeType::Object);
 
   // Set the typename of the node
-  node->mTypeName = GetLastAcceptedToken().mText;
+  node->mTypeName = InternText(GetLastAcceptedToken().mText);
 
   // Any amount of attributes can follow the type name
   while (Attribute())
@@ -125,7 +132,7 @@ bool DataTreeParser::Attribute()
 
   Expect(DataTokenType::Identifier, "Attributes must have an identifier after '['");
 
-  StringRange attributeName = GetLastAcceptedToken().mText;
+  String attributeName = InternText(GetLastAcceptedToken().mText);
   StringRange attributeValue;
 
   // Optionally accept an attribute value
@@ -191,7 +198,7 @@ bool DataTreeParser::Property()
 
   Expect(DataTokenType::Identifier, "Incomplete property. An identifier must come after 'var' ");
 
-  String propertyName = GetLastAcceptedToken().mText;
+  String propertyName = InternText(GetLastAcceptedToken().mText);
 
   Expect(DataTokenType::Assignment, "A property must be assigned a value with '='");
 
@@ -260,65 +267,76 @@ bool DataTreeParser::AcceptValue(bool createNode, DataTokenType::Enum tokenType)
   DataNode* node = CreateNewNode(DataNodeType::Value);
   DataToken& token = GetLastAcceptedToken();
 
-  node->mTextValue = token.mText;
-
   // Integer
   if (token.mType == DataTokenType::Integer)
   {
-    node->mTypeName = Serialization::Trait<int>::TypeName();
+    node->mTypeName = mIntegerTypeName;
+    node->mTextValue = InternText(token.mText);
   }
   // Hex
   else if (token.mType == DataTokenType::Hex)
   {
-    node->mTypeName = Serialization::Trait<u64>::TypeName();
+    // Hex values are mostly unique ids, so they aren't interned
+    node->mTypeName = mHexTypeName;
+    node->mTextValue = token.mText;
   }
   // Float
   else if (token.mType == DataTokenType::Float)
   {
-    node->mTypeName = Serialization::Trait<float>::TypeName();
+    node->mTypeName = mFloatTypeName;
+    node->mTextValue = InternText(token.mText);
   }
   // Boolean
   else if (token.mType == DataTokenType::True || token.mType == DataTokenType::False)
   {
-    node->mTypeName = Serialization::Trait<bool>::TypeName();
+    node->mTypeName = mBooleanTypeName;
+    node->mTextValue = InternText(token.mText);
   }
   else if (token.mType == DataTokenType::StringLiteral)
   {
     node->mTypeName = ZilchTypeId(String)->Name;
 
-    StringBuilder builder;
+    // Most strings have nothing escaped and can be used as is
     StringRange text = token.mText;
-
-    // Remove all escaped slashes and quotes that were added when saved
-    while (!text.Empty())
+    if (memchr(text.Data(), '\\', text.SizeInBytes()) == nullptr)
+    {
+      node->mTextValue = text;
+    }
+    else
     {
-      Rune rune = text.Front();
+      StringBuilder builder;
 
-      // We escaped all slashes when saving, so we need to remove them
-      if (rune == '\\')
+      // Remove all escaped slashes and quotes that were added when saved
+      while (!text.Empty())
       {
-        text.PopFront();
+        Rune rune = text.Front();
 
-        // Temporary solution, only do this extra step if the next character is
-        // either a slash or a quote (the special case we're trying to solve
-        // here) If we updated all text files, this check would not be needed
-        Rune next = text.Front();
-        if (next == '\\' || next == '\"')
-        {
-          rune = next;
-        }
-        else
+        // We escaped all slashes when saving, so we need to remove them
+        if (rune == '\\')
         {
-          builder.Append(rune);
-          rune = next;
+          text.PopFront();
+
+          // Temporary solution, only do this extra step if the next character is
+          // either a slash or a quote (the special case we're trying to solve
+          // here) If we updated all text files, this check would not be needed
+          Rune next = text.Front();
+          if (next == '\\' || next == '\"')
+          {
+            rune = next;
+          }
+          else
+          {
+            builder.Append(rune);
+            rune = next;
+          }
         }
+
+        builder.Append(rune);
+        text.PopFront();
       }
 
-      builder.Append(rune);
-      text.PopFront();
+      node->mTextValue = builder.ToString();
     }
-
-    node->mTextValue = builder.ToString();
   }
   // Enum
   else if (token.mType == DataTokenType::Enumeration)
@@ -326,9 +344,9 @@ bool DataTreeParser::AcceptValue(bool createNode, DataTokenType::Enum tokenType)
     // The enum comes in as 'Type.Value' (ie. 'LightType.PointLight'), so we
     // need to separate the type name from the value
     StringTokenRange r(token.mText, '.');
-    node->mTypeName = r.Front();
+    node->mTypeName = InternText(r.Front());
     r.PopFront();
-    node->mTextValue = r.Front();
+    node->mTextValue = InternText(r.Front());
     node->mFlags.SetFlag(DataNodeFlags::Enumeration);
   }
 
@@ -337,6 +355,17 @@ bool DataTreeParser::AcceptValue(bool createNode, DataTokenType::Enum tokenType)
   return true;
 }
 
+String DataTreeParser::InternText(StringRange text)
+{
+  HashSet<String>::range found = mInternedText.FindAs(text, HashPolicy<StringRange>());
+  if (!found.Empty())
+    return found.Front();
+
+  String interned = text;
+  mInternedText.Insert(interned);
+  return interned;
+}
+
 DataNode* DataTreeParser::CreateNewNode(DataNodeType::Enum nodeType)
 {
   DataNode* parent = GetCurrentNode();
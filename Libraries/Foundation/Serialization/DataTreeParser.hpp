@@ -29,6 +29,11 @@ private:
   bool Expect(DataTokenType::Enum token, cstr errorMessage);
   bool AcceptValue(bool createNode, DataTokenType::Enum tokenType);
 
+  /// Names and common values repeat throughout a file, so every node with the
+  /// same text shares the String made for the first one (instead of going
+  /// through the global string pool each time).
+  String InternText(StringRange text);
+
   DataNode* CreateNewNode(DataNodeType::Enum nodeType);
   void PopNode();
   DataNode* GetCurrentNode();
@@ -40,6 +45,12 @@ private:
   uint mCurrentIndex;
   Array<DataToken> mTokens;
   DataTreeContext& mContext;
+
+  HashSet<String> mInternedText;
+  String mIntegerTypeName;
+  String mHexTypeName;
+  String mFloatTypeName;
+  String mBooleanTypeName;
 };
 
 } // namespace Zero
@@ -4,13 +4,12 @@
 namespace Zero
 {
 
-DeclareEnum18(TokenState,
+DeclareEnum17(TokenState,
               Start,
               Identifier,
               EnumerationStart,
               Enumeration,
               StringLiteralStart,
-              StringLiteralEscape,
               StringLiteral,
               Integer,
               ZeroInteger,
@@ -49,10 +48,17 @@ inline DataTokenType::Enum GetTokenFromState(TokenState::Enum currentState)
 }
 
 // Data Tree Tokenizer
-DataTreeTokenizer::DataTreeTokenizer(StringParam text) : mLineNumber(0)
+DataTreeTokenizer::DataTreeTokenizer(StringRange text) : mLineNumber(0), mText(text)
 {
-  mText = text;
-  mRange = mText.All();
+  mPosition = mText.mBegin;
+  mEnd = mText.mEnd;
+}
+
+// Identifiers and enumerations are the most common tokens, so they're read
+// without going back through the state machine for every character
+inline bool IsIdentifierCharacter(char character)
+{
+  return IsAlpha(character) || character == '_' || IsNumber(character);
 }
 
 bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
@@ -61,18 +67,18 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
 
   // Reset token data
   token.mType = DataTokenType::None;
-  token.mText = String();
+  token.mText = StringRange();
   token.mLineNumber = mLineNumber;
 
   // Store where we started so we can get the full text of the token
-  StringIterator tokenStart = mRange.Begin();
+  cstr tokenStart = mPosition;
 
   // Start in the starting state
   TokenState::Enum currentState = TokenState::Start;
 
-  while (!mRange.Empty())
+  while (mPosition < mEnd)
   {
-    Rune rune = mRange.Front();
+    char character = *mPosition;
     bool tokenAccepted = false;
 
     switch (currentState)
@@ -80,34 +86,34 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
       // Start
     case TokenState::Start:
     {
-      if (IsAlpha(rune) || rune == '_')
+      if (IsAlpha(character) || character == '_')
         currentState = TokenState::Identifier;
-      else if (rune == '\"')
+      else if (character == '\"')
         currentState = TokenState::StringLiteralStart;
-      else if (rune == '-')
+      else if (character == '-')
         currentState = TokenState::NegativeStart;
-      else if (rune == '0')
+      else if (character == '0')
         currentState = TokenState::ZeroInteger;
-      else if (IsNumber(rune))
+      else if (IsNumber(character))
         currentState = TokenState::Integer;
-      else if (IsSymbol(rune))
+      else if (IsSymbol(character))
       {
-        if (rune == '=')
+        if (character == '=')
           token.mType = DataTokenType::Assignment;
-        else if (rune == '{')
+        else if (character == '{')
           token.mType = DataTokenType::OpenCurley;
-        else if (rune == '}')
+        else if (character == '}')
           token.mType = DataTokenType::CloseCurley;
-        else if (rune == '[')
+        else if (character == '[')
           token.mType = DataTokenType::OpenBracket;
-        else if (rune == ']')
+        else if (character == ']')
           token.mType = DataTokenType::CloseBracket;
-        else if (rune == ',')
+        else if (character == ',')
           token.mType = DataTokenType::Comma;
-        else if (rune == ':')
+        else if (character == ':')
           token.mType = DataTokenType::Colon;
 
-        mRange.PopFront();
+        ++mPosition;
         return (token.mType != DataTokenType::None);
       }
       else
@@ -120,20 +126,11 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Literal Start
     case TokenState::StringLiteralStart:
     {
-      if (rune == '\\')
-        currentState = TokenState::StringLiteralEscape;
-      else if (rune == '\"')
-        currentState = TokenState::StringLiteral;
-
-      // Otherwise, we accept any character so we don't need to do anything
-      break;
-    }
-    // Literal Escape
-    case TokenState::StringLiteralEscape:
-    {
-      currentState = TokenState::StringLiteralStart;
-
-      // Otherwise, we accept any character so we don't need to do anything
+      // Skip straight to the closing quote, which is consumed below
+      SkipStringLiteral();
+      if (mPosition == mEnd)
+        continue;
+      currentState = TokenState::StringLiteral;
       break;
     }
     // Literal
@@ -147,11 +144,15 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Identifier
     case TokenState::Identifier:
     {
+      while (mPosition < mEnd && IsIdentifierCharacter(*mPosition))
+        ++mPosition;
+      if (mPosition == mEnd)
+        continue;
+
       // Transition to enum if it's a period
-      if (rune == '.')
+      if (*mPosition == '.')
         currentState = TokenState::EnumerationStart;
-      // Only accept alpha and underscores
-      else if (!IsAlpha(rune) && rune != '_' && !IsNumber(rune))
+      else
         tokenAccepted = true;
 
       break;
@@ -159,7 +160,7 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Enumeration Start
     case TokenState::EnumerationStart:
     {
-      if (IsAlpha(rune) || rune == '_')
+      if (IsAlpha(character) || character == '_')
         currentState = TokenState::Enumeration;
       else
         status.SetFailed("Expected literal after enumeration start");
@@ -169,21 +170,24 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Enumeration
     case TokenState::Enumeration:
     {
-      // Only accept alpha and underscores
-      if (!IsAlpha(rune) && rune != '_' && !IsNumber(rune))
-        tokenAccepted = true;
+      while (mPosition < mEnd && IsIdentifierCharacter(*mPosition))
+        ++mPosition;
+      if (mPosition == mEnd)
+        continue;
+
+      tokenAccepted = true;
       break;
     }
     // Integer
     case TokenState::Integer:
     {
-      if (IsNumber(rune))
+      if (IsNumber(character))
         break;
-      else if (rune == '.')
+      else if (character == '.')
         currentState = TokenState::FloatStart;
-      else if (rune == 'f')
+      else if (character == 'f')
         currentState = TokenState::ExplicitFloat;
-      else if (rune == 'e')
+      else if (character == 'e')
         currentState = TokenState::ScientificNotationStart;
       else
         tokenAccepted = true;
@@ -192,9 +196,9 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Negative Start
     case TokenState::NegativeStart:
     {
-      if (rune == '0')
+      if (character == '0')
         currentState = TokenState::ZeroInteger;
-      else if (IsNumber(rune))
+      else if (IsNumber(character))
         currentState = TokenState::Integer;
       else
         status.SetFailed("Negative symbol must be followed by a number");
@@ -203,11 +207,11 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Integer
     case TokenState::ZeroInteger:
     {
-      if (IsNumber(rune))
+      if (IsNumber(character))
         currentState = TokenState::Integer;
-      else if (rune == 'x' || rune == 'X')
+      else if (character == 'x' || character == 'X')
         currentState = TokenState::HexStart;
-      else if (rune == '.')
+      else if (character == '.')
         currentState = TokenState::FloatStart;
       else
         tokenAccepted = true;
@@ -216,7 +220,7 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Hex Start
     case TokenState::HexStart:
     {
-      if (IsHex(rune))
+      if (IsHex(character))
         currentState = TokenState::Hex;
       else
         status.SetFailed("Incomplete hex value");
@@ -225,7 +229,7 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Hex
     case TokenState::Hex:
     {
-      if (IsHex(rune))
+      if (IsHex(character))
         currentState = TokenState::Hex;
       else
         tokenAccepted = true;
@@ -234,7 +238,7 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Float Start
     case TokenState::FloatStart:
     {
-      if (IsNumber(rune))
+      if (IsNumber(character))
         currentState = TokenState::Float;
       else
         status.SetFailed("Incomplete float. A number must follow the '.'");
@@ -243,9 +247,9 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Float
     case TokenState::Float:
     {
-      if (rune == 'e')
+      if (character == 'e')
         currentState = TokenState::ScientificNotationStart;
-      else if (!IsNumber(rune))
+      else if (!IsNumber(character))
         tokenAccepted = true;
       break;
     }
@@ -258,9 +262,9 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Notation Start
     case TokenState::ScientificNotationStart:
     {
-      if (rune == '+' || rune == '-')
+      if (character == '+' || character == '-')
         currentState = TokenState::ScientificNotationSign;
-      else if (IsNumber(rune))
+      else if (IsNumber(character))
         currentState = TokenState::ScientificNotationFloat;
       else
         status.SetFailed("Incomplete scientific notation. A number or +- should follow 'e'");
@@ -269,7 +273,7 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Notation Sign
     case TokenState::ScientificNotationSign:
     {
-      if (IsNumber(rune))
+      if (IsNumber(character))
         currentState = TokenState::ScientificNotationFloat;
       else
         status.SetFailed("Incomplete scientific notation. A number should "
@@ -279,9 +283,9 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     // Notation Float
     case TokenState::ScientificNotationFloat:
     {
-      if (rune == 'f')
+      if (character == 'f')
         currentState = TokenState::ExplicitFloat;
-      else if (!IsNumber(rune))
+      else if (!IsNumber(character))
         tokenAccepted = true;
       break;
     }
@@ -297,7 +301,7 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
     if (tokenAccepted)
       break;
     else
-      mRange.PopFront();
+      ++mPosition;
   }
 
   // Check to see if the state is an accepting state
@@ -306,9 +310,9 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
   // If we found a valid token, assign the text and return success
   // Strip the quotes for string literals
   if (token.mType == DataTokenType::StringLiteral)
-    token.mText = mText.SubString(tokenStart + 1, mRange.Begin() - 1);
+    token.mText = StringRange(mText.mOriginalString, tokenStart + 1, mPosition - 1);
   else if (token.mType != DataTokenType::None)
-    token.mText = mText.SubString(tokenStart, mRange.Begin());
+    token.mText = StringRange(mText.mOriginalString, tokenStart, mPosition);
 
   // Lookup keywords
   if (token.mType == DataTokenType::Identifier)
@@ -328,28 +332,57 @@ void DataTreeTokenizer::EatWhitespace()
 {
   bool lastWasCarriageReturn = false;
 
-  while (!mRange.Empty())
+  while (mPosition < mEnd)
   {
-    Rune rune = mRange.Front();
+    char character = *mPosition;
 
     // Increase line number if it's a newline
-    if (rune == '\r')
+    if (character == '\r')
     {
       ++mLineNumber;
     }
-    else if (rune == '\n')
+    else if (character == '\n')
     {
       if (!lastWasCarriageReturn)
         ++mLineNumber;
     }
-    else if (!IsSpace(rune))
+    else if (!IsSpace(character))
     {
       break;
     }
 
-    lastWasCarriageReturn = (rune == '\r');
+    lastWasCarriageReturn = (character == '\r');
+
+    ++mPosition;
+  }
+}
+
+void DataTreeTokenizer::SkipStringLiteral()
+{
+  // The closing quote is the first one that isn't escaped. Quotes and slashes
+  // are single bytes that can't appear inside of a multi-byte character, so
+  // memchr can be used to find each quote (it's vectorized by the platform).
+  cstr contentStart = mPosition;
+  for (;;)
+  {
+    cstr quote = (cstr)memchr(mPosition, '"', mEnd - mPosition);
+    if (quote == nullptr)
+    {
+      mPosition = mEnd;
+      return;
+    }
+
+    // Every slash escapes the character after it, so the quote is escaped
+    // when an odd number of slashes come before it
+    size_t slashCount = 0;
+    for (cstr slash = quote; slash > contentStart && slash[-1] == '\\'; --slash)
+      ++slashCount;
+
+    mPosition = quote;
+    if (slashCount % 2 == 0)
+      return;
 
-    mRange.PopFront();
+    ++mPosition;
   }
 }
 
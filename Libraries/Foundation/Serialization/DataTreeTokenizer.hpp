@@ -35,18 +35,25 @@ struct DataToken
 };
 
 // Data Tree Tokenizer
+/// Tokens are ranges into the given text (nothing is copied). The text is
+/// scanned a byte at a time, every structural character is ascii so multi-byte
+/// characters can only appear inside of string literals.
 class DataTreeTokenizer
 {
 public:
-  DataTreeTokenizer(StringParam text);
+  DataTreeTokenizer(StringRange text);
 
   bool ReadToken(DataToken& token, Status& status);
 
 private:
   void EatWhitespace();
+  /// Moves to the closing quote of a string literal (or the end of the text).
+  void SkipStringLiteral();
   uint mLineNumber;
-  String mText;
-  StringRange mRange;
+  /// Keeps the text alive and is what token ranges are made from.
+  StringRange mText;
+  cstr mPosition;
+  cstr mEnd;
 };
 
 } // namespace Zero
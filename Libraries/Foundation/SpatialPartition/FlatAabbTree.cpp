@@ -0,0 +1,397 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+// Leaves are split down to single primitives so queries return exactly the
+// overlapping aabbs. Each node already tests its four leaves in one loop.
+const uint cFlatAabbTreeMaxLeafPrimitives = 1;
+// Number of buckets each axis is divided into when evaluating splits
+const uint cFlatAabbTreeSahBins = 16;
+
+namespace
+{
+
+// A node of the intermediate binary tree
+struct BinaryNode
+{
+  Aabb mAabb;
+  // Children are only valid for internal nodes
+  uint mChildren[2];
+  // Range of the primitive array for leaves
+  uint mBegin;
+  uint mCount;
+  bool mLeaf;
+};
+
+struct SahBin
+{
+  SahBin() : mCount(0)
+  {
+    mAabb.SetInvalid();
+  }
+
+  Aabb mAabb;
+  uint mCount;
+};
+
+// Half the surface area is all the heuristic needs
+real HalfArea(const Aabb& aabb)
+{
+  Vec3 extents = aabb.mMax - aabb.mMin;
+  return extents.x * extents.y + extents.y * extents.z + extents.z * extents.x;
+}
+
+// Finds the cheapest binned split of the range. Returns false if no bin
+// boundary separates the centroids.
+bool FindSahSplit(const Array<Aabb>& aabbs,
+                  const Array<Vec3>& centroids,
+                  const Array<uint>& primitives,
+                  BinaryNode& node,
+                  uint& splitAxis,
+                  real& splitPosition)
+{
+  Aabb centroidBounds;
+  centroidBounds.SetInvalid();
+  for (uint i = node.mBegin; i < node.mBegin + node.mCount; ++i)
+    centroidBounds.Expand(centroids[primitives[i]]);
+
+  real bestCost = Math::PositiveMax();
+  bool found = false;
+  Vec3 centroidExtents = centroidBounds.mMax - centroidBounds.mMin;
+  for (uint axis = 0; axis < 3; ++axis)
+  {
+    real extent = centroidExtents[axis];
+    if (extent <= real(0))
+      continue;
+
+    SahBin bins[cFlatAabbTreeSahBins];
+    real binScale = real(cFlatAabbTreeSahBins) / extent;
+    for (uint i = node.mBegin; i < node.mBegin + node.mCount; ++i)
+    {
+      uint primitive = primitives[i];
+      uint bin = (uint)((centroids[primitive][axis] - centroidBounds.mMin[axis]) * binScale);
+      bin = Math::Min(bin, cFlatAabbTreeSahBins - 1);
+      bins[bin].mAabb.Combine(aabbs[primitive]);
+      ++bins[bin].mCount;
+    }
+
+    // Sweep from the right to get the cost of everything past each plane
+    real rightAreas[cFlatAabbTreeSahBins];
+    uint rightCounts[cFlatAabbTreeSahBins];
+    Aabb rightAabb;
+    rightAabb.SetInvalid();
+    uint rightCount = 0;
+    for (uint i = cFlatAabbTreeSahBins - 1; i > 0; --i)
+    {
+      rightAabb.Combine(bins[i].mAabb);
+      rightCount += bins[i].mCount;
+      rightAreas[i] = rightCount ? HalfArea(rightAabb) : real(0);
+      rightCounts[i] = rightCount;
+    }
+
+    Aabb leftAabb;
+    leftAabb.SetInvalid();
+    uint leftCount = 0;
+    real invParentArea = real(1) / Math::Max(HalfArea(node.mAabb), Math::Epsilon());
+    for (uint i = 0; i < cFlatAabbTreeSahBins - 1; ++i)
+    {
+      leftAabb.Combine(bins[i].mAabb);
+      leftCount += bins[i].mCount;
+      if (leftCount == 0 || rightCounts[i + 1] == 0)
+        continue;
+
+      // One traversal step plus the expected number of primitive tests
+      real cost =
+          real(1) + (HalfArea(leftAabb) * leftCount + rightAreas[i + 1] * rightCounts[i + 1]) * invParentArea;
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        splitAxis = axis;
+        splitPosition = centroidBounds.mMin[axis] + extent * real(i + 1) / real(cFlatAabbTreeSahBins);
+        found = true;
+      }
+    }
+  }
+
+  return found;
+}
+
+} // namespace
+
+FlatAabbTree::FlatAabbTree()
+{
+}
+
+void FlatAabbTree::Build(const Array<Aabb>& aabbs)
+{
+  Clear();
+  if (aabbs.Empty())
+    return;
+
+  uint primitiveCount = aabbs.Size();
+  Array<Vec3> centroids;
+  centroids.Resize(primitiveCount);
+  mPrimitives.Resize(primitiveCount);
+  for (uint i = 0; i < primitiveCount; ++i)
+  {
+    centroids[i] = aabbs[i].GetCenter();
+    mPrimitives[i] = i;
+  }
+
+  // Build a binary tree top down. An explicit stack is used since lopsided
+  // meshes can produce very deep trees.
+  Array<BinaryNode> binaryNodes;
+  binaryNodes.Reserve(primitiveCount * 2);
+  BinaryNode& root = binaryNodes.PushBack();
+  root.mBegin = 0;
+  root.mCount = primitiveCount;
+
+  Array<uint> buildStack;
+  buildStack.PushBack(0);
+  while (!buildStack.Empty())
+  {
+    uint nodeIndex = buildStack.Back();
+    buildStack.PopBack();
+
+    BinaryNode& node = binaryNodes[nodeIndex];
+    node.mAabb.SetInvalid();
+    for (uint i = node.mBegin; i < node.mBegin + node.mCount; ++i)
+      node.mAabb.Combine(aabbs[mPrimitives[i]]);
+
+    node.mLeaf = true;
+    if (node.mCount <= cFlatAabbTreeMaxLeafPrimitives)
+      continue;
+
+    uint begin = node.mBegin;
+    uint count = node.mCount;
+    uint middle = begin;
+    uint axis = 0;
+    real position = 0;
+    if (FindSahSplit(aabbs, centroids, mPrimitives, node, axis, position))
+    {
+      uint end = begin + count;
+      while (middle < end)
+      {
+        if (centroids[mPrimitives[middle]][axis] < position)
+          ++middle;
+        else
+          Math::Swap(mPrimitives[middle], mPrimitives[--end]);
+      }
+    }
+
+    // Either every centroid is the same or rounding put everything on one side
+    // of the plane. Leaves still have to be split, so just halve the range.
+    if (middle == begin || middle == begin + count)
+      middle = begin + count / 2;
+
+    node.mLeaf = false;
+    node.mChildren[0] = binaryNodes.Size();
+    node.mChildren[1] = binaryNodes.Size() + 1;
+
+    // The node reference is invalid after pushing
+    BinaryNode& left = binaryNodes.PushBack();
+    left.mBegin = begin;
+    left.mCount = middle - begin;
+    BinaryNode& right = binaryNodes.PushBack();
+    right.mBegin = middle;
+    right.mCount = begin + count - middle;
+
+    buildStack.PushBack(binaryNodes.Size() - 2);
+    buildStack.PushBack(binaryNodes.Size() - 1);
+  }
+
+  // Collapse the binary tree into four child nodes by repeatedly opening the
+  // largest internal child until a node has four children
+  Array<Pair<uint, uint>> collapseStack;
+  mNodes.PushBack();
+  collapseStack.PushBack(Pair<uint, uint>(0, 0));
+  while (!collapseStack.Empty())
+  {
+    Pair<uint, uint> entry = collapseStack.Back();
+    collapseStack.PopBack();
+
+    uint children[4];
+    uint childCount = 0;
+    BinaryNode& binaryNode = binaryNodes[entry.second];
+    if (binaryNode.mLeaf)
+    {
+      children[childCount++] = entry.second;
+    }
+    else
+    {
+      children[childCount++] = binaryNode.mChildren[0];
+      children[childCount++] = binaryNode.mChildren[1];
+    }
+
+    while (childCount < 4)
+    {
+      int largest = -1;
+      real largestArea = -Math::PositiveMax();
+      for (uint i = 0; i < childCount; ++i)
+      {
+        BinaryNode& child = binaryNodes[children[i]];
+        real area = HalfArea(child.mAabb);
+        if (!child.mLeaf && area > largestArea)
+        {
+          largest = (int)i;
+          largestArea = area;
+        }
+      }
+
+      if (largest < 0)
+        break;
+
+      BinaryNode& opened = binaryNodes[children[largest]];
+      children[largest] = opened.mChildren[0];
+      children[childCount++] = opened.mChildren[1];
+    }
+
+    // Filled out on the side since adding child nodes can move the array
+    NodeType node;
+    for (uint i = 0; i < 4; ++i)
+    {
+      if (i >= childCount)
+      {
+        node.mMinX[i] = node.mMinY[i] = node.mMinZ[i] = Math::PositiveMax();
+        node.mMaxX[i] = node.mMaxY[i] = node.mMaxZ[i] = -Math::PositiveMax();
+        node.mChildren[i] = NodeType::cEmptyChild;
+        node.mCounts[i] = 0;
+        continue;
+      }
+
+      BinaryNode& child = binaryNodes[children[i]];
+      node.mMinX[i] = child.mAabb.mMin.x;
+      node.mMinY[i] = child.mAabb.mMin.y;
+      node.mMinZ[i] = child.mAabb.mMin.z;
+      node.mMaxX[i] = child.mAabb.mMax.x;
+      node.mMaxY[i] = child.mAabb.mMax.y;
+      node.mMaxZ[i] = child.mAabb.mMax.z;
+
+      if (child.mLeaf)
+      {
+        node.mChildren[i] = child.mBegin;
+        node.mCounts[i] = child.mCount;
+      }
+      else
+      {
+        node.mChildren[i] = mNodes.Size();
+        node.mCounts[i] = 0;
+        collapseStack.PushBack(Pair<uint, uint>(mNodes.Size(), children[i]));
+        mNodes.PushBack();
+      }
+    }
+    mNodes[entry.first] = node;
+  }
+}
+
+void FlatAabbTree::Clear()
+{
+  mNodes.Clear();
+  mPrimitives.Clear();
+}
+
+bool FlatAabbTree::Empty() const
+{
+  return mNodes.Empty();
+}
+
+uint FlatAabbTree::GetPrimitiveCount() const
+{
+  return mPrimitives.Size();
+}
+
+void FlatAabbTree::Serialize(Serializer& stream)
+{
+  ErrorIf(stream.GetType() != SerializerType::Binary, "Flat aabb trees can only be serialized in binary.");
+
+  uint nodeCount = mNodes.Size();
+  stream.ArraySize(nodeCount);
+  uint primitiveCount = mPrimitives.Size();
+  stream.ArraySize(primitiveCount);
+
+  if (stream.GetMode() == SerializerMode::Loading)
+  {
+    mNodes.Resize(nodeCount);
+    mPrimitives.Resize(primitiveCount);
+  }
+
+  if (nodeCount != 0)
+    stream.ArrayField("Nodes", "Nodes", (::byte*)mNodes.Data(), BasicArrayType::Float, nodeCount, sizeof(NodeType));
+  if (primitiveCount != 0)
+    stream.ArrayField(
+        "Primitives", "Primitives", (::byte*)mPrimitives.Data(), BasicArrayType::Integer, primitiveCount, sizeof(uint));
+}
+
+void FlatAabbTree::Query(const Aabb& aabb, Array<uint>& results) const
+{
+  if (mNodes.Empty())
+    return;
+
+  FlatAabbTreeStack stack;
+  stack.Push(0, 0);
+  while (!stack.Empty())
+  {
+    const NodeType& node = mNodes[stack.Pop().first];
+    uint hitMask = OverlapChildren(node, aabb);
+    for (uint i = 0; i < 4; ++i)
+    {
+      if ((hitMask & (1 << i)) == 0)
+        continue;
+
+      uint count = node.mCounts[i];
+      if (count == 0)
+      {
+        stack.Push(node.mChildren[i], 0);
+        continue;
+      }
+
+      uint first = node.mChildren[i];
+      for (uint p = first; p < first + count; ++p)
+        results.PushBack(mPrimitives[p]);
+    }
+  }
+}
+
+uint FlatAabbTree::OverlapChildren(const NodeType& node, const Aabb& aabb)
+{
+  // Empty slots have inverted aabbs so they never overlap
+  uint mask = 0;
+  for (uint i = 0; i < 4; ++i)
+  {
+    if (node.mMinX[i] <= aabb.mMax.x && node.mMinY[i] <= aabb.mMax.y && node.mMinZ[i] <= aabb.mMax.z &&
+        node.mMaxX[i] >= aabb.mMin.x && node.mMaxY[i] >= aabb.mMin.y && node.mMaxZ[i] >= aabb.mMin.z)
+      mask |= 1 << i;
+  }
+  return mask;
+}
+
+uint FlatAabbTree::RayChildren(
+    const NodeType& node, Vec3Param start, Vec3Param invDirection, real maxT, real entryTimes[4])
+{
+  // Empty slots are not rejected by the slab test, the callers skip them
+  const float* mins[3] = {node.mMinX, node.mMinY, node.mMinZ};
+  const float* maxs[3] = {node.mMaxX, node.mMaxY, node.mMaxZ};
+
+  uint mask = 0;
+  for (uint i = 0; i < 4; ++i)
+  {
+    real tNear = real(0);
+    real tFar = maxT;
+    for (uint axis = 0; axis < 3; ++axis)
+    {
+      real t0 = (mins[axis][i] - start[axis]) * invDirection[axis];
+      real t1 = (maxs[axis][i] - start[axis]) * invDirection[axis];
+      tNear = Math::Max(tNear, Math::Min(t0, t1));
+      tFar = Math::Min(tFar, Math::Max(t0, t1));
+    }
+
+    entryTimes[i] = tNear;
+    if (tNear <= tFar)
+      mask |= 1 << i;
+  }
+  return mask;
+}
+
+} // namespace Zero
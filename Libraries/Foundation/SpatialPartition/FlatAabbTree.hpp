@@ -0,0 +1,195 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+// Flat Aabb Tree Node
+/// Four child aabbs stored component-wise so a node's children are read from a
+/// few contiguous arrays. Queries test the four children of a node in one loop
+/// and return which of them to visit as a bit mask.
+struct FlatAabbTreeNode
+{
+  /// Marks a child slot that isn't used.
+  static const uint cEmptyChild = (uint)-1;
+
+  float mMinX[4];
+  float mMinY[4];
+  float mMinZ[4];
+  float mMaxX[4];
+  float mMaxY[4];
+  float mMaxZ[4];
+  /// Node index of an internal child or the first primitive of a leaf child.
+  uint mChildren[4];
+  /// Number of primitives in a leaf child, zero for internal children.
+  uint mCounts[4];
+};
+
+// Flat Aabb Tree
+/// A static aabb tree built with the surface area heuristic and flattened into
+/// a single array of four child nodes. The nodes and primitive indices are plain
+/// arrays so a tree can be built offline and loaded straight into memory
+/// instead of being reconstructed. Primitives are referred to by the index of
+/// their aabb in the array the tree was built from.
+class FlatAabbTree
+{
+public:
+  typedef FlatAabbTreeNode NodeType;
+
+  /// Bump when the node layout or build changes so stale data is rebuilt.
+  static const u32 cVersion = 1;
+
+  FlatAabbTree();
+
+  /// Builds the tree over the given primitive aabbs.
+  void Build(const Array<Aabb>& aabbs);
+  void Clear();
+  bool Empty() const;
+  /// The number of primitives the tree was built over.
+  uint GetPrimitiveCount() const;
+
+  /// Only binary serializers are supported, the node arrays are read and
+  /// written as a single block.
+  void Serialize(Serializer& stream);
+
+  /// Appends every primitive whose aabb overlaps the given aabb.
+  void Query(const Aabb& aabb, Array<uint>& results) const;
+
+  /// Visits the primitives whose aabbs are hit by the ray, roughly front to
+  /// back. The callback is called as callback(primitive, maxT) and should
+  /// lower maxT when it finds a hit so farther nodes are skipped. The ray's
+  /// t is in terms of its (possibly non-normalized) direction.
+  template <typename Callback>
+  void CastRay(const Ray& ray, real maxT, Callback& callback) const;
+
+  Array<NodeType> mNodes;
+  /// Primitive indices, leaves reference a contiguous range of these.
+  Array<uint> mPrimitives;
+
+private:
+  /// Returns a bit mask of the node's children the aabb overlaps.
+  static uint OverlapChildren(const NodeType& node, const Aabb& aabb);
+  /// Returns a bit mask of the node's children the ray hits within [0, maxT]
+  /// and fills out the entry t of each hit child.
+  static uint RayChildren(
+      const NodeType& node, Vec3Param start, Vec3Param invDirection, real maxT, real entryTimes[4]);
+};
+
+// Flat Aabb Tree Stack
+/// Traversal stack that only allocates for unusually deep trees.
+class FlatAabbTreeStack
+{
+public:
+  FlatAabbTreeStack() : mSize(0)
+  {
+  }
+
+  void Push(uint node, real entryTime)
+  {
+    if (mSize < cFixedSize)
+    {
+      mFixed[mSize].first = node;
+      mFixed[mSize].second = entryTime;
+    }
+    else
+    {
+      mOverflow.PushBack(Pair<uint, real>(node, entryTime));
+    }
+    ++mSize;
+  }
+
+  Pair<uint, real> Pop()
+  {
+    --mSize;
+    if (mSize < cFixedSize)
+      return mFixed[mSize];
+    Pair<uint, real> entry = mOverflow.Back();
+    mOverflow.PopBack();
+    return entry;
+  }
+
+  bool Empty() const
+  {
+    return mSize == 0;
+  }
+
+private:
+  static const uint cFixedSize = 128;
+
+  uint mSize;
+  Pair<uint, real> mFixed[cFixedSize];
+  Array<Pair<uint, real>> mOverflow;
+};
+
+template <typename Callback>
+void FlatAabbTree::CastRay(const Ray& ray, real maxT, Callback& callback) const
+{
+  if (mNodes.Empty())
+    return;
+
+  // Avoid infinities for axis aligned rays, they turn into NaNs in the slab test
+  Vec3 invDirection;
+  for (uint axis = 0; axis < 3; ++axis)
+  {
+    real direction = ray.Direction[axis];
+    if (Math::Abs(direction) < Math::Epsilon())
+      invDirection[axis] = direction < 0 ? -Math::PositiveMax() : Math::PositiveMax();
+    else
+      invDirection[axis] = real(1.0) / direction;
+  }
+
+  FlatAabbTreeStack stack;
+  stack.Push(0, 0);
+  while (!stack.Empty())
+  {
+    Pair<uint, real> entry = stack.Pop();
+    // A closer hit was found after this node was pushed
+    if (entry.second > maxT)
+      continue;
+
+    const NodeType& node = mNodes[entry.first];
+    real entryTimes[4];
+    uint hitMask = RayChildren(node, ray.Start, invDirection, maxT, entryTimes);
+    if (hitMask == 0)
+      continue;
+
+    // Sort the hit children far to near so the nearest is visited first
+    uint order[4];
+    uint hitCount = 0;
+    for (uint i = 0; i < 4; ++i)
+    {
+      if ((hitMask & (1 << i)) == 0 || node.mChildren[i] == NodeType::cEmptyChild)
+        continue;
+
+      uint insert = hitCount++;
+      while (insert > 0 && entryTimes[order[insert - 1]] < entryTimes[i])
+      {
+        order[insert] = order[insert - 1];
+        --insert;
+      }
+      order[insert] = i;
+    }
+
+    for (uint i = 0; i < hitCount; ++i)
+    {
+      uint child = order[i];
+      if (node.mCounts[child] == 0)
+        stack.Push(node.mChildren[child], entryTimes[child]);
+    }
+
+    // Leaves are tested immediately, nearest first
+    for (uint i = hitCount; i > 0; --i)
+    {
+      uint child = order[i - 1];
+      uint count = node.mCounts[child];
+      if (count == 0 || entryTimes[child] > maxT)
+        continue;
+
+      uint first = node.mChildren[child];
+      for (uint p = first; p < first + count; ++p)
+        callback(mPrimitives[p], maxT);
+    }
+  }
+}
+
+} // namespace Zero
@@ -47,6 +47,7 @@ public:
 #include "AabbTreeMethods.hpp"
 #include "StaticAabbTree.hpp"
 #include "StaticAabbTreeBroadPhase.hpp"
+#include "FlatAabbTree.hpp"
 #include "BroadPhasePackage.hpp"
 #include "BroadPhaseCreator.hpp"
 #include "BroadPhaseTracker.hpp"
@@ -27,9 +27,8 @@ public:
     deflateEnd(&stream);
   }
 
-  void Deflate(::byte* input, ::byte* output, int availableIn, int availableOut, int finished)
+  void Deflate(::byte* input, ::byte* output, int availableIn, int availableOut, int flushStatus)
   {
-    int flushStatus = finished ? Z_FINISH : Z_NO_FLUSH;
     stream.avail_in = availableIn;
     stream.next_in = input;
     stream.avail_out = availableOut;
@@ -79,7 +78,17 @@ public:
 int RawDeflate(::byte* outputData, uint outsize, ::byte* inputData, uint inSize, int level)
 {
   Deflater deflater(level);
-  deflater.Deflate(inputData, outputData, inSize, outsize, true);
+  deflater.Deflate(inputData, outputData, inSize, outsize, Z_FINISH);
+  return deflater.written;
+}
+
+// Deflates one block of a larger entry. Every block is deflated on its own and
+// ends on a byte boundary (a sync flush), only the last block finishes the
+// stream, so the blocks put together are one deflate stream.
+int RawDeflateBlock(::byte* outputData, uint outSize, ::byte* inputData, uint inSize, int level, bool last)
+{
+  Deflater deflater(level);
+  deflater.Deflate(inputData, outputData, inSize, outSize, last ? Z_FINISH : Z_SYNC_FLUSH);
   return deflater.written;
 }
 
@@ -90,12 +99,177 @@ int RawInflate(::byte* outputData, uint outSize, ::byte* inputData, uint inSize)
   return inflater.written;
 }
 
+//  ------------------ Archive Tasks
+
+// Archives are below the engine's job system, so their work is run on a few
+// threads that only live as long as the work does
+const size_t cArchiveThreadCount = 8;
+// Entries larger than this are compressed in blocks on separate threads
+const size_t cArchiveBlockSize = 1024 * 1024;
+// Bounds how much of a directory is read into memory at once
+const u64 cArchiveBatchSize = 64 * 1024 * 1024;
+// The size of a sync flush marker, with some room to spare
+const uint cSyncFlushBound = 16;
+
+typedef void (*ArchiveTaskFunction)(void* userData, size_t index);
+
+struct ArchiveTaskRunner
+{
+  OsInt RunTasks()
+  {
+    for (;;)
+    {
+      size_t index = ++mNextTask - 1;
+      if (index >= mTaskCount)
+        return 0;
+      mFunction(mUserData, index);
+    }
+  }
+
+  ArchiveTaskFunction mFunction;
+  void* mUserData;
+  size_t mTaskCount;
+  Atomic<size_t> mNextTask;
+};
+
+// Runs every task on the archive threads and the calling thread, and returns
+// once they're all done
+void RunArchiveTasks(size_t taskCount, ArchiveTaskFunction function, void* userData)
+{
+  ArchiveTaskRunner runner;
+  runner.mFunction = function;
+  runner.mUserData = userData;
+  runner.mTaskCount = taskCount;
+  runner.mNextTask = 0;
+
+  size_t threadCount = 0;
+  if (ThreadingEnabled && taskCount > 1)
+    threadCount = Math::Min(taskCount, cArchiveThreadCount) - 1;
+
+  Thread threads[cArchiveThreadCount - 1];
+  for (size_t i = 0; i < threadCount; ++i)
+    threads[i].Initialize(&Thread::ObjectEntryCreator<ArchiveTaskRunner, &ArchiveTaskRunner::RunTasks>, &runner, "Archive");
+
+  runner.RunTasks();
+
+  for (size_t i = 0; i < threadCount; ++i)
+  {
+    if (threads[i].IsValid())
+    {
+      threads[i].WaitForCompletion();
+      threads[i].Close();
+    }
+  }
+}
+
+// One block of an entry being added
+struct ArchiveBlockTask
+{
+  ::byte* Input;
+  size_t InputSize;
+  uint CompressionLevel;
+  bool Last;
+
+  // Only set when the block is compressed
+  ::byte* Output;
+  size_t OutputSize;
+  u32 Crc;
+};
+
+// An entry being extracted
+struct ArchiveExportTask
+{
+  ArchiveEntry* Entry;
+  String OutputFile;
+};
+
+// Formats that barely shrink when they're compressed again
+const cstr cCompressedFormats[] = {
+    "png", "jpg", "jpeg", "gif", "webp", "ogg", "mp3", "flac", "mp4", "webm", "zip", "gz", "bz2", "xz", "7z", "rar"};
+
+bool IsCompressedFormat(StringParam name)
+{
+  String extension = FilePath::GetExtension(name).ToLower();
+  for (size_t i = 0; i < sizeof(cCompressedFormats) / sizeof(cCompressedFormats[0]); ++i)
+  {
+    if (extension == cCompressedFormats[i])
+      return true;
+  }
+  return false;
+}
+
+void DecompressArchiveEntry(ArchiveEntry& entry)
+{
+  if (entry.Full.Data == nullptr)
+  {
+    if (entry.CompressionLevel == CompressionLevel::NoCompression)
+    {
+      // Not compressed copy data
+      entry.Full.Data = entry.Compressed.Data;
+      entry.Compressed.Data = nullptr;
+    }
+    else
+    {
+      // Inflate Data
+      entry.Full.Data = (::byte*)zAllocate(entry.Full.Size);
+      RawInflate(entry.Full.Data, entry.Full.Size, entry.Compressed.Data, entry.Compressed.Size);
+
+      // Free compressed data
+      zDeallocate(entry.Compressed.Data);
+      entry.Compressed.Data = nullptr;
+    }
+  }
+}
+
+template <typename Type>
+Array<Type>& GetTasks(void* userData)
+{
+  return *(Array<Type>*)userData;
+}
+
+void CompressBlockTask(void* userData, size_t index)
+{
+  ArchiveBlockTask& block = GetTasks<ArchiveBlockTask>(userData)[index];
+
+  uLong crc = crc32(0L, Z_NULL, 0);
+  block.Crc = (u32)crc32(crc, block.Input, (uInt)block.InputSize);
+
+  // Stored blocks only need their crc
+  if (block.CompressionLevel == CompressionLevel::NoCompression)
+    return;
+
+  uint maxCompressedSize = compressBound((uLong)block.InputSize) + cSyncFlushBound;
+  block.Output = (::byte*)zAllocate(maxCompressedSize);
+  block.OutputSize = RawDeflateBlock(
+      block.Output, maxCompressedSize, block.Input, (uint)block.InputSize, block.CompressionLevel, block.Last);
+}
+
+void DecompressEntryTask(void* userData, size_t index)
+{
+  DecompressArchiveEntry(GetTasks<ArchiveEntry>(userData)[index]);
+}
+
+void ExportEntryTask(void* userData, size_t index)
+{
+  ArchiveExportTask& task = GetTasks<ArchiveExportTask>(userData)[index];
+  ArchiveEntry& entry = *task.Entry;
+
+  // Decompress the entry if it has not been done.
+  DecompressArchiveEntry(entry);
+
+  WriteToFile(task.OutputFile.c_str(), entry.Full.Data, entry.Full.Size);
+  FreeBlock(entry.Full);
+}
+
 //  ------------------ Archive
 
 Archive::Archive(ArchiveMode::Enum mode, uint compressionLevel) :
     mCompressionLevel(compressionLevel),
     mMode(mode),
-    mFileOriginBegin(0)
+    mFileOriginBegin(0),
+    mStoreCompressedFormats(true),
+    mStreamFile(nullptr),
+    mStreamedEntryCount(0)
 {
 }
 
@@ -116,6 +290,33 @@ void Archive::Clear()
 }
 
 void Archive::ArchiveDirectory(Status& status, StringParam path, StringParam parentPath, FileFilter* filter)
+{
+  Array<PendingEntry> files;
+  CollectDirectory(path, parentPath, filter, files);
+
+  // Files are read and compressed in batches so a large directory is never
+  // read into memory all at once
+  Array<PendingEntry> batch;
+  u64 batchSize = 0;
+  forRange (PendingEntry& file, files.All())
+  {
+    batch.PushBack(file);
+    batchSize += GetFileSize(file.FullPath);
+    if (batchSize >= cArchiveBatchSize)
+    {
+      AddPendingEntries(batch);
+      batch.Clear();
+      batchSize = 0;
+    }
+  }
+
+  AddPendingEntries(batch);
+}
+
+void Archive::CollectDirectory(StringParam path,
+                               StringParam parentPath,
+                               FileFilter* filter,
+                               Array<PendingEntry>& pending)
 {
   FileRange files(path);
   for (; !files.Empty(); files.PopFront())
@@ -134,11 +335,14 @@ void Archive::ArchiveDirectory(Status& status, StringParam path, StringParam par
 
     if (DirectoryExists(fullPath))
     {
-      ArchiveDirectory(status, FilePath::Combine(path, localPath), relativePath, filter);
+      CollectDirectory(FilePath::Combine(path, localPath), relativePath, filter, pending);
     }
     else
     {
-      AddFile(fullPath, relativePath);
+      PendingEntry& entry = pending.PushBack();
+      entry.Name = relativePath;
+      entry.FullPath = fullPath;
+      entry.OwnsSource = true;
     }
   }
 }
@@ -150,73 +354,153 @@ void Archive::AddFileRelative(StringParam basePath, StringParam relativeName)
 
 void Archive::AddFileBlock(StringParam relativeName, DataBlock sourceBlock)
 {
-  ::byte* destBuffer = 0;
-  uLong compressedSize = 0;
+  Array<PendingEntry> pending;
+  PendingEntry& entry = pending.PushBack();
+  entry.Name = relativeName;
+  entry.Source = sourceBlock;
+  entry.OwnsSource = false;
+  AddPendingEntries(pending);
+}
+
+void Archive::AddFile(StringParam fullpath, StringParam relativeName)
+{
+  Array<PendingEntry> pending;
+  PendingEntry& entry = pending.PushBack();
+  entry.Name = relativeName;
+  entry.FullPath = fullpath;
+  entry.OwnsSource = true;
+  AddPendingEntries(pending);
+}
+
+void Archive::ReadPendingEntryTask(void* userData, size_t index)
+{
+  PendingEntry& entry = GetTasks<PendingEntry>(userData)[index];
+  if (entry.Source.Data == nullptr)
+    entry.Source = ReadFileIntoDataBlock(entry.FullPath.c_str());
+}
 
-  // Compute Crc
-  uLong crcTemp = crc32(0L, Z_NULL, 0);
-  uLong crc = crc32(crcTemp, sourceBlock.Data, sourceBlock.Size);
+void Archive::AddPendingEntries(Array<PendingEntry>& pending)
+{
+  if (pending.Empty())
+    return;
 
-  if (mCompressionLevel == 0)
+  // Read every file that isn't in memory yet
+  RunArchiveTasks(pending.Size(), &Archive::ReadPendingEntryTask, &pending);
+
+  // Split every entry into blocks. The blocks of an entry are next to each
+  // other, firstBlocks has where each entry's blocks start
+  Array<ArchiveBlockTask> blocks;
+  Array<size_t> firstBlocks;
+  Array<uint> compressionLevels;
+  forRange (PendingEntry& entry, pending.All())
   {
-    // No compression, just copy data into buffer
-    compressedSize = sourceBlock.Size;
-    destBuffer = (::byte*)zAllocate(sourceBlock.Size);
-    memcpy(destBuffer, sourceBlock.Data, sourceBlock.Size);
+    firstBlocks.PushBack(blocks.Size());
+    compressionLevels.PushBack(GetEntryCompressionLevel(entry.Name));
+
+    // Could not open file. (Blocks added directly are written even if empty)
+    if (entry.OwnsSource && !entry.Source)
+      continue;
+
+    size_t offset = 0;
+    for (;;)
+    {
+      ArchiveBlockTask& block = blocks.PushBack();
+      block.Input = entry.Source.Data + offset;
+      block.InputSize = Math::Min(entry.Source.Size - offset, cArchiveBlockSize);
+      block.CompressionLevel = compressionLevels.Back();
+      block.Output = nullptr;
+      block.OutputSize = 0;
+      block.Crc = 0;
+
+      offset += block.InputSize;
+      block.Last = offset == entry.Source.Size;
+      if (block.Last)
+        break;
+    }
   }
-  else
+  firstBlocks.PushBack(blocks.Size());
+
+  RunArchiveTasks(blocks.Size(), &CompressBlockTask, &blocks);
+
+  // Join the blocks of each entry
+  TimeType currentTime = Time::GetTime();
+  for (size_t i = 0; i < pending.Size(); ++i)
   {
-    // Get the upper bound for the compressed data
-    uint maxCompressedSize = compressBound(sourceBlock.Size);
+    PendingEntry& source = pending[i];
+    if (source.OwnsSource && !source.Source)
+      continue;
 
-    // Allocate the output buffer
-    destBuffer = (::byte*)zAllocate(maxCompressedSize);
+    size_t blocksBegin = firstBlocks[i];
+    size_t blocksEnd = firstBlocks[i + 1];
 
-    // Deflate the buffer to the compressed size
-    compressedSize = RawDeflate(destBuffer, maxCompressedSize, sourceBlock.Data, sourceBlock.Size, mCompressionLevel);
+    // The crc of the whole entry is built from the crc of each block
+    uLong crc = blocks[blocksBegin].Crc;
+    for (size_t b = blocksBegin + 1; b < blocksEnd; ++b)
+      crc = crc32_combine(crc, blocks[b].Crc, (z_off_t)blocks[b].InputSize);
 
-    // Optionally shrink the buffer to the compresses size
-    // this costs another memory copy bug the compresses size can be
-    // significantly smaller
-    const bool shrinkToActualCompressedSize = true;
-    if (shrinkToActualCompressedSize)
+    ArchiveEntry entry;
+    entry.Name = source.Name.Replace("\\", "/");
+    entry.Full.Data = nullptr;
+    entry.Full.Size = source.Source.Size;
+    entry.Crc = crc;
+    entry.CompressionLevel = compressionLevels[i];
+    // Use current time
+    entry.ModifiedTime = currentTime;
+
+    if (entry.CompressionLevel == CompressionLevel::NoCompression)
     {
-      ::byte* compressed = (::byte*)zAllocate(compressedSize);
-      memcpy(compressed, destBuffer, compressedSize);
-      zDeallocate(destBuffer);
-      destBuffer = compressed;
+      // No compression, the file's data is used as is
+      entry.Compressed.Size = source.Source.Size;
+      if (source.OwnsSource)
+      {
+        entry.Compressed.Data = source.Source.Data;
+        source.Source.Data = nullptr;
+      }
+      else
+      {
+        entry.Compressed.Data = (::byte*)zAllocate(source.Source.Size);
+        memcpy(entry.Compressed.Data, source.Source.Data, source.Source.Size);
+      }
     }
-  }
+    else
+    {
+      // Copy the compressed blocks into one buffer of the compressed size
+      size_t compressedSize = 0;
+      for (size_t b = blocksBegin; b < blocksEnd; ++b)
+        compressedSize += blocks[b].OutputSize;
 
-  // Add the entry
-  ArchiveEntry entry;
-  entry.Name = relativeName.Replace("\\", "/");
-  entry.Full.Data = nullptr;
-  entry.Full.Size = sourceBlock.Size;
-  entry.Compressed.Size = compressedSize;
-  entry.Compressed.Data = destBuffer;
-  entry.Crc = crc;
-  entry.CompressionLevel = mCompressionLevel;
-  // Use current time
-  entry.ModifiedTime = Time::GetTime();
-  Entries.PushBack(entry);
-}
+      entry.Compressed.Size = compressedSize;
+      entry.Compressed.Data = (::byte*)zAllocate(compressedSize);
 
-void Archive::AddFile(StringParam fullpath, StringParam relativeName)
-{
-  DataBlock dataBlock = ReadFileIntoDataBlock(fullpath.c_str());
+      ::byte* output = entry.Compressed.Data;
+      for (size_t b = blocksBegin; b < blocksEnd; ++b)
+      {
+        memcpy(output, blocks[b].Output, blocks[b].OutputSize);
+        output += blocks[b].OutputSize;
+        zDeallocate(blocks[b].Output);
+      }
+    }
 
-  // Could not open file.
-  if (!dataBlock)
-    return;
+    if (source.OwnsSource)
+      FreeBlock(source.Source);
 
-  AddFileBlock(relativeName, dataBlock);
+    Entries.PushBack(entry);
+  }
 
-  FreeBlock(dataBlock);
+  if (mStreamFile)
+    WriteStreamedEntries();
+}
+
+uint Archive::GetEntryCompressionLevel(StringParam name)
+{
+  if (mStoreCompressedFormats && IsCompressedFormat(name))
+    return CompressionLevel::NoCompression;
+  return mCompressionLevel;
 }
 
 void Archive::ExportToDirectory(ArchiveExportMode::Enum exportMode, StringParam path)
 {
+  Array<ArchiveExportTask> tasks;
 
   CreateDirectoryAndParents(path);
   forRange (ArchiveEntry& entry, Entries.All())
@@ -236,44 +520,24 @@ void Archive::ExportToDirectory(ArchiveExportMode::Enum exportMode, StringParam
         continue;
     }
 
-    // Decompress the entry if it has not been done.
-    if (entry.Full.Data == nullptr)
-      DecompressEntry(entry);
-
-    WriteToFile(outputFile.c_str(), entry.Full.Data, entry.Full.Size);
-    FreeBlock(entry.Full);
+    ArchiveExportTask& task = tasks.PushBack();
+    task.Entry = &entry;
+    task.OutputFile = outputFile;
   }
+
+  // Directories are all created above, so the entries can be decompressed and
+  // written on several threads
+  RunArchiveTasks(tasks.Size(), &ExportEntryTask, &tasks);
 }
 
 void Archive::DecompressEntry(ArchiveEntry& entry)
 {
-  if (entry.Full.Data == nullptr)
-  {
-    if (entry.CompressionLevel == CompressionLevel::NoCompression)
-    {
-      // Not compressed copy data
-      entry.Full.Data = entry.Compressed.Data;
-      entry.Compressed.Data = nullptr;
-    }
-    else
-    {
-      // Inflate Data
-      entry.Full.Data = (::byte*)zAllocate(entry.Full.Size);
-      RawInflate(entry.Full.Data, entry.Full.Size, entry.Compressed.Data, entry.Compressed.Size);
-
-      // Free compressed data
-      zDeallocate(entry.Compressed.Data);
-      entry.Compressed.Data = nullptr;
-    }
-  }
+  DecompressArchiveEntry(entry);
 }
 
 void Archive::DecompressEntries()
 {
-  forRange (ArchiveEntry& entry, Entries.All())
-  {
-    DecompressEntry(entry);
-  }
+  RunArchiveTasks(Entries.Size(), &DecompressEntryTask, &Entries);
 }
 
 //-------------------------Zip------------------------------------------------
@@ -390,8 +654,15 @@ TimeType ZipTimeToTime(u16 mdate, u16 mtime)
   return Time::CalendarDateTimeToTimeType(newTime);
 }
 
-void FillEntry(FileInfo& info, ArchiveEntry& entry, uint compressionMethod)
+const uint DeflateMethod = 8;
+const uint NoCompressionMethod = 0;
+
+void FillEntry(FileInfo& info, ArchiveEntry& entry)
 {
+  // Entries can each have their own compression level
+  uint compressionMethod =
+      entry.CompressionLevel == CompressionLevel::NoCompression ? NoCompressionMethod : DeflateMethod;
+
   u16 currentDate = 0;
   u16 currentTime = 0;
   TimeToZipTime(entry.ModifiedTime, &currentDate, &currentTime);
@@ -436,25 +707,30 @@ uint Archive::ComputeZipSize()
   return size;
 }
 
-const uint DeflateMethod = 8;
-const uint NoCompressionMethod = 0;
-
 template <typename Stream>
 void Archive::WriteZipInternal(Stream& file)
 {
-  uint compressionMethod = mCompressionLevel == 0 ? NoCompressionMethod : DeflateMethod;
-
   forRange (ArchiveEntry& entry, Entries.All())
-  {
-    entry.Offset = (size_t)file.Tell();
-    ZipLocalFileHeader header;
-    header.Signature = LocalHeader;
-    FillEntry(header.Info, entry, compressionMethod);
-    Write(file, header);
-    file.Write((::byte*)entry.Name.Data(), entry.Name.SizeInBytes());
-    file.Write((::byte*)entry.Compressed.Data, entry.Compressed.Size);
-  }
+    WriteLocalEntry(file, entry);
+
+  WriteCentralDirectory(file);
+}
+
+template <typename Stream>
+void Archive::WriteLocalEntry(Stream& file, ArchiveEntry& entry)
+{
+  entry.Offset = (size_t)file.Tell();
+  ZipLocalFileHeader header;
+  header.Signature = LocalHeader;
+  FillEntry(header.Info, entry);
+  Write(file, header);
+  file.Write((::byte*)entry.Name.Data(), entry.Name.SizeInBytes());
+  file.Write((::byte*)entry.Compressed.Data, entry.Compressed.Size);
+}
 
+template <typename Stream>
+void Archive::WriteCentralDirectory(Stream& file)
+{
   u32 centralOffset = (u32)file.Tell();
   forRange (ArchiveEntry& entry, Entries.All())
   {
@@ -466,7 +742,7 @@ void Archive::WriteZipInternal(Stream& file)
     header.VersionMadeBy = 20;
     header.FileCommentLength = 0;
     header.Offset = entry.Offset;
-    FillEntry(header.Info, entry, compressionMethod);
+    FillEntry(header.Info, entry);
     Write(file, header);
     file.Write((::byte*)entry.Name.Data(), entry.Name.SizeInBytes());
   }
@@ -484,6 +760,34 @@ void Archive::WriteZipInternal(Stream& file)
   Write(file, endCentral);
 }
 
+void Archive::BeginStreaming(File& file)
+{
+  mStreamFile = &file;
+  mStreamedEntryCount = 0;
+  WriteStreamedEntries();
+}
+
+void Archive::EndStreaming()
+{
+  if (mStreamFile == nullptr)
+    return;
+
+  WriteCentralDirectory(*mStreamFile);
+  mStreamFile = nullptr;
+}
+
+void Archive::WriteStreamedEntries()
+{
+  for (; mStreamedEntryCount < Entries.Size(); ++mStreamedEntryCount)
+  {
+    ArchiveEntry& entry = Entries[mStreamedEntryCount];
+    WriteLocalEntry(*mStreamFile, entry);
+
+    // Only the sizes are needed for the central directory
+    FreeBlock(entry.Compressed);
+  }
+}
+
 template <typename Stream>
 bool Archive::IsZipFileInternal(Stream& file)
 {
@@ -542,11 +846,6 @@ void Archive::ReadZipFileInternal(ArchiveReadFlags::Enum readFlags, Stream& file
         ::byte* buffer = (::byte*)zAllocate(localFile.Info.CompressedSize);
         file.Read(status, buffer, localFile.Info.CompressedSize);
         entry.Compressed.Data = buffer;
-
-        if (readFlags & ArchiveReadFlags::Decompress)
-        {
-          DecompressEntry(entry);
-        }
       }
       else
       {
@@ -575,7 +874,7 @@ void Archive::ReadZipFileInternal(ArchiveReadFlags::Enum readFlags, Stream& file
       String comment;
 
       ReadString(file, endCentral.CommentLength, comment);
-      return;
+      break;
     }
     else
     {
@@ -586,6 +885,10 @@ void Archive::ReadZipFileInternal(ArchiveReadFlags::Enum readFlags, Stream& file
       Read(file, temp);
     }
   }
+
+  // Every entry is read first so they can be decompressed together
+  if ((readFlags & ArchiveReadFlags::Data) && (readFlags & ArchiveReadFlags::Decompress))
+    DecompressEntries();
 }
 
 void Archive::Extract(File& file, StringParam name, StringParam destfile)
@@ -657,6 +960,15 @@ void Archive::ReadZip(ArchiveReadFlags::Enum readFlags, File& file)
 
 void Archive::ReadZipFile(ArchiveReadFlags::Enum readFlags, StringParam name)
 {
+  // Reading the headers from a mapped view avoids a read call for every field
+  Status status;
+  MappedFile mappedFile;
+  if (mappedFile.Open(status, name))
+  {
+    ReadZip(readFlags, mappedFile.GetBlock());
+    return;
+  }
+
   File file;
   if (file.Open(name.c_str(), FileMode::Read, FileAccessPattern::Sequential))
     ReadZip(readFlags, file);
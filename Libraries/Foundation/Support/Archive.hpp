@@ -61,7 +61,9 @@ const uint MaxCompression = 9;
 } // namespace CompressionLevel
 
 /// Archive is a collection files in one large file. Used
-/// for writing / reading zip files.
+/// for writing / reading zip files. Entries are compressed and decompressed on
+/// several threads, and large entries are split into blocks that are
+/// compressed on separate threads.
 class Archive
 {
 public:
@@ -115,6 +117,15 @@ public:
   void WriteZipFile(StringParam filename);
   void ReadZipFile(ArchiveReadFlags::Enum readFlags, StringParam filename);
   uint ComputeZipSize();
+
+  // Streaming
+
+  // Every entry (including those already added) is written to the file as
+  // soon as it's compressed and its data is freed, so the archive is never
+  // held in memory. EndStreaming writes the end of the zip. A streamed archive
+  // can't be written again with WriteZip.
+  void BeginStreaming(File& file);
+  void EndStreaming();
   // Entry Access
 
   // Clear all entries
@@ -134,11 +145,37 @@ public:
   // file).
   u64 mFileOriginBegin;
 
+  // Files in formats that are already compressed (images, audio, archives...)
+  // are stored without compressing them again. True by default.
+  bool mStoreCompressedFormats;
+
 private:
+  // A file or data block waiting to be compressed
+  struct PendingEntry
+  {
+    String Name;
+    // The file is read on a worker thread if the source isn't set
+    String FullPath;
+    DataBlock Source;
+    bool OwnsSource;
+  };
+
   uint mCompressionLevel;
   ArchiveMode::Enum mMode;
   Array<ArchiveEntry> Entries;
 
+  // The file entries are written to when streaming
+  File* mStreamFile;
+  // How many entries have already been written to the stream
+  uint mStreamedEntryCount;
+
+  static void ReadPendingEntryTask(void* userData, size_t index);
+  void CollectDirectory(StringParam path, StringParam parentPath, FileFilter* filter, Array<PendingEntry>& pending);
+  // Reads and compresses the pending entries and adds them
+  void AddPendingEntries(Array<PendingEntry>& pending);
+  uint GetEntryCompressionLevel(StringParam name);
+  void WriteStreamedEntries();
+
   void DecompressEntries();
   void DecompressEntry(ArchiveEntry& entry);
   void ComputeOffsets();
@@ -155,6 +192,10 @@ private:
 
   template <typename Stream>
   void WriteZipInternal(Stream& file);
+  template <typename Stream>
+  void WriteLocalEntry(Stream& file, ArchiveEntry& entry);
+  template <typename Stream>
+  void WriteCentralDirectory(Stream& file);
 };
 
 } // namespace Zero
@@ -0,0 +1,224 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+#include "SamplingProfiler.hpp"
+#include "Zilch/Precompiled.hpp"
+
+namespace Zero
+{
+
+namespace Profile
+{
+
+// Room for about a second of deep samples at the default rate. Samples taken
+// when it's full (a long frame) are dropped.
+const size_t cRawSampleCapacity = 256 * 1024;
+const size_t cMaxNativeFrames = 96;
+const size_t cMaxScriptFrames = 64;
+// GetStackAddresses, TakeSample, the signal handler and the signal trampoline
+const size_t cSampleFramesToSkip = 4;
+
+SamplingProfiler* SamplingProfiler::Instance = nullptr;
+
+void SamplingProfiler::Initialize()
+{
+  Instance = new SamplingProfiler();
+}
+
+void SamplingProfiler::Shutdown()
+{
+  SafeDelete(Instance);
+}
+
+SamplingProfiler::SamplingProfiler() : mRawSize(0), mDroppedSamples(0), mSampleCount(0)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+  // The script functions in any unfolded samples may already be gone
+  mSampler.Stop();
+}
+
+bool SamplingProfiler::Start(Status& status, uint samplesPerSecond)
+{
+  if (mSampler.IsRunning())
+    return true;
+
+  // The signal handler can't allocate
+  mRawSamples.Resize(cRawSampleCapacity);
+  return mSampler.Start(status, samplesPerSecond, &SamplingProfiler::TakeSample, this);
+}
+
+void SamplingProfiler::Stop()
+{
+  if (!mSampler.IsRunning())
+    return;
+
+  mSampler.Stop();
+  Flush();
+}
+
+bool SamplingProfiler::IsRunning()
+{
+  return mSampler.IsRunning();
+}
+
+void SamplingProfiler::TakeSample(void* userData)
+{
+  SamplingProfiler* self = (SamplingProfiler*)userData;
+
+  CallStackAddresses callStack;
+  GetStackAddresses(callStack, cMaxNativeFrames, cSampleFramesToSkip);
+  size_t nativeCount = callStack.mCaptureFrameCount;
+
+  // Native functions called from script also have frames, so only the frames
+  // run by the virtual machine are kept
+  Zilch::Function* scriptFunctions[cMaxScriptFrames];
+  size_t scriptCount = 0;
+  Zilch::ExecutableState* state = Zilch::ExecutableState::CallingState;
+  if (state != nullptr)
+  {
+    Array<Zilch::PerFrameData*>& frames = state->StackFrames;
+    for (size_t i = 0; i < frames.Size() && scriptCount < cMaxScriptFrames; ++i)
+    {
+      Zilch::Function* function = frames[i]->CurrentFunction;
+      if (function != nullptr && function->BoundFunction == Zilch::VirtualMachine::ExecuteNext)
+        scriptFunctions[scriptCount++] = function;
+    }
+  }
+
+  size_t begin = self->mRawSize.Load();
+  size_t end = begin + 2 + nativeCount + scriptCount;
+  if (end > self->mRawSamples.Size())
+  {
+    ++self->mDroppedSamples;
+    return;
+  }
+
+  void** sample = self->mRawSamples.Data() + begin;
+  sample[0] = (void*)nativeCount;
+  sample[1] = (void*)scriptCount;
+  memcpy(sample + 2, callStack.mAddresses, nativeCount * sizeof(void*));
+  memcpy(sample + 2 + nativeCount, scriptFunctions, scriptCount * sizeof(void*));
+
+  self->mRawSize = end;
+}
+
+String SamplingProfiler::GetNativeFrameName(void* address)
+{
+  String* cachedName = mNativeFrameNames.FindPointer(address);
+  if (cachedName != nullptr)
+    return *cachedName;
+
+  SymbolInfo symbolInfo;
+  symbolInfo.mAddress = address;
+  GetSymbolInfo(nullptr, symbolInfo);
+
+  String name = symbolInfo.mSymbolName;
+  if (name.Empty() && !symbolInfo.mModuleName.Empty())
+    name = BuildString("[", symbolInfo.mModuleName, "]");
+  else if (name.Empty())
+    name = String::Format("%p", address);
+
+  // Both separators of the folded format are replaced
+  name = name.Replace(";", ":").Replace("\n", " ");
+  mNativeFrameNames.Insert(address, name);
+  return name;
+}
+
+String GetScriptFrameName(Zilch::Function* function)
+{
+  if (function->Owner == nullptr)
+    return function->Name;
+  return BuildString(function->Owner->Name, ".", function->Name);
+}
+
+bool IsExecuteNextFrame(StringParam name)
+{
+  return name.Contains("VirtualMachine::ExecuteNext");
+}
+
+void SamplingProfiler::Flush()
+{
+  size_t position = 0;
+  for (;;)
+  {
+    // The signal can still add samples after the size is read, so they're
+    // folded on the next pass
+    size_t rawSize = mRawSize;
+    while (position < rawSize)
+    {
+      void** sample = mRawSamples.Data() + position;
+      size_t nativeCount = (size_t)sample[0];
+      size_t scriptCount = (size_t)sample[1];
+      void** addresses = sample + 2;
+      Zilch::Function** scriptFunctions = (Zilch::Function**)(addresses + nativeCount);
+      position += 2 + nativeCount + scriptCount;
+
+      // Each script function runs in its own ExecuteNext, so the script
+      // frames replace those from the outermost in
+      StringBuilder builder;
+      size_t nextScript = 0;
+      for (size_t i = nativeCount; i > 0; --i)
+      {
+        String name = GetNativeFrameName(addresses[i - 1]);
+        if (nextScript < scriptCount && IsExecuteNextFrame(name))
+          name = GetScriptFrameName(scriptFunctions[nextScript++]);
+
+        if (builder.GetSize() != 0)
+          builder.Append(';');
+        builder.Append(name);
+      }
+
+      // Any script frames whose ExecuteNext wasn't found (the stack was too
+      // deep) are added to the end
+      for (; nextScript < scriptCount; ++nextScript)
+      {
+        if (builder.GetSize() != 0)
+          builder.Append(';');
+        builder.Append(GetScriptFrameName(scriptFunctions[nextScript]));
+      }
+
+      ++mFoldedStacks[builder.ToString()];
+      ++mSampleCount;
+    }
+
+    if (mRawSize.CompareExchange(0, rawSize))
+      break;
+  }
+}
+
+void SamplingProfiler::Clear()
+{
+  Flush();
+  mFoldedStacks.Clear();
+  mSampleCount = 0;
+  mDroppedSamples = 0;
+}
+
+String SamplingProfiler::GetFoldedStacks()
+{
+  Flush();
+
+  StringBuilder builder;
+  forRange (HashMap<String, size_t>::pair& entry, mFoldedStacks.All())
+  {
+    builder.Append(entry.first);
+    builder.AppendFormat(" %llu\n", (u64)entry.second);
+  }
+  return builder.ToString();
+}
+
+size_t SamplingProfiler::GetSampleCount()
+{
+  return mSampleCount;
+}
+
+size_t SamplingProfiler::GetDroppedSampleCount()
+{
+  return mDroppedSamples;
+}
+
+} // namespace Profile
+
+} // namespace Zero
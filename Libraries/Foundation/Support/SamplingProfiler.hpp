@@ -0,0 +1,64 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+namespace Profile
+{
+
+/// Samples the call stack of the thread that starts it, including the Zilch
+/// functions that were running, and counts how often each stack was seen.
+/// Unlike ProfileScope records this sees time that isn't instrumented.
+class SamplingProfiler
+{
+public:
+  static const uint cDefaultSamplesPerSecond = 997;
+
+  static SamplingProfiler* Instance;
+  static void Initialize();
+  static void Shutdown();
+
+  SamplingProfiler();
+  ~SamplingProfiler();
+
+  /// Fails if the platform can't sample threads.
+  bool Start(Status& status, uint samplesPerSecond = cDefaultSamplesPerSecond);
+  void Stop();
+  bool IsRunning();
+
+  /// Folds the samples taken so far into the stack counts. Samples hold
+  /// pointers to the Zilch functions that were running, so this must be
+  /// called on the sampled thread before script libraries are released (the
+  /// engine calls it every frame and before committing newly compiled
+  /// scripts).
+  void Flush();
+  void Clear();
+
+  /// One line per unique stack: the frames from the outermost in separated by
+  /// ';' followed by the number of samples. This is the folded format read by
+  /// flamegraph.pl and speedscope.
+  String GetFoldedStacks();
+  size_t GetSampleCount();
+  size_t GetDroppedSampleCount();
+
+private:
+  static void TakeSample(void* userData);
+  String GetNativeFrameName(void* address);
+
+  ThreadSampler mSampler;
+
+  // Samples written by TakeSample. Each is the native frame count, the script
+  // frame count, the return addresses (innermost first) and then the script
+  // functions (outermost first).
+  Array<void*> mRawSamples;
+  Atomic<size_t> mRawSize;
+  Atomic<size_t> mDroppedSamples;
+
+  size_t mSampleCount;
+  HashMap<void*, String> mNativeFrameNames;
+  HashMap<String, size_t> mFoldedStacks;
+};
+
+} // namespace Profile
+} // namespace Zero
@@ -7,6 +7,7 @@
 #include "Urls.hpp"
 #include "FileSupport.hpp"
 #include "Profiler.hpp"
+#include "SamplingProfiler.hpp"
 #include "NameValidation.hpp"
 #include "ChunkReader.hpp"
 #include "ChunkWriter.hpp"
@@ -31,6 +31,11 @@ void ZeroStartup::UserCreation()
 {
 }
 
+void ZeroStartup::UserEngineUpdate()
+{
+  Z::gEngine->Update();
+}
+
 void ZeroStartup::UserShutdownLibraries()
 {
 }
@@ -117,6 +122,7 @@ void ZeroStartup::Initialize()
 
   // Start the profiling system used to performance counters and timers.
   Profile::ProfileSystem::Initialize();
+  Profile::SamplingProfiler::Initialize();
   mFileSystemInitializer = new FileSystemInitializer(&PopulateVirtualFileSystemWithZip);
 
   // Mirror console output to a log file.
@@ -141,6 +147,9 @@ void ZeroStartup::Initialize()
   if (Environment::GetValue<bool>("BeginTracing", false))
     Profile::ProfileSystem::Instance->BeginTracing();
 
+  ComponentPools::sEnabled = Environment::GetValue<bool>("PooledComponents", false);
+  FontManager::sDistanceFieldFonts = Environment::GetValue<bool>("DistanceFieldFonts", false);
+
   // Add stdout listener (requires engine initialization to get the Environment
   // object)
   if (!environment->GetParsedArgument("logStdOut").Empty())
@@ -253,8 +262,13 @@ void ZeroStartup::Startup()
   engine->AddSystem(CreateOsShellSystem());
   engine->AddSystem(CreateTimeSystem());
   engine->AddSystem(CreatePhysicsSystem());
-  engine->AddSystem(CreateSoundSystem());
-  engine->AddSystem(CreateGraphicsSystem());
+
+  // Nothing is heard or drawn when headless, so those systems are never created
+  if (!mHeadless)
+  {
+    engine->AddSystem(CreateSoundSystem());
+    engine->AddSystem(CreateGraphicsSystem());
+  }
 
   SystemInitializer initializer;
   initializer.mEngine = engine;
@@ -266,6 +280,12 @@ void ZeroStartup::Startup()
   if (mLoadContent)
     LoadContentConfig();
 
+  if (mHeadless)
+  {
+    ZPrint("Running headless, no main window will be created.\n");
+    return;
+  }
+
   ZPrint("Creating main window.\n");
 
   OsShell* osShell = engine->has(OsShell);
@@ -359,7 +379,15 @@ void ZeroStartup::JobsComplete()
 
 void ZeroStartup::EngineUpdate()
 {
-  Z::gEngine->Update();
+  UserEngineUpdate();
+
+  // Debug objects are normally cleared by the GraphicsEngine once drawn
+  if (mHeadless)
+  {
+    gDebugDraw->ClearObjects();
+    ZilchManager::GetInstance()->mDebugger.DoNotAllowBreakReason.Clear();
+  }
+
   if (Z::gEngine->mEngineActive)
     return;
 
@@ -450,6 +478,7 @@ void ZeroStartup::Shutdown()
     mExit = true;
   }
 
+  Profile::SamplingProfiler::Shutdown();
   Profile::ProfileSystem::Shutdown();
 }
 
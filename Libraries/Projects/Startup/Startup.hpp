@@ -56,6 +56,9 @@ protected:
                                WindowStyleFlags::Resizable | WindowStyleFlags::Close | WindowStyleFlags::ClientOnly);
   Cog* mWindowSettingsFromProjectCog = nullptr;
   bool mUseSplashScreen = false;
+  // Dedicated servers don't create a main window, graphics or sound systems. Their resources are still
+  // loaded since game objects reference them, but their components do nothing.
+  bool mHeadless = false;
 
   // This will be available in UserStartup.
   OsWindow* mMainWindow = nullptr;
@@ -74,6 +77,8 @@ protected:
   virtual void UserInitialize();
   virtual void UserStartup();
   virtual void UserCreation();
+  // Called every frame during EngineUpdate (the default just updates the engine).
+  virtual void UserEngineUpdate();
   virtual void UserShutdown();
   virtual void UserShutdownLibraries();
 
@@ -671,8 +671,14 @@ void BackupProjectJob::Execute()
   Array<ArchiveData> files;
   GetFileList(mProjectPath, String(), files);
 
+  // Each file is written to the final file location as soon as it's
+  // compressed so the project is never held in memory
+  File file;
+  file.Open(mDestinationFilePath, FileMode::Write, FileAccessPattern::Sequential);
+
   // Add each file to the archive, sending out progress events every so often
   Archive projectArchive(ArchiveMode::Compressing);
+  projectArchive.BeginStreaming(file);
   for (size_t i = 0; i < files.Size(); ++i)
   {
     ArchiveData& data = files[i];
@@ -682,8 +688,9 @@ void BackupProjectJob::Execute()
       UpdateProgress("ArchivingProject", i / (float)files.Size());
   }
 
-  // Write the zip to the final file location
-  projectArchive.WriteZipFile(mDestinationFilePath);
+  // Finish the zip
+  projectArchive.EndStreaming();
+  file.Close();
 
   // Mark that we've finished
   mState = BackgroundTaskState::Completed;
@@ -0,0 +1,6 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+#include "Startup/StartupStandard.hpp"
+#include "ServerTickMetrics.hpp"
+#include "ServerStartup.hpp"
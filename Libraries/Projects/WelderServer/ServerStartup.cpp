@@ -0,0 +1,135 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+void LoadGamePackages(StringParam projectFile, Cog* projectCog);
+
+void ServerStartup::UserInitialize()
+{
+  String projectFile = Environment::GetValue<String>("file");
+
+  static const String cDefaultProjectFile("Project.zeroproj");
+  if (projectFile.Empty() && FileExists(cDefaultProjectFile))
+    projectFile = cDefaultProjectFile;
+
+  if (projectFile.Empty())
+  {
+    ZPrint("Usage: WelderServer -file <Project.zeroproj> [-level <Name>] [-tickRate <Hz>] "
+           "[-maxCatchUpTicks <Count>] [-metricsInterval <Seconds>]\n");
+    return Exit(1);
+  }
+
+  Cog* projectCog = Z::gFactory->Create(Z::gEngine->GetEngineSpace(), projectFile, 0, nullptr);
+  if (projectCog == nullptr)
+  {
+    FatalEngineError("Failed load project '%s'", projectFile.c_str());
+    return Exit(1);
+  }
+
+  int tickRate = Environment::GetValue<int>("tickRate", 60);
+  int maxCatchUpTicks = Environment::GetValue<int>("maxCatchUpTicks", 5);
+  float metricsInterval = Environment::GetValue<float>("metricsInterval", 10.0f);
+
+  mTickRate = (uint)Math::Clamp(tickRate, 1, 1000);
+  mTickPeriod = 1.0 / mTickRate;
+  mMaxCatchUpTicks = (uint)Math::Max(maxCatchUpTicks, 0);
+  mMetricsInterval = Math::Max(metricsInterval, 0.0f);
+
+  // Content comes from the exported packages, there is no window to show a
+  // splash screen in
+  mHeadless = true;
+  mLoadContent = false;
+  mUseSplashScreen = false;
+
+  mProjectCog = projectCog;
+  mProjectFile = projectFile;
+  mLevelName = Environment::GetValue<String>("level");
+}
+
+void ServerStartup::UserStartup()
+{
+  LoadGamePackages(mProjectFile, mProjectCog);
+}
+
+void ServerStartup::UserCreation()
+{
+  ZPrint("Creating server game at %u ticks per second\n", mTickRate);
+
+  ProjectSettings* project = mProjectCog->has(ProjectSettings);
+  ObjectStore::GetInstance()->SetStoreName(project->ProjectName);
+
+  ZilchManager::GetInstance()->TriggerCompileExternally();
+
+  ObjectEvent event(mProjectCog);
+  Z::gEngine->DispatchEvent(Events::ProjectLoaded, &event);
+
+  // The project's frame rate settings are applied on ProjectLoaded. The server
+  // does its own pacing so the time system only needs to know the tick rate
+  // (spaces using fixed frame time step by it).
+  TimeSystem* timeSystem = Z::gEngine->has(TimeSystem);
+  timeSystem->mLimitFrameRate = false;
+  timeSystem->mFrameRate = mTickRate;
+
+  GameSession* game = Z::gEngine->CreateGameSession();
+  game->SetInEditor(false);
+  game->Start();
+
+  if (!mLevelName.Empty())
+  {
+    Level* level = LevelManager::FindOrNull(mLevelName);
+    Space* space = game->FindSpaceByName(SpecialCogNames::Main);
+    if (level == nullptr)
+      ZPrint("Level '%s' was not found, keeping the starting level\n", mLevelName.c_str());
+    else if (space == nullptr)
+      ZPrint("The game has no '%s' space to load level '%s' into\n", SpecialCogNames::Main.c_str(), mLevelName.c_str());
+    else
+      space->LoadLevel(level);
+  }
+
+  CommandManager::GetInstance()->RunParsedCommandsDelayed();
+
+  mTickTimer.Reset();
+  mNextTickTime = 0.0;
+  mNextReportTime = mMetricsInterval;
+}
+
+void ServerStartup::UserEngineUpdate()
+{
+  double now = mTickTimer.UpdateAndGetTime();
+
+  // Sleep until the deadline rather than spinning. Os::Sleep only has
+  // millisecond precision so anything shorter is picked up on the next call.
+  if (now < mNextTickTime)
+  {
+    uint sleepMs = (uint)((mNextTickTime - now) * 1000.0);
+    if (sleepMs != 0)
+      Os::Sleep(sleepMs);
+    return;
+  }
+
+  // Late ticks are run back to back to keep simulation time in step with real
+  // time, unless we've fallen so far behind (level load, debugger) that it's
+  // better to drop them
+  uint lateTicks = (uint)((now - mNextTickTime) / mTickPeriod);
+  if (lateTicks > mMaxCatchUpTicks)
+  {
+    mMetrics.AddSkippedTicks(lateTicks);
+    mNextTickTime = now;
+  }
+
+  Z::gEngine->Update();
+
+  double end = mTickTimer.UpdateAndGetTime();
+  mNextTickTime += mTickPeriod;
+  mMetrics.AddTick(end - now, end > mNextTickTime);
+
+  if (mMetricsInterval > 0.0 && end >= mNextReportTime)
+  {
+    mMetrics.Report();
+    mNextReportTime = end + mMetricsInterval;
+  }
+}
+
+} // namespace Zero
@@ -0,0 +1,42 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+/// Runs an exported project headless with a fixed tick rate. Instead of being
+/// paced by the window / vertical sync, each tick sleeps until its deadline.
+///
+/// Command line:
+///   -file <Project.zeroproj>  Project to run (defaults to Project.zeroproj in
+///                             the working directory).
+///   -level <Name>             Level to load instead of the starting level.
+///   -tickRate <Hz>            Ticks per second (default 60).
+///   -maxCatchUpTicks <Count>  How many late ticks are run back to back before
+///                             they are dropped (default 5).
+///   -metricsInterval <Sec>    Seconds between tick metric reports, 0 disables
+///                             them (default 10).
+class ServerStartup : public ZeroStartup
+{
+private:
+  Cog* mProjectCog = nullptr;
+  String mProjectFile;
+  String mLevelName;
+
+  uint mTickRate = 60;
+  double mTickPeriod = 1.0 / 60.0;
+  uint mMaxCatchUpTicks = 5;
+  double mMetricsInterval = 10.0;
+
+  Timer mTickTimer;
+  double mNextTickTime = 0.0;
+  double mNextReportTime = 0.0;
+  ServerTickMetrics mMetrics;
+
+  void UserInitialize() override;
+  void UserStartup() override;
+  void UserCreation() override;
+  void UserEngineUpdate() override;
+};
+
+} // namespace Zero
@@ -0,0 +1,55 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+ServerTickMetrics::ServerTickMetrics()
+{
+  Reset();
+}
+
+void ServerTickMetrics::AddTick(double durationSeconds, bool overran)
+{
+  ++mTickCount;
+  mTotalSeconds += durationSeconds;
+  mMinSeconds = Math::Min(mMinSeconds, durationSeconds);
+  mMaxSeconds = Math::Max(mMaxSeconds, durationSeconds);
+
+  if (overran)
+    ++mOverrunCount;
+}
+
+void ServerTickMetrics::AddSkippedTicks(uint count)
+{
+  mSkippedCount += count;
+}
+
+void ServerTickMetrics::Report()
+{
+  if (mTickCount == 0)
+    return;
+
+  double averageMs = mTotalSeconds / mTickCount * 1000.0;
+  ZPrint("Server ticks: %u avg: %.3fms min: %.3fms max: %.3fms overruns: %u skipped: %u\n",
+         mTickCount,
+         averageMs,
+         mMinSeconds * 1000.0,
+         mMaxSeconds * 1000.0,
+         mOverrunCount,
+         mSkippedCount);
+
+  Reset();
+}
+
+void ServerTickMetrics::Reset()
+{
+  mTickCount = 0;
+  mOverrunCount = 0;
+  mSkippedCount = 0;
+  mTotalSeconds = 0.0;
+  mMinSeconds = Math::DoublePositiveMax();
+  mMaxSeconds = 0.0;
+}
+
+} // namespace Zero
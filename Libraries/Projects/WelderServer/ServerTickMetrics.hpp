@@ -0,0 +1,31 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+/// Tick duration statistics for a dedicated server. Printed and reset at a
+/// fixed interval so fleet tooling can scrape them from the log.
+class ServerTickMetrics
+{
+public:
+  ServerTickMetrics();
+
+  /// Records how long a tick took and whether it ran past its deadline.
+  void AddTick(double durationSeconds, bool overran);
+  /// Ticks dropped because the server fell too far behind.
+  void AddSkippedTicks(uint count);
+
+  /// Prints the stats gathered since the last report and resets them.
+  void Report();
+  void Reset();
+
+  uint mTickCount;
+  uint mOverrunCount;
+  uint mSkippedCount;
+  double mTotalSeconds;
+  double mMinSeconds;
+  double mMaxSeconds;
+};
+
+} // namespace Zero
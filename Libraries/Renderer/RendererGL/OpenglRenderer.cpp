@@ -56,6 +56,7 @@ const Zero::String cZeroPerspectiveToApiPerspective("TransformData.ZeroPerspecti
 
 const Zero::String cSpriteSource("SpriteSource_SpriteSourceColor");
 const Zero::String cSpriteSourceCubePreview("SpriteSource_TextureCubePreview");
+const Zero::String cSpriteSourceDistanceField("SpriteSource_DistanceFieldTextColor");
 } // namespace
 
 namespace Zero
@@ -2100,7 +2101,11 @@ void OpenglRenderer::DrawStreamed(ViewNode& viewNode, FrameNode& frameNode)
       if (textureData->mType == TextureType::TextureCube)
         SetShaderParameter(ShaderInputType::Texture, cSpriteSourceCubePreview, &mNextTextureSlot);
       else
+      {
+        // Only one of these exists on the active shader
         SetShaderParameter(ShaderInputType::Texture, cSpriteSource, &mNextTextureSlot);
+        SetShaderParameter(ShaderInputType::Texture, cSpriteSourceDistanceField, &mNextTextureSlot);
+      }
       ++mNextTextureSlot;
     }
   }
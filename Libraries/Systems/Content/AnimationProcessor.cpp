@@ -199,6 +199,93 @@ void GetClipTrack(SceneTrack& sceneTrack, SceneTrack& clipTrack, float startTime
     key.Keytime -= offset;
 }
 
+// Utility functions for compressing the tracks
+Vec3 GetKeyValue(PositionKey& key)
+{
+  return key.Position;
+}
+
+Quat GetKeyValue(RotationKey& key)
+{
+  return key.Rotation;
+}
+
+Vec3 GetKeyValue(ScalingKey& key)
+{
+  return key.Scale;
+}
+
+template <typename ValueType, typename KeyType>
+void WriteCompressedCurve(
+    ChunkFileWriter& writer, Array<KeyType>& keys, uint channel, float tolerance, AnimationCompressionReport& report)
+{
+  if (keys.Empty())
+    return;
+
+  Array<float> times;
+  Array<ValueType> values;
+  forRange (KeyType& key, keys.All())
+  {
+    times.PushBack(key.Keytime);
+    values.PushBack(GetKeyValue(key));
+  }
+
+  CompressedCurve curve;
+  curve.Compress(times, values, tolerance);
+  report.AddCurve(channel, keys.Size(), sizeof(KeyType), curve, curve.GetMaxError(times, values));
+  curve.Write(writer);
+}
+
+void AnimationProcessor::WriteObjectTrack(ChunkFileWriter& writer,
+                                          SceneTrack& sceneTrack,
+                                          AnimationCompressionReport& report)
+{
+  if (mBuilder->mCompressTransforms)
+  {
+    u32 objectTrackStart = writer.StartChunk(CompressedObjectTrackChunk);
+    writer.Write(sceneTrack.FullPath);
+
+    // Empty channels aren't written
+    u32 channels = AnimationPoseChannels::None;
+    if (!sceneTrack.PositionKeys.Empty())
+      channels |= AnimationPoseChannels::Translation;
+    if (!sceneTrack.RotationKeys.Empty())
+      channels |= AnimationPoseChannels::Rotation;
+    if (!sceneTrack.ScalingKeys.Empty())
+      channels |= AnimationPoseChannels::Scale;
+    writer.Write(channels);
+
+    WriteCompressedCurve<Vec3>(
+        writer, sceneTrack.PositionKeys, AnimationPoseChannels::Translation, mBuilder->mTranslationTolerance, report);
+    WriteCompressedCurve<Quat>(
+        writer, sceneTrack.RotationKeys, AnimationPoseChannels::Rotation, mBuilder->mRotationTolerance, report);
+    WriteCompressedCurve<Vec3>(
+        writer, sceneTrack.ScalingKeys, AnimationPoseChannels::Scale, mBuilder->mScaleTolerance, report);
+
+    writer.EndChunk(objectTrackStart);
+    return;
+  }
+
+  u32 objectTrackStart = writer.StartChunk(ObjectTrackChunk);
+  ObjectTrackHeader trackHeader;
+  trackHeader.mNumPositionKeys = sceneTrack.PositionKeys.Size();
+  trackHeader.mNumRotationKeys = sceneTrack.RotationKeys.Size();
+  trackHeader.mNumScalingKeys = sceneTrack.ScalingKeys.Size();
+  writer.Write(trackHeader);
+  writer.Write(sceneTrack.FullPath);
+
+  for (size_t i = 0; i < trackHeader.mNumPositionKeys; ++i)
+    writer.Write(sceneTrack.PositionKeys[i]);
+
+  for (size_t i = 0; i < trackHeader.mNumRotationKeys; ++i)
+    writer.Write(sceneTrack.RotationKeys[i]);
+
+  for (size_t i = 0; i < trackHeader.mNumScalingKeys; ++i)
+    writer.Write(sceneTrack.ScalingKeys[i]);
+
+  writer.EndChunk(objectTrackStart);
+}
+
 void AnimationProcessor::ExportAnimationData(String outputPath)
 {
   size_t numAnimations = mAnimationDataArray.Size();
@@ -236,6 +323,7 @@ void AnimationProcessor::ExportAnimationData(String outputPath)
       endTime = Math::Clamp(endTime, 0.0f, animData.AnimationDuration);
       startTime = Math::Clamp(startTime, 0.0f, endTime);
 
+      AnimationCompressionReport report;
       AnimationHeader animHeader;
       animHeader.mAnimationDuration = endTime - startTime;
       animHeader.mNumTracks = animData.ObjectTracks.Size();
@@ -251,25 +339,11 @@ void AnimationProcessor::ExportAnimationData(String outputPath)
         GetClipTrack<RotationKey>(sceneTrack, clipTrack, startTime, endTime);
         GetClipTrack<ScalingKey>(sceneTrack, clipTrack, startTime, endTime);
 
-        u32 objectTrackStart = writer.StartChunk(ObjectTrackChunk);
-        ObjectTrackHeader trackHeader;
-        trackHeader.mNumPositionKeys = clipTrack.PositionKeys.Size();
-        trackHeader.mNumRotationKeys = clipTrack.RotationKeys.Size();
-        trackHeader.mNumScalingKeys = clipTrack.ScalingKeys.Size();
-        writer.Write(trackHeader);
-        writer.Write(clipTrack.FullPath);
-
-        for (size_t i = 0; i < trackHeader.mNumPositionKeys; ++i)
-          writer.Write(clipTrack.PositionKeys[i]);
-
-        for (size_t i = 0; i < trackHeader.mNumRotationKeys; ++i)
-          writer.Write(clipTrack.RotationKeys[i]);
-
-        for (size_t i = 0; i < trackHeader.mNumScalingKeys; ++i)
-          writer.Write(clipTrack.ScalingKeys[i]);
-
-        writer.EndChunk(objectTrackStart);
+        WriteObjectTrack(writer, clipTrack, report);
       }
+
+      if (mBuilder->mCompressTransforms)
+        report.Print(name);
     }
   }
   else
@@ -287,6 +361,7 @@ void AnimationProcessor::ExportAnimationData(String outputPath)
       ChunkFileWriter writer;
       writer.Open(outputFileName);
 
+      AnimationCompressionReport report;
       AnimationHeader animHeader;
       animHeader.mAnimationDuration = animData.AnimationDuration;
       animHeader.mNumTracks = animData.ObjectTracks.Size();
@@ -295,27 +370,11 @@ void AnimationProcessor::ExportAnimationData(String outputPath)
 
       for (size_t trackIndex = 0; trackIndex < animHeader.mNumTracks; ++trackIndex)
       {
-        SceneTrack& sceneTrack = animData.ObjectTracks[trackIndex];
-
-        u32 objectTrackStart = writer.StartChunk(ObjectTrackChunk);
-        ObjectTrackHeader trackHeader;
-        trackHeader.mNumPositionKeys = sceneTrack.PositionKeys.Size();
-        trackHeader.mNumRotationKeys = sceneTrack.RotationKeys.Size();
-        trackHeader.mNumScalingKeys = sceneTrack.ScalingKeys.Size();
-        writer.Write(trackHeader);
-        writer.Write(sceneTrack.FullPath);
-
-        for (size_t i = 0; i < trackHeader.mNumPositionKeys; ++i)
-          writer.Write(sceneTrack.PositionKeys[i]);
-
-        for (size_t i = 0; i < trackHeader.mNumRotationKeys; ++i)
-          writer.Write(sceneTrack.RotationKeys[i]);
-
-        for (size_t i = 0; i < trackHeader.mNumScalingKeys; ++i)
-          writer.Write(sceneTrack.ScalingKeys[i]);
-
-        writer.EndChunk(objectTrackStart);
+        WriteObjectTrack(writer, animData.ObjectTracks[trackIndex], report);
       }
+
+      if (mBuilder->mCompressTransforms)
+        report.Print(name);
     }
   }
 
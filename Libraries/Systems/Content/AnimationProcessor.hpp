@@ -35,6 +35,8 @@ public:
 
   void ExtractAndProcessAnimationData(const aiScene* scene);
   void ExportAnimationData(String outputPath);
+  /// Writes the track compressed if the builder is set to compress.
+  void WriteObjectTrack(ChunkFileWriter& writer, SceneTrack& sceneTrack, AnimationCompressionReport& report);
 
   AnimationBuilder* mBuilder;
   HierarchyDataMap& mHierarchyDataMap;
@@ -448,11 +448,29 @@ ZilchDefineType(AnimationBuilder, builder, type)
   ZeroBindDependency(GeometryContent);
 
   ZilchBindFieldProperty(mClips);
+  ZilchBindFieldProperty(mCompressTransforms);
+  ZilchBindFieldProperty(mTranslationTolerance);
+  ZilchBindFieldProperty(mRotationTolerance);
+  ZilchBindFieldProperty(mScaleTolerance);
+}
+
+AnimationBuilder::AnimationBuilder() : DirectBuilderComponent(10, ".animset.data", "AnimationSet")
+{
+  AnimationCompressionSettings settings;
+  mCompressTransforms = false;
+  mTranslationTolerance = settings.mTranslationTolerance;
+  mRotationTolerance = settings.mRotationTolerance;
+  mScaleTolerance = settings.mScaleTolerance;
 }
 
 void AnimationBuilder::Serialize(Serializer& stream)
 {
+  AnimationCompressionSettings settings;
   SerializeNameDefault(mClips, Array<AnimationClip>());
+  SerializeNameDefault(mCompressTransforms, false);
+  SerializeNameDefault(mTranslationTolerance, settings.mTranslationTolerance);
+  SerializeNameDefault(mRotationTolerance, settings.mRotationTolerance);
+  SerializeNameDefault(mScaleTolerance, settings.mScaleTolerance);
   SerializeNameDefault(mAnimations, Array<GeometryResourceEntry>());
 }
 
@@ -88,11 +88,17 @@ class AnimationBuilder : public DirectBuilderComponent
 public:
   ZilchDeclareType(AnimationBuilder, TypeCopyMode::ReferenceType);
 
-  AnimationBuilder() : DirectBuilderComponent(10, ".animset.data", "AnimationSet")
-  {
-  }
+  AnimationBuilder();
 
   Array<AnimationClip> mClips;
+  /// Removes keys from the Transform tracks that can be interpolated within
+  /// the tolerances and quantizes the rest. Reduces memory at a small cost in
+  /// accuracy.
+  bool mCompressTransforms;
+  float mTranslationTolerance;
+  /// In radians.
+  float mRotationTolerance;
+  float mScaleTolerance;
   Array<GeometryResourceEntry> mAnimations;
 
   // BuilderComponent Interface
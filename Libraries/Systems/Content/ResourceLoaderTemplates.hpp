@@ -155,14 +155,10 @@ public:
   {
     ResourceType* newResource = new ResourceType();
 
-    ChunkFileReader reader;
-    reader.Open(entry.FullPath);
-
-    LoadPattern::Load(newResource, reader);
+    LoadFromMappedFile(newResource, entry);
 
     ResourceMananger::GetInstance()->AddResource(entry, newResource);
 
-    reader.Close();
     return newResource;
   }
 
@@ -185,13 +181,30 @@ public:
     ResourceType* newResource = (ResourceType*)resource;
     newResource->Unload();
 
-    ChunkFileReader reader;
-    reader.Open(entry.FullPath);
-
-    LoadPattern::Load(newResource, reader);
+    LoadFromMappedFile(newResource, entry);
 
     resource->SendModified();
   }
+
+  // Chunk files are read a few bytes at a time, so they're read from a mapped
+  // view of the file when the platform can map it
+  void LoadFromMappedFile(ResourceType* resource, ResourceEntry& entry)
+  {
+    Status status;
+    MappedFile mappedFile;
+    if (mappedFile.Open(status, entry.FullPath))
+    {
+      ChunkBufferReader reader;
+      reader.Open(mappedFile.GetBlock());
+      LoadPattern::Load(resource, reader);
+      return;
+    }
+
+    ChunkFileReader reader;
+    reader.Open(entry.FullPath);
+    LoadPattern::Load(resource, reader);
+    reader.Close();
+  }
 };
 
 } // namespace Zero
@@ -1633,10 +1633,19 @@ ZilchDefineType(RichAnimationBuilder, builder, type)
   ZeroBindSetup(SetupMode::CallSetDefaults);
 
   ZilchBindGetterSetterProperty(PreviewArchetype)->Add(new MetaEditorResource(false, true));
+  ZilchBindFieldProperty(mCompressTransforms);
+  ZilchBindFieldProperty(mTranslationTolerance);
+  ZilchBindFieldProperty(mRotationTolerance);
+  ZilchBindFieldProperty(mScaleTolerance);
 }
 
 RichAnimationBuilder::RichAnimationBuilder() : DirectBuilderComponent(0, ".data", "Animation")
 {
+  AnimationCompressionSettings settings;
+  mCompressTransforms = false;
+  mTranslationTolerance = settings.mTranslationTolerance;
+  mRotationTolerance = settings.mRotationTolerance;
+  mScaleTolerance = settings.mScaleTolerance;
 }
 
 void RichAnimationBuilder::Initialize(ContentComposition* item)
@@ -1649,6 +1658,12 @@ void RichAnimationBuilder::Serialize(Serializer& stream)
 {
   DirectBuilderComponent::Serialize(stream);
   SerializeNameDefault(mPreviewArchetype, String());
+
+  AnimationCompressionSettings settings;
+  SerializeNameDefault(mCompressTransforms, false);
+  SerializeNameDefault(mTranslationTolerance, settings.mTranslationTolerance);
+  SerializeNameDefault(mRotationTolerance, settings.mRotationTolerance);
+  SerializeNameDefault(mScaleTolerance, settings.mScaleTolerance);
 }
 
 Archetype* RichAnimationBuilder::GetPreviewArchetype()
@@ -1680,6 +1695,18 @@ void RichAnimationBuilder::BuildContent(BuildOptions& buildOptions)
   Animation* animation = animationHandle;
   richAnimation.BakeToAnimation(animation);
 
+  if (mCompressTransforms)
+  {
+    AnimationCompressionSettings settings;
+    settings.mTranslationTolerance = mTranslationTolerance;
+    settings.mRotationTolerance = mRotationTolerance;
+    settings.mScaleTolerance = mScaleTolerance;
+
+    AnimationCompressionReport report;
+    CompressAnimation(animation, settings, report);
+    report.Print(Name);
+  }
+
   // Save the normal animation
   bool success = SaveToDataFile(*animation, destFile);
 
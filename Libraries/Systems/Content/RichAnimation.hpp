@@ -410,6 +410,13 @@ public:
   void SetPreviewArchetype(Archetype* archetype);
 
   String mPreviewArchetype;
+  /// Removes keys from the baked Transform tracks that can be interpolated
+  /// within the tolerances and quantizes the rest.
+  bool mCompressTransforms;
+  float mTranslationTolerance;
+  /// In radians.
+  float mRotationTolerance;
+  float mScaleTolerance;
 };
 
 } // namespace Zero
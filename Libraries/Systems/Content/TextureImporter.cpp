@@ -104,6 +104,130 @@ void ResizeImage(TextureFormat::Enum format,
     ResizeImage<::byte, 4>(srcImage, srcWidth, srcHeight, dstImage, dstWidth, dstHeight, ByteClamp);
 }
 
+// Below this many destination pixels a level is downsampled on the calling
+// thread, small mips aren't worth the job overhead.
+const uint cDownsamplePixelsPerJob = 128 * 1024;
+
+inline float BoxAverage(float p00, float p01, float p10, float p11)
+{
+  return (p00 + p01 + p10 + p11) * 0.25f;
+}
+
+inline u16 BoxAverage(u16 p00, u16 p01, u16 p10, u16 p11)
+{
+  return (u16)(((uint)p00 + p01 + p10 + p11) >> 2);
+}
+
+inline ::byte BoxAverage(::byte p00, ::byte p01, ::byte p10, ::byte p11)
+{
+  return (::byte)(((uint)p00 + p01 + p10 + p11) >> 2);
+}
+
+// Box filters the destination rows [rowBegin, rowEnd) of an image that is
+// exactly half the size of the source. For exact halves this gives the same
+// result as the bilinear ResizeImage (every sample lands between 4 texels).
+template <typename T, unsigned Channels>
+void HalveImageRows(const ::byte* srcImage, uint srcWidth, ::byte* dstImage, uint dstWidth, uint rowBegin, uint rowEnd)
+{
+  const T* src = (const T*)srcImage;
+  T* dst = (T*)dstImage;
+  uint srcStride = srcWidth * Channels;
+
+  for (uint y = rowBegin; y < rowEnd; ++y)
+  {
+    const T* row0 = src + y * 2 * srcStride;
+    const T* row1 = row0 + srcStride;
+    T* dstRow = dst + y * dstWidth * Channels;
+
+    for (uint x = 0; x < dstWidth; ++x)
+    {
+      uint i0 = x * 2 * Channels;
+      uint i1 = i0 + Channels;
+      for (uint c = 0; c < Channels; ++c)
+        dstRow[x * Channels + c] = BoxAverage(row0[i0 + c], row0[i1 + c], row1[i0 + c], row1[i1 + c]);
+    }
+  }
+}
+
+void HalveImageRows(TextureFormat::Enum format,
+                    const ::byte* srcImage,
+                    uint srcWidth,
+                    ::byte* dstImage,
+                    uint dstWidth,
+                    uint rowBegin,
+                    uint rowEnd)
+{
+  if (format == TextureFormat::RGB32f)
+    HalveImageRows<float, 3>(srcImage, srcWidth, dstImage, dstWidth, rowBegin, rowEnd);
+  else if (format == TextureFormat::RGBA16)
+    HalveImageRows<u16, 4>(srcImage, srcWidth, dstImage, dstWidth, rowBegin, rowEnd);
+  else
+    HalveImageRows<::byte, 4>(srcImage, srcWidth, dstImage, dstWidth, rowBegin, rowEnd);
+}
+
+class HalveImageJob : public Job
+{
+public:
+  void Execute() override
+  {
+    HalveImageRows(mFormat, mSrcImage, mSrcWidth, mDstImage, mDstWidth, mRowBegin, mRowEnd);
+    mCountdownEvent->DecrementCount();
+  }
+
+  TextureFormat::Enum mFormat;
+  const ::byte* mSrcImage;
+  uint mSrcWidth;
+  ::byte* mDstImage;
+  uint mDstWidth;
+  uint mRowBegin;
+  uint mRowEnd;
+  CountdownEvent* mCountdownEvent;
+};
+
+void DownsampleImage(TextureFormat::Enum format,
+                     const ::byte* srcImage,
+                     uint srcWidth,
+                     uint srcHeight,
+                     ::byte* dstImage,
+                     uint dstWidth,
+                     uint dstHeight)
+{
+  // Odd sizes and 1 pixel wide levels don't line up with the box filter
+  if (srcWidth != dstWidth * 2 || srcHeight != dstHeight * 2)
+  {
+    ResizeImage(format, srcImage, srcWidth, srcHeight, dstImage, dstWidth, dstHeight);
+    return;
+  }
+
+  if (dstWidth * dstHeight < cDownsamplePixelsPerJob)
+  {
+    HalveImageRows(format, srcImage, srcWidth, dstImage, dstWidth, 0, dstHeight);
+    return;
+  }
+
+  // Split the level into bands of rows
+  uint rowsPerJob = Math::Max(cDownsamplePixelsPerJob / dstWidth, 1u);
+  CountdownEvent countdownEvent;
+  for (uint rowBegin = 0; rowBegin < dstHeight; rowBegin += rowsPerJob)
+  {
+    countdownEvent.IncrementCount();
+
+    HalveImageJob* job = new HalveImageJob();
+    job->mFormat = format;
+    job->mSrcImage = srcImage;
+    job->mSrcWidth = srcWidth;
+    job->mDstImage = dstImage;
+    job->mDstWidth = dstWidth;
+    job->mRowBegin = rowBegin;
+    job->mRowEnd = Math::Min(rowBegin + rowsPerJob, dstHeight);
+    job->mCountdownEvent = &countdownEvent;
+    job->mRunImmediateWhenThreadingDisabled = true;
+    Z::gJobs->AddJob(job);
+  }
+
+  countdownEvent.Wait();
+}
+
 void MipmapTexture(Array<MipHeader>& mipHeaders, Array<::byte*>& imageData, TextureFormat::Enum format, bool compressed)
 {
   if (mipHeaders.Size() != 1 || imageData.Size() != 1)
@@ -151,7 +275,7 @@ void MipmapTexture(Array<MipHeader>& mipHeaders, Array<::byte*>& imageData, Text
     uint newSize = newWidth * newHeight * pixelSize;
 
     ::byte* newImage = new ::byte[newSize];
-    ResizeImage(format, image, width, height, newImage, newWidth, newHeight);
+    DownsampleImage(format, image, width, height, newImage, newWidth, newHeight);
 
     MipHeader header;
     header.mFace = TextureFace::None;
@@ -367,6 +491,92 @@ float GetCompressionRatio(TextureCompression::Enum compression)
   }
 }
 
+bool CompressMip(TextureFormat::Enum format,
+                 TextureCompression::Enum compression,
+                 MipHeader& mipHeader,
+                 ::byte*& imageData)
+{
+  uint width = mipHeader.mWidth;
+  uint height = mipHeader.mHeight;
+
+  // Compressed image must be a multiple of 4
+  // Pixel padding caused by compressing sizes 2 or 1 works correctly if
+  // image needs to be y inverted
+  uint newWidth = width;
+  uint newHeight = height;
+  if (width >= 3 && width % 4 != 0)
+    newWidth = width + 4 - width % 4;
+  if (height >= 3 && height % 4 != 0)
+    newHeight = height + 4 - height % 4;
+  if (newWidth != width || newHeight != height)
+  {
+    uint newSize = newWidth * newHeight * GetPixelSize(format);
+    ::byte* newImage = new ::byte[newSize];
+
+    ResizeImage(format, imageData, width, height, newImage, newWidth, newHeight);
+
+    delete[] imageData;
+    imageData = newImage;
+
+    width = newWidth;
+    height = newHeight;
+  }
+
+  nvtt::Surface surface;
+  ToNvttSurface(surface, width, height, format, imageData);
+
+  nvtt::CompressionOptions compressionOptions;
+  compressionOptions.setFormat(NvttFormat(compression));
+  compressionOptions.setQuality(nvtt::Quality_Fastest);
+
+  CompressionOutput compressionOutput;
+  CompressedError compressedError;
+
+  nvtt::OutputOptions outputOptions;
+  outputOptions.setOutputHandler(&compressionOutput);
+  outputOptions.setErrorHandler(&compressedError);
+  outputOptions.setContainer(nvtt::Container_DDS10);
+
+  nvtt::Context context;
+
+  // NVidia texture tools uses threads (pthreads on Emscripten) and
+  // since threads are disabled, this unfortunately just freezes in
+  // browsers. For now, we actually support not having compressed textures.
+#if defined(WelderTargetOsEmscripten)
+  bool result = true;
+#else
+  bool result = context.compress(surface, 0, 0, compressionOptions, outputOptions);
+#endif
+
+  if (!result)
+    return false;
+
+  mipHeader.mWidth = width;
+  mipHeader.mHeight = height;
+  mipHeader.mDataSize = compressionOutput.mSize;
+
+  delete[] imageData;
+  imageData = compressionOutput.mData;
+  return true;
+}
+
+class CompressMipJob : public Job
+{
+public:
+  void Execute() override
+  {
+    *mResult = CompressMip(mFormat, mCompression, *mMipHeader, *mImageData);
+    mCountdownEvent->DecrementCount();
+  }
+
+  TextureFormat::Enum mFormat;
+  TextureCompression::Enum mCompression;
+  MipHeader* mMipHeader;
+  ::byte** mImageData;
+  bool* mResult;
+  CountdownEvent* mCountdownEvent;
+};
+
 ImageProcessorCodes::Enum TextureImporter::ProcessTexture(Status& status)
 {
   if (!FileExists(mInputFile))
@@ -421,7 +631,7 @@ ImageProcessorCodes::Enum TextureImporter::ProcessTexture(Status& status)
         uint newHeight = Math::Max(height / 2, 1u);
         uint newSize = newWidth * newHeight * pixelSize;
         ::byte* newImageData = new ::byte[newSize];
-        ResizeImage(mLoadFormat, mImageData[0], width, height, newImageData, newWidth, newHeight);
+        DownsampleImage(mLoadFormat, mImageData[0], width, height, newImageData, newWidth, newHeight);
 
         mMipHeaders[0].mWidth = newWidth;
         mMipHeaders[0].mHeight = newHeight;
@@ -591,77 +801,39 @@ ImageProcessorCodes::Enum TextureImporter::ProcessTexture(Status& status)
 
   if (mBuilder->mCompression != TextureCompression::None)
   {
-    uint dataOffset = 0;
+    // Every mip and face is compressed independently with its own context
+    Array<bool> results(mMipHeaders.Size(), false);
+    CountdownEvent countdownEvent;
     for (uint i = 0; i < mMipHeaders.Size(); ++i)
     {
-      uint width = mMipHeaders[i].mWidth;
-      uint height = mMipHeaders[i].mHeight;
-
-      // Compressed image must be a multiple of 4
-      // Pixel padding caused by compressing sizes 2 or 1 works correctly if
-      // image needs to be y inverted
-      uint newWidth = width;
-      uint newHeight = height;
-      if (width >= 3 && width % 4 != 0)
-        newWidth = width + 4 - width % 4;
-      if (height >= 3 && height % 4 != 0)
-        newHeight = height + 4 - height % 4;
-      if (newWidth != width || newHeight != height)
-      {
-        uint newSize = newWidth * newHeight * GetPixelSize(mLoadFormat);
-        ::byte* newImage = new ::byte[newSize];
-
-        ResizeImage(mLoadFormat, mImageData[i], width, height, newImage, newWidth, newHeight);
-
-        delete[] mImageData[i];
-        mImageData[i] = newImage;
-
-        width = newWidth;
-        height = newHeight;
-      }
-
-      nvtt::Surface surface;
-      ToNvttSurface(surface, width, height, mLoadFormat, mImageData[i]);
-
-      nvtt::CompressionOptions compressionOptions;
-      compressionOptions.setFormat(NvttFormat(mBuilder->mCompression));
-      compressionOptions.setQuality(nvtt::Quality_Fastest);
-
-      CompressionOutput compressionOutput;
-      CompressedError compressedError;
-
-      nvtt::OutputOptions outputOptions;
-      outputOptions.setOutputHandler(&compressionOutput);
-      outputOptions.setErrorHandler(&compressedError);
-      outputOptions.setContainer(nvtt::Container_DDS10);
-
-      nvtt::Context context;
+      countdownEvent.IncrementCount();
+
+      CompressMipJob* job = new CompressMipJob();
+      job->mFormat = mLoadFormat;
+      job->mCompression = mBuilder->mCompression;
+      job->mMipHeader = &mMipHeaders[i];
+      job->mImageData = &mImageData[i];
+      job->mResult = &results[i];
+      job->mCountdownEvent = &countdownEvent;
+      job->mRunImmediateWhenThreadingDisabled = true;
+      Z::gJobs->AddJob(job);
+    }
 
-      // NVidia texture tools uses threads (pthreads on Emscripten) and
-      // since threads are disabled, this unfortunately just freezes in
-      // browsers. For now, we actually support not having compressed textures.
-#if defined(WelderTargetOsEmscripten)
-      bool result = true;
-#else
-      bool result = context.compress(surface, 0, 0, compressionOptions, outputOptions);
-#endif
+    countdownEvent.Wait();
 
-      if (!result)
-      {
-        mBuilder = nullptr;
-        delete mImageContent;
-        status.SetFailed("Compression failed");
-        return ImageProcessorCodes::Failed;
-      }
+    if (results.Contains(false))
+    {
+      mBuilder = nullptr;
+      delete mImageContent;
+      status.SetFailed("Compression failed");
+      return ImageProcessorCodes::Failed;
+    }
 
-      mMipHeaders[i].mWidth = width;
-      mMipHeaders[i].mHeight = height;
-      mMipHeaders[i].mDataSize = compressionOutput.mSize;
+    uint dataOffset = 0;
+    for (uint i = 0; i < mMipHeaders.Size(); ++i)
+    {
       mMipHeaders[i].mDataOffset = dataOffset;
       dataOffset += mMipHeaders[i].mDataSize;
-
-      delete[] mImageData[i];
-      mImageData[i] = compressionOutput.mData;
     }
   }
 
@@ -188,13 +188,15 @@ Mat4 Camera::GetPerspectiveTransform()
   {
     BuildPerspectiveTransformZero(
         mViewToPerspective, Math::DegToRad(mFieldOfView), mAspectRatio, mNearPlane, mFarPlane);
-    Z::gRenderer->BuildPerspectiveTransform(
-        mViewToApiPerspective, Math::DegToRad(mFieldOfView), mAspectRatio, mNearPlane, mFarPlane);
+    if (Z::gRenderer)
+      Z::gRenderer->BuildPerspectiveTransform(
+          mViewToApiPerspective, Math::DegToRad(mFieldOfView), mAspectRatio, mNearPlane, mFarPlane);
   }
   else
   {
     BuildOrthographicTransformZero(mViewToPerspective, mSize, mAspectRatio, mNearPlane, mFarPlane);
-    Z::gRenderer->BuildOrthographicTransform(mViewToApiPerspective, mSize, mAspectRatio, mNearPlane, mFarPlane);
+    if (Z::gRenderer)
+      Z::gRenderer->BuildOrthographicTransform(mViewToApiPerspective, mSize, mAspectRatio, mNearPlane, mFarPlane);
   }
 
   mDirtyPerspective = false;
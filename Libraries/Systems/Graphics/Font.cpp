@@ -18,6 +18,8 @@ bool IsPrintable(Rune rune)
   return (rune >= 32 && rune < 127) || rune == 169 || rune == 149 || rune == 245 || rune > 255;
 }
 
+uint RenderFont::sTextureVersion = 0;
+
 RenderFont::RenderFont(Font* fontObject, int fontHeight) :
     mFont(fontObject),
     mFontHeight(fontHeight),
@@ -25,8 +27,26 @@ RenderFont::RenderFont(Font* fontObject, int fontHeight) :
     mTexPosX(cFontSpacing),
     mTexPosY(cFontSpacing),
     mMaxWidthInPixels(1),
-    mMaxHeightInPixels(1)
+    mMaxHeightInPixels(1),
+    mAtlas(nullptr),
+    mAtlasScale(1.0f)
+{
+}
+
+RenderFont::RenderFont(Font* fontObject, int fontHeight, DistanceFieldAtlas* atlas) :
+    mFont(fontObject),
+    mFontHeight(fontHeight),
+    mTextureSize(cDistanceFieldAtlasSize),
+    mTexPosX(0),
+    mTexPosY(0),
+    mMaxWidthInPixels(1),
+    mMaxHeightInPixels(1),
+    mAtlas(atlas),
+    mAtlasScale(fontHeight / (float)cDistanceFieldFontHeight)
 {
+  mDescent = atlas->mDescent * mAtlasScale;
+  mLineHeight = atlas->mLineHeight * mAtlasScale;
+  mTexture = atlas->mTexture;
 }
 
 RenderFont::~RenderFont()
@@ -123,6 +143,18 @@ RenderRune& RenderFont::GetRenderRune(Rune rune)
 
   if (renderRune)
     return *renderRune;
+  // Distance field runes only need to be scaled from the atlas
+  else if (mAtlas)
+  {
+    RenderRune atlasRune = mAtlas->GetRenderRune(rune.value);
+
+    RenderRune& scaledRune = mRunes[rune.value];
+    scaledRune.Rect = atlasRune.Rect;
+    scaledRune.Size = atlasRune.Size * mAtlasScale;
+    scaledRune.Offset = atlasRune.Offset * mAtlasScale;
+    scaledRune.Advance = atlasRune.Advance * mAtlasScale;
+    return scaledRune;
+  }
   // if the rune isn't rasterized yet, attempt to load it
   else
   {
@@ -178,13 +210,15 @@ ZilchDefineType(Font, builder, type)
   ZeroBindDocumented();
 }
 
-Font::Font()
+Font::Font() : mDistanceFieldAtlas(nullptr)
 {
 }
 
 Font::~Font()
 {
   DeleteObjectsInContainer(mRendered);
+  DeleteObjectsInContainer(mDistanceFieldRendered);
+  SafeDelete(mDistanceFieldAtlas);
 
   if (FontBlock)
     FreeBlock(FontBlock);
@@ -203,6 +237,20 @@ RenderFont* Font::GetRenderFont(uint size)
   }
 }
 
+RenderFont* Font::GetDistanceFieldRenderFont(uint size)
+{
+  RenderFont* renderFont = mDistanceFieldRendered.FindValue(size, nullptr);
+  if (renderFont)
+    return renderFont;
+
+  if (mDistanceFieldAtlas == nullptr)
+    mDistanceFieldAtlas = new DistanceFieldAtlas(this);
+
+  renderFont = new RenderFont(this, size, mDistanceFieldAtlas);
+  mDistanceFieldRendered[size] = renderFont;
+  return renderFont;
+}
+
 class FontLoaderTtf : public ResourceLoader
 {
   HandleOf<Resource> LoadFromFile(ResourceEntry& entry)
@@ -225,6 +273,8 @@ class FontLoaderTtf : public ResourceLoader
 
 ImplementResourceManager(FontManager, Font);
 
+bool FontManager::sDistanceFieldFonts = false;
+
 FontManager::~FontManager()
 {
 }
@@ -244,6 +294,8 @@ FontManager::FontManager(BoundType* resourceType) : ResourceManager(resourceType
 RenderFont* FontManager::GetRenderFont(StringParam face, uint size, uint flags)
 {
   Font* font = FontManager::Find(face);
+  if (sDistanceFieldFonts)
+    return font->GetDistanceFieldRenderFont(size);
   return font->GetRenderFont(size);
 }
 
@@ -564,6 +616,9 @@ void FontRasterizer::LoadGlyphsOntoTexture(bool isOriginalTexture)
     mRenderFont->mRunes[runeCode] = missingRune;
   }
 
+  if (!isOriginalTexture)
+    ++RenderFont::sTextureVersion;
+
   mRenderFont->mTexture = texture;
   mFontObject->mRendered[fontHeight] = mRenderFont;
 }
@@ -695,4 +750,328 @@ bool FontRasterizer::RoomOnTextureForRunes(int xPos, int yPos)
   return runeSlotsLeft >= mGlyphInfo.Size();
 }
 
+// Distance Field Glyph
+struct DistanceFieldGlyph
+{
+  uint GlyphIndex;
+  // Reserved rect in the atlas (includes the spread on every side)
+  int X;
+  int Y;
+  int Width;
+  int Height;
+  // Filled out by the job
+  Image Field;
+};
+
+// Stores the distance to the closest texel on the other side of the glyph's
+// outline in alpha (0.5 on the outline, inside is above). Glyphs are small at
+// the atlas height so a search within the spread is fast enough.
+void GenerateDistanceField(FT_Bitmap* bitmap, DistanceFieldGlyph* glyph)
+{
+  const int spread = cDistanceFieldSpread;
+  int bitmapWidth = (int)bitmap->width;
+  int bitmapHeight = (int)bitmap->rows;
+
+  // Threshold the coverage once, padded by the spread
+  int width = glyph->Width;
+  int height = glyph->Height;
+  Array<bool> inside(width * height, false);
+  for (int y = 0; y < bitmapHeight && y + spread < height; ++y)
+  {
+    for (int x = 0; x < bitmapWidth && x + spread < width; ++x)
+      inside[(x + spread) + (y + spread) * width] = bitmap->buffer[y * bitmap->pitch + x] >= 128;
+  }
+
+  glyph->Field.Allocate(width, height);
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      bool isInside = inside[x + y * width];
+      int closestSq = (spread + 1) * (spread + 1);
+
+      int startY = Math::Max(y - spread, 0);
+      int endY = Math::Min(y + spread, height - 1);
+      int startX = Math::Max(x - spread, 0);
+      int endX = Math::Min(x + spread, width - 1);
+      for (int sy = startY; sy <= endY; ++sy)
+      {
+        for (int sx = startX; sx <= endX; ++sx)
+        {
+          if (inside[sx + sy * width] == isInside)
+            continue;
+
+          int dx = sx - x;
+          int dy = sy - y;
+          closestSq = Math::Min(closestSq, dx * dx + dy * dy);
+        }
+      }
+
+      // The outline is half way between texel centers
+      float distance = Math::Sqrt((float)closestSq) - 0.5f;
+      if (!isInside)
+        distance = -distance;
+
+      float value = Math::Clamp(0.5f + distance / (2.0f * spread), 0.0f, 1.0f);
+      ImagePixel alpha = (ImagePixel)(value * 255.0f);
+      glyph->Field.SetPixel(x, y, (alpha << 24) | 0x00FFFFFF);
+    }
+  }
+}
+
+// Distance Field Glyph Job
+class DistanceFieldGlyphJob : public Job
+{
+public:
+  void Execute() override
+  {
+    // Freetype objects can't be shared between threads, every job loads its
+    // own face from the atlas' font data
+    FT_Library library;
+    FT_Face face;
+    bool loaded = FT_Init_FreeType(&library) == 0;
+    loaded = loaded && FT_New_Memory_Face(library, mAtlas->mFontSource.Data, mAtlas->mFontSource.Size, 0, &face) == 0;
+
+    if (loaded)
+    {
+      FT_Set_Pixel_Sizes(face, 0, cDistanceFieldFontHeight);
+      FT_Select_Charmap(face, FT_ENCODING_UNICODE);
+
+      forRange (DistanceFieldGlyph* glyph, mGlyphs.All())
+      {
+        if (FT_Load_Glyph(face, glyph->GlyphIndex, FT_LOAD_DEFAULT) != 0)
+          continue;
+        if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL) != 0)
+          continue;
+
+        GenerateDistanceField(&face->glyph->bitmap, glyph);
+      }
+
+      FT_Done_Face(face);
+    }
+
+    FT_Done_FreeType(library);
+
+    mAtlas->CompleteGlyphs(mGlyphs);
+    mAtlas->mPendingJobs.DecrementCount();
+  }
+
+  DistanceFieldAtlas* mAtlas;
+  Array<DistanceFieldGlyph*> mGlyphs;
+};
+
+// Distance Field Atlas
+DistanceFieldAtlas::DistanceFieldAtlas(Font* fontObject) :
+    mFontObject(fontObject),
+    mPenX(1),
+    mPenY(1),
+    mRowHeight(0),
+    mFull(false)
+{
+  mData = new FontRasterizerData();
+  int errorCode = FT_Init_FreeType(&mData->Library);
+  ErrorIf(errorCode != 0, nullptr, "Failed to load freetype.");
+
+  // Same as FontRasterizer::LoadFontFace
+  mFontSource = ReadFileIntoDataBlock(mFontObject->LoadPath.c_str());
+  errorCode = FT_New_Memory_Face(mData->Library, mFontSource.Data, mFontSource.Size, 0, &mData->FontFace);
+  ErrorIf(errorCode != 0, nullptr, "Bad file or path.");
+
+  FT_Set_Pixel_Sizes(mData->FontFace, 0, cDistanceFieldFontHeight);
+  FT_Select_Charmap(mData->FontFace, FT_ENCODING_UNICODE);
+
+  mDescent = -(float)FtToPixels(mData->FontFace->size->metrics.descender);
+  mLineHeight = (float)FtToPixels(mData->FontFace->size->metrics.height);
+
+  // Glyphs are sub uploaded as they finish, start out empty
+  Image image;
+  image.Allocate(cDistanceFieldAtlasSize, cDistanceFieldAtlasSize);
+  image.ClearColorTo(0x00FFFFFF);
+  mTexture = Texture::CreateRuntime();
+  mTexture->mFiltering = TextureFiltering::Bilinear;
+  mTexture->mDistanceField = true;
+  mTexture->Upload(
+      cDistanceFieldAtlasSize, cDistanceFieldAtlasSize, TextureFormat::RGBA8, (::byte*)image.Data, image.SizeInBytes);
+
+  // Same default set as rasterized fonts
+  for (int runeCode = 0; runeCode < cAnsiRunes; ++runeCode)
+  {
+    if (!mRunes.ContainsKey(runeCode))
+      AddRune(runeCode);
+  }
+  QueueGlyphJobs();
+
+  ConnectThisTo(Z::gEngine, Events::EngineUpdate, OnEngineUpdate);
+}
+
+DistanceFieldAtlas::~DistanceFieldAtlas()
+{
+  // Jobs reference the font data and the atlas
+  mPendingJobs.Wait();
+
+  DeleteObjectsInContainer(mQueuedGlyphs);
+  DeleteObjectsInContainer(mCompletedGlyphs);
+
+  FT_Done_Face(mData->FontFace);
+  FT_Done_FreeType(mData->Library);
+  SafeDelete(mData);
+  zDeallocate(mFontSource.Data);
+}
+
+RenderRune& DistanceFieldAtlas::GetRenderRune(int runeCode)
+{
+  RenderRune* renderRune = mRunes.FindPointer(runeCode);
+  if (renderRune)
+    return *renderRune;
+
+  AddRune(runeCode);
+  QueueGlyphJobs();
+  return mRunes[runeCode];
+}
+
+void DistanceFieldAtlas::AddRune(int runeCode)
+{
+  Rune rune = Rune(runeCode);
+
+  RenderRune renderRune;
+  renderRune.Rect.TopLeft = Vec2::cZero;
+  renderRune.Rect.BotRight = Vec2::cZero;
+  renderRune.Size = Vec2::cZero;
+  renderRune.Offset = Vec2::cZero;
+  renderRune.Advance = 0.0f;
+
+  // Unprintable runes draw as the empty rune, missing glyphs as a '?'. The
+  // fallbacks are copied since adding to the map can invalidate them.
+  if (!IsPrintable(rune))
+  {
+    RenderRune emptyRune = GetRenderRune(cEmptyRuneIndex);
+    mRunes[runeCode] = emptyRune;
+    return;
+  }
+
+  FT_Face face = mData->FontFace;
+  FT_UInt glyphIndex = FT_Get_Char_Index(face, UTF8::Utf8ToUtf32(rune));
+  if (glyphIndex == cMissingGlyphIndex || FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT) != 0)
+  {
+    if (runeCode != '?')
+      renderRune = GetRenderRune('?');
+    mRunes[runeCode] = renderRune;
+    return;
+  }
+
+  FT_Glyph_Metrics& metrics = face->glyph->metrics;
+  int glyphWidth = FtToPixels(metrics.width);
+  int glyphHeight = FtToPixels(metrics.height);
+  renderRune.Advance = (float)FtToPixels(face->glyph->advance.x);
+
+  // Nothing to draw for white space
+  if (glyphWidth == 0 || glyphHeight == 0)
+  {
+    mRunes[runeCode] = renderRune;
+    return;
+  }
+
+  // The rendered bitmap can be a pixel larger than the metrics
+  int width = glyphWidth + 1 + cDistanceFieldSpread * 2;
+  int height = glyphHeight + 1 + cDistanceFieldSpread * 2;
+  int x, y;
+  if (!AllocateRect(width, height, x, y))
+  {
+    if (!mFull)
+      DoNotifyWarning("Font atlas full", "Distance field font atlas is out of space, new runes will draw as '?'.");
+    mFull = true;
+
+    if (runeCode != '?')
+      renderRune = GetRenderRune('?');
+    mRunes[runeCode] = renderRune;
+    return;
+  }
+
+  float atlasSize = (float)cDistanceFieldAtlasSize;
+  renderRune.Size = Vec2((float)width, (float)height);
+  renderRune.Offset = Vec2((float)(FtToPixels(metrics.horiBearingX) - cDistanceFieldSpread),
+                           (float)(FtToPixels(-metrics.horiBearingY) + cDistanceFieldFontHeight - cDistanceFieldSpread));
+  renderRune.Rect.TopLeft = Vec2(x / atlasSize, y / atlasSize);
+  renderRune.Rect.BotRight = Vec2((x + width) / atlasSize, (y + height) / atlasSize);
+  mRunes[runeCode] = renderRune;
+
+  DistanceFieldGlyph* glyph = new DistanceFieldGlyph();
+  glyph->GlyphIndex = glyphIndex;
+  glyph->X = x;
+  glyph->Y = y;
+  glyph->Width = width;
+  glyph->Height = height;
+  mQueuedGlyphs.PushBack(glyph);
+}
+
+bool DistanceFieldAtlas::AllocateRect(int width, int height, int& x, int& y)
+{
+  // Start a new row when this one is full
+  if (mPenX + width + 1 > cDistanceFieldAtlasSize)
+  {
+    mPenX = 1;
+    mPenY += mRowHeight + 1;
+    mRowHeight = 0;
+  }
+
+  if (mPenY + height + 1 > cDistanceFieldAtlasSize)
+    return false;
+
+  x = mPenX;
+  y = mPenY;
+  mPenX += width + 1;
+  mRowHeight = Math::Max(mRowHeight, height);
+  return true;
+}
+
+void DistanceFieldAtlas::QueueGlyphJobs()
+{
+  // Every job has to load the face, so glyphs are batched
+  const uint glyphsPerJob = 16;
+
+  for (uint start = 0; start < mQueuedGlyphs.Size(); start += glyphsPerJob)
+  {
+    uint end = Math::Min(start + glyphsPerJob, (uint)mQueuedGlyphs.Size());
+
+    DistanceFieldGlyphJob* job = new DistanceFieldGlyphJob();
+    job->mAtlas = this;
+    job->mGlyphs.Assign(mQueuedGlyphs.SubRange(start, end - start));
+    job->mRunImmediateWhenThreadingDisabled = true;
+
+    mPendingJobs.IncrementCount();
+    Z::gJobs->AddJob(job);
+  }
+
+  mQueuedGlyphs.Clear();
+}
+
+void DistanceFieldAtlas::CompleteGlyphs(Array<DistanceFieldGlyph*>& glyphs)
+{
+  mLock.Lock();
+  mCompletedGlyphs.Append(glyphs.All());
+  mLock.Unlock();
+}
+
+void DistanceFieldAtlas::UploadCompletedGlyphs()
+{
+  Array<DistanceFieldGlyph*> completedGlyphs;
+
+  mLock.Lock();
+  completedGlyphs.Swap(mCompletedGlyphs);
+  mLock.Unlock();
+
+  forRange (DistanceFieldGlyph* glyph, completedGlyphs.All())
+  {
+    // Glyphs that failed to render are left empty
+    if (glyph->Field.Data != nullptr)
+      mTexture->SubUpload(glyph->Field, glyph->X, glyph->Y);
+    delete glyph;
+  }
+}
+
+void DistanceFieldAtlas::OnEngineUpdate(Event* event)
+{
+  UploadCompletedGlyphs();
+}
+
 } // namespace Zero
@@ -5,6 +5,8 @@ namespace Zero
 {
 // Forward declaration
 struct FontRasterizerData;
+struct DistanceFieldGlyph;
+class DistanceFieldAtlas;
 class Font;
 
 /// Text format constants and helpers
@@ -16,6 +18,11 @@ bool IsPrintable(Rune rune);
 const int cAnsiRunes = 256;
 const int cDefaultFontTextureSize = 512;
 const int cFontSpacing = 4;
+// Pixel height glyphs are rendered at in distance field atlases
+const int cDistanceFieldFontHeight = 32;
+// How many pixels of distance are stored around each distance field glyph
+const int cDistanceFieldSpread = 4;
+const int cDistanceFieldAtlasSize = 1024;
 
 struct RenderGlyph
 {
@@ -50,6 +57,8 @@ class RenderFont : public Resource
 {
 public:
   RenderFont(Font* fontObject, int fontHeight);
+  /// A render font at any size that scales the runes of a distance field atlas.
+  RenderFont(Font* fontObject, int fontHeight, DistanceFieldAtlas* atlas);
   ~RenderFont();
 
   /// How wide is the given string
@@ -73,6 +82,10 @@ public:
 
   RenderRune& GetRenderRune(Rune runeCode);
 
+  /// Changes whenever any font's runes are moved to a new texture, so text
+  /// that was laid out before then has the wrong texture and coordinates.
+  static uint sTextureVersion;
+
   HashMap<int, RenderRune> mRunes;
   HandleOf<Texture> mTexture;
   // Data for texture to keep track of current status
@@ -85,6 +98,11 @@ public:
   // when adding new glyphs to a default rasterized font
   int mMaxWidthInPixels;
   int mMaxHeightInPixels;
+
+  // Only set for distance field fonts, runes are copied from the atlas and
+  // scaled to this font's height instead of being rasterized
+  DistanceFieldAtlas* mAtlas;
+  float mAtlasScale;
 };
 
 // Font Class
@@ -100,6 +118,12 @@ public:
   HashMap<int, RenderFont*> mRendered;
   RenderFont* GetRenderFont(uint size);
   DataBlock FontBlock;
+
+  /// Render font for the given size that shares the font's distance field
+  /// atlas. Must be drawn with the DistanceFieldText material.
+  RenderFont* GetDistanceFieldRenderFont(uint size);
+  HashMap<int, RenderFont*> mDistanceFieldRendered;
+  DistanceFieldAtlas* mDistanceFieldAtlas;
 };
 
 class FontManager : public ResourceManager
@@ -110,6 +134,65 @@ public:
   FontManager(BoundType* resourceType);
   ~FontManager();
   RenderFont* GetRenderFont(StringParam face, uint size, uint flags);
+
+  /// When set, GetRenderFont returns fonts backed by a single distance field
+  /// atlas per face instead of rasterizing every size. Enabled at startup with
+  /// the 'DistanceFieldFonts' command line argument.
+  static bool sDistanceFieldFonts;
+};
+
+/// Glyph atlas shared by every size of a font. Glyphs are stored as signed
+/// distance fields (in alpha) at cDistanceFieldFontHeight so any size can be
+/// drawn from them. Metrics and atlas space for a new rune are computed right
+/// away on the main thread, the distance field itself is generated on the job
+/// system and uploaded on a later engine update.
+class DistanceFieldAtlas : public EventObject
+{
+public:
+  typedef DistanceFieldAtlas ZilchSelf;
+
+  DistanceFieldAtlas(Font* fontObject);
+  ~DistanceFieldAtlas();
+
+  /// Rune metrics at cDistanceFieldFontHeight.
+  RenderRune& GetRenderRune(int runeCode);
+
+  /// Called from worker threads, takes ownership of the glyphs.
+  void CompleteGlyphs(Array<DistanceFieldGlyph*>& glyphs);
+  /// Uploads all finished glyphs to the texture.
+  void UploadCompletedGlyphs();
+  void OnEngineUpdate(Event* event);
+
+  Font* mFontObject;
+  float mDescent;
+  float mLineHeight;
+  HashMap<int, RenderRune> mRunes;
+  HandleOf<Texture> mTexture;
+
+  // Font file data, shared read only with the glyph jobs
+  DataBlock mFontSource;
+  // Face used for metrics on the main thread
+  FontRasterizerData* mData;
+
+private:
+  void AddRune(int runeCode);
+  /// Returns false if the atlas is full.
+  bool AllocateRect(int width, int height, int& x, int& y);
+  void QueueGlyphJobs();
+
+  // Shelf packing position
+  int mPenX;
+  int mPenY;
+  int mRowHeight;
+  bool mFull;
+
+  // Glyphs with reserved space waiting to be sent to a job
+  Array<DistanceFieldGlyph*> mQueuedGlyphs;
+
+  ThreadLock mLock;
+  Array<DistanceFieldGlyph*> mCompletedGlyphs;
+  // Jobs still reading mFontSource
+  CountdownEvent mPendingJobs;
 };
 
 // Font Rasterizer helper class, creates new Render Fonts or updates existing
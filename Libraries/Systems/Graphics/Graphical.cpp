@@ -86,7 +86,8 @@ void Graphical::Initialize(CogInitializer& initializer)
 
   RebuildComponentShaderInputs();
 
-  ConnectThisTo(Z::gEngine->has(GraphicsEngine), Events::ShaderInputsModified, OnShaderInputsModified);
+  if (GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine))
+    ConnectThisTo(graphicsEngine, Events::ShaderInputsModified, OnShaderInputsModified);
   ConnectThisTo(MaterialManager::GetInstance(), Events::ResourceModified, OnMaterialModified);
 }
 
@@ -353,15 +354,20 @@ void Graphical::AddComponentShaderInputs(Component* component)
   if (componentType->HasAttribute(ObjectAttributes::cProxy))
     return;
 
+  // Nothing is rendered without a GraphicsEngine (running headless)
+  GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine);
+  if (graphicsEngine == nullptr)
+    return;
+
   String componentName = ZilchVirtualTypeId(component)->Name;
   Array<ShaderMetaProperty>* shaderProperties =
-      Z::gEngine->has(GraphicsEngine)->mComponentShaderProperties.FindPointer(componentName);
+      graphicsEngine->mComponentShaderProperties.FindPointer(componentName);
 
   // No inputs from this component
   if (shaderProperties == nullptr)
     return;
 
-  ZilchShaderGenerator* shaderGenerator = Z::gEngine->has(GraphicsEngine)->mShaderGenerator;
+  ZilchShaderGenerator* shaderGenerator = graphicsEngine->mShaderGenerator;
 
   forRange (ShaderMetaProperty& shaderProperty, shaderProperties->All())
   {
@@ -43,8 +43,11 @@ void GraphicsSpace::Initialize(CogInitializer& initializer)
   if (!mRandomSeed)
     mRandom.SetSeed(mSeed);
 
+  // There is no GraphicsEngine when running headless, so this space is never
+  // rendered
   mGraphicsEngine = Z::gEngine->has(GraphicsEngine);
-  mGraphicsEngine->AddSpace(this);
+  if (mGraphicsEngine)
+    mGraphicsEngine->AddSpace(this);
 
   ConnectThisTo(this, Events::SpaceDestroyed, OnSpaceDestroyed);
   ConnectThisTo(this, Events::SystemLogicUpdate, OnLogicUpdate);
@@ -53,7 +56,8 @@ void GraphicsSpace::Initialize(CogInitializer& initializer)
 
 void GraphicsSpace::OnSpaceDestroyed(ObjectEvent* event)
 {
-  mGraphicsEngine->RemoveSpace(this);
+  if (mGraphicsEngine)
+    mGraphicsEngine->RemoveSpace(this);
 }
 
 void GraphicsSpace::AddGraphical(Graphical* graphical)
@@ -7,6 +7,13 @@ namespace Zero
 
 const uint WeightTextureSize = 128;
 
+// Frames that a patch lod mesh is kept after it was last drawn
+const uint PatchLodLifetime = 120;
+
+// Vertex and index memory of every patch lod mesh, the memory graph reports the
+// peak along with what's currently resident
+static Memory::Heap* sHeightMapMeshHeap = Memory::GetNamedHeap("HeightMapMeshes");
+
 GraphicalPatchIndices* GraphicalPatchIndices::GetInstance()
 {
   static GraphicalPatchIndices sInstance;
@@ -15,24 +22,117 @@ GraphicalPatchIndices* GraphicalPatchIndices::GetInstance()
 
 GraphicalPatchIndices::GraphicalPatchIndices()
 {
-  mIndices.Reserve(HeightPatch::NumIndicesTotal);
-  for (uint y = 0; y < HeightPatch::NumQuadsPerSide; ++y)
+  for (uint lod = 0; lod < HeightPatchLodCount; ++lod)
+  {
+    uint quadsPerSide = HeightPatch::NumQuadsPerSide >> lod;
+    uint verticesPerSide = quadsPerSide + 1;
+
+    Array<uint>& indices = mIndices[lod];
+    indices.Reserve(quadsPerSide * quadsPerSide * 6);
+    for (uint y = 0; y < quadsPerSide; ++y)
+    {
+      for (uint x = 0; x < quadsPerSide; ++x)
+      {
+        uint topLeft = x + y * verticesPerSide;
+
+        indices.PushBack(topLeft);
+        indices.PushBack(topLeft + verticesPerSide);
+        indices.PushBack(topLeft + verticesPerSide + 1);
+
+        indices.PushBack(topLeft + verticesPerSide + 1);
+        indices.PushBack(topLeft + 1);
+        indices.PushBack(topLeft);
+      }
+    }
+  }
+}
+
+void BuildPatchLodVertices(const Array<Vec3>& positions,
+                           uint lod,
+                           uint stitch,
+                           Array<HeightPatchLodVertex>& vertices)
+{
+  uint paddedWidth = HeightPatch::PaddedNumVerticesPerSide;
+  uint step = 1 << lod;
+  uint lastVertex = HeightPatch::NumVerticesPerSide - 1;
+  uint verticesPerSide = lastVertex / step + 1;
+  vertices.Reserve(verticesPerSide * verticesPerSide);
+
+  // Offset into the middle of the padded area so adjacent indexing will always
+  // be valid
+  for (uint y = 0; y <= lastVertex; y += step)
   {
-    for (uint x = 0; x < HeightPatch::NumQuadsPerSide; ++x)
+    for (uint x = 0; x <= lastVertex; x += step)
     {
-      uint topLeft = x + y * HeightPatch::NumVerticesPerSide;
+      uint index = (x + 1) + (y + 1) * paddedWidth;
+
+      Vec3 pos = positions[index];
+
+      // Vertices between the coarser neighbor's vertices are placed on the
+      // neighbor's edge
+      bool oddX = (x / step) % 2 == 1;
+      bool oddY = (y / step) % 2 == 1;
+      bool stitchX = (x == 0 && (stitch & HeightPatchStitch::NegativeX)) ||
+                     (x == lastVertex && (stitch & HeightPatchStitch::PositiveX));
+      bool stitchY = (y == 0 && (stitch & HeightPatchStitch::NegativeY)) ||
+                     (y == lastVertex && (stitch & HeightPatchStitch::PositiveY));
+      if (stitchX && oddY)
+        pos = (positions[index - step * paddedWidth] + positions[index + step * paddedWidth]) * 0.5f;
+      else if (stitchY && oddX)
+        pos = (positions[index - step] + positions[index + step]) * 0.5f;
+
+      Vec2 uv;
+      uv.x = x / (real)lastVertex;
+      uv.y = y / (real)lastVertex;
+
+      // Sample adjacent positions
+      Vec3 n = positions[index - paddedWidth];
+      Vec3 s = positions[index + paddedWidth];
+      Vec3 w = positions[index - 1];
+      Vec3 e = positions[index + 1];
+
+      // Use the west->east vector as the tangent
+      Vec3 tangent = e - w;
+      tangent.Normalize();
+
+      // Use the north->south vector as the bitangent
+      Vec3 bitangent = s - n;
+      bitangent.Normalize();
 
-      mIndices.PushBack(topLeft);
-      mIndices.PushBack(topLeft + HeightPatch::NumVerticesPerSide);
-      mIndices.PushBack(topLeft + HeightPatch::NumVerticesPerSide + 1);
+      // Cross the tangent and bitangent to determine our normal
+      Vec3 normal = Math::Cross(bitangent, tangent);
+      normal.Normalize();
 
-      mIndices.PushBack(topLeft + HeightPatch::NumVerticesPerSide + 1);
-      mIndices.PushBack(topLeft + 1);
-      mIndices.PushBack(topLeft);
+      HeightPatchLodVertex& vertex = vertices.PushBack();
+      vertex.mPosition = pos;
+      vertex.mUv = uv;
+      vertex.mNormal = normal;
+      vertex.mTangent = tangent;
+      vertex.mBitangent = bitangent;
     }
   }
 }
 
+// Height Patch Lod Job
+/// Builds the vertices of a patch lod from a copy of the patch's heights, so
+/// the HeightMap can keep changing while it runs.
+class HeightPatchLodJob : public Job
+{
+public:
+  void Execute() override
+  {
+    BuildPatchLodVertices(mPositions, mLod, mStitch, mVertices);
+    mPositions.Clear();
+    mFinished.Store(true);
+  }
+
+  Array<Vec3> mPositions;
+  uint mLod;
+  uint mStitch;
+  Array<HeightPatchLodVertex> mVertices;
+  Atomic<bool> mFinished;
+};
+
 ZilchDefineType(HeightMapModel, builder, type)
 {
   ZeroBindComponent();
@@ -40,11 +140,14 @@ ZilchDefineType(HeightMapModel, builder, type)
   ZeroBindInterface(Graphical);
   ZeroBindDependency(HeightMap);
   ZeroBindSetup(SetupMode::DefaultSerialization);
+
+  ZilchBindFieldProperty(mLodDistance);
 }
 
 void HeightMapModel::Serialize(Serializer& stream)
 {
   Graphical::Serialize(stream);
+  SerializeNameDefault(mLodDistance, 2.0f);
 }
 
 void HeightMapModel::Initialize(CogInitializer& initializer)
@@ -57,10 +160,11 @@ void HeightMapModel::Initialize(CogInitializer& initializer)
 
   // Grab the height-map component so we can read its data
   mMap = GetOwner()->has(HeightMap);
+  mReleaseFrame = 0;
 
   // Loop through all the patches on the map
   forRange (HeightPatch* patch, mMap->GetAllPatches())
-    CreateGraphicalPatchMesh(patch);
+    UpdateGraphicalPatch(patch);
 
   RebuildLocalAabb();
 
@@ -74,9 +178,12 @@ void HeightMapModel::OnDestroy(uint flags)
 {
   Graphical::OnDestroy(flags);
 
-  // Have to manually clean up allocated weight textures
+  // Have to manually clean up allocated weight textures and lods
   forRange (GraphicalHeightPatch& patch, mGraphicalPatches.Values())
+  {
+    ReleasePatchLods(patch);
     delete patch.mWeightTexture;
+  }
 }
 
 Aabb HeightMapModel::GetLocalAabb()
@@ -88,8 +195,8 @@ void HeightMapModel::ExtractFrameData(FrameNode& frameNode, FrameBlock& frameBlo
 {
   GraphicalEntryData* entryData = ((GraphicalEntry*)frameNode.mGraphicalEntry)->mData;
 
-  PatchIndex patchIndex = *(PatchIndex*)&entryData->mUtility;
-  HeightPatch* heightPatch = mMap->GetPatchAtIndex(patchIndex);
+  GraphicalHeightPatchLod* patchLod = (GraphicalHeightPatchLod*)entryData->mUtility;
+  HeightPatch* heightPatch = mMap->GetPatchAtIndex(patchLod->mPatchIndex);
   GraphicalHeightPatch& graphicalPatch = mGraphicalPatches[heightPatch];
 
   frameNode.mBorderThickness = 1.0f;
@@ -98,7 +205,7 @@ void HeightMapModel::ExtractFrameData(FrameNode& frameNode, FrameBlock& frameBlo
   frameNode.mCoreVertexType = CoreVertexType::Mesh;
 
   frameNode.mMaterialRenderData = mMaterial->mRenderData;
-  frameNode.mMeshRenderData = graphicalPatch.mMesh->mRenderData;
+  frameNode.mMeshRenderData = patchLod->mMesh->mRenderData;
   frameNode.mTextureRenderData = graphicalPatch.mWeightTexture->Image->mRenderData;
 
   frameNode.mLocalToWorld = mTransform->GetWorldMatrix();
@@ -121,29 +228,32 @@ void HeightMapModel::ExtractViewData(ViewNode& viewNode, ViewBlock& viewBlock, F
 
 void HeightMapModel::MidPhaseQuery(Array<GraphicalEntry>& entries, Camera& camera, Frustum* frustum)
 {
+  // Entries from every camera this frame point at the lods, so they're only
+  // released on the first query of a frame
+  ReleaseUnusedPatchLods();
+
+  // Lods are picked for every patch, even those that are culled, since the
+  // visible patches have to stitch to them
+  ComputePatchLods(camera);
+
+  Mat4 worldMatrix = mTransform->GetWorldMatrix();
   typedef HashMap<HeightPatch*, GraphicalHeightPatch>::pair GraphicalPatchPair;
-  if (frustum == nullptr)
+  forRange (GraphicalPatchPair& pair, mGraphicalPatches.All())
   {
-    forRange (GraphicalPatchPair& pair, mGraphicalPatches.All())
-    {
-      HeightPatch* heightPatch = pair.first;
-      GraphicalHeightPatch& graphicalPatch = pair.second;
+    HeightPatch* heightPatch = pair.first;
+    GraphicalHeightPatch& graphicalPatch = pair.second;
 
-      AddGraphicalPatchEntry(entries, graphicalPatch, heightPatch->Index);
-    }
-  }
-  else
-  {
-    Mat4 worldMatrix = mTransform->GetWorldMatrix();
-    forRange (GraphicalPatchPair& pair, mGraphicalPatches.All())
+    if (frustum != nullptr)
     {
-      HeightPatch* heightPatch = pair.first;
-      GraphicalHeightPatch& graphicalPatch = pair.second;
-
       Aabb aabb = graphicalPatch.mLocalAabb.TransformAabb(worldMatrix);
-      if (Overlap(aabb, *frustum))
-        AddGraphicalPatchEntry(entries, graphicalPatch, heightPatch->Index);
+      if (!Overlap(aabb, *frustum))
+        continue;
     }
+
+    uint lod = mPatchLods[heightPatch->Index];
+    uint stitch = GetPatchStitch(heightPatch->Index, lod);
+    GraphicalHeightPatchLod* patchLod = GetPatchLod(heightPatch, graphicalPatch, lod, stitch);
+    AddGraphicalPatchEntry(entries, *patchLod);
   }
 }
 
@@ -166,15 +276,13 @@ String HeightMapModel::GetDefaultMaterialName()
   return "DefaultHeightMapMaterial";
 }
 
-void HeightMapModel::AddGraphicalPatchEntry(Array<GraphicalEntry>& entries,
-                                            GraphicalHeightPatch& graphicalPatch,
-                                            PatchIndex index)
+void HeightMapModel::AddGraphicalPatchEntry(Array<GraphicalEntry>& entries, GraphicalHeightPatchLod& patchLod)
 {
-  GraphicalEntryData& entryData = graphicalPatch.mGraphicalEntryData;
+  GraphicalEntryData& entryData = patchLod.mGraphicalEntryData;
   entryData.mGraphical = this;
   entryData.mFrameNodeIndex = -1;
   entryData.mPosition = mTransform->GetWorldTranslation();
-  entryData.mUtility = *(u64*)&index;
+  entryData.mUtility = (u64)&patchLod;
 
   GraphicalEntry entry;
   entry.mData = &entryData;
@@ -183,6 +291,191 @@ void HeightMapModel::AddGraphicalPatchEntry(Array<GraphicalEntry>& entries,
   entries.PushBack(entry);
 }
 
+void HeightMapModel::ComputePatchLods(Camera& camera)
+{
+  mPatchLods.Clear();
+
+  Vec3 localCameraPosition = mTransform->TransformPointInverse(camera.GetWorldTranslation());
+  float lodDistance = Math::Max(mLodDistance, 0.01f) * mMap->GetUnitsPerPatch();
+
+  typedef HashMap<HeightPatch*, GraphicalHeightPatch>::pair GraphicalPatchPair;
+  forRange (GraphicalPatchPair& pair, mGraphicalPatches.All())
+  {
+    Aabb& aabb = pair.second.mLocalAabb;
+    Vec3 closestPoint = Math::Clamp(localCameraPosition, aabb.mMin, aabb.mMax);
+    float distance = Math::Length(localCameraPosition - closestPoint);
+
+    // Full detail within the lod distance, then one lod per doubling
+    uint lod = 0;
+    while (distance > lodDistance && lod < HeightPatchLodCount - 1)
+    {
+      distance *= 0.5f;
+      ++lod;
+    }
+
+    mPatchLods.Insert(pair.first->Index, lod);
+  }
+
+  // Lods only ever move down towards a neighbor, so a pass for every lod is
+  // enough for the whole map to settle
+  const PatchIndex neighbors[] = {PatchIndex(-1, 0), PatchIndex(1, 0), PatchIndex(0, -1), PatchIndex(0, 1)};
+  for (uint pass = 0; pass < HeightPatchLodCount; ++pass)
+  {
+    bool changed = false;
+    typedef HashMap<PatchIndex, uint>::pair PatchLodPair;
+    forRange (PatchLodPair& pair, mPatchLods.All())
+    {
+      for (uint i = 0; i < 4; ++i)
+      {
+        uint* neighborLod = mPatchLods.FindPointer(pair.first + neighbors[i]);
+        if (neighborLod && pair.second > *neighborLod + 1)
+        {
+          pair.second = *neighborLod + 1;
+          changed = true;
+        }
+      }
+    }
+
+    if (!changed)
+      break;
+  }
+}
+
+uint HeightMapModel::GetPatchStitch(PatchIndexParam index, uint lod)
+{
+  const PatchIndex neighbors[] = {PatchIndex(-1, 0), PatchIndex(1, 0), PatchIndex(0, -1), PatchIndex(0, 1)};
+  const uint stitches[] = {HeightPatchStitch::NegativeX,
+                           HeightPatchStitch::PositiveX,
+                           HeightPatchStitch::NegativeY,
+                           HeightPatchStitch::PositiveY};
+
+  uint stitch = HeightPatchStitch::None;
+  for (uint i = 0; i < 4; ++i)
+  {
+    uint* neighborLod = mPatchLods.FindPointer(index + neighbors[i]);
+    if (neighborLod && *neighborLod > lod)
+      stitch |= stitches[i];
+  }
+  return stitch;
+}
+
+GraphicalHeightPatchLod* HeightMapModel::GetPatchLod(HeightPatch* heightPatch,
+                                                     GraphicalHeightPatch& graphicalPatch,
+                                                     uint lod,
+                                                     uint stitch)
+{
+  uint frame = Z::gEngine->has(GraphicsEngine)->mFrameCounter;
+
+  uint key = lod * HeightPatchStitch::Count + stitch;
+  GraphicalHeightPatchLod* patchLod = graphicalPatch.mLods.FindValue(key, nullptr);
+  if (patchLod == nullptr)
+  {
+    patchLod = new GraphicalHeightPatchLod();
+    patchLod->mPatchIndex = heightPatch->Index;
+    patchLod->mLod = lod;
+
+    // The heights are copied now, the job only reads its own copy
+    HeightPatchLodJob* job = new HeightPatchLodJob();
+    mMap->GetPaddedHeightPatchVertices(heightPatch, job->mPositions);
+    job->mLod = lod;
+    job->mStitch = stitch;
+
+    // A patch with no mesh at all would leave a hole, so it's built right away
+    if (GetReadyPatchLod(graphicalPatch, lod) == nullptr)
+    {
+      job->Execute();
+      CreatePatchLodMesh(graphicalPatch, *patchLod, job->mVertices);
+      delete job;
+    }
+    else
+    {
+      patchLod->mJob = job;
+      Z::gJobs->AddJob(job);
+    }
+
+    graphicalPatch.mLods.Insert(key, patchLod);
+  }
+  patchLod->mLastUsedFrame = frame;
+
+  if (!patchLod->IsReady())
+  {
+    HeightPatchLodJob* job = (HeightPatchLodJob*)(Job*)patchLod->mJob;
+    if (job->mFinished.Load())
+    {
+      CreatePatchLodMesh(graphicalPatch, *patchLod, job->mVertices);
+      patchLod->mJob = nullptr;
+    }
+  }
+
+  // Neighbors may not be stitched to the lod that is drawn in its place until
+  // the job finishes
+  if (!patchLod->IsReady())
+  {
+    patchLod = GetReadyPatchLod(graphicalPatch, lod);
+    patchLod->mLastUsedFrame = frame;
+  }
+
+  return patchLod;
+}
+
+GraphicalHeightPatchLod* HeightMapModel::GetReadyPatchLod(GraphicalHeightPatch& graphicalPatch, uint lod)
+{
+  GraphicalHeightPatchLod* closest = nullptr;
+  uint closestDistance = (uint)-1;
+  forRange (GraphicalHeightPatchLod* patchLod, graphicalPatch.mLods.Values())
+  {
+    if (!patchLod->IsReady())
+      continue;
+
+    uint distance = (uint)Math::Abs((int)patchLod->mLod - (int)lod);
+    if (distance < closestDistance)
+    {
+      closest = patchLod;
+      closestDistance = distance;
+    }
+  }
+  return closest;
+}
+
+void HeightMapModel::ReleaseUnusedPatchLods()
+{
+  uint frame = Z::gEngine->has(GraphicsEngine)->mFrameCounter;
+  if (frame == mReleaseFrame)
+    return;
+  mReleaseFrame = frame;
+
+  Array<uint> releasedKeys;
+  forRange (GraphicalHeightPatch& graphicalPatch, mGraphicalPatches.Values())
+  {
+    releasedKeys.Clear();
+
+    typedef HashMap<uint, GraphicalHeightPatchLod*>::pair PatchLodPair;
+    forRange (PatchLodPair& pair, graphicalPatch.mLods.All())
+    {
+      GraphicalHeightPatchLod* patchLod = pair.second;
+      if (frame - patchLod->mLastUsedFrame > PatchLodLifetime)
+      {
+        sHeightMapMeshHeap->RemoveAllocation(patchLod->mMemory);
+        delete patchLod;
+        releasedKeys.PushBack(pair.first);
+      }
+    }
+
+    forRange (uint key, releasedKeys.All())
+      graphicalPatch.mLods.Erase(key);
+  }
+}
+
+void HeightMapModel::ReleasePatchLods(GraphicalHeightPatch& graphicalPatch)
+{
+  forRange (GraphicalHeightPatchLod* patchLod, graphicalPatch.mLods.Values())
+  {
+    sHeightMapMeshHeap->RemoveAllocation(patchLod->mMemory);
+    delete patchLod;
+  }
+  graphicalPatch.mLods.Clear();
+}
+
 void HeightMapModel::OnPatchAdded(HeightMapEvent* event)
 {
   HeightPatch* heightPatch = event->Patch;
@@ -195,7 +488,7 @@ void HeightMapModel::OnPatchAdded(HeightMapEvent* event)
 
   UpdateBroadPhaseAabb();
 
-  CreateGraphicalPatchMesh(heightPatch);
+  UpdateGraphicalPatch(heightPatch);
 }
 
 void HeightMapModel::OnPatchRemoved(HeightMapEvent* event)
@@ -204,6 +497,7 @@ void HeightMapModel::OnPatchRemoved(HeightMapEvent* event)
 
   ErrorIf(!mGraphicalPatches.ContainsKey(heightPatch), "No GraphicalHeightPatch found for HeightPatch.");
   GraphicalHeightPatch& graphicalHeightPatch = mGraphicalPatches[heightPatch];
+  ReleasePatchLods(graphicalHeightPatch);
   delete graphicalHeightPatch.mWeightTexture;
   mGraphicalPatches.Erase(heightPatch);
   RebuildLocalAabb();
@@ -213,7 +507,7 @@ void HeightMapModel::OnPatchModified(HeightMapEvent* event)
 {
   HeightPatch* heightPatch = event->Patch;
 
-  CreateGraphicalPatchMesh(heightPatch);
+  UpdateGraphicalPatch(heightPatch);
   RebuildLocalAabb();
 }
 
@@ -252,77 +546,13 @@ void HeightMapModel::RebuildLocalAabb()
   UpdateBroadPhaseAabb();
 }
 
-void HeightMapModel::CreateGraphicalPatchMesh(HeightPatch* heightPatch)
+void HeightMapModel::UpdateGraphicalPatch(HeightPatch* heightPatch)
 {
-  Aabb patchAabb = mMap->GetPatchLocalAabb(heightPatch);
   GraphicalHeightPatch& graphicalPatch = mGraphicalPatches[heightPatch];
-  graphicalPatch.mLocalAabb = patchAabb;
-  graphicalPatch.mMesh = Mesh::CreateRuntime();
-
-  Mesh* mesh = graphicalPatch.mMesh;
-  mesh->mPrimitiveType = PrimitiveType::Triangles;
-  mesh->mAabb = patchAabb;
-  VertexBuffer* vertices = &mesh->mVertices;
-  IndexBuffer* indices = &mesh->mIndices;
-
-  // Get the local space vertices
-  Array<Vec3> positions;
-  uint paddedWidth = HeightPatch::PaddedNumVerticesPerSide;
-  PatchIndex patchIndex = heightPatch->Index;
-  mMap->GetPaddedHeightPatchVertices(heightPatch, positions);
-
-  vertices->AddAttribute(VertexSemantic::Position, VertexElementType::Real, 3);
-  vertices->AddAttribute(VertexSemantic::Uv, VertexElementType::Real, 2);
-  vertices->AddAttribute(VertexSemantic::Normal, VertexElementType::Real, 3);
-  vertices->AddAttribute(VertexSemantic::Tangent, VertexElementType::Real, 3);
-  vertices->AddAttribute(VertexSemantic::Bitangent, VertexElementType::Real, 3);
-
-  // Iterate over the middle of the padded area and adjacent indexing will
-  // always be valid
-  for (uint y = 1; y < paddedWidth - 1; ++y)
-  {
-    for (uint x = 1; x < paddedWidth - 1; ++x)
-    {
-      uint index = x + y * paddedWidth;
-
-      Vec3 pos = positions[index];
-
-      Vec2 uv;
-      uv.x = (x - 1) / (real)(HeightPatch::NumVerticesPerSide - 1);
-      uv.y = (y - 1) / (real)(HeightPatch::NumVerticesPerSide - 1);
+  graphicalPatch.mLocalAabb = mMap->GetPatchLocalAabb(heightPatch);
 
-      // Sample adjacent positions
-      Vec3 n = positions[index - paddedWidth];
-      Vec3 s = positions[index + paddedWidth];
-      Vec3 w = positions[index - 1];
-      Vec3 e = positions[index + 1];
-
-      // Use the west->east vector as the tangent
-      Vec3 tangent = e - w;
-      tangent.Normalize();
-
-      // Use the north->south vector as the bitangent
-      Vec3 bitangent = s - n;
-      bitangent.Normalize();
-
-      // Cross the tangent and bitangent to determine our normal
-      Vec3 normal = Math::Cross(bitangent, tangent);
-      normal.Normalize();
-
-      vertices->AddReal(pos);
-      vertices->AddReal(uv);
-      vertices->AddReal(normal);
-      vertices->AddReal(tangent);
-      vertices->AddReal(bitangent);
-    }
-  }
-
-  indices->mData = GraphicalPatchIndices::GetInstance()->mIndices;
-  indices->mIndexSize = 4;
-  indices->mIndexCount = indices->mData.Size();
-  indices->mGenerated = false;
-
-  mesh->Upload();
+  // Meshes are built again for whichever lods the cameras need
+  ReleasePatchLods(graphicalPatch);
 
   // Load the splat control texture
   ByteColor color = ToByteColor(Vec4(1, 0, 0, 0));
@@ -344,4 +574,38 @@ void HeightMapModel::CreateGraphicalPatchMesh(HeightPatch* heightPatch)
   }
 }
 
+void HeightMapModel::CreatePatchLodMesh(GraphicalHeightPatch& graphicalPatch,
+                                        GraphicalHeightPatchLod& patchLod,
+                                        Array<HeightPatchLodVertex>& vertexData)
+{
+  patchLod.mMesh = Mesh::CreateRuntime();
+
+  Mesh* mesh = patchLod.mMesh;
+  mesh->mPrimitiveType = PrimitiveType::Triangles;
+  mesh->mAabb = graphicalPatch.mLocalAabb;
+  VertexBuffer* vertices = &mesh->mVertices;
+  IndexBuffer* indices = &mesh->mIndices;
+
+  vertices->AddAttribute(VertexSemantic::Position, VertexElementType::Real, 3);
+  vertices->AddAttribute(VertexSemantic::Uv, VertexElementType::Real, 2);
+  vertices->AddAttribute(VertexSemantic::Normal, VertexElementType::Real, 3);
+  vertices->AddAttribute(VertexSemantic::Tangent, VertexElementType::Real, 3);
+  vertices->AddAttribute(VertexSemantic::Bitangent, VertexElementType::Real, 3);
+
+  vertices->Grow(vertexData.Size() * sizeof(HeightPatchLodVertex));
+  forRange (HeightPatchLodVertex& vertex, vertexData.All())
+    vertices->WriteData(vertex);
+
+  indices->mData = GraphicalPatchIndices::GetInstance()->mIndices[patchLod.mLod];
+  indices->mIndexSize = 4;
+  indices->mIndexCount = indices->mData.Size();
+  indices->mGenerated = false;
+
+  patchLod.mMemory = vertices->mDataSize + indices->mIndexCount * indices->mIndexSize;
+  sHeightMapMeshHeap->AddAllocation(patchLod.mMemory);
+
+  // Ray casts are done against the HeightMap, the mesh doesn't need a tree
+  mesh->UploadNoRayCastInfo();
+}
+
 } // namespace Zero
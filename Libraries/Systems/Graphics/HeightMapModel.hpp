@@ -5,13 +5,76 @@
 namespace Zero
 {
 
+/// Patches are drawn with every 2^lod vertex, down to 2 quads per side.
+const uint HeightPatchLodCount = 5;
+
+/// Edges of a patch that border a patch drawn at the next coarser lod.
+/// The in between vertices on those edges are moved onto the coarser edge so
+/// that there are no cracks between the patches.
+namespace HeightPatchStitch
+{
+enum Enum
+{
+  None = 0,
+  NegativeX = 1 << 0,
+  PositiveX = 1 << 1,
+  NegativeY = 1 << 2,
+  PositiveY = 1 << 3,
+  Count = 1 << 4
+};
+} // namespace HeightPatchStitch
+
+/// One vertex of a patch mesh, in the order of the mesh's attributes.
+struct HeightPatchLodVertex
+{
+  Vec3 mPosition;
+  Vec2 mUv;
+  Vec3 mNormal;
+  Vec3 mTangent;
+  Vec3 mBitangent;
+};
+
+/// Builds the vertices of a patch at a lod from its padded height patch
+/// vertices (see HeightMap::GetPaddedHeightPatchVertices).
+void BuildPatchLodVertices(const Array<Vec3>& positions,
+                           uint lod,
+                           uint stitch,
+                           Array<HeightPatchLodVertex>& vertices);
+
 class GraphicalPatchIndices
 {
 public:
   static GraphicalPatchIndices* GetInstance();
 
   GraphicalPatchIndices();
-  Array<uint> mIndices;
+  Array<uint> mIndices[HeightPatchLodCount];
+};
+
+/// The mesh of a patch at one lod and set of stitched edges. Only created when
+/// a camera needs it and released once no camera has used it for a while. The
+/// vertices are built on the job system, until then the patch is drawn with
+/// another of its lods.
+class GraphicalHeightPatchLod
+{
+public:
+  GraphicalHeightPatchLod() : mLod(0), mMemory(0), mLastUsedFrame(0)
+  {
+  }
+
+  bool IsReady()
+  {
+    return (Mesh*)mMesh != nullptr;
+  }
+
+  HandleOf<Mesh> mMesh;
+  /// The job building the vertices, null once the mesh is created.
+  HandleOf<Job> mJob;
+  GraphicalEntryData mGraphicalEntryData;
+  PatchIndex mPatchIndex;
+  uint mLod;
+  // Bytes of vertex and index data in the mesh
+  uint mMemory;
+  uint mLastUsedFrame;
 };
 
 class GraphicalHeightPatch
@@ -22,8 +85,8 @@ public:
   }
 
   Aabb mLocalAabb;
-  HandleOf<Mesh> mMesh;
-  GraphicalEntryData mGraphicalEntryData;
+  // Keyed by lod * HeightPatchStitch::Count + stitch
+  HashMap<uint, GraphicalHeightPatchLod*> mLods;
 
   // A pixel buffer we use to paint materials onto the height map (splatting)
   // Each channel in the pixel buffer corresponds to a weight of how much
@@ -55,7 +118,20 @@ public:
 
   // Internal
 
-  void AddGraphicalPatchEntry(Array<GraphicalEntry>& entries, GraphicalHeightPatch& graphicalPatch, PatchIndex index);
+  void AddGraphicalPatchEntry(Array<GraphicalEntry>& entries, GraphicalHeightPatchLod& patchLod);
+
+  /// Picks the lod of every patch from its distance to the camera. Neighboring
+  /// patches are kept within one lod of each other so that they can be stitched.
+  void ComputePatchLods(Camera& camera);
+  uint GetPatchStitch(PatchIndexParam index, uint lod);
+  /// Returns the closest lod of the patch that has a mesh. Lods that aren't
+  /// built yet are queued on the job system, only a patch without any mesh is
+  /// built right away.
+  GraphicalHeightPatchLod* GetPatchLod(HeightPatch* heightPatch, GraphicalHeightPatch& graphicalPatch, uint lod, uint stitch);
+  GraphicalHeightPatchLod* GetReadyPatchLod(GraphicalHeightPatch& graphicalPatch, uint lod);
+  /// Releases meshes that haven't been drawn for a while.
+  void ReleaseUnusedPatchLods();
+  void ReleasePatchLods(GraphicalHeightPatch& graphicalPatch);
 
   void OnPatchAdded(HeightMapEvent* event);
   void OnPatchRemoved(HeightMapEvent* event);
@@ -63,7 +139,15 @@ public:
   void OnSave(HeightMapEvent* event);
 
   void RebuildLocalAabb();
-  void CreateGraphicalPatchMesh(HeightPatch* heightPatch);
+  void UpdateGraphicalPatch(HeightPatch* heightPatch);
+  /// Creates the mesh once the vertices are built.
+  void CreatePatchLodMesh(GraphicalHeightPatch& graphicalPatch,
+                          GraphicalHeightPatchLod& patchLod,
+                          Array<HeightPatchLodVertex>& vertices);
+
+  /// The distance (in patches) from the camera that patches are drawn at full
+  /// detail. Detail halves every time the distance doubles.
+  float mLodDistance;
 
   // Store a pointer back to the height map
   HeightMap* mMap;
@@ -71,6 +155,10 @@ public:
   Aabb mLocalAabb;
   // We need to associate each patch with graphical data
   HashMap<HeightPatch*, GraphicalHeightPatch> mGraphicalPatches;
+  // The lod of every patch for the camera being queried
+  HashMap<PatchIndex, uint> mPatchLods;
+  // Graphics frame that unused lods were last released on
+  uint mReleaseFrame;
 };
 
 } // namespace Zero
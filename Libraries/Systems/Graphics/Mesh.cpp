@@ -502,7 +502,8 @@ HandleOf<Mesh> Mesh::CreateRuntime()
   Mesh* mesh = MeshManager::CreateRuntime();
   mesh->mAabb.SetCenterAndHalfExtents(Vec3::cZero, Vec3(0.5f));
 
-  Z::gEngine->has(GraphicsEngine)->AddMesh(mesh);
+  if (GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine))
+    graphicsEngine->AddMesh(mesh);
   return mesh;
 }
 
@@ -516,7 +517,8 @@ HandleOf<Mesh> Mesh::RuntimeClone()
   clone->mBindOffsetInv = mBindOffsetInv;
   clone->mPrimitiveType = mPrimitiveType;
 
-  Z::gEngine->has(GraphicsEngine)->AddMesh(clone);
+  if (GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine))
+    graphicsEngine->AddMesh(clone);
   return clone;
 }
 
@@ -572,7 +574,8 @@ void Mesh::UploadInternal(bool updateAabb, bool updateTree)
       BuildAabbAndTree<false>();
   }
 
-  Z::gEngine->has(GraphicsEngine)->AddMesh(this);
+  if (GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine))
+    graphicsEngine->AddMesh(this);
 
   SendModified();
 }
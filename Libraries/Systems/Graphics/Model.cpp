@@ -8,6 +8,7 @@ namespace Zero
 ZilchDefineType(Model, builder, type)
 {
   ZeroBindComponent();
+  type->AddAttribute(ObjectAttributes::cPooledStorage);
   ZeroBindDocumented();
   ZeroBindInterface(Graphical);
   ZeroBindSetup(SetupMode::DefaultSerialization);
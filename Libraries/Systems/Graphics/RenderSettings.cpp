@@ -101,7 +101,12 @@ void ShaderInputs::Add(String fragmentName, String inputName, Texture* input)
 
 void ShaderInputs::Add(String fragmentName, String inputName, ShaderInputType::Enum type, AnyParam value)
 {
-  ZilchShaderGenerator* shaderGenerator = Z::gEngine->has(GraphicsEngine)->mShaderGenerator;
+  // No shader inputs are ever used without a GraphicsEngine (running headless)
+  GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine);
+  if (!graphicsEngine)
+    return;
+
+  ZilchShaderGenerator* shaderGenerator = graphicsEngine->mShaderGenerator;
 
   ShaderInput shaderInput = shaderGenerator->CreateShaderInput(fragmentName, inputName, type, value);
   if (shaderInput.mShaderInputType != ShaderInputType::Invalid)
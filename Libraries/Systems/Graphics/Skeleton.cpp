@@ -251,17 +251,24 @@ IndexRange Skeleton::GetBoneTransforms(Array<Mat4>& skinningBuffer, uint version
   if (version == mCachedVersion)
     return mCachedTransformRange;
 
-  Array<Mat4> boneTransforms;
-  boneTransforms.Resize(mBones.Size());
-
-  // mBones[0] is this object and bone pointer may be null
-  boneTransforms[0] = mBones[0].mCog->has(Transform)->GetParentRelativeMatrix();
-  for (uint i = 1; i < mBones.Size(); ++i)
-    boneTransforms[i] = boneTransforms[mBones[i].mParentIndex] * mBones[i].mCog->has(Bone)->GetLocalTransform();
-
+  // Computed in place, bones are stored depth first so every parent comes
+  // before its children
+  uint boneCount = mBones.Size();
   mCachedTransformRange.start = skinningBuffer.Size();
-  skinningBuffer.Append(boneTransforms.All());
+  skinningBuffer.Resize(skinningBuffer.Size() + boneCount);
   mCachedTransformRange.end = skinningBuffer.Size();
+  Mat4* boneTransforms = skinningBuffer.Data() + mCachedTransformRange.start;
+
+  // mBones[0] is this object and bone pointer may be null
+  boneTransforms[0] = mBones[0].mTransform->GetParentRelativeMatrix();
+  for (uint i = 1; i < boneCount; ++i)
+  {
+    BoneInfo& bone = mBones[i];
+    if (bone.mDirectChild)
+      boneTransforms[i] = boneTransforms[bone.mParentIndex] * bone.mTransform->GetParentRelativeMatrix();
+    else
+      boneTransforms[i] = boneTransforms[bone.mParentIndex] * bone.mCog->has(Bone)->GetLocalTransform();
+  }
 
   mCachedVersion = version;
   return mCachedTransformRange;
@@ -294,7 +301,9 @@ void Skeleton::BuildSkeletonRecursive(Cog& cog, int parentIndex)
   {
     BoneInfo bone;
     bone.mCog = &cog;
+    bone.mTransform = cog.has(Transform);
     bone.mParentIndex = parentIndex;
+    bone.mDirectChild = parentIndex != -1 && cog.GetParent() == mBones[parentIndex].mCog;
 
     index = mBones.Size();
     mNameMap[cog.mName] = index;
@@ -54,7 +54,11 @@ class BoneInfo
 {
 public:
   Cog* mCog;
+  Transform* mTransform;
   int mParentIndex;
+  /// Whether the bone's parent object is its parent bone, otherwise the
+  /// transforms of the objects in between are included in its local transform.
+  bool mDirectChild;
   Array<Cog*> mChildren;
 };
 
@@ -68,6 +68,7 @@ void BaseSprite::ComputeLocalToViewMatrix(Mat4& localToView, Mat4& localToWorld,
 ZilchDefineType(Sprite, builder, type)
 {
   ZeroBindComponent();
+  type->AddAttribute(ObjectAttributes::cPooledStorage);
   ZeroBindDocumented();
   ZeroBindInterface(BaseSprite);
   ZeroBindSetup(SetupMode::DefaultSerialization);
@@ -46,7 +46,8 @@ HandleOf<Texture> Texture::CreateRuntime()
   // Allow change of settings on runtime textures
   texture->mProtected = false;
 
-  Z::gEngine->has(GraphicsEngine)->AddTexture(texture);
+  if (GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine))
+    graphicsEngine->AddTexture(texture);
   return texture;
 }
 
@@ -75,6 +76,7 @@ Texture::Texture() : mRenderData(nullptr)
 
   mProtected = true;
   mDirty = false;
+  mDistanceField = false;
 }
 
 IntVec2 Texture::GetSize()
@@ -212,7 +214,8 @@ void Texture::Upload(TextureData& textureData)
   mMipHeaders->mDataOffset = 0;
   mMipHeaders->mDataSize = mTotalDataSize;
 
-  Z::gEngine->has(GraphicsEngine)->AddTexture(this);
+  if (GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine))
+    graphicsEngine->AddTexture(this);
 }
 
 void Texture::SubUpload(TextureData& textureData, int xOffset, int yOffset)
@@ -244,7 +247,8 @@ void Texture::SubUpload(TextureData& textureData, int xOffset, int yOffset)
   mMipHeaders->mDataOffset = 0;
   mMipHeaders->mDataSize = mTotalDataSize;
 
-  Z::gEngine->has(GraphicsEngine)->AddTexture(this, true, xOffset, yOffset);
+  if (GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine))
+    graphicsEngine->AddTexture(this, true, xOffset, yOffset);
 }
 
 void Texture::Upload(uint width, uint height, TextureFormat::Enum format, ::byte* data, uint size, bool copyData)
@@ -277,7 +281,8 @@ void Texture::Upload(uint width, uint height, TextureFormat::Enum format, ::byte
     mMipHeaders->mDataSize = mTotalDataSize;
   }
 
-  Z::gEngine->has(GraphicsEngine)->AddTexture(this);
+  if (GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine))
+    graphicsEngine->AddTexture(this);
 }
 
 void Texture::Upload(Image& image)
@@ -300,7 +305,8 @@ void Texture::Upload(Image& image)
   mMipHeaders->mDataOffset = 0;
   mMipHeaders->mDataSize = mTotalDataSize;
 
-  Z::gEngine->has(GraphicsEngine)->AddTexture(this);
+  if (GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine))
+    graphicsEngine->AddTexture(this);
 }
 
 void Texture::SubUpload(Image& image, int xOffset, int yOffset)
@@ -327,7 +333,8 @@ void Texture::SubUpload(Image& image, int xOffset, int yOffset)
   mMipHeaders->mDataOffset = 0;
   mMipHeaders->mDataSize = mTotalDataSize;
 
-  Z::gEngine->has(GraphicsEngine)->AddTexture(this, true, xOffset, yOffset);
+  if (GraphicsEngine* graphicsEngine = Z::gEngine->has(GraphicsEngine))
+    graphicsEngine->AddTexture(this, true, xOffset, yOffset);
 }
 
 ImplementResourceManager(TextureManager, Texture);
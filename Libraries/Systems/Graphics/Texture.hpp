@@ -113,6 +113,9 @@ public:
 
   bool mProtected;
   bool mDirty;
+  /// Font atlas storing signed distance in alpha, widgets draw it with the
+  /// DistanceFieldText material.
+  bool mDistanceField;
 };
 
 /// Resource Manager for Textures.
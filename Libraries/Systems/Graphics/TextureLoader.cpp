@@ -26,7 +26,9 @@ void LoadTexture(StringParam filename, Texture* texture)
     return;
 
   // Check for compression support and fallback to downsized texture if needed
-  if (header.mCompression != TextureCompression::None && Z::gRenderer->mDriverSupport.mTextureCompression == false)
+  // There is no renderer when running headless, nothing is uploaded
+  if (header.mCompression != TextureCompression::None && Z::gRenderer &&
+      Z::gRenderer->mDriverSupport.mTextureCompression == false)
   {
     // If a texture is compressed, the data file will have an uncompressed
     // version of the texture after the compressed data, including a separate
@@ -576,27 +576,71 @@ void ZilchShaderGenerator::MapFragmentTypes()
   }
 }
 
+// Output of running the spir-v tool passes and backend for one shader entry.
+class ShaderPipelineResult
+{
+public:
+  ShaderPipelineResult() : mSuccess(false)
+  {
+  }
+
+  typedef ZilchShaderGenerator::TranslationPassResultRef TranslationPassResultRef;
+
+  // Filled out on the main thread with the binary spir-v for each stage,
+  // the job appends the results of every pass after it.
+  Array<TranslationPassResultRef> mVertexResults;
+  Array<TranslationPassResultRef> mGeometryResults;
+  Array<TranslationPassResultRef> mPixelResults;
+  bool mSuccess;
+};
+
+// Runs the specialization constant, optimizer and glsl passes of one shader
+// entry. Generating the binary spir-v walks the shared shader libraries so it is
+// done on the main thread, everything after only touches the entry's own byte
+// streams which allows every permutation to be translated concurrently.
+class ShaderPipelineJob : public Job
+{
+public:
+  void Execute() override
+  {
+    // Passes store errors and settings on themselves so every job needs its own.
+    ShaderPipelineDescription pipelineDescription;
+    ZilchShaderGenerator::BuildPipelineDescription(pipelineDescription);
+
+    bool success = true;
+    success &= ZilchShaderGenerator::RunPipelinePasses(pipelineDescription, mResult->mVertexResults);
+    if (!mResult->mGeometryResults.Empty())
+      success &= ZilchShaderGenerator::RunPipelinePasses(pipelineDescription, mResult->mGeometryResults);
+    success &= ZilchShaderGenerator::RunPipelinePasses(pipelineDescription, mResult->mPixelResults);
+    mResult->mSuccess = success;
+
+    ++(*mCompletedCount);
+    mCountdownEvent->DecrementCount();
+  }
+
+  ShaderPipelineResult* mResult;
+  Atomic<size_t>* mCompletedCount;
+  CountdownEvent* mCountdownEvent;
+};
+
+// Forwards shader compile progress to the loading screen. Only done while
+// already loading so that recompiling a few fragments doesn't show it.
+static void ReportShaderProgress(size_t completedCount, size_t totalCount)
+{
+  if (!Z::gEngine->IsLoading() || totalCount == 0)
+    return;
+
+  String progressLine = String::Format("%d of %d", (int)completedCount, (int)totalCount);
+  Z::gEngine->LoadingUpdate(
+      "Compiling", "Shaders", progressLine, ProgressType::Normal, (float)completedCount / (float)totalCount);
+}
+
 bool ZilchShaderGenerator::BuildShaders(ShaderSet& shaders,
                                         HashMap<String, UniqueComposite>& composites,
                                         Array<ShaderEntry>& shaderEntries,
                                         Array<ShaderDefinition>* compositeShaderDefs)
 {
   ProfileScopeFunction();
-  // @Nate: Build a description of the pipeline tools to run.
-  // This could be cached and down the line should probably be
-  // split up to deal with multiple libraries and caching.
-  ShaderPipelineDescription pipelineDescription;
-#if !defined(ZeroDebug)
-  pipelineDescription.mToolPasses.PushBack(new SpirVSpecializationConstantPass());
-  pipelineDescription.mToolPasses.PushBack(new SpirVOptimizerPass());
-#endif
-  ZeroZilchShaderGlslBackend* backend = new ZeroZilchShaderGlslBackend();
-  pipelineDescription.mBackend = backend;
-
-#ifdef WelderTargetOsEmscripten
-  backend->mTargetVersion = 300;
-  backend->mTargetGlslEs = true;
-#endif
 
   ZilchShaderIRCompositor compositor;
 
@@ -610,8 +654,21 @@ bool ZilchShaderGenerator::BuildShaders(ShaderSet& shaders,
   const size_t compositeBatchCount = 20;
 
   size_t totalShaderCount = shaderArray.Size();
+
+  // Results are written to by the pipeline jobs so they must never be
+  // reallocated while jobs are running.
+  size_t firstEntryIndex = shaderEntries.Size();
+  Array<ShaderPipelineResult> pipelineResults;
+  pipelineResults.Resize(totalShaderCount);
+
+  CountdownEvent countdownEvent;
+  Atomic<size_t> completedCount(0);
+  bool compiled = true;
+
   for (size_t startIndex = 0; startIndex < totalShaderCount; startIndex += compositeBatchCount)
   {
+    ReportShaderProgress(completedCount, totalShaderCount);
+
     ZilchShaderIRProject shaderProject("ShaderProject");
 
     // All batches are added to this array, get start index for this batch.
@@ -699,7 +756,8 @@ bool ZilchShaderGenerator::BuildShaders(ShaderSet& shaders,
     if (shaderLibrary == nullptr)
     {
       DoNotifyError("Shader Error", "Failed to build shader library.");
-      return false;
+      compiled = false;
+      break;
     }
 
     for (size_t i = entryStartIndex; i < shaderEntries.Size(); ++i)
@@ -711,33 +769,91 @@ bool ZilchShaderGenerator::BuildShaders(ShaderSet& shaders,
       ZilchShaderIRType* pixelShader = shaderLibrary->FindType(entry.mPixelShader);
       ErrorIf(vertexShader == nullptr || pixelShader == nullptr, "Invalid shader entry");
 
-      bool success = true;
-      Array<TranslationPassResultRef> vertexPipelineResults;
-      success &= CompilePipeline(vertexShader, pipelineDescription, vertexPipelineResults);
+      ShaderPipelineResult& result = pipelineResults[i - firstEntryIndex];
 
-      Array<TranslationPassResultRef> geometryPipelineResults;
+      bool success = true;
+      success &= TranslateBinary(vertexShader, result.mVertexResults);
       if (geometryShader != nullptr)
-        success &= CompilePipeline(geometryShader, pipelineDescription, geometryPipelineResults);
-
-      Array<TranslationPassResultRef> pixelPipelineResults;
-      success &= CompilePipeline(pixelShader, pipelineDescription, pixelPipelineResults);
+        success &= TranslateBinary(geometryShader, result.mGeometryResults);
+      success &= TranslateBinary(pixelShader, result.mPixelResults);
 
       if (!success)
-        return false;
+      {
+        compiled = false;
+        break;
+      }
 
-      entry.mVertexShader = vertexPipelineResults.Back()->mByteStream.ToString();
-      if (geometryShader != nullptr)
-        entry.mGeometryShader = geometryPipelineResults.Back()->mByteStream.ToString();
-      entry.mPixelShader = pixelPipelineResults.Back()->mByteStream.ToString();
+      // The remaining passes only depend on the binary and run on the job system
+      // while the next batch is composited.
+      countdownEvent.IncrementCount();
+
+      ShaderPipelineJob* job = new ShaderPipelineJob();
+      job->mResult = &result;
+      job->mCompletedCount = &completedCount;
+      job->mCountdownEvent = &countdownEvent;
+      job->mRunImmediateWhenThreadingDisabled = true;
+      Z::gJobs->AddJob(job);
     }
+
+    if (!compiled)
+      break;
+  }
+
+  // Jobs reference the results and countdown on the stack so they must all
+  // finish even if compilation failed.
+  countdownEvent.Wait();
+
+  if (!compiled)
+    return false;
+
+  for (size_t i = firstEntryIndex; i < shaderEntries.Size(); ++i)
+  {
+    ShaderEntry& entry = shaderEntries[i];
+    ShaderPipelineResult& result = pipelineResults[i - firstEntryIndex];
+
+    if (!result.mSuccess)
+      return false;
+
+    entry.mVertexShader = result.mVertexResults.Back()->mByteStream.ToString();
+    if (!result.mGeometryResults.Empty())
+      entry.mGeometryShader = result.mGeometryResults.Back()->mByteStream.ToString();
+    entry.mPixelShader = result.mPixelResults.Back()->mByteStream.ToString();
   }
 
+  ReportShaderProgress(totalShaderCount, totalShaderCount);
   return true;
 }
 
+void ZilchShaderGenerator::BuildPipelineDescription(ShaderPipelineDescription& pipeline)
+{
+  // @Nate: Build a description of the pipeline tools to run.
+  // This could be cached and down the line should probably be
+  // split up to deal with multiple libraries and caching.
+#if !defined(ZeroDebug)
+  pipeline.mToolPasses.PushBack(new SpirVSpecializationConstantPass());
+  pipeline.mToolPasses.PushBack(new SpirVOptimizerPass());
+#endif
+  ZeroZilchShaderGlslBackend* backend = new ZeroZilchShaderGlslBackend();
+  pipeline.mBackend = backend;
+
+#ifdef WelderTargetOsEmscripten
+  backend->mTargetVersion = 300;
+  backend->mTargetGlslEs = true;
+#endif
+}
+
 bool ZilchShaderGenerator::CompilePipeline(ZilchShaderIRType* shaderType,
                                            ShaderPipelineDescription& pipeline,
                                            Array<TranslationPassResultRef>& pipelineResults)
+{
+  if (!TranslateBinary(shaderType, pipelineResults))
+    return false;
+
+  return RunPipelinePasses(pipeline, pipelineResults);
+}
+
+bool ZilchShaderGenerator::TranslateBinary(ZilchShaderIRType* shaderType,
+                                           Array<TranslationPassResultRef>& pipelineResults)
 {
   if (shaderType == nullptr)
     return false;
@@ -751,6 +867,14 @@ bool ZilchShaderGenerator::CompilePipeline(ZilchShaderIRType* shaderType,
   ZilchShaderSpirVBinaryBackend binaryBackend;
   binaryBackend.TranslateType(shaderType, byteWriter, binaryBackendData->mReflectionData);
 
+  return true;
+}
+
+bool ZilchShaderGenerator::RunPipelinePasses(ShaderPipelineDescription& pipeline,
+                                             Array<TranslationPassResultRef>& pipelineResults)
+{
+  ErrorIf(pipelineResults.Empty(), "Binary spir-v must be translated before running passes");
+
   // Run each tool in the pipeline
   for (size_t i = 0; i < pipeline.mToolPasses.Size(); ++i)
   {
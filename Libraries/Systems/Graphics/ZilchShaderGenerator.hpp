@@ -46,9 +46,17 @@ public:
                     HashMap<String, UniqueComposite>& composites,
                     Array<ShaderEntry>& shaderEntries,
                     Array<ShaderDefinition>* compositeShaderDefs = nullptr);
+  /// Adds the tool passes and backend used for every shader to the pipeline.
+  static void BuildPipelineDescription(ShaderPipelineDescription& pipeline);
   bool CompilePipeline(ZilchShaderIRType* shaderType,
                        ShaderPipelineDescription& pipeline,
                        Array<TranslationPassResultRef>& pipelineResults);
+  /// Translates a shader type to binary spir-v. Reads from the shader libraries
+  /// so it must be done on the main thread.
+  static bool TranslateBinary(ZilchShaderIRType* shaderType, Array<TranslationPassResultRef>& pipelineResults);
+  /// Runs the pipeline's passes on the last result. Only touches the given
+  /// results so it is safe to call from any thread with its own pipeline.
+  static bool RunPipelinePasses(ShaderPipelineDescription& pipeline, Array<TranslationPassResultRef>& pipelineResults);
 
   ShaderInput
   CreateShaderInput(StringParam fragmentName, StringParam inputName, ShaderInputType::Enum type, AnyParam value);
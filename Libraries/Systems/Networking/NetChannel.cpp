@@ -300,6 +300,10 @@ NetProperty* NetChannel::AddNetProperty(Component* component,
                                                            GetComponentAnyProperty,
                                                            SetComponentAnyProperty,
                                                            netPropertyConfig);
+
+    // Let snapshots copy the property value without converting it to a variant
+    if (netPropertyType)
+      netPropertyType->SetGatherValueFn(GatherComponentAnyProperty);
   }
 
   // Unable to get or add net property type?
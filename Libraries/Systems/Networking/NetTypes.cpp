@@ -355,6 +355,36 @@ void SetComponentAnyProperty(const Variant& value, Variant& propertyData)
   // Set the property value
   property->SetValue(component, anyValue);
 }
+bool GatherComponentAnyProperty(const Variant& propertyData, NativeType* nativeType, ::byte* destination)
+{
+  // Get associated property instance data
+  String propertyName = propertyData.GetOrError<ComponentPropertyInstanceData>().mPropertyName;
+  Component* component = propertyData.GetOrError<ComponentPropertyInstanceData>().mComponent;
+  BoundType* componentBoundType = ZilchVirtualTypeId(component);
+
+  // Get property instance
+  Property* property = componentBoundType->GetProperty(propertyName);
+  if (!property) // Unable?
+    return false;
+
+  // Get any value
+  Any anyValue = property->GetValue(component);
+  if (!anyValue.IsHoldingValue()) // Unable?
+    return false;
+
+  // The any's stored type is not the expected basic native type?
+  if (ZilchTypeToBasicNativeType(anyValue.StoredType) != nativeType)
+    return false;
+
+  // Get any's stored value data
+  const void* anyData = anyValue.Dereference();
+  if (!anyData) // Unable?
+    return false;
+
+  // Copy the property value
+  memcpy(destination, anyData, nativeType->mTypeSize);
+  return true;
+}
 
 //
 // Helper Methods
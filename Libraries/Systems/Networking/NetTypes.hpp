@@ -134,6 +134,7 @@ void SetComponentCogPathProperty(const Variant& value, Variant& propertyData);
 // Serialized Data Type: A Basic Native Type or Any
 Variant GetComponentAnyProperty(const Variant& propertyData);
 void SetComponentAnyProperty(const Variant& value, Variant& propertyData);
+bool GatherComponentAnyProperty(const Variant& propertyData, NativeType* nativeType, ::byte* destination);
 
 //
 // Helper Methods
@@ -16,6 +16,22 @@ static const String cHttpNewline("\r\n");
 // These values must correspond with the enum values in WebServerRequestMethod.
 static const String cMethods[] = {"OPTIONS", "GET", "HEAD", "POST", "PUT", "DELETE", "TRACE", "CONNECT"};
 
+// Connections are spread over a fixed number of I/O threads that each poll
+// their sockets, rather than a thread per connection.
+static const size_t cReactorCount = 2;
+// How long an I/O thread waits before checking if the server is still running.
+static const uint cReactorWaitMs = 100;
+static const size_t cMaxPollResults = 64;
+static const size_t cReceiveSize = 16 * 1024;
+// Requests are rejected if their headers are larger or the client sends more
+// post data than this.
+static const size_t cMaxHeaderSize = 64 * 1024;
+static const u64 cMaxContentLength = 256 * 1024 * 1024;
+// Keep-alive connections that haven't sent a request in this many seconds are
+// closed.
+static const TimeType cIdleTimeout = 30;
+static const uint cNoRequest = (uint)-1;
+
 ZilchDefineType(WebServerRequestEvent, builder, type)
 {
   ZilchBindFieldGetter(mWebServer);
@@ -36,7 +52,8 @@ ZilchDefineType(WebServerRequestEvent, builder, type)
 WebServerRequestEvent::WebServerRequestEvent(WebServerConnection* connection) :
     mWebServer(connection->mWebServer),
     mConnection(connection),
-    mMethod(WebServerRequestMethod::Other)
+    mMethod(WebServerRequestMethod::Other),
+    mRequestIndex(0)
 {
 }
 
@@ -115,250 +132,539 @@ void WebServerRequestEvent::Respond(StringParam response)
     return;
   }
 
-  mConnection->mWriteLock.Lock();
-  mConnection->mWriteData.Insert(mConnection->mWriteData.Begin(), response.Data(), response.EndData());
-  mConnection->mWriteComplete = true;
-  mConnection->mWriteLock.Unlock();
-  mConnection->mWriteSignal.Signal();
-
+  mConnection->QueueResponse(mRequestIndex, response);
+  mConnection->Release();
   mConnection = nullptr;
 }
 
-WebServerConnection::WebServerConnection(WebServer* server) : mWebServer(server), mWriteComplete(false)
+// Without a length the client can only tell where a response ends when the
+// connection closes.
+bool ResponseHasLength(StringParam response)
 {
-  mWriteSignal.Initialize();
+  cstr data = response.c_str();
+  cstr headerEnd = strstr(data, "\r\n\r\n");
+  size_t headerSize = headerEnd ? (size_t)(headerEnd - data) : response.SizeInBytes();
+
+  String headers = String(data, headerSize).ToLower();
+  return headers.Contains("\ncontent-length:") || headers.Contains("\ntransfer-encoding:");
 }
 
-WebServerConnection::~WebServerConnection()
+// Returns the empty line that ends the request headers, or null if it hasn't
+// been received yet.
+const char* FindHeaderEnd(const char* begin, const char* end)
 {
+  while (end - begin >= 4)
+  {
+    const char* found = (const char*)memchr(begin, '\r', end - begin - 3);
+    if (found == nullptr)
+      return nullptr;
+
+    if (found[1] == '\n' && found[2] == '\r' && found[3] == '\n')
+      return found;
+    begin = found + 1;
+  }
+  return nullptr;
 }
 
-// Method   : Reading GET/POST/PUT first line of the HTTP request.
-// Headers  : Reading headers such as "Accept-Language: en-us\r\n".
-// Content  : Reading the content length from the headers if it exists.
-// PostData : Reading everything after the \r\n\r\n (should have read a content
-// length).
-DeclareEnum4(ReadStage, Method, Headers, Content, PostData);
+// Returns the \r\n that ends the line, or the end if there isn't one.
+const char* FindLineEnd(const char* begin, const char* end)
+{
+  for (const char* it = begin; it + 1 < end; ++it)
+  {
+    if (it[0] == '\r' && it[1] == '\n')
+      return it;
+  }
+  return end;
+}
 
-OsInt WebServerConnection::ReadWriteThread(void* userData)
+String TrimmedString(const char* begin, const char* end)
 {
-  WebServerConnection* self = (WebServerConnection*)userData;
-  WebServer* webServer = self->mWebServer;
+  while (begin != end && (*begin == ' ' || *begin == '\t'))
+    ++begin;
+  while (end != begin && (end[-1] == ' ' || end[-1] == '\t'))
+    --end;
+  return String(begin, end);
+}
 
-  StringBuilder builder;
+// Parses the request line (such as "GET /index.htm HTTP/1.1") and the headers
+// (such as "Accept-Language: en-us") that come before the empty line. Returns
+// false if the request line is malformed.
+bool ParseRequestHead(const char* begin, const char* end, WebServerRequestEvent* event, String& versionOut)
+{
+  const char* newline = FindLineEnd(begin, end);
+
+  // The uri can't have spaces, but be lenient and take everything between the
+  // method and the version
+  const char* methodEnd = (const char*)memchr(begin, ' ', newline - begin);
+  const char* versionBegin = newline;
+  while (versionBegin != begin && versionBegin[-1] != ' ')
+    --versionBegin;
+  if (methodEnd == nullptr || methodEnd == begin || versionBegin <= methodEnd + 1)
+    return false;
 
-  // Look for the request method line, such as "GET /index.htm HTTP/1.1\r\n"
-  static const size_t cMethodMatchCount = 4;
-  static const Regex cMethodRegex("^([A-Z]+)\\s+(.*)\\s+HTTP/[0-9\\.]+\r\n(\r\n)?");
+  String methodString(begin, methodEnd);
+  String version(versionBegin, newline);
+  if (!version.StartsWith("HTTP/"))
+    return false;
 
-  // Look for the headers, such as "Accept-Language: en-us\r\n"
-  static const size_t cHeaderMatchCount = 4;
-  static const Regex cHeaderRegex("^([^:]+)\\s*:\\s*([^\r\n]*)\r\n(\r\n)?");
+  WebServerRequestMethod::Enum method = WebServerRequestMethod::Other;
+  for (size_t i = 0; i < WebServerRequestMethod::Size; ++i)
+  {
+    if (cMethods[i] == methodString)
+      method = (WebServerRequestMethod::Enum)i;
+  }
 
-  // Preemptively create the event so we can fill it out
-  WebServerRequestEvent* toSend = new WebServerRequestEvent(self);
+  String uri = TrimmedString(methodEnd + 1, versionBegin - 1);
+  event->mMethod = method;
+  event->mMethodString = methodString;
+  event->mOriginalUri = uri;
+  event->mDecodedUri = UrlParamDecode(uri);
+  versionOut = version;
 
-  bool running = true;
-  int contentLength = 0;
+  // Keys are case-insensitive, and values have optional whitespace
+  const char* line = Math::Min(newline + 2, end);
+  while (line < end)
+  {
+    const char* lineEnd = FindLineEnd(line, end);
 
-  // This designates what part of the http request we're reading.
-  ReadStage::Enum stage = ReadStage::Method;
+    const char* colon = (const char*)memchr(line, ':', lineEnd - line);
+    if (colon != nullptr)
+      event->mHeaders[TrimmedString(line, colon).ToLower()] = TrimmedString(colon + 1, lineEnd);
 
-  String unparsedContent;
+    line = lineEnd + 2;
+  }
 
-  while (webServer->mRunning)
+  return true;
+}
+
+WebServerConnection::WebServerConnection(WebServer* server, WebServerReactor* reactor) :
+    mWebServer(server),
+    mReactor(reactor),
+    mReferenceCount(1),
+    mHeaderSearchStart(0),
+    mNextRequestIndex(0),
+    mLastActivity(Time::GetTime()),
+    mRequestsEnded(false),
+    mNextResponseIndex(0),
+    mWriteOffset(0),
+    mCloseAfterRequest(cNoRequest),
+    mCloseAfterWrite(false),
+    mWriteFailed(false),
+    mPollingWrite(false),
+    mClosed(false)
+{
+}
+
+WebServerConnection::~WebServerConnection()
+{
+}
+
+void WebServerConnection::AddReference()
+{
+  ++mReferenceCount;
+}
+
+void WebServerConnection::Release()
+{
+  if (--mReferenceCount == 0)
+    delete this;
+}
+
+void WebServerConnection::QueueResponse(uint requestIndex, StringParam response, bool closeAfter)
+{
+  closeAfter = closeAfter || !ResponseHasLength(response);
+
+  mWriteLock.Lock();
+  if (!mClosed)
+  {
+    if (closeAfter)
+      mCloseAfterRequest = Math::Min(mCloseAfterRequest, requestIndex);
+
+    mPendingResponses.Insert(requestIndex, response);
+    FlushResponses();
+    SendWriteData();
+    UpdatePolling();
+  }
+  mWriteLock.Unlock();
+}
+
+bool WebServerConnection::OnReadable()
+{
+  for (;;)
   {
-    ::byte buffer[4096];
+    // Receive straight into the end of the unparsed data
+    size_t oldSize = mReadData.Size();
+    mReadData.Resize(oldSize + cReceiveSize);
+
     Status status;
-    size_t amount = self->mSocket.Receive(status, buffer, sizeof(buffer));
+    size_t amount = mSocket.Receive(status, (::byte*)mReadData.Data() + oldSize, cReceiveSize);
+    mReadData.Resize(oldSize + amount);
 
-    // If the connection is gracefully closed, or we had an error, then
-    // terminate the connection.
-    if (amount == 0 || status.Failed() || !webServer->mRunning)
+    if (status.Failed())
     {
-      // Mark the event's connection as null so it doesn't try to send a 404
-      // response in it's destructor.
-      toSend->mConnection = nullptr;
+      // Everything that was available has been read
+      if (Socket::IsWouldBlockError(status.Context))
+        break;
+      return false;
+    }
+
+    // The client gracefully closed the connection
+    if (amount == 0)
+      return false;
 
-      // Since the connection is considered terminated, we're no
-      // longer running (the write thread should also shut-down).
-      running = false;
-      delete toSend;
-      toSend = nullptr;
+    // Anything left will be reported on the next wait
+    if (amount < cReceiveSize)
       break;
-    }
+  }
 
-    builder.Append((cstr)buffer, amount);
+  mLastActivity = Time::GetTime();
+  ParseRequests();
+  return true;
+}
 
-    // This isn't the most efficient way of doing this,
-    // but the performance of the web server isn't critical.
-    unparsedContent = BuildString(unparsedContent, String((cstr)buffer, amount));
+bool WebServerConnection::OnWritable()
+{
+  mWriteLock.Lock();
+  SendWriteData();
+  bool open = !mWriteFailed && !(mCloseAfterWrite && mWriteData.Empty());
+  if (open)
+    UpdatePolling();
+  mWriteLock.Unlock();
+  return open;
+}
 
-    Matches matches;
+bool WebServerConnection::IsIdle(TimeType now)
+{
+  mWriteLock.Lock();
+  bool waiting = mNextResponseIndex != mNextRequestIndex || !mWriteData.Empty() || mCloseAfterWrite;
+  mWriteLock.Unlock();
 
-    if (stage == ReadStage::Method)
-    {
-      cMethodRegex.Search(unparsedContent, matches, RegexFlags::None);
+  // A request the user hasn't responded to yet keeps the connection open
+  return !waiting && now - mLastActivity >= cIdleTimeout;
+}
 
-      if (matches.Size() == cMethodMatchCount)
-      {
-        WebServerRequestMethod::Enum method = WebServerRequestMethod::Other;
-        String methodString = matches[1];
-        String uri = matches[2];
-
-        for (size_t i = 0; i < WebServerRequestMethod::Size; ++i)
-        {
-          if (cMethods[i] == methodString)
-            method = (WebServerRequestMethod::Enum)i;
-        }
-
-        toSend->mMethod = method;
-        toSend->mMethodString = methodString;
-        toSend->mOriginalUri = uri;
-        toSend->mDecodedUri = UrlParamDecode(uri);
-
-        // Was this the last line in the header? We know this because we'll see
-        // \r\n\r\n. Note that this is extremely unlikely to not get any other
-        // headers, and only the method request line.
-        if (!matches[3].Empty())
-          stage = ReadStage::Content;
-        else
-          stage = ReadStage::Headers;
-
-        unparsedContent = unparsedContent.SubString(matches[0].End(), unparsedContent.End());
-      }
-    }
+void WebServerConnection::Close()
+{
+  mWriteLock.Lock();
+  if (!mClosed)
+  {
+    Status status;
+    mReactor->mPoller.Remove(status, mSocket);
+    mSocket.Close();
+    mPendingResponses.Clear();
+    mWriteData.Clear();
+    mClosed = true;
+  }
+  mWriteLock.Unlock();
+}
+
+void WebServerConnection::ParseRequests()
+{
+  size_t parsed = 0;
 
-    if (stage == ReadStage::Headers)
+  while (!mRequestsEnded)
+  {
+    const char* data = mReadData.Data() + parsed;
+    size_t size = mReadData.Size() - parsed;
+
+    const char* headerEnd = FindHeaderEnd(data + mHeaderSearchStart, data + size);
+    if (headerEnd == nullptr)
     {
-      // Loop until we don't find any headers in the unparsed data.
-      // Note that there could still be more incoming even when we finish this
-      // loop!
-      for (;;)
+      if (size > cMaxHeaderSize)
       {
-        cHeaderRegex.Search(unparsedContent, matches, RegexFlags::None);
-
-        if (matches.Size() == cHeaderMatchCount)
-        {
-          // Add the header to the event (keys are case-insensitive, and values
-          // have optional whitespace).
-          String key = matches[1].ToLower();
-          String value = matches[2].Trim();
-          toSend->mHeaders[key] = value;
-
-          // Was this the last line in the header? We know this because we'll
-          // see \r\n\r\n.
-          if (!matches[3].Empty())
-            stage = ReadStage::Content;
-
-          unparsedContent = unparsedContent.SubString(matches[0].End(), unparsedContent.End());
-        }
-        else
-        {
-          // We didn't find another header.
-          break;
-        }
+        RejectRequest(WebResponseCode::BadRequest);
+        break;
       }
+
+      // The empty line could be split across receives
+      mHeaderSearchStart = size >= 3 ? size - 3 : 0;
+      break;
     }
 
-    if (stage == ReadStage::Content)
-    {
-      // We only care about post data if there was a Content-Length field.
-      static const String cContentLength("content-length");
-      String contentLengthString = toSend->GetHeaderValue(cContentLength);
+    WebServerRequestEvent* event = new WebServerRequestEvent(this);
+    String version;
+    bool parsedHead = ParseRequestHead(data, headerEnd, event, version);
 
-      if (!contentLengthString.Empty())
-        contentLength = atoi(contentLengthString.c_str());
+    static const String cContentLength("content-length");
+    static const String cTransferEncoding("transfer-encoding");
+    String contentLengthString = event->GetHeaderValue(cContentLength);
+    bool hasTransferEncoding = event->HasHeader(cTransferEncoding);
 
-      // If we didn't have the header, or for some reason the content length was
-      // unparsable or 0, then we're done!
-      if (contentLength == 0)
-      {
-        toSend->mData = builder.ToString();
-        Z::gDispatch->Dispatch(webServer, Events::WebServerRequestRaw, toSend);
-        toSend = nullptr;
-        break;
-      }
+    // We only care about post data if there was a Content-Length field.
+    char* contentLengthEnd = nullptr;
+    u64 contentLength = strtoull(contentLengthString.c_str(), &contentLengthEnd, 10);
+    bool validContentLength = contentLengthString.Empty() || *contentLengthEnd == '\0';
+
+    if (!parsedHead || !validContentLength || hasTransferEncoding || contentLength > cMaxContentLength)
+    {
+      // Mark the event's connection as null so it doesn't try to send a 404
+      // response in it's destructor.
+      event->mConnection = nullptr;
+      delete event;
+
+      if (hasTransferEncoding)
+        RejectRequest(WebResponseCode::UnimplementedHeaderValueUsed);
+      else if (contentLength > cMaxContentLength)
+        RejectRequest(WebResponseCode::RequestEntityTooLarge);
       else
-      {
-        // Otherwise we move onto POST data parsing.
-        stage = ReadStage::PostData;
-      }
+        RejectRequest(WebResponseCode::BadRequest);
+      break;
     }
 
-    if (stage == ReadStage::PostData)
+    size_t headerSize = (size_t)(headerEnd - data) + 4;
+    size_t requestSize = headerSize + (size_t)contentLength;
+    if (size < requestSize)
     {
-      // If we have enough data from the client to make-up all the post data,
-      // then dispatch it!
-      if ((int)unparsedContent.SizeInBytes() >= contentLength)
-      {
-        toSend->mData = builder.ToString();
-        toSend->mPostData = unparsedContent;
-        Z::gDispatch->Dispatch(webServer, Events::WebServerRequestRaw, toSend);
-        toSend = nullptr;
-        break;
-      }
+      // Wait for the rest of the post data, the headers are parsed again
+      // once it's here.
+      event->mConnection = nullptr;
+      delete event;
+      mHeaderSearchStart = headerSize - 4;
+      break;
     }
+
+    event->mData = String(data, requestSize);
+    event->mPostData = String(data + headerSize, (size_t)contentLength);
+    event->mRequestIndex = mNextRequestIndex++;
+
+    // HTTP/1.1 connections stay open unless the client asks otherwise. Older
+    // clients would need a keep-alive response header, so they're closed.
+    static const String cConnection("connection");
+    String connection = event->GetHeaderValue(cConnection).ToLower();
+    if (version != "HTTP/1.1" || connection.Contains("close"))
+    {
+      mRequestsEnded = true;
+      mWriteLock.Lock();
+      mCloseAfterRequest = Math::Min(mCloseAfterRequest, event->mRequestIndex);
+      mWriteLock.Unlock();
+    }
+
+    // The event holds a reference until it's responded to.
+    AddReference();
+    Z::gDispatch->Dispatch(mWebServer, Events::WebServerRequestRaw, event);
+
+    parsed += requestSize;
+    mHeaderSearchStart = 0;
+  }
+
+  // Anything sent after the last request is ignored
+  if (mRequestsEnded)
+  {
+    mReadData.Clear();
+    return;
   }
 
-  ErrorIf(toSend != nullptr, "We should have sent or deleted the event by this point");
+  // Remove the requests that were dispatched, this only moves the partial
+  // request at the end (if any)
+  if (parsed != 0)
+  {
+    size_t remaining = mReadData.Size() - parsed;
+    memmove(mReadData.Data(), mReadData.Data() + parsed, remaining);
+    mReadData.Resize(remaining);
+  }
+}
+
+void WebServerConnection::RejectRequest(WebResponseCode::Enum code)
+{
+  mRequestsEnded = true;
+
+  String response = BuildString("HTTP/1.1 ", WebServer::GetWebResponseCodeString(code), "\r\ncontent-length: 0\r\n\r\n");
+  QueueResponse(mNextRequestIndex++, response, true);
+}
 
-  if (running)
+void WebServerConnection::FlushResponses()
+{
+  // Responses are sent in request order, so one that's ready early waits for
+  // the responses before it.
+  while (!mCloseAfterWrite)
   {
-    Array<::byte> writeData;
+    String* response = mPendingResponses.FindPointer(mNextResponseIndex);
+    if (response == nullptr)
+      break;
+
+    mWriteData.Insert(mWriteData.End(), response->Data(), response->EndData());
+    mPendingResponses.Erase(mNextResponseIndex);
 
-    // Loop until we're no longer running, or an error occurs.
-    for (;;)
+    if (mNextResponseIndex == mCloseAfterRequest)
+      mCloseAfterWrite = true;
+    ++mNextResponseIndex;
+  }
+}
+
+void WebServerConnection::SendWriteData()
+{
+  while (mWriteOffset < mWriteData.Size())
+  {
+    Status status;
+    size_t amount = mSocket.Send(status, mWriteData.Data() + mWriteOffset, mWriteData.Size() - mWriteOffset);
+
+    if (status.Failed())
     {
-      self->mWriteSignal.Wait();
+      // The rest is sent once the socket is writable again
+      if (!Socket::IsWouldBlockError(status.Context))
+        mWriteFailed = true;
+      break;
+    }
 
-      if (!webServer->mRunning)
-        break;
+    if (amount == 0)
+      break;
+    mWriteOffset += amount;
+  }
+
+  // Clear the data but keep the buffer allocated.
+  if (mWriteOffset == mWriteData.Size() || mWriteFailed)
+  {
+    mWriteData.Clear();
+    mWriteOffset = 0;
+  }
+}
 
-      // Steal any data that needs to be written.
-      self->mWriteLock.Lock();
-      writeData.Swap(self->mWriteData);
-      running = !self->mWriteComplete;
-      self->mWriteLock.Unlock();
+void WebServerConnection::UpdatePolling()
+{
+  // The reactor closes the connection when it sees it's writable after the
+  // last response was sent (or failed)
+  bool pollWrite = !mWriteData.Empty() || mCloseAfterWrite || mWriteFailed;
+  if (pollWrite == mPollingWrite)
+    return;
 
-      ::byte* buffer = writeData.Data();
-      size_t size = writeData.Size();
+  SocketPollFlags::Type flags = SocketPollFlags::Read;
+  if (pollWrite)
+    flags |= SocketPollFlags::Write;
 
-      // Write out all the data we have.
-      while (size != 0)
-      {
-        Status status;
-        size_t amount = self->mSocket.Send(status, buffer, size);
+  Status status;
+  mReactor->mPoller.Modify(status, mSocket, flags, this);
+  mPollingWrite = pollWrite;
+}
+
+WebServerReactor::WebServerReactor(WebServer* server) : mWebServer(server), mLastIdleCheck(0)
+{
+}
+
+WebServerReactor::~WebServerReactor()
+{
+  Stop();
+}
+
+bool WebServerReactor::Start(Status& status)
+{
+  if (!mPoller.Open(status))
+    return false;
+
+  mLastIdleCheck = Time::GetTime();
+  mThread.Initialize(&IoThread, this, "WebServerIo");
+  return true;
+}
+
+void WebServerReactor::Stop()
+{
+  if (mThread.IsValid())
+  {
+    mThread.WaitForCompletion();
+    mThread.Close();
+  }
+
+  mConnectionsLock.Lock();
+  Array<WebServerConnection*> connections;
+  connections.Swap(mConnections);
+  mConnectionsLock.Unlock();
+
+  // Events that haven't been responded to keep their connection alive, but
+  // their responses are dropped.
+  forRange (WebServerConnection* connection, connections)
+  {
+    connection->Close();
+    connection->Release();
+  }
+
+  mPoller.Close();
+}
+
+void WebServerReactor::AddConnection(WebServerConnection* connection)
+{
+  mConnectionsLock.Lock();
+  mConnections.PushBack(connection);
+  mConnectionsLock.Unlock();
+
+  Status status;
+  mPoller.Add(status, connection->mSocket, SocketPollFlags::Read, connection);
+  if (status.Failed())
+    CloseConnection(connection);
+}
+
+void WebServerReactor::CloseConnection(WebServerConnection* connection)
+{
+  connection->Close();
+
+  mConnectionsLock.Lock();
+  mConnections.EraseValue(connection);
+  mConnectionsLock.Unlock();
+
+  connection->Release();
+}
+
+void WebServerReactor::CloseIdleConnections()
+{
+  // Idle connections are only looked for once a second
+  TimeType now = Time::GetTime();
+  if (now == mLastIdleCheck)
+    return;
+  mLastIdleCheck = now;
+
+  Array<WebServerConnection*> idleConnections;
+  mConnectionsLock.Lock();
+  forRange (WebServerConnection* connection, mConnections)
+  {
+    if (connection->IsIdle(now))
+      idleConnections.PushBack(connection);
+  }
+  mConnectionsLock.Unlock();
+
+  forRange (WebServerConnection* connection, idleConnections)
+    CloseConnection(connection);
+}
 
-        if (amount == 0 || status.Failed())
-        {
-          running = false;
-          break;
-        }
+OsInt WebServerReactor::IoThread(void* userData)
+{
+  WebServerReactor* self = (WebServerReactor*)userData;
+  WebServer* webServer = self->mWebServer;
+
+  SocketPollResult results[cMaxPollResults];
+  while (webServer->mRunning)
+  {
+    Status status;
+    size_t count = self->mPoller.Wait(status, results, cMaxPollResults, cReactorWaitMs);
+    if (status.Failed())
+    {
+      Os::Sleep(cReactorWaitMs);
+      continue;
+    }
 
-        size -= amount;
-        buffer += amount;
+    for (size_t i = 0; i < count; ++i)
+    {
+      // The listening socket is polled with itself as the user data
+      if (results[i].mUserData == &webServer->mAcceptSocket)
+      {
+        webServer->AcceptConnections();
+        continue;
       }
 
-      // Clear the data but keep the buffer allocated (this makes the swap more
-      // efficient).
-      writeData.Clear();
+      WebServerConnection* connection = (WebServerConnection*)results[i].mUserData;
+      SocketPollFlags::Type flags = results[i].mFlags;
 
-      // If we wrote all the data, then we're done with this thread!
-      if (!running)
-        break;
+      // A closed connection is read from until the receive reports why
+      bool open = true;
+      if (flags & (SocketPollFlags::Read | SocketPollFlags::Closed))
+        open = connection->OnReadable();
+      if (open && (flags & SocketPollFlags::Write))
+        open = connection->OnWritable();
+
+      if (!open)
+        self->CloseConnection(connection);
     }
-  }
 
-  // Since we got here, it's time to erase/delete this connection.
-  webServer->mConnectionsLock.Lock();
-  webServer->mConnections.EraseValue(self);
-  webServer->mConnectionCountEvent.DecrementCount();
-  webServer->mConnectionsLock.Unlock();
+    self->CloseIdleConnections();
+  }
 
-  // Since we're done with the connection, delete it.
-  // The server won't touch the connection.
-  delete self;
   return 0;
 }
 
@@ -378,7 +684,7 @@ ZilchDefineType(WebServer, builder, type)
   ZilchBindFieldProperty(mPath);
 }
 
-WebServer::WebServer()
+WebServer::WebServer() : mNextReactor(0)
 {
   ConnectThisTo(this, Events::WebServerRequestRaw, OnWebServerRequestRaw);
 }
@@ -416,8 +722,32 @@ bool WebServer::Host(uint port)
   if (status.Failed())
     return false;
 
+  mAcceptSocket.SetBlocking(status, false);
+  if (status.Failed())
+    return false;
+
   mRunning = true;
-  mAcceptThread.Initialize(&AcceptThread, this, "WebServerAccept");
+  mNextReactor = 0;
+  for (size_t i = 0; i < cReactorCount; ++i)
+  {
+    WebServerReactor* reactor = new WebServerReactor(this);
+    mReactors.PushBack(reactor);
+
+    if (!reactor->Start(status))
+    {
+      Close();
+      return false;
+    }
+  }
+
+  // The first reactor also accepts connections.
+  mReactors.Front()->mPoller.Add(status, mAcceptSocket, SocketPollFlags::Read, &mAcceptSocket);
+  if (status.Failed())
+  {
+    Close();
+    return false;
+  }
+
   return true;
 }
 
@@ -427,23 +757,14 @@ void WebServer::Close()
     return;
 
   mRunning = false;
-  mAcceptSocket.Close();
-  mAcceptThread.WaitForCompletion();
-  mAcceptThread.Close();
 
-  mConnectionsLock.Lock();
-  forRange (WebServerConnection* connection, mConnections)
-  {
-    // Close the socket to resume from any blocking reads.
-    connection->mSocket.Close();
-
-    // Signal the writes so that we'll resume from waiting.
-    connection->mWriteSignal.Signal();
-  }
-  mConnectionsLock.Unlock();
+  // The first reactor accepts connections, so it's stopped before the
+  // connections are handed to any others.
+  forRange (WebServerReactor* reactor, mReactors)
+    reactor->Stop();
+  DeleteObjectsInContainer(mReactors);
 
-  // Wait until all the connections are finished.
-  mConnectionCountEvent.Wait();
+  mAcceptSocket.Close();
 }
 
 String WebServer::GetWebResponseCodeString(WebResponseCode::Enum code)
@@ -679,35 +1000,29 @@ void WebServer::DoNotifyExceptionOnFail(StringParam message, const u32& context,
   DoNotifyException("WebServer", message);
 }
 
-OsInt WebServer::AcceptThread(void* userData)
+void WebServer::AcceptConnections()
 {
-  WebServer* self = (WebServer*)userData;
-
-  while (self->mRunning)
+  for (;;)
   {
     Socket acceptedSocket;
 
+    // Stop once there are no more pending connections.
     Status status;
-    self->mAcceptSocket.Accept(status, &acceptedSocket);
+    mAcceptSocket.Accept(status, &acceptedSocket);
+    if (status.Failed() || !acceptedSocket.IsOpen())
+      break;
 
-    // If we got a valid socket then throw it on the connections list and start
-    // up threads for the socket.
-    if (status.Succeeded() && acceptedSocket.IsOpen())
-    {
-      WebServerConnection* connection = new WebServerConnection(self);
-      connection->mSocket = ZeroMove(acceptedSocket);
+    acceptedSocket.SetBlocking(status, false);
+    if (status.Failed())
+      continue;
 
-      connection->mReadWriteThread.Initialize(
-          &WebServerConnection::ReadWriteThread, connection, "WebServerConnectionReadWrite");
+    WebServerReactor* reactor = mReactors[mNextReactor];
+    mNextReactor = (mNextReactor + 1) % mReactors.Size();
 
-      self->mConnectionsLock.Lock();
-      self->mConnections.PushBack(connection);
-      self->mConnectionCountEvent.IncrementCount();
-      self->mConnectionsLock.Unlock();
-    }
+    WebServerConnection* connection = new WebServerConnection(this, reactor);
+    connection->mSocket = ZeroMove(acceptedSocket);
+    reactor->AddConnection(connection);
   }
-
-  return 0;
 }
 
 } // namespace Zero
@@ -25,6 +25,7 @@ typedef WebServerHeaderMap::KeyRange WebServerHeaderRange;
 
 class WebServer;
 class WebServerConnection;
+class WebServerReactor;
 
 /// An event that occurs when we get data from a web server (such as a request).
 /// If no Respond function is called on the event then we will automatically
@@ -97,23 +98,95 @@ public:
   /// The connection that this event originated from. We clear the event once we
   /// have responded.
   WebServerConnection* mConnection;
+
+  /// Which request this was on the connection. Pipelined requests can be
+  /// responded to in any order, but the responses are sent in request order.
+  uint mRequestIndex;
 };
 
+/// One keep-alive HTTP connection. Requests are parsed on the reactor's I/O
+/// thread and responses are queued from the main thread. Each event that hasn't
+/// been responded to holds a reference, so the connection outlives its socket.
 class WebServerConnection
 {
 public:
-  WebServerConnection(WebServer* server);
+  WebServerConnection(WebServer* server, WebServerReactor* reactor);
   ~WebServerConnection();
 
-  static OsInt ReadWriteThread(void* userData);
+  void AddReference();
+  void Release();
+
+  /// Adds the response to a request and sends what it can without blocking.
+  /// Called from any thread, and ignored once the connection is closed.
+  void QueueResponse(uint requestIndex, StringParam response, bool closeAfter = false);
+
+  // These are only called on the reactor's I/O thread. They return false when
+  // the connection should be closed.
+  bool OnReadable();
+  bool OnWritable();
+  bool IsIdle(TimeType now);
+  void Close();
 
   WebServer* mWebServer;
+  WebServerReactor* mReactor;
   Socket mSocket;
-  Thread mReadWriteThread;
-  OsEvent mWriteSignal;
+  Atomic<int> mReferenceCount;
+
+  // Only used by the I/O thread.
+  Array<char> mReadData;
+  size_t mHeaderSearchStart;
+  uint mNextRequestIndex;
+  TimeType mLastActivity;
+  /// Set once a request that ends the connection is read, anything the client
+  /// sends after it is ignored.
+  bool mRequestsEnded;
+
+  // Everything below is guarded by the write lock.
   ThreadLock mWriteLock;
+  HashMap<uint, String> mPendingResponses;
+  uint mNextResponseIndex;
   Array<::byte> mWriteData;
-  bool mWriteComplete;
+  size_t mWriteOffset;
+  /// The request after which the connection is closed (keep-alive wasn't
+  /// requested, or the response has no length).
+  uint mCloseAfterRequest;
+  bool mCloseAfterWrite;
+  bool mWriteFailed;
+  bool mPollingWrite;
+  bool mClosed;
+
+private:
+  void ParseRequests();
+  void RejectRequest(WebResponseCode::Enum code);
+  void FlushResponses();
+  void SendWriteData();
+  void UpdatePolling();
+};
+
+/// Waits on a set of connections with a SocketPoller and services them on its
+/// own I/O thread. The first reactor also accepts new connections.
+class WebServerReactor
+{
+public:
+  WebServerReactor(WebServer* server);
+  ~WebServerReactor();
+
+  bool Start(Status& status);
+  /// Waits for the I/O thread and closes all of the connections.
+  void Stop();
+
+  void AddConnection(WebServerConnection* connection);
+  void CloseConnection(WebServerConnection* connection);
+  void CloseIdleConnections();
+
+  static OsInt IoThread(void* userData);
+
+  WebServer* mWebServer;
+  SocketPoller mPoller;
+  Thread mThread;
+  ThreadLock mConnectionsLock;
+  Array<WebServerConnection*> mConnections;
+  TimeType mLastIdleCheck;
 };
 
 /// Listens on a given port for incoming HTTP traffic and allows the user
@@ -124,6 +197,7 @@ class WebServer : public ReferenceCountedThreadSafeId32EventObject
 {
 public:
   friend class WebServerConnection;
+  friend class WebServerReactor;
 
   ZilchDeclareType(WebServer, TypeCopyMode::ReferenceType);
 
@@ -139,8 +213,8 @@ public:
   bool Host(uint port);
 
   /// Closes the server and all connections.
-  /// This will block until the connections are completed / all threads are
-  /// shutdown.
+  /// This will block until all the I/O threads are shutdown. Responses to
+  /// requests that are still pending are dropped.
   void Close();
 
   /// Replaces & > < " ' characters with &amp; &lt; &gt; &quot; &#39; and
@@ -185,15 +259,14 @@ public:
 private:
   void OnWebServerRequestRaw(WebServerRequestEvent* event);
   static void DoNotifyExceptionOnFail(StringParam message, const u32& context, void* userData);
-  static OsInt AcceptThread(void* userData);
+  /// Accepts every pending connection (called on the first reactor's thread).
+  void AcceptConnections();
 
-  Thread mAcceptThread;
   Socket mAcceptSocket;
   Atomic<bool> mLogging;
   Atomic<bool> mRunning;
-  ThreadLock mConnectionsLock;
-  Array<WebServerConnection*> mConnections;
-  CountdownEvent mConnectionCountEvent;
+  Array<WebServerReactor*> mReactors;
+  size_t mNextReactor;
 
   // Maps the extension (without '.') to a MIME type.
   HashMap<String, String> mExtensionToMimeType;
@@ -35,7 +35,7 @@ Contact* ContactManager::AddManifold(Manifold& manifold)
   // If the contact didn't already exist, create it
   if (!contact)
   {
-    contact = mContactPool->AllocateType<Contact>();
+    contact = new (PhysicsSpace::AllocateShared(mContactPool, sizeof(Contact))) Contact();
 
     contact->mContactManager = this;
     contact->SetPair(manifold.Objects);
@@ -105,7 +105,8 @@ void ContactManager::DestroyContacts()
     Contact* contact = &mContactsToDestroy.Front();
     mContactsToDestroy.PopFront();
 
-    mContactPool->DeallocateType(contact);
+    contact->~Contact();
+    PhysicsSpace::DeallocateShared(mContactPool, contact, sizeof(Contact));
   }
 }
 
@@ -4,6 +4,163 @@
 namespace Zero
 {
 
+namespace
+{
+
+// Walks the bounds of a patch from the top block down and tests the ray
+// against the triangles of the cells it can touch, keeping the closest hit.
+struct HeightPatchRayCast
+{
+  HeightPatchRayCast(HeightMap* map, Vec3Param rayStart, Vec3Param rayDirection, real maxT)
+  {
+    mMap = map;
+    mBounds = nullptr;
+    mRayStart = rayStart;
+    mRayDirection = rayDirection;
+    mCellSize = map->mUnitsPerPatch / HeightPatch::Size;
+    mHit = false;
+    mT = maxT;
+    mTriangleIndex = 0;
+  }
+
+  void SetPatch(HeightPatchBounds* bounds)
+  {
+    mBounds = bounds;
+    Vec2 patchPos = mMap->GetLocalPosition(bounds->mIndex);
+    mPatchStart = patchPos - Vec2(mMap->mUnitsPerPatch, mMap->mUnitsPerPatch) * .5f;
+  }
+
+  // Clips the ray against the block's square on the x-z plane. The square is
+  // padded slightly so that hits exactly on an edge are never lost.
+  bool ClipBlock(uint level, uint x, uint y, real minT, real maxT, real& enterT, real& exitT)
+  {
+    real blockSize = mCellSize * real(1 << level);
+    real padding = mCellSize * real(0.01f);
+    Vec2 blockMin = mPatchStart + Vec2(real(x), real(y)) * blockSize - Vec2(padding, padding);
+    Vec2 blockMax = blockMin + Vec2(blockSize, blockSize) + Vec2(padding, padding) * real(2);
+
+    Vec2 start(mRayStart.x, mRayStart.z);
+    Vec2 direction(mRayDirection.x, mRayDirection.z);
+    enterT = minT;
+    exitT = maxT;
+    for (uint axis = 0; axis < 2; ++axis)
+    {
+      if (direction[axis] == real(0))
+      {
+        if (start[axis] < blockMin[axis] || start[axis] > blockMax[axis])
+          return false;
+        continue;
+      }
+
+      real t0 = (blockMin[axis] - start[axis]) / direction[axis];
+      real t1 = (blockMax[axis] - start[axis]) / direction[axis];
+      if (t0 > t1)
+        Math::Swap(t0, t1);
+      enterT = Math::Max(enterT, t0);
+      exitT = Math::Min(exitT, t1);
+    }
+    return enterT <= exitT;
+  }
+
+  // Whether the ray's height over the clipped range overlaps the block's heights
+  bool OverlapsHeight(Vec2Param bounds, real enterT, real exitT)
+  {
+    // Empty blocks have their min above their max
+    if (bounds.x > bounds.y)
+      return false;
+
+    real padding = (bounds.y - bounds.x) * real(0.02f) + real(0.001f);
+    real y0 = mRayStart.y + mRayDirection.y * enterT;
+    real y1 = mRayStart.y + mRayDirection.y * exitT;
+    if (Math::Max(y0, y1) < bounds.x - padding || Math::Min(y0, y1) > bounds.y + padding)
+      return false;
+    return true;
+  }
+
+  void CastBlock(uint level, uint x, uint y, real minT)
+  {
+    real enterT, exitT;
+    if (!ClipBlock(level, x, y, minT, mT, enterT, exitT))
+      return;
+    if (!OverlapsHeight(mBounds->GetBounds(level, x, y), enterT, exitT))
+      return;
+
+    if (level == 1)
+    {
+      CastCells(x * 2, y * 2, minT);
+      return;
+    }
+
+    // Visit the children closest to the ray's start first so that a hit
+    // shortens the ray for the rest
+    uint flipX = mRayDirection.x < real(0) ? 1 : 0;
+    uint flipY = mRayDirection.z < real(0) ? 1 : 0;
+    for (uint i = 0; i < 4; ++i)
+    {
+      uint childX = x * 2 + ((i & 1) ^ flipX);
+      uint childY = y * 2 + ((i >> 1) ^ flipY);
+      CastBlock(level - 1, childX, childY, minT);
+    }
+  }
+
+  // Tests the triangles of the 2x2 cells starting at the given cell
+  void CastCells(uint startX, uint startY, real minT)
+  {
+    for (uint i = 0; i < 4; ++i)
+    {
+      uint x = startX + (i & 1);
+      uint y = startY + (i >> 1);
+
+      real enterT, exitT;
+      if (!ClipBlock(0, x, y, minT, mT, enterT, exitT))
+        continue;
+      if (!OverlapsHeight(mBounds->GetBounds(0, x, y), enterT, exitT))
+        continue;
+
+      Triangle triangles[2];
+      uint count = mBounds->GetTriangles(mMap, x, y, triangles);
+      for (uint j = 0; j < count; ++j)
+      {
+        // The same test that HeightMapRayRange uses
+        Triangle& tri = triangles[j];
+        Intersection::IntersectionPoint point;
+        Intersection::Type type =
+            Intersection::RayTriangle(mRayStart, mRayDirection, tri.p0, tri.p1, tri.p2, &point, real(0.001));
+        if (type == Intersection::None || point.T > mT)
+          continue;
+        if (mHit && point.T == mT)
+          continue;
+
+        mHit = true;
+        mT = point.T;
+        mPoint = point;
+        mTriangle = tri;
+        mPatchIndex = mBounds->mIndex;
+        mCellIndex = CellIndex(x, y);
+        mTriangleIndex = j;
+      }
+    }
+  }
+
+  HeightMap* mMap;
+  HeightPatchBounds* mBounds;
+  Vec2 mPatchStart;
+  real mCellSize;
+  Vec3 mRayStart;
+  Vec3 mRayDirection;
+
+  // Closest hit so far
+  bool mHit;
+  real mT;
+  Intersection::IntersectionPoint mPoint;
+  Triangle mTriangle;
+  PatchIndex mPatchIndex;
+  CellIndex mCellIndex;
+  uint mTriangleIndex;
+};
+
+} // namespace
+
 ZilchDefineType(HeightMapCollider, builder, type)
 {
   ZeroBindComponent();
@@ -14,6 +171,10 @@ ZilchDefineType(HeightMapCollider, builder, type)
 
   ZilchBindGetterSetterProperty(Thickness);
   ZilchBindMethod(ClearCachedEdgeAdjacency);
+  ZilchBindOverloadedMethod(CastRays,
+                            ZilchInstanceOverload(CastResultsRange, const HandleOf<ArrayClass<Vec3>>&, Vec3Param));
+  ZilchBindOverloadedMethod(
+      CastRays, ZilchInstanceOverload(CastResultsRange, const HandleOf<ArrayClass<Vec3>>&, Vec3Param, CastFilter&));
 }
 
 HeightMapCollider::HeightMapCollider()
@@ -22,6 +183,11 @@ HeightMapCollider::HeightMapCollider()
   mLocalAabb.Zero();
 }
 
+HeightMapCollider::~HeightMapCollider()
+{
+  ClearPatchBounds();
+}
+
 void HeightMapCollider::Serialize(Serializer& stream)
 {
   Collider::Serialize(stream);
@@ -122,35 +288,149 @@ void HeightMapCollider::ClearCachedEdgeAdjacency()
   mInfoMap.Clear();
 }
 
-HeightMapCollider::HeightMapRangeWrapper::HeightMapRangeWrapper(HeightMap* map, Aabb& aabb, real thickness)
+HeightMapCollider::HeightMapRangeWrapper::HeightMapRangeWrapper(HeightMapCollider* collider, const Aabb& aabb)
 {
-  mRange.SetLocal(map, aabb, thickness);
+  mCollider = collider;
+  mThickness = collider->mThickness;
+  mLocalAabbMin = aabb.mMin;
+  mLocalAabbMax = aabb.mMax;
+  mPatchBounds = nullptr;
+  mTriangleCount = 0;
+  mTriangleIndex = 0;
+
+  // Project the aabb onto the height map plane and convert it to patch indices
+  HeightMap* map = collider->mMap;
+  mMinPatch = map->GetPatchIndexFromLocal(Vec2(mLocalAabbMin.x, mLocalAabbMin.z));
+  mMaxPatch = map->GetPatchIndexFromLocal(Vec2(mLocalAabbMax.x, mLocalAabbMax.z));
+  mPatchIndex = mMinPatch;
+
+  SkipDeadPatches();
+  SkipDeadCells();
 }
 
 void HeightMapCollider::HeightMapRangeWrapper::PopFront()
 {
-  mRange.PopFront();
+  ++mTriangleIndex;
+  if (mTriangleIndex < mTriangleCount)
+    return;
+
+  ++mCellIndex.x;
+  SkipDeadCells();
 }
 
 HeightMapCollider::HeightMapRangeWrapper::InternalObject& HeightMapCollider::HeightMapRangeWrapper::Front()
 {
-  HeightMapAabbRange::TriangleInfo item = mRange.Front();
-  AbsoluteIndex absIndex = mRange.mMap->GetAbsoluteIndex(item.mPatchIndex, item.mCellIndex);
-  uint triIndex = mRange.mTriangleIndex;
+  AbsoluteIndex absIndex = mCollider->mMap->GetAbsoluteIndex(mPatchIndex, mCellIndex);
 
   // Convert the triangle's info into a unique 32-bit key (change the key later
   // to be bigger?)
   uint key;
-  HeightMapCollider::TriangleIndexToKey(absIndex, triIndex, key);
+  HeightMapCollider::TriangleIndexToKey(absIndex, mTriangleIndex, key);
   mObj.Index = key;
-  mObj.Shape.BaseTri = item.mLocalTri;
+  mObj.Shape.BaseTri = mTriangles[mTriangleIndex];
 
   return mObj;
 }
 
 bool HeightMapCollider::HeightMapRangeWrapper::Empty()
 {
-  return mRange.Empty();
+  // We're done when we exceed the max y patch value
+  return mPatchIndex.y > mMaxPatch.y;
+}
+
+void HeightMapCollider::HeightMapRangeWrapper::SkipDeadPatches()
+{
+  // Only patches that exist in the map have bounds
+  while (!Empty())
+  {
+    mPatchBounds = mCollider->mPatchBounds.FindValue(mPatchIndex, nullptr);
+    if (mPatchBounds != nullptr)
+    {
+      LoadCellRange();
+      return;
+    }
+
+    // Get the next column, if we exceed our max get the next row
+    ++mPatchIndex.x;
+    if (mPatchIndex.x > mMaxPatch.x)
+    {
+      mPatchIndex.x = mMinPatch.x;
+      ++mPatchIndex.y;
+    }
+  }
+}
+
+void HeightMapCollider::HeightMapRangeWrapper::LoadCellRange()
+{
+  // Same as HeightMapAabbRange::GetCellIndices
+  HeightMap* map = mCollider->mMap;
+  Vec2 patchPos = map->GetLocalPosition(mPatchIndex);
+  Vec2 patchHalfExtents = Vec2(map->mUnitsPerPatch, map->mUnitsPerPatch) * .5f;
+  Vec2 patchStart = patchPos - patchHalfExtents;
+  Vec2 localMin = Vec2(mLocalAabbMin.x, mLocalAabbMin.z) - patchStart;
+  Vec2 localMax = Vec2(mLocalAabbMax.x, mLocalAabbMax.z) - patchStart;
+
+  int lastCell = HeightPatch::Size - 1;
+  real cellSizeScalar = map->mUnitsPerPatch / HeightPatch::Size;
+  mMinCell.x = Math::Clamp((int)Math::Floor(localMin.x / cellSizeScalar), 0, lastCell);
+  mMinCell.y = Math::Clamp((int)Math::Floor(localMin.y / cellSizeScalar), 0, lastCell);
+  mMaxCell.x = Math::Clamp((int)Math::Floor(localMax.x / cellSizeScalar), 0, lastCell);
+  mMaxCell.y = Math::Clamp((int)Math::Floor(localMax.y / cellSizeScalar), 0, lastCell);
+  mCellIndex = mMinCell;
+}
+
+void HeightMapCollider::HeightMapRangeWrapper::SkipDeadCells()
+{
+  // The current cell may already be the one we want
+  while (!Empty())
+  {
+    if (mCellIndex.x > mMaxCell.x)
+    {
+      mCellIndex.x = mMinCell.x;
+      ++mCellIndex.y;
+    }
+
+    // Out of rows, move on to the next patch
+    if (mCellIndex.y > mMaxCell.y)
+    {
+      ++mPatchIndex.x;
+      if (mPatchIndex.x > mMaxPatch.x)
+      {
+        mPatchIndex.x = mMinPatch.x;
+        ++mPatchIndex.y;
+      }
+      SkipDeadPatches();
+      continue;
+    }
+
+    uint cellsToSkip = GetCellsToSkip();
+    if (cellsToSkip != 0)
+    {
+      mCellIndex.x += cellsToSkip;
+      continue;
+    }
+
+    // The cell's bounds passed so it has at least one triangle
+    mTriangleCount = mPatchBounds->GetTriangles(mCollider->mMap, mCellIndex.x, mCellIndex.y, mTriangles);
+    mTriangleIndex = 0;
+    return;
+  }
+}
+
+uint HeightMapCollider::HeightMapRangeWrapper::GetCellsToSkip()
+{
+  // Check the largest blocks first to skip as many cells as possible. The
+  // cell level is the same test as HeightMapAabbRange::TrianglesWorthChecking.
+  for (int level = HeightPatchBounds::cLevelCount - 1; level >= 0; --level)
+  {
+    Vec2 bounds = mPatchBounds->GetBounds(level, mCellIndex.x >> level, mCellIndex.y >> level);
+    if (bounds.x - mThickness > mLocalAabbMax.y || bounds.y < mLocalAabbMin.y)
+    {
+      int blockEnd = ((mCellIndex.x >> level) + 1) << level;
+      return blockEnd - mCellIndex.x;
+    }
+  }
+  return 0;
 }
 
 Triangle HeightMapCollider::GetTriangle(uint key)
@@ -177,7 +457,7 @@ Triangle HeightMapCollider::GetTriangle(uint key)
 
 HeightMapCollider::HeightMapRangeWrapper HeightMapCollider::GetOverlapRange(Aabb& localAabb)
 {
-  HeightMapRangeWrapper range(mMap, localAabb, mThickness);
+  HeightMapRangeWrapper range(this, localAabb);
   // This only needs to be set once and it will persist through all objects in
   // the range
   range.mObj.Shape.ScaledDir = HeightMap::UpVector * -mThickness;
@@ -186,19 +466,65 @@ HeightMapCollider::HeightMapRangeWrapper HeightMapCollider::GetOverlapRange(Aabb
 
 bool HeightMapCollider::Cast(const Ray& localRay, ProxyResult& result, BaseCastFilter& filter)
 {
-  // Cast a local ray (already transformed by the collision manager) against the
-  // internal height map
-  HeightMapRayRange range = mMap->CastLocalRay(localRay);
-  // If the height map didn't get any results then stop
-  if (range.Empty())
+  if (mPatchBounds.Empty())
     return false;
 
-  // Otherwise we got a triangle that we actually hit
-  HeightMapRayRange::TriangleInfo& triInfo = range.Front();
-  Triangle& tri = triInfo.mLocalTri;
+  // Clip the ray (already transformed by the collision manager) to the bounds
+  // of all of the patches. The aabb is padded so hits on its surface are kept.
+  Vec3 padding = Vec3(real(0.01f));
+  Intersection::Interval interval;
+  Intersection::Type type = Intersection::RayAabb(
+      localRay.Start, localRay.Direction, mLocalAabb.mMin - padding, mLocalAabb.mMax + padding, &interval);
+  if (type == Intersection::None)
+    return false;
+  real minT = Math::Max(interval.Min, real(0));
+  real maxT = interval.Max;
+  if (minT > maxT)
+    return false;
+
+  HeightPatchRayCast cast(mMap, localRay.Start, localRay.Direction, maxT);
+  uint topLevel = HeightPatchBounds::cLevelCount - 1;
+
+  Vec2 rayStart = Vec2(localRay.Start.x, localRay.Start.z);
+  Vec2 rayDir = Vec2(localRay.Direction.x, localRay.Direction.z);
+  if (rayDir.x == real(0) && rayDir.y == real(0))
+  {
+    // A ray straight down only goes through one patch
+    PatchIndex patchIndex = mMap->GetPatchIndexFromLocal(rayStart);
+    if (HeightPatchBounds* bounds = mPatchBounds.FindValue(patchIndex, nullptr))
+    {
+      cast.SetPatch(bounds);
+      cast.CastBlock(topLevel, 0, 0, minT);
+    }
+  }
+  else
+  {
+    // Walk the patches in the order the ray goes through them
+    PatchRayRange range(mMap, rayStart, rayDir, minT, maxT);
+    for (; !range.Empty(); range.PopFront())
+    {
+      HeightPatchBounds* bounds = mPatchBounds.FindValue(range.Front(), nullptr);
+      if (bounds == nullptr)
+        continue;
+
+      cast.SetPatch(bounds);
+
+      // Every patch after this one starts further along the ray
+      real enterT, exitT;
+      bool overlaps = cast.ClipBlock(topLevel, 0, 0, minT, Math::PositiveMax(), enterT, exitT);
+      if (cast.mHit && overlaps && enterT > cast.mT)
+        break;
+
+      cast.CastBlock(topLevel, 0, 0, minT);
+    }
+  }
+
+  if (!cast.mHit)
+    return false;
 
   // Copy the intersection info into the cast result
-  Intersection::IntersectionPoint& point = triInfo.mIntersectionInfo;
+  Triangle& tri = cast.mTriangle;
+  Intersection::IntersectionPoint& point = cast.mPoint;
   result.mPoints[0] = point.Points[0];
   result.mPoints[1] = point.Points[1];
   result.mDistance = point.T;
@@ -221,12 +547,70 @@ bool HeightMapCollider::Cast(const Ray& localRay, ProxyResult& result, BaseCastF
   }
 
   // Compute this triangle's key so we can look it back up if needed
-  AbsoluteIndex absIndex = mMap->GetAbsoluteIndex(range.mPatchRange.Front(), range.mCellRange.Front());
-  HeightMapCollider::TriangleIndexToKey(absIndex, range.mTriangleIndex, result.ShapeIndex);
+  AbsoluteIndex absIndex = mMap->GetAbsoluteIndex(cast.mPatchIndex, cast.mCellIndex);
+  HeightMapCollider::TriangleIndexToKey(absIndex, cast.mTriangleIndex, result.ShapeIndex);
 
   return true;
 }
 
+uint HeightMapCollider::CastRays(const Array<Ray>& worldRays, Array<ProxyResult>& results, BaseCastFilter& filter)
+{
+  WorldTransformation* worldTransform = GetWorldTransform();
+  Mat4 transform = worldTransform->GetWorldMatrix();
+  Mat4 invTransform = transform.Inverted();
+
+  uint hitCount = 0;
+  results.Resize(worldRays.Size());
+  for (uint i = 0; i < worldRays.Size(); ++i)
+  {
+    ProxyResult& result = results[i];
+    Ray worldRay = worldRays[i];
+    worldRay.Direction.AttemptNormalize();
+    Ray localRay = worldRay.Transform(invTransform);
+    if (!Cast(localRay, result, filter))
+    {
+      result.mObjectHit = nullptr;
+      continue;
+    }
+
+    // Bring the local results back into world space
+    result.mObjectHit = static_cast<Collider*>(this);
+    result.mPoints[0] = Math::TransformPoint(transform, result.mPoints[0]);
+    result.mPoints[1] = Math::TransformPoint(transform, result.mPoints[1]);
+    result.mDistance = Math::Length(result.mPoints[0] - worldRay.Start);
+    result.mContactNormal = worldTransform->TransformSurfaceNormal(result.mContactNormal);
+    result.mContactNormal.AttemptNormalize();
+    ++hitCount;
+  }
+  return hitCount;
+}
+
+CastResultsRange HeightMapCollider::CastRays(const HandleOf<ArrayClass<Vec3>>& worldStarts, Vec3Param worldDirection)
+{
+  CastFilter filter;
+  return CastRays(worldStarts, worldDirection, filter);
+}
+
+CastResultsRange HeightMapCollider::CastRays(const HandleOf<ArrayClass<Vec3>>& worldStarts,
+                                             Vec3Param worldDirection,
+                                             CastFilter& filter)
+{
+  CastResultsRange range;
+  ArrayClass<Vec3>* starts = worldStarts;
+  if (starts != nullptr)
+  {
+    Array<Ray> worldRays;
+    worldRays.Resize(starts->NativeArray.Size());
+    for (uint i = 0; i < worldRays.Size(); ++i)
+      worldRays[i] = Ray(starts->NativeArray[i], worldDirection);
+
+    // Cast results are laid out the same as proxy results (see CastResults)
+    CastRays(worldRays, (ProxyCastResultArray&)range.mArray, filter);
+  }
+  range.mRange = range.mArray.All();
+  return range;
+}
+
 HeightMap* HeightMapCollider::GetHeightMap()
 {
   return mMap;
@@ -284,15 +668,51 @@ void HeightMapCollider::ReloadAllPatches()
     if (range.Front() != nullptr)
       LoadPatch(mMap, range.Front());
   }
+
+  // Every patch is loaded at once so each only has to be built once
+  ClearPatchBounds();
+  for (range = mMap->GetAllPatches(); !range.Empty(); range.PopFront())
+  {
+    HeightPatch* patch = range.Front();
+    if (patch == nullptr)
+      continue;
+
+    HeightPatchBounds* bounds = new HeightPatchBounds();
+    bounds->Build(mMap, patch->Index);
+    mPatchBounds.Insert(patch->Index, bounds);
+  }
   // Since our internal size changed make sure to run all common update code
   InternalSizeChanged();
 }
 
+void HeightMapCollider::RebuildPatchBounds(PatchIndexParam index)
+{
+  // A patch's cells use the first row and column of the patches after it, so
+  // the patches before this one have to be rebuilt too
+  for (int y = -1; y <= 0; ++y)
+  {
+    for (int x = -1; x <= 0; ++x)
+    {
+      PatchIndex patchIndex = index + PatchIndex(x, y);
+      if (HeightPatchBounds* bounds = mPatchBounds.FindValue(patchIndex, nullptr))
+        bounds->Build(mMap, patchIndex);
+    }
+  }
+}
+
+void HeightMapCollider::ClearPatchBounds()
+{
+  DeleteObjectsIn(mPatchBounds.Values());
+  mPatchBounds.Clear();
+}
+
 void HeightMapCollider::OnHeightMapPatchAdded(HeightMapEvent* hEvent)
 {
   // Create a new patch aabb and load/compute the patch's local space aabb
   mPatchAabbs.Insert(hEvent->Patch->Index, Aabb());
   LoadPatch(hEvent->Map, hEvent->Patch);
+  mPatchBounds.Insert(hEvent->Patch->Index, new HeightPatchBounds());
+  RebuildPatchBounds(hEvent->Patch->Index);
 
   // Since our internal size changed make sure to run all common update code
   InternalSizeChanged();
@@ -302,6 +722,10 @@ void HeightMapCollider::OnHeightMapPatchRemoved(HeightMapEvent* hEvent)
 {
   // Remove a patch aabb
   mPatchAabbs.Erase(hEvent->Patch->Index);
+  PatchIndex index = hEvent->Patch->Index;
+  delete mPatchBounds.FindValue(index, nullptr);
+  mPatchBounds.Erase(index);
+  RebuildPatchBounds(index);
 
   // Since our internal size changed make sure to run all common update code
   InternalSizeChanged();
@@ -311,6 +735,7 @@ void HeightMapCollider::OnHeightMapPatchModified(HeightMapEvent* hEvent)
 {
   // One of the patches were modified. For simplicity just reload the patch.
   LoadPatch(hEvent->Map, hEvent->Patch);
+  RebuildPatchBounds(hEvent->Patch->Index);
 
   // Since our internal size changed make sure to run all common update code
   InternalSizeChanged();
@@ -6,6 +6,8 @@ namespace Zero
 
 struct ProxyResult;
 struct BaseCastFilter;
+struct CastFilter;
+struct CastResultsRange;
 
 /// Defines collision for a height map.
 class HeightMapCollider : public Collider
@@ -14,6 +16,7 @@ public:
   ZilchDeclareType(HeightMapCollider, TypeCopyMode::ReferenceType);
 
   HeightMapCollider();
+  ~HeightMapCollider();
 
   // Component interface
   void Serialize(Serializer& stream) override;
@@ -38,8 +41,9 @@ public:
 
   /// A range for returning the local-space triangles that need to have
   /// collision checked. All triangles returned intersect the passed in local
-  /// space aabb. The work horse is the internal HeightMapAabbRange, this just
-  /// wraps that for intersection and computes a unique id for each triangles.
+  /// space aabb. Walks the same patches and cells in the same order as the
+  /// HeightMap's HeightMapAabbRange, but skips whole blocks of cells using the
+  /// collider's HeightPatchBounds and computes a unique id for each triangle.
   struct HeightMapRangeWrapper
   {
     /// Represents a unique (swept) triangle int he height map
@@ -49,14 +53,42 @@ public:
       SweptTriangle Shape;
     };
 
-    HeightMapRangeWrapper(HeightMap* map, Aabb& aabb, real thickness);
+    HeightMapRangeWrapper(HeightMapCollider* collider, const Aabb& aabb);
 
     // Range Interface
     void PopFront();
     InternalObject& Front();
     bool Empty();
 
-    HeightMapAabbRange mRange;
+    // Internals
+    /// Moves to the next patch that has bounds (or past the last one).
+    void SkipDeadPatches();
+    void LoadCellRange();
+    /// Moves to the next cell with triangles in the aabb, starting at the
+    /// current one.
+    void SkipDeadCells();
+    /// If a block holding the current cell can't touch the aabb, returns how
+    /// many cells to move along x to get past it.
+    uint GetCellsToSkip();
+
+    HeightMapCollider* mCollider;
+    real mThickness;
+    Vec3 mLocalAabbMin;
+    Vec3 mLocalAabbMax;
+
+    PatchIndex mMinPatch;
+    PatchIndex mMaxPatch;
+    PatchIndex mPatchIndex;
+    HeightPatchBounds* mPatchBounds;
+
+    CellIndex mMinCell;
+    CellIndex mMaxCell;
+    CellIndex mCellIndex;
+
+    Triangle mTriangles[2];
+    uint mTriangleCount;
+    uint mTriangleIndex;
+
     InternalObject mObj;
   };
 
@@ -80,6 +112,18 @@ public:
   /// generic GetOverlapAabb function. Note: the ray here is expected to be in
   /// this cog's local space.
   bool Cast(const Ray& localRay, ProxyResult& result, BaseCastFilter& filter);
+  /// Casts many world space rays against just this height map, inverting its
+  /// transform once for all of them. Each result is filled out in world space
+  /// with mObjectHit set to this collider, or null if its ray missed. Returns
+  /// how many rays hit.
+  uint CastRays(const Array<Ray>& worldRays, Array<ProxyResult>& results, BaseCastFilter& filter);
+  /// Casts a world space ray from each start in the same direction against
+  /// only this height map (such as to find the ground under many points). There
+  /// is one result per start in the same order, the results of rays that missed
+  /// have no collider.
+  CastResultsRange CastRays(const HandleOf<ArrayClass<Vec3>>& worldStarts, Vec3Param worldDirection);
+  CastResultsRange
+  CastRays(const HandleOf<ArrayClass<Vec3>>& worldStarts, Vec3Param worldDirection, CastFilter& filter);
 
   HeightMap* GetHeightMap();
   TriangleInfoMap* GetInfoMap();
@@ -91,9 +135,14 @@ public:
 
 private:
   typedef HashMap<PatchIndex, Aabb> PatchAabbMap;
+  typedef HashMap<PatchIndex, HeightPatchBounds*> PatchBoundsMap;
 
   void LoadPatch(HeightMap* map, HeightPatch* mapPatch);
   void ReloadAllPatches();
+  /// Rebuilds the bounds of the patch and of the patches that share its
+  /// corners (the ones before it on x and y).
+  void RebuildPatchBounds(PatchIndexParam index);
+  void ClearPatchBounds();
   void OnHeightMapPatchAdded(HeightMapEvent* hEvent);
   void OnHeightMapPatchRemoved(HeightMapEvent* hEvent);
   void OnHeightMapPatchModified(HeightMapEvent* hEvent);
@@ -101,6 +150,7 @@ private:
   real mThickness;
   Aabb mLocalAabb;
   PatchAabbMap mPatchAabbs;
+  PatchBoundsMap mPatchBounds;
 
   HeightMap* mMap;
   TriangleInfoMap mInfoMap;
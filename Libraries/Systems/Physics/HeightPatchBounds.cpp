@@ -0,0 +1,139 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+// Height Patch Bounds
+void HeightPatchBounds::Build(HeightMap* map, PatchIndexParam index)
+{
+  mIndex = index;
+
+  // Sampled the same way as the HeightMap's ranges so the triangles match
+  for (uint y = 0; y < cCornersPerSide; ++y)
+  {
+    for (uint x = 0; x < cCornersPerSide; ++x)
+    {
+      AbsoluteIndex absoluteIndex = map->GetAbsoluteIndex(index, CellIndex(x, y));
+      mHeights[x + y * cCornersPerSide] = map->SampleHeight(absoluteIndex, Math::cInfinite);
+    }
+  }
+
+  // Each cell only bounds the corners of its valid triangles
+  Vec2* cells = mBounds + GetLevelOffset(0);
+  for (uint y = 0; y < cSize; ++y)
+  {
+    for (uint x = 0; x < cSize; ++x)
+    {
+      const float* corner = mHeights + x + y * cCornersPerSide;
+      float h00 = corner[0];
+      float h10 = corner[1];
+      float h01 = corner[cCornersPerSide];
+      float h11 = corner[cCornersPerSide + 1];
+
+      bool b00 = h00 != Math::cInfinite;
+      bool b01 = h01 != Math::cInfinite;
+      bool b10 = h10 != Math::cInfinite;
+      bool b11 = h11 != Math::cInfinite;
+
+      Vec2 bounds(Math::PositiveMax(), -Math::PositiveMax());
+      if (b01 && b00 && b10)
+      {
+        bounds.x = Math::Min(Math::Min(h00, h01), Math::Min(h10, bounds.x));
+        bounds.y = Math::Max(Math::Max(h00, h01), Math::Max(h10, bounds.y));
+      }
+      if (b01 && b10 && b11)
+      {
+        bounds.x = Math::Min(Math::Min(h10, h01), Math::Min(h11, bounds.x));
+        bounds.y = Math::Max(Math::Max(h10, h01), Math::Max(h11, bounds.y));
+      }
+      cells[x + y * cSize] = bounds;
+    }
+  }
+
+  for (uint level = 1; level < cLevelCount; ++level)
+  {
+    uint size = cSize >> level;
+    uint childSize = size * 2;
+    const Vec2* children = mBounds + GetLevelOffset(level - 1);
+    Vec2* blocks = mBounds + GetLevelOffset(level);
+
+    for (uint y = 0; y < size; ++y)
+    {
+      for (uint x = 0; x < size; ++x)
+      {
+        const Vec2* child = children + x * 2 + y * 2 * childSize;
+        Vec2 bounds = child[0];
+        bounds.x = Math::Min(Math::Min(bounds.x, child[1].x), Math::Min(child[childSize].x, child[childSize + 1].x));
+        bounds.y = Math::Max(Math::Max(bounds.y, child[1].y), Math::Max(child[childSize].y, child[childSize + 1].y));
+        blocks[x + y * size] = bounds;
+      }
+    }
+  }
+}
+
+Vec2 HeightPatchBounds::GetBounds(uint level, uint x, uint y) const
+{
+  return mBounds[GetLevelOffset(level) + x + y * (cSize >> level)];
+}
+
+uint HeightPatchBounds::GetTriangles(HeightMap* map, uint x, uint y, Triangle triangles[2]) const
+{
+  // Computed exactly as HeightMap::GetQuadAtIndex so the triangles match the
+  // ones looked up by key
+  Vec2 patchPos = map->GetLocalPosition(mIndex);
+  Vec2 patchHalfExtents = Vec2(map->mUnitsPerPatch, map->mUnitsPerPatch) * .5f;
+  Vec2 patchStart = patchPos - patchHalfExtents;
+  real cellSizeScalar = map->mUnitsPerPatch / HeightPatch::Size;
+  Vec2 cellSize = Vec2(cellSizeScalar, cellSizeScalar) * .5f;
+  Vec2 currCell = Vec2((float)x, (float)y);
+  Vec2 cellStart = patchStart + currCell * cellSizeScalar;
+  Vec2 cellPos = cellStart + cellSize;
+
+  const float* corner = mHeights + x + y * cCornersPerSide;
+  real h00 = corner[0];
+  real h10 = corner[1];
+  real h01 = corner[cCornersPerSide];
+  real h11 = corner[cCornersPerSide + 1];
+
+  Vec3 p00 = Vec3(cellPos.x - cellSize.x, h00, cellPos.y - cellSize.y);
+  Vec3 p01 = Vec3(cellPos.x - cellSize.x, h01, cellPos.y + cellSize.y);
+  Vec3 p10 = Vec3(cellPos.x + cellSize.x, h10, cellPos.y - cellSize.y);
+  Vec3 p11 = Vec3(cellPos.x + cellSize.x, h11, cellPos.y + cellSize.y);
+
+  bool b01 = h01 != Math::cInfinite;
+  bool b00 = h00 != Math::cInfinite;
+  bool b10 = h10 != Math::cInfinite;
+  bool b11 = h11 != Math::cInfinite;
+
+  if (b01 && b00 && b10)
+  {
+    triangles[0] = Triangle(p00, p01, p10);
+
+    if (b01 && b10 && b11)
+    {
+      triangles[1] = Triangle(p10, p01, p11);
+      return 2;
+    }
+    return 1;
+  }
+  else if (b01 && b10 && b11)
+  {
+    triangles[0] = Triangle(p10, p01, p11);
+    return 1;
+  }
+  return 0;
+}
+
+uint HeightPatchBounds::GetLevelOffset(uint level)
+{
+  uint offset = 0;
+  for (uint i = 0; i < level; ++i)
+  {
+    uint size = cSize >> i;
+    offset += size * size;
+  }
+  return offset;
+}
+
+} // namespace Zero
@@ -0,0 +1,42 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Zero
+{
+
+// Height Patch Bounds
+/// The corner heights of every cell in a patch (including the corners shared
+/// with the next patches) and a pyramid of the min and max height of every
+/// block of 2^level by 2^level cells. Queries against the HeightMapCollider
+/// skip any block that the ray or aabb can't touch and read the corners from
+/// here instead of sampling the HeightMap.
+class HeightPatchBounds
+{
+public:
+  static const uint cSize = HeightPatch::Size;
+  static const uint cCornersPerSide = cSize + 1;
+  /// Down to a single block covering the whole patch.
+  static const uint cLevelCount = 6;
+  static const uint cNodeCount = (cSize * cSize * 4 - 1) / 3;
+
+  /// Reads the corner heights from the map and builds the pyramid. Has to be
+  /// built again whenever this patch or one next to it changes.
+  void Build(HeightMap* map, PatchIndexParam index);
+
+  /// The min and max height of a block (x is the min). The min is larger than
+  /// the max when none of the block's cells have a triangle.
+  Vec2 GetBounds(uint level, uint x, uint y) const;
+
+  /// The same triangles that HeightMap::GetQuadAtIndex returns for the cell.
+  uint GetTriangles(HeightMap* map, uint x, uint y, Triangle triangles[2]) const;
+
+  PatchIndex mIndex;
+  /// Infinite where the map has no height (holes and edges).
+  float mHeights[cCornersPerSide * cCornersPerSide];
+  Vec2 mBounds[cNodeCount];
+
+private:
+  static uint GetLevelOffset(uint level);
+};
+
+} // namespace Zero
@@ -208,35 +208,31 @@ void GenerateInternalEdgeInfo(PhysicsMesh* mesh, TriangleInfoMap* infoMap)
   infoMap->Clear();
 
   // get the tree and make sure it exists
-  typedef StaticAabbTree<uint> TreeType;
-  TreeType* treePointer = mesh->GetAabbTree();
-  if (treePointer == nullptr)
+  PhysicsMesh::AabbTree* tree = mesh->GetAabbTree();
+  if (tree == nullptr)
   {
     ErrorIf(true,
             "Physics mesh returned a null tree pointer, "
             "tree must not have been constructed yet.");
     return;
   }
-  // i believe the range macro below doesn't like pointers, so convert to a
-  // reference
-  TreeType& tree = *treePointer;
 
   // loop over all of the triangles in the mesh, for each triangle send it
   // through the tree to determine which triangles should be checked for the
   // more expensive internal calculation (should I fatten the aabb?)
+  Array<uint> overlappingTriangles;
   uint triangleCount = mesh->GetTriangleCount();
   for (uint indexA = 0; indexA < triangleCount; ++indexA)
   {
     Triangle triA = mesh->GetTriangle(indexA);
     Aabb triAabb = ToAabb(triA);
 
-    Array<TreeType::NodeType*> scratchData;
-    AutoDeclare(range, tree.Query(triAabb, scratchData));
-    for (; !range.Empty(); range.PopFront())
-    // forRangeBroadphaseTree(StaticAabbTree<uint>, tree, Aabb, triAabb)
+    overlappingTriangles.Clear();
+    tree->Query(triAabb, overlappingTriangles);
+    for (uint i = 0; i < overlappingTriangles.Size(); ++i)
     {
       // Get the triangle index
-      uint indexB = range.Front();
+      uint indexB = overlappingTriangles[i];
       // if not the same triangle, try to compute the voronoi edge info for the
       // pair.
       if (indexA != indexB)
@@ -11,11 +11,11 @@ Memory::Pool* Island::sPool = new Memory::Pool("Islands", Memory::GetNamedHeap("
 
 void* Island::operator new(size_t size)
 {
-  return sPool->Allocate(size);
+  return PhysicsSpace::AllocateShared(sPool, size);
 }
 void Island::operator delete(void* pMem, size_t size)
 {
-  return sPool->Deallocate(pMem, size);
+  PhysicsSpace::DeallocateShared(sPool, pMem, size);
 }
 
 Island::Island()
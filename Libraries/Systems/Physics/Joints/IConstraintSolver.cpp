@@ -19,7 +19,14 @@ size_t GetMaxSolverSize()
 Memory::Pool* IConstraintSolver::sPool =
     new Memory::Pool("Solvers", Memory::GetNamedHeap("Physics"), GetMaxSolverSize(), 512);
 
-ImplementOverloadedNewWithAllocator(IConstraintSolver, IConstraintSolver::sPool);
+void* IConstraintSolver::operator new(size_t size)
+{
+  return PhysicsSpace::AllocateShared(sPool, size);
+}
+void IConstraintSolver::operator delete(void* pMem, size_t size)
+{
+  PhysicsSpace::DeallocateShared(sPool, pMem, size);
+}
 
 void IConstraintSolver::AddJoints(JointList& joints)
 {
@@ -39,11 +39,11 @@ Memory::Pool* Manifold::sManifoldPool =
 
 void* Manifold::operator new(size_t size)
 {
-  return sManifoldPool->Allocate(size);
+  return PhysicsSpace::AllocateShared(sManifoldPool, size);
 }
 void Manifold::operator delete(void* pMem, size_t size)
 {
-  return sManifoldPool->Deallocate(pMem, size);
+  PhysicsSpace::DeallocateShared(sManifoldPool, pMem, size);
 }
 
 ManifoldPoint Manifold::GetPoint(uint index)
@@ -17,10 +17,56 @@ ZilchDefineType(PhysicsMesh, builder, type)
   ZilchBindMethod(RuntimeClone);
 }
 
+// Meshes built before the flat tree stored a StaticAabbTree instead
+static void DeleteLegacyAabbTree(AabbNode<uint>* node)
+{
+  if (node == nullptr)
+    return;
+
+  DeleteLegacyAabbTree(node->mChild1);
+  DeleteLegacyAabbTree(node->mChild2);
+  delete node;
+}
+
+PhysicsMesh::PhysicsMesh()
+{
+  mLoadedTree = false;
+}
+
 void PhysicsMesh::Serialize(Serializer& stream)
 {
   GenericPhysicsMesh::Serialize(stream);
-  SerializeAabbTree(stream, mTree);
+
+  // The tree is only stored in binary files (built content and saved runtime
+  // meshes), text data rebuilds it on initialize
+  if (stream.GetType() != SerializerType::Binary)
+    return;
+
+  uint version = AabbTree::cVersion;
+  stream.SerializeField("MidPhaseVersion", version);
+
+  if (stream.GetMode() == SerializerMode::Saving)
+  {
+    mTree.Serialize(stream);
+    return;
+  }
+
+  if (version == AabbTree::cVersion)
+  {
+    mTree.Serialize(stream);
+    mLoadedTree = !mTree.Empty();
+  }
+  else if (version == 0)
+  {
+    // The zero read was the start of the old tree's polymorphic node. Old trees
+    // are skipped and regenerated since they stored index buffer offsets.
+    DeleteLegacyAabbTree(SerializeAabbTree<uint>(stream));
+    stream.EndPolymorphic();
+  }
+  else
+  {
+    ErrorIf(true, "Physics mesh has an unknown mid-phase version.");
+  }
 }
 
 void PhysicsMesh::Initialize()
@@ -31,7 +77,8 @@ void PhysicsMesh::Initialize()
 void PhysicsMesh::Unload()
 {
   GenericPhysicsMesh::Unload();
-  mTree.DeleteTree();
+  mTree.Clear();
+  mLoadedTree = false;
 }
 
 void PhysicsMesh::OnResourceModified()
@@ -52,6 +99,12 @@ void PhysicsMesh::ForceRebuild()
 
 void PhysicsMesh::RebuildMidPhase()
 {
+  // Any rebuild after the first means the mesh was modified
+  bool useLoadedTree = mLoadedTree && mTree.GetPrimitiveCount() == GetTriangleCount();
+  mLoadedTree = false;
+  if (useLoadedTree)
+    return;
+
   GenerateTree();
 }
 
@@ -60,32 +113,52 @@ void PhysicsMesh::GenerateInternalEdgeData()
   GenerateInternalEdgeInfo(this, &mInfoMap);
 }
 
-bool PhysicsMesh::CastRay(const Ray& localRay, ProxyResult& result, BaseCastFilter& filter)
+// Tests the triangles the tree finds along the ray, shortening the ray with
+// every hit so nodes behind the closest triangle are skipped
+struct PhysicsMeshRayCallback
 {
-  bool triangleHit = false;
-  result.mTime = Math::PositiveMax();
+  PhysicsMeshRayCallback(PhysicsMesh* mesh, const Ray& localRay, ProxyResult& result, BaseCastFilter& filter) :
+      mMesh(mesh),
+      mLocalRay(localRay),
+      mResult(result),
+      mFilter(filter),
+      mHit(false)
+  {
+  }
 
-  // Query the aabb tree for possible triangles. Test all triangles whose aabbs
-  // we hit.
-  forRangeBroadphaseTree(StaticAabbTree<uint>, mTree, Ray, localRay)
+  void operator()(uint triIndex, real& maxT)
   {
-    uint triIndex = range.Front();
-    Triangle tri = GetTriangle(triIndex);
-    triangleHit |= CastRayTriangle(localRay, tri, triIndex, result, filter);
+    Triangle tri = mMesh->GetTriangle(triIndex);
+    if (mMesh->CastRayTriangle(mLocalRay, tri, triIndex, mResult, mFilter))
+    {
+      mHit = true;
+      maxT = mResult.mTime;
+    }
   }
 
-  return triangleHit;
+  PhysicsMesh* mMesh;
+  const Ray& mLocalRay;
+  ProxyResult& mResult;
+  BaseCastFilter& mFilter;
+  bool mHit;
+};
+
+bool PhysicsMesh::CastRay(const Ray& localRay, ProxyResult& result, BaseCastFilter& filter)
+{
+  result.mTime = Math::PositiveMax();
+
+  PhysicsMeshRayCallback callback(this, localRay, result, filter);
+  mTree.CastRay(localRay, result.mTime, callback);
+  return callback.mHit;
 }
 
 void PhysicsMesh::GetOverlappingTriangles(Aabb& aabb, TriangleArray& triangles, Array<uint>& triangleIds)
 {
-  forRangeBroadphaseTree(StaticAabbTree<uint>, mTree, Aabb, aabb)
-  {
-    // Get the triangle index
-    uint triIndex = range.Front();
-    triangles.PushBack(GetTriangle(triIndex));
-    triangleIds.PushBack(triIndex);
-  }
+  uint firstId = triangleIds.Size();
+  mTree.Query(aabb, triangleIds);
+
+  for (uint i = firstId; i < triangleIds.Size(); ++i)
+    triangles.PushBack(GetTriangle(triangleIds[i]));
 }
 
 void PhysicsMesh::CopyTo(PhysicsMesh* destination)
@@ -94,38 +167,20 @@ void PhysicsMesh::CopyTo(PhysicsMesh* destination)
   ForceRebuild();
 }
 
-StaticAabbTree<uint>* PhysicsMesh::GetAabbTree()
+PhysicsMesh::AabbTree* PhysicsMesh::GetAabbTree()
 {
   return &mTree;
 }
 
 void PhysicsMesh::GenerateTree()
 {
-  // Clear the old tree
-  mTree.DeleteTree();
-
-  // Build the Aabb-Tree
-  mTree.SetPartitionMethod(PartitionMethods::MinimizeVolumeSum);
-
-  // Dummy proxy. They will not be needed.
-  BroadPhaseProxy proxy;
-
-  size_t triangleCount = GetTriangleCount();
-  for (size_t triIndex = 0; triIndex < triangleCount; ++triIndex)
-  {
-    Triangle tri = GetTriangle(triIndex);
-
-    // Create the broad phase data.
-    BaseBroadPhaseData<uint> data;
-    data.mClientData = triIndex;
-    data.mAabb = ToAabb(tri);
-
-    // Insert it into the tree
-    mTree.CreateProxy(proxy, data);
-  }
+  uint triangleCount = GetTriangleCount();
+  Array<Aabb> triangleAabbs;
+  triangleAabbs.Resize(triangleCount);
+  for (uint triIndex = 0; triIndex < triangleCount; ++triIndex)
+    triangleAabbs[triIndex] = ToAabb(GetTriangle(triIndex));
 
-  // Construct the tree
-  mTree.Construct();
+  mTree.Build(triangleAabbs);
 }
 
 ImplementResourceManager(PhysicsMeshManager, PhysicsMesh);
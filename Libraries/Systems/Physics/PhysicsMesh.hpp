@@ -10,7 +10,9 @@ class PhysicsMesh : public GenericPhysicsMesh
 {
 public:
   ZilchDeclareType(PhysicsMesh, TypeCopyMode::ReferenceType);
-  typedef StaticAabbTree<uint> AabbTree;
+  typedef FlatAabbTree AabbTree;
+
+  PhysicsMesh();
 
   // Interface
   void Serialize(Serializer& stream) override;
@@ -37,13 +39,17 @@ public:
   /// Copy all relevant info for runtime clone.
   void CopyTo(PhysicsMesh* destination);
   /// Returns the mesh's Aabb tree.
-  StaticAabbTree<uint>* GetAabbTree();
+  AabbTree* GetAabbTree();
 
 private:
   void GenerateTree();
 
-  /// Aabb Tree used for fast ray casts and triangle lookups.
-  StaticAabbTree<uint> mTree;
+  /// Aabb Tree used for fast ray casts and triangle lookups. Built at content
+  /// build time and loaded with the mesh.
+  AabbTree mTree;
+  /// Set when the tree was loaded with the mesh so the first rebuild (on
+  /// initialize) doesn't regenerate it.
+  bool mLoadedTree;
 };
 
 class PhysicsMeshManager : public ResourceManager
@@ -175,6 +175,33 @@ ZilchDefineType(PhysicsSpace, builder, type)
   // ZilchBindGetter(IslandCount);
 }
 
+bool PhysicsSpace::sLockSharedPools = false;
+ThreadLock PhysicsSpace::sSharedPoolLock;
+
+MemPtr PhysicsSpace::AllocateShared(Memory::Pool* pool, size_t size)
+{
+  if (!sLockSharedPools)
+    return pool->Allocate(size);
+
+  sSharedPoolLock.Lock();
+  MemPtr memory = pool->Allocate(size);
+  sSharedPoolLock.Unlock();
+  return memory;
+}
+
+void PhysicsSpace::DeallocateShared(Memory::Pool* pool, MemPtr memory, size_t size)
+{
+  if (!sLockSharedPools)
+  {
+    pool->Deallocate(memory, size);
+    return;
+  }
+
+  sSharedPoolLock.Lock();
+  pool->Deallocate(memory, size);
+  sSharedPoolLock.Unlock();
+}
+
 PhysicsSpace::PhysicsSpace()
 {
   mHeap = nullptr;
@@ -186,9 +213,12 @@ PhysicsSpace::PhysicsSpace()
   mIslandManager = nullptr;
   mWorldCollider = nullptr;
   mNodeManager = nullptr;
+  mUnpooledBodyCount = 0;
 
   mDebugDrawFlags.SetFlag(PhysicsSpaceDebugDrawFlags::DrawDebug);
   mIterationDt = real(.016);
+  mSteppedConcurrently = false;
+  mQueueBodyEvents = false;
 
   mInvalidVelocityOccurred = false;
   mMaxVelocity = real(1e+10);
@@ -279,6 +309,8 @@ void PhysicsSpace::Initialize(CogInitializer& initializer)
   PushBroadPhaseQueue();
 
   ConnectThisTo(GetOwner(), Events::SystemLogicUpdate, SystemLogicUpdate);
+  ConnectThisTo(GetOwner(), Events::PreConcurrentSystemLogicUpdate, PreConcurrentLogicUpdate);
+  ConnectThisTo(GetOwner(), Events::ConcurrentSystemLogicUpdate, ConcurrentLogicUpdate);
 }
 
 PhysicsIslandType::Enum PhysicsSpace::GetIslandingType() const
@@ -588,24 +620,35 @@ void PhysicsSpace::SystemLogicUpdate(UpdateEvent* updateEvent)
   {
     FpuExceptionsEnabler();
 
-    // If any resources are modified then make sure to update them now (probably
-    // modified in script)
-    UpdateModifiedResources();
+    if (mSteppedConcurrently)
+    {
+      // The timestep was already run on a worker thread, only its events and
+      // results need to be published. Every concurrent step has finished by now
+      mSteppedConcurrently = false;
+      sLockSharedPools = false;
+      DispatchQueuedBodyEvents();
+    }
+    else
+    {
+      // If any resources are modified then make sure to update them now
+      // (probably modified in script)
+      UpdateModifiedResources();
 
-    // This push is necessary to put physics into a valid state after the rest
-    // of the engine may have done things to physics
-    PushBroadPhaseQueueProfiled();
+      // This push is necessary to put physics into a valid state after the
+      // rest of the engine may have done things to physics
+      PushBroadPhaseQueueProfiled();
 
-    ReturnIf(mSubStepCount == 0, , "Physics is set to have no iteration steps.");
+      ReturnIf(mSubStepCount == 0, , "Physics is set to have no iteration steps.");
 
-    // If this is a preview space, don't run the timestep. This will prevent
-    // previews from integrating forces, solving joints, etc...
-    if (!GetSpace()->IsPreviewMode())
-    {
-      real frameTime = updateEvent->Dt;
-      real dt = frameTime / real(mSubStepCount);
-      for (uint i = 0; i < mSubStepCount; ++i)
-        IterateTimestep(dt);
+      // If this is a preview space, don't run the timestep. This will prevent
+      // previews from integrating forces, solving joints, etc...
+      if (!GetSpace()->IsPreviewMode())
+      {
+        real frameTime = updateEvent->Dt;
+        real dt = frameTime / real(mSubStepCount);
+        for (uint i = 0; i < mSubStepCount; ++i)
+          IterateTimestep(dt);
+      }
     }
   }
 
@@ -620,6 +663,82 @@ void PhysicsSpace::SystemLogicUpdate(UpdateEvent* updateEvent)
   owner->DispatchEvent(Events::PhysicsUpdateFinished, &e);
 }
 
+void PhysicsSpace::PreConcurrentLogicUpdate(UpdateEvent* updateEvent)
+{
+  mSteppedConcurrently = mSubStepCount != 0 && !GetSpace()->IsPreviewMode() && CanStepConcurrently();
+
+  // Resource managers are shared between spaces and notify script, so they
+  // can't be updated from the worker thread
+  if (mSteppedConcurrently)
+  {
+    UpdateModifiedResources();
+    sLockSharedPools = true;
+  }
+}
+
+void PhysicsSpace::ConcurrentLogicUpdate(UpdateEvent* updateEvent)
+{
+  if (!mSteppedConcurrently)
+    return;
+
+  ProfileScopeTree("ConcurrentPhysics", "Engine", ByteColorRGBA(232, 0, 34, 255));
+  FpuExceptionsEnabler();
+
+  PushBroadPhaseQueueProfiled();
+
+  mQueueBodyEvents = true;
+  real frameTime = updateEvent->Dt;
+  real dt = frameTime / real(mSubStepCount);
+  for (uint i = 0; i < mSubStepCount; ++i)
+    IterateTimestep(dt);
+  mQueueBodyEvents = false;
+}
+
+void PhysicsSpace::DispatchQueuedBodyEvents()
+{
+  // Bodies may have been destroyed by script since the step queued the events
+  forRange (QueuedBodyEvent& queuedEvent, mQueuedBodyEvents.All())
+  {
+    Cog* cog = queuedEvent.mCogId;
+    if (cog == nullptr)
+      continue;
+
+    RigidBody* body = cog->has(RigidBody);
+    if (body == nullptr)
+      continue;
+
+    ObjectEvent toSend(body);
+    cog->DispatchEvent(queuedEvent.mEventId, &toSend);
+  }
+  mQueuedBodyEvents.Clear();
+}
+
+bool PhysicsSpace::CanStepConcurrently()
+{
+  // Debug drawing goes through the global debug draw stack
+  if (mDebugDrawFlags.IsSet(PhysicsSpaceDebugDrawFlags::DrawSleepPreventors))
+    return false;
+
+  // Custom effects are computed in script
+  forRange (PhysicsEffect& effect, mEffects.All())
+  {
+    if (effect.GetEffectType() == PhysicsEffectType::Custom)
+      return false;
+  }
+
+  // Pre-solve events are sent in the middle of the timestep
+  if (CollisionTable* collisionTable = mCollisionTable)
+  {
+    forRange (CollisionFilter* filter, collisionTable->mCollisionFilters.All())
+    {
+      if (filter->mFilterFlags.IsSet(FilterFlags::PreSolveEvent))
+        return false;
+    }
+  }
+
+  return true;
+}
+
 void PhysicsSpace::FlushPhysicsQueue()
 {
   PushBroadPhaseQueue();
@@ -710,8 +829,8 @@ void PhysicsSpace::IntegrateBodiesVelocity(real dt)
     if (body.mState.IsSet(RigidBodyStates::Asleep))
     {
       // Change to the inactive list
-      mRigidBodies.Erase(&body);
-      mInactiveRigidBodies.PushBack(&body);
+      UnlinkBody(&body);
+      LinkBody(&body, mInactiveRigidBodies);
       continue;
     }
 
@@ -725,23 +844,39 @@ void PhysicsSpace::IntegrateBodiesVelocity(real dt)
 
 void PhysicsSpace::IntegrateBodiesPosition(real dt)
 {
-  RigidBodyList::range range = mRigidBodies.All();
-
-  while (!range.Empty())
+  // When every body in the space is pooled, walk the pool's contiguous slots
+  // instead of chasing the list's links across the heap
+  if (mUnpooledBodyCount == 0 && ComponentPools::GetPool(ZilchTypeId(RigidBody)) != nullptr)
   {
-    RigidBody& body = range.Front();
-
-    if (!body.GetStatic())
+    forRange (RigidBody& body, ComponentPools::All<RigidBody>(GetSpace()))
     {
-      Physics::Integration::IntegratePosition(&body, dt);
-      // Attempt to sleep the body.
-      body.UpdateSleepTimer(dt);
+      // The pool also holds bodies in the other lists and ones that are still
+      // being created
+      if (body.mInActiveBodies)
+        IntegrateBodyPosition(body, dt);
     }
+    return;
+  }
+
+  RigidBodyList::range range = mRigidBodies.All();
 
+  while (!range.Empty())
+  {
+    IntegrateBodyPosition(range.Front(), dt);
     range.PopFront();
   }
 }
 
+void PhysicsSpace::IntegrateBodyPosition(RigidBody& body, real dt)
+{
+  if (!body.GetStatic())
+  {
+    Physics::Integration::IntegratePosition(&body, dt);
+    // Attempt to sleep the body.
+    body.UpdateSleepTimer(dt);
+  }
+}
+
 void PhysicsSpace::BroadPhase()
 {
   ProfileScopeTree("BroadPhase", "Iteration", Color::SaddleBrown);
@@ -1549,30 +1684,51 @@ void PhysicsSpace::AddComponent(RigidBody* body)
       body->Set2DInternal(false);
   }
 
+  if (!ComponentPools::Contains(GetSpace(), body))
+    ++mUnpooledBodyCount;
+
   if (body->mState.IsSet(RigidBodyStates::Kinematic))
-    mMovingKinematicBodies.PushBack(body);
+    LinkBody(body, mMovingKinematicBodies);
   else if (body->mState.IsSet(RigidBodyStates::Asleep | RigidBodyStates::Static))
-    mInactiveRigidBodies.PushBack(body);
+    LinkBody(body, mInactiveRigidBodies);
   else
-    mRigidBodies.PushBack(body);
+    LinkBody(body, mRigidBodies);
 }
 
 void PhysicsSpace::RemoveComponent(RigidBody* body)
 {
+  if (!ComponentPools::Contains(GetSpace(), body))
+    --mUnpooledBodyCount;
+
   // This can be in several lists, unlink from whichever
-  RigidBodyList::Unlink(body);
+  UnlinkBody(body);
 }
 
 void PhysicsSpace::ComponentStateChange(RigidBody* body)
 {
-  RigidBodyList::Unlink(body);
+  UnlinkBody(body);
 
   if (body->GetStatic() || body->IsAsleep())
-    mInactiveRigidBodies.PushBack(body);
+    LinkBody(body, mInactiveRigidBodies);
   else if (body->GetKinematic())
-    mMovingKinematicBodies.PushBack(body);
+    LinkBody(body, mMovingKinematicBodies);
   else
-    mRigidBodies.PushBack(body);
+    LinkBody(body, mRigidBodies);
+}
+
+void PhysicsSpace::SendBodyStateEvent(RigidBody* body, StringParam eventId)
+{
+  // Event handlers can be script, which can't run on the worker thread
+  if (mQueueBodyEvents)
+  {
+    QueuedBodyEvent& queuedEvent = mQueuedBodyEvents.PushBack();
+    queuedEvent.mCogId = body->GetOwner();
+    queuedEvent.mEventId = eventId;
+    return;
+  }
+
+  ObjectEvent toSend(body);
+  body->GetOwner()->DispatchEvent(eventId, &toSend);
 }
 
 void PhysicsSpace::AddComponent(Joint* joint)
@@ -1742,9 +1898,21 @@ Physics::CollisionManager* PhysicsSpace::GetCollisionManager()
 }
 
 void PhysicsSpace::ActivateKinematic(RigidBody* body)
+{
+  UnlinkBody(body);
+  LinkBody(body, mMovingKinematicBodies);
+}
+
+void PhysicsSpace::LinkBody(RigidBody* body, RigidBodyList& list)
+{
+  list.PushBack(body);
+  body->mInActiveBodies = &list == &mRigidBodies;
+}
+
+void PhysicsSpace::UnlinkBody(RigidBody* body)
 {
   RigidBodyList::Unlink(body);
-  mMovingKinematicBodies.PushBack(body);
+  body->mInActiveBodies = false;
 }
 
 void PhysicsSpace::UpdateKinematicVelocities()
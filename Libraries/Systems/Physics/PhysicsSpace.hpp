@@ -86,6 +86,14 @@ public:
   PhysicsSpace();
   virtual ~PhysicsSpace();
 
+  /// Islands, manifolds, contacts and solvers are allocated from pools shared
+  /// by every space, so they have to be locked while spaces are stepping
+  /// concurrently.
+  static bool sLockSharedPools;
+  static ThreadLock sSharedPoolLock;
+  static MemPtr AllocateShared(Memory::Pool* pool, size_t size);
+  static void DeallocateShared(Memory::Pool* pool, MemPtr memory, size_t size);
+
   // Component Interface
   void Serialize(Serializer& stream) override;
   void Initialize(CogInitializer& initializer) override;
@@ -155,6 +163,17 @@ public:
   /// Updates every object in the space (integration, collision detection /
   /// resolution, etc...).
   void SystemLogicUpdate(UpdateEvent* updateEvent);
+  /// Decides on the main thread whether the coming step can run on a worker
+  /// thread and applies modified resources before it starts.
+  void PreConcurrentLogicUpdate(UpdateEvent* updateEvent);
+  /// Steps the simulation from a worker thread when the space is updated in
+  /// parallel with other isolated spaces. Events are still sent from
+  /// SystemLogicUpdate on the main thread.
+  void ConcurrentLogicUpdate(UpdateEvent* updateEvent);
+  /// Whether anything in the timestep would call into script or debug draw.
+  bool CanStepConcurrently();
+  /// Sends the sleep state events queued by the last concurrent step.
+  void DispatchQueuedBodyEvents();
 
   /// Forces all queued computations in physics to be updated now. Should only
   /// be used for debugging.
@@ -284,6 +303,9 @@ public:
   void RemoveComponent(RigidBody* body);
   /// The given body has changed between Dynamic/Static/Kinematic.
   void ComponentStateChange(RigidBody* body);
+  /// Sends a sleep state event for the body, or queues it until
+  /// SystemLogicUpdate while the timestep is running on a worker thread.
+  void SendBodyStateEvent(RigidBody* body, StringParam eventId);
 
   void AddComponent(Joint* joint);
   void RemoveComponent(Joint* joint);
@@ -355,6 +377,11 @@ private:
 
   /// Takes a kinematic object and moves it to the moving kinematic list.
   void ActivateKinematic(RigidBody* body);
+  /// Links the body into one of the body lists and tracks whether it's the
+  /// active list.
+  void LinkBody(RigidBody* body, RigidBodyList& list);
+  void UnlinkBody(RigidBody* body);
+  void IntegrateBodyPosition(RigidBody& body, real dt);
   /// Computes a kinematic body's velocities.
   void UpdateKinematicVelocities();
   /// Updates kinematic objects between the three internal states of moving,
@@ -393,6 +420,9 @@ private:
 
   // Components
   RigidBodyList mRigidBodies;
+  /// Bodies in this space that were not allocated from the space's component
+  /// pool. Pool walks are only complete while this is zero.
+  uint mUnpooledBodyCount;
   /// Asleep bodies.
   RigidBodyList mInactiveRigidBodies;
   /// Kinematic bodies that have had a transform update called in the last
@@ -455,6 +485,18 @@ public:
   // if it is operating during IterateTimestep.
   real mIterationDt;
 
+  /// Set when the timestep runs in ConcurrentLogicUpdate this step.
+  bool mSteppedConcurrently;
+  /// Set while the timestep is running on a worker thread.
+  bool mQueueBodyEvents;
+
+  struct QueuedBodyEvent
+  {
+    CogId mCogId;
+    String mEventId;
+  };
+  Array<QueuedBodyEvent> mQueuedBodyEvents;
+
   // These variables control the max velocity that a rigid body can be set to.
   // The bool is used to only display an error message the first time this
   // happens.
@@ -77,6 +77,7 @@ public:
 #include "ConvexMeshCollider.hpp"
 #include "CylinderCollider.hpp"
 #include "EllipsoidCollider.hpp"
+#include "HeightPatchBounds.hpp"
 #include "HeightMapCollider.hpp"
 #include "MassOverride.hpp"
 #include "MeshCollider.hpp"
@@ -12,6 +12,7 @@ const real RigidBody::mMaxVelocity = real(1e+10);
 ZilchDefineType(RigidBody, builder, type)
 {
   ZeroBindComponent();
+  type->AddAttribute(ObjectAttributes::cPooledStorage);
   ZeroBindSetup(SetupMode::DefaultSerialization);
   ZeroBindDocumented();
   ZeroBindTag(Tags::Physics);
@@ -87,6 +88,7 @@ RigidBody::RigidBody()
   mPhysicsNode = nullptr;
   mSpaceEffectsToIgnore = nullptr;
   mSpace = nullptr;
+  mInActiveBodies = false;
 }
 
 void RigidBody::Serialize(Serializer& stream)
@@ -745,8 +747,7 @@ void RigidBody::PutToSleep()
   mForceAccumulator.ZeroOut();
   mTorqueAccumulator.ZeroOut();
   // Notify everyone we fell asleep
-  ObjectEvent toSend(this);
-  GetOwner()->DispatchEvent(Events::RigidBodySlept, &toSend);
+  mSpace->SendBodyStateEvent(this, Events::RigidBodySlept);
 }
 
 void RigidBody::WakeUp()
@@ -787,8 +788,7 @@ void RigidBody::InternalWakeUp()
   mSleepTimer = real(0);
 
   // Tell everyone that we woke up
-  ObjectEvent toSend(this);
-  GetOwner()->DispatchEvent(Events::RigidBodyAwoke, &toSend);
+  mSpace->SendBodyStateEvent(this, Events::RigidBodyAwoke);
 }
 
 bool RigidBody::UpdateSleepTimer(real dt)
@@ -393,6 +393,9 @@ public:
   // Space information
   PhysicsSpace* mSpace;
   Link<RigidBody> mSpaceLink;
+  /// Whether mSpaceLink is in the space's list of active dynamic bodies, so
+  /// passes that walk the component pool can skip the others.
+  bool mInActiveBodies;
 };
 
 typedef InList<RigidBody, &RigidBody::mSpaceLink> RigidBodyList;
@@ -24,6 +24,10 @@ ZilchDefineType(Sound, builder, type)
 
 void Sound::CreateAsset(Status& status, StringParam assetName, StringParam fileName, AudioFileLoadType::Enum loadType)
 {
+  // Don't decode audio that can never be played (running headless)
+  if (!Z::gSound)
+    return;
+
   // If the load type is set to auto, determine the type based on the length of
   // the file
   if (loadType == AudioFileLoadType::Auto)
@@ -549,6 +549,10 @@ void SoundCue::StopPreview()
 
 HandleOf<SoundInstance> SoundCue::PlayCue(SoundSpace* space, HandleOf<SoundNode> outputNode, bool startPaused)
 {
+  // There is no SoundSystem when running headless
+  if (!Z::gSound)
+    return nullptr;
+
   // No sounds to choose from
   if (Sounds.Empty())
   {
@@ -60,6 +60,7 @@ ZilchDefineType(SoundEmitter, builder, type)
 }
 
 SoundEmitter::SoundEmitter() :
+    mSpace(nullptr),
     mEmitterObject(nullptr),
     mPitchNode(nullptr),
     mVolumeNode(nullptr),
@@ -125,6 +126,10 @@ void SoundEmitter::Initialize(CogInitializer& initializer)
   mTransform = GetOwner()->has(Transform);
   mPrevPosition = mTransform->GetWorldTranslation();
 
+  // There is no SoundSystem when running headless, so no nodes are created
+  if (!Z::gSound)
+    return;
+
   // Save the ID for this emitter's SoundNodes
   mNodeID = Z::gSound->mCounter++;
 
@@ -234,6 +239,9 @@ void SoundEmitter::InterpolateVolume(float volume, float interpolationTime)
 {
   mVolume = Math::Clamp(volume, 0.0f, cMaxVolumeValue);
 
+  if (!mVolumeNode)
+    return;
+
   mVolumeNode->InterpolateVolume(mVolume, interpolationTime);
 }
 
@@ -251,6 +259,9 @@ void SoundEmitter::InterpolateDecibels(float decibels, float interpolationTime)
 {
   mVolume = Math::Clamp(DecibelsToVolume(decibels), 0.0f, cMaxVolumeValue);
 
+  if (!mVolumeNode)
+    return;
+
   mVolumeNode->InterpolateVolume(mVolume, interpolationTime);
 }
 
@@ -268,6 +279,9 @@ void SoundEmitter::InterpolatePitch(float pitch, float interpolationTime)
 {
   mPitch = Math::Clamp(pitch, cMinPitchValue, cMaxPitchValue);
 
+  if (!mPitchNode)
+    return;
+
   mPitchNode->InterpolatePitch(mPitch, interpolationTime);
 }
 
@@ -285,6 +299,9 @@ void SoundEmitter::InterpolateSemitones(float pitch, float interpolationTime)
 {
   mPitch = Math::Clamp(SemitonesToPitch(pitch), cMinPitchValue, cMaxPitchValue);
 
+  if (!mPitchNode)
+    return;
+
   mPitchNode->InterpolatePitch(mPitch, interpolationTime);
 }
 
@@ -296,6 +313,10 @@ bool SoundEmitter::GetPaused()
 void SoundEmitter::SetPaused(bool pause)
 {
   mIsPaused = pause;
+
+  if (!mEmitterObject)
+    return;
+
   EmitterNode* node = mEmitterObject;
   Z::gSound->Mixer.AddTask(CreateFunctor(&EmitterNode::SetPausedThreaded, node, mIsPaused), node);
 }
@@ -347,6 +368,10 @@ float SoundEmitter::GetEmitAngle()
 void SoundEmitter::SetEmitAngle(float angleInDegrees)
 {
   mEmitAngle = Math::Clamp(angleInDegrees, 1.0f, 360.0f);
+
+  if (!mEmitterObject)
+    return;
+
   EmitterNode* node = mEmitterObject;
   Z::gSound->Mixer.AddTask(CreateFunctor(&EmitterNode::SetDirectionalAngleThreaded, node, mEmitAngle, mRearVolume),
                            node);
@@ -360,6 +385,10 @@ float SoundEmitter::GetRearVolume()
 void SoundEmitter::SetRearVolume(float minimumVolume)
 {
   mRearVolume = Math::Clamp(minimumVolume, 0.0f, cMaxVolumeValue);
+
+  if (!mEmitterObject)
+    return;
+
   EmitterNode* node = mEmitterObject;
   Z::gSound->Mixer.AddTask(CreateFunctor(&EmitterNode::SetDirectionalAngleThreaded, node, mEmitAngle, mRearVolume),
                            node);
@@ -458,7 +487,7 @@ void SoundEmitter::Update(float dt)
 
 HandleOf<SoundInstance> SoundEmitter::PlayCueInternal(SoundCue* cue, bool startPaused)
 {
-  if (!cue)
+  if (!cue || !mEmitterObject)
     return nullptr;
 
   HandleOf<SoundNode> outputNode;
@@ -517,6 +546,10 @@ void SoundEmitter::SetUpAttenuatorNode(SoundAttenuator* newAttenuator)
   // Set the attenuator handle
   mAttenuator = newAttenuator;
 
+  // No nodes exist to attach to (running headless)
+  if (!mEmitterObject)
+    return;
+
   // Check if the new attenuator is null or the default
   if (!newAttenuator || newAttenuator->Name == "DefaultNoAttenuation")
   {
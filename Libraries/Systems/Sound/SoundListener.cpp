@@ -43,6 +43,10 @@ void SoundListener::Initialize(CogInitializer& initializer)
   Mat4 matrix = mTransform->GetWorldMatrix();
   mPrevForward = Math::ToVector3(matrix.BasisZ());
 
+  // There is no SoundSystem when running headless
+  if (!Z::gSound)
+    return;
+
   // Add a new listener node
   String name;
   if (!mSpace->GetOwner()->IsEditorMode())
@@ -97,7 +101,8 @@ bool SoundListener::GetActive()
 
 void SoundListener::SetActive(bool newActive)
 {
-  mListenerNode->SetActive(newActive);
+  if (mListenerNode)
+    mListenerNode->SetActive(newActive);
 
   mActive = newActive;
 }
@@ -115,7 +120,8 @@ float SoundListener::GetAttenuationScale()
 void SoundListener::SetAttenuationScale(float scale)
 {
   mAttenuationScale = scale;
-  mListenerNode->SetAttenuationScale(scale);
+  if (mListenerNode)
+    mListenerNode->SetAttenuationScale(scale);
 }
 
 void SoundListener::Update(float invDt)
@@ -48,6 +48,10 @@ SoundSpace::SoundSpace() :
 
 SoundSpace::~SoundSpace()
 {
+  // Nothing was created without a SoundSystem (running headless)
+  if (!Z::gSound)
+    return;
+
   // Remove this space from the system's list
   Z::gSound->RemoveSoundSpace(this, mEditorMode);
   // Disconnect the nodes
@@ -58,6 +62,11 @@ void SoundSpace::Initialize(CogInitializer& config)
 {
   // Are we in editor mode?
   mEditorMode = !GetGameSession() || GetGameSession()->IsEditorMode();
+
+  // There is no SoundSystem when running headless
+  if (!Z::gSound)
+    return;
+
   // Add this space to the system's list
   Z::gSound->AddSoundSpace(this, mEditorMode);
 
@@ -84,6 +93,9 @@ void SoundSpace::Serialize(Serializer& stream)
 
 float SoundSpace::GetVolume()
 {
+  if (!mSoundNodeOutput)
+    return 1.0f;
+
   return mSoundNodeOutput->GetVolume();
 }
 
@@ -110,11 +122,17 @@ void SoundSpace::SetMuteAudio(bool mute)
 
 void SoundSpace::InterpolateVolume(float value, float interpolationTime)
 {
+  if (!mSoundNodeOutput)
+    return;
+
   mSoundNodeOutput->InterpolateVolume(Math::Max(value, 0.0f), interpolationTime);
 }
 
 float SoundSpace::GetDecibels()
 {
+  if (!mSoundNodeOutput)
+    return 0.0f;
+
   return VolumeToDecibels(mSoundNodeOutput->GetVolume());
 }
 
@@ -125,6 +143,9 @@ void SoundSpace::SetDecibels(float decibels)
 
 void SoundSpace::InterpolateDecibels(float decibels, float interpolationTime)
 {
+  if (!mSoundNodeOutput)
+    return;
+
   mSoundNodeOutput->InterpolateVolume(DecibelsToVolume(decibels), interpolationTime);
 }
 
@@ -143,6 +164,9 @@ void SoundSpace::SetPitch(float pitch)
 
 void SoundSpace::InterpolatePitch(float pitch, float time)
 {
+  if (!mSoundNodeInput)
+    return;
+
   if (!mPitchNode)
   {
     mPitchNode = new PitchNode("Space", mSpaceNodeID);
@@ -167,6 +191,9 @@ void SoundSpace::SetSemitones(float pitch)
 
 void SoundSpace::InterpolateSemitones(float semitones, float time)
 {
+  if (!mSoundNodeInput)
+    return;
+
   semitones = Math::Clamp(semitones, cMinSemitonesValue, cMaxSemitonesValue);
 
   if (!mPitchNode)
@@ -180,11 +207,17 @@ void SoundSpace::InterpolateSemitones(float semitones, float time)
 
 bool SoundSpace::GetPaused()
 {
+  if (!mSoundNodeInput)
+    return false;
+
   return mSoundNodeInput->GetPaused();
 }
 
 void SoundSpace::SetPaused(bool pause)
 {
+  if (!mSoundNodeInput)
+    return;
+
   mSoundNodeInput->SetPaused(pause);
 }
 
@@ -118,6 +118,13 @@ void SoundLibrary::Initialize()
 {
   BuildStaticLibrary();
   MetaDatabase::GetInstance()->AddNativeLibrary(GetLibrary());
+
+  // Registered here rather than by the SoundSystem so that sound resources
+  // still load when the system is not created (running headless)
+  InitializeResourceManager(SoundManager);
+  InitializeResourceManager(SoundCueManager);
+  InitializeResourceManager(SoundTagManager);
+  InitializeResourceManager(SoundAttenuatorManager);
 }
 
 void SoundLibrary::Shutdown()
@@ -165,11 +165,6 @@ void SoundSystem::Initialize(SystemInitializer& initializer)
   mOutputNode = new CombineNode("AudioOutput", mCounter++);
   Mixer.FinalOutputNode->AddInputNode(mOutputNode);
 
-  InitializeResourceManager(SoundManager);
-  InitializeResourceManager(SoundCueManager);
-  InitializeResourceManager(SoundTagManager);
-  InitializeResourceManager(SoundAttenuatorManager);
-
   if (!mUseRandomSeed)
     mRandom.SetSeed(mSeed);
 }
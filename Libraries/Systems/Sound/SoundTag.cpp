@@ -413,6 +413,10 @@ ZilchDefineType(SoundTag, builder, type)
 
 SoundTag::SoundTag() : mTagObject(nullptr), mCompressorTag(nullptr)
 {
+  // There is no SoundSystem when running headless
+  if (!Z::gSound)
+    return;
+
   Z::gSound->mSoundTags.PushBack(this);
 
   if (Z::gSound->mSoundSpaceCounter > 0)
@@ -421,6 +425,9 @@ SoundTag::SoundTag() : mTagObject(nullptr), mCompressorTag(nullptr)
 
 SoundTag::~SoundTag()
 {
+  if (!Z::gSound)
+    return;
+
   Z::gSound->mSoundTags.Erase(this);
 
   if (mTagObject)
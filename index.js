@@ -98,6 +98,19 @@ const executables = [
       "ZeroLauncherResources"
     ],
     vfsOnlyPackage: []
+  },
+  {
+    // Dedicated server, projects are loaded from their exported packages.
+    copyToIncludedBuilds: false,
+    directory: "Projects",
+    name: "WelderServer",
+    nonResourceDependencies: [
+      "Data",
+      repoRootFile
+    ],
+    prebuild: false,
+    resourceLibraries: [],
+    vfsOnlyPackage: []
   }
 ];
 